@@ -30,6 +30,11 @@
 #define IMGUI_NEW(type)         IM_PLACEMENT_NEW (ImGui::MemAlloc(sizeof(type) ) ) type
 #define IMGUI_DELETE(type, obj) reinterpret_cast<type*>(obj)->~type(), ImGui::MemFree(obj)
 
+// Lines::setText(...) uses the threading layer of imguihelper when it's available
+#if (defined(IMGUIHELPER_H_) && defined(IMGUIHELPER_HAS_THREADS))
+#   define IMGUICODEEDITOR_HAS_THREADS
+#endif
+
 #if (!defined(IMGUI_USER_ADDONS_INL_) || defined(NO_IMGUI_WIDGETS_CPP_AUTO_COMPILATION))
 #   define IMGUIEDITOR_STANDALONE
 #endif
@@ -183,7 +188,7 @@ static inline void ImDrawListRenderTextLine(ImDrawList* draw_list,const ImFont*
     if (!text_end) text_end = text_begin + strlen(text_begin);
 
     if ((int)pos.y > clip_rect.w) {
-        pos.x+= (int)pos.x + MyCalcTextWidth(text_begin,text_end);  // Not sure this is correct!
+        pos.x+= MyCalcTextWidth(text_begin,text_end);
         return;
     }
 
@@ -200,6 +205,7 @@ static inline void ImDrawListRenderTextLine(ImDrawList* draw_list,const ImFont*
     if (y + line_height < clip_rect.y && s < text_end) {
         //while (s < text_end && *s != '\n')  s++;// Fast-forward to next line
         s = (const char*)memchr(s, '\n', text_end - s);
+        if (!s) s = text_end;   // single line: nothing to draw
         //s = s ? (s + 1) : text_end;
     }
 
@@ -320,7 +326,7 @@ static inline void ImDrawListAddTextLine(ImDrawList* draw_list,const ImFont* fon
 {
     if (text_end == NULL)   text_end = text_begin + strlen(text_begin);
     if ((col & IM_COL32_A_MASK) == 0)   {
-        pos.x+= (int)pos.x + MyCalcTextWidth(text_begin,text_end);  // Not sure this is correct!
+        pos.x+= MyCalcTextWidth(text_begin,text_end);
         return;
     }
     if (text_begin == text_end) return;
@@ -666,6 +672,24 @@ void CodeEditor::TextLineWithSH(const char* fmt, ...)   {
 }
 
 
+// The text of a Line: it points inside Lines::textBuffer (it's not owned)
+struct LineText {
+    const char* chars;  // '\0' terminated
+    int numChars;
+    LineText() : chars(""),numChars(0) {}
+    inline int size() const {return numChars;}
+    inline int length() const {return numChars;}
+    inline const char* c_str() const {return chars;}
+    inline const char& operator[](int i) const {return chars[i];}
+    inline ImString substr(int beg,int cnt=-1) const {
+        if (beg>=numChars) return ImString("");
+        if (cnt==-1 || cnt>numChars-beg) cnt = numChars-beg;
+        ImString rv;rv.resize(cnt);
+        if (cnt>0) memcpy(&rv[0],&chars[beg],cnt);
+        return rv;
+    }
+};
+
 struct Line {
     enum Attribute {
 	AT_BOOKMARK             = 1,
@@ -680,7 +704,7 @@ struct Line {
     };
 
     // Fixed data
-    ImString text;
+    LineText text;
     int attributes;
 
     // Offst Data
@@ -699,12 +723,30 @@ struct Line {
     // Proposal: use "foldingStartLine" and "foldingEndLine" for all the lines inside a folding region too.
     // => DONE <=
 
-    void reset() {text="";}
+    // Syntax Highlighting Data
+    enum SHState {
+        SH_STATE_NONE = 0,              // default state
+        SH_STATE_MULTILINE_COMMENT = 1, // inside a multiline comment
+        SH_STATE_STRING = 2,            // inside a string continued on the next line: the string delimiter is fsv->stringDelimiterChars[shState-SH_STATE_STRING]
+        SH_STATE_UNKNOWN = 255          // not calculated yet
+    };
+    struct SHSpan {
+        int end;                        // in bytes, from the start of the cached segment (the span starts where the previous one ends)
+        int sht;                        // SyntaxHighlightingType or -1 (plain text)
+    };
+    unsigned char shStateIn,shStateOut; // lexer state at the start and at the end of the line (see CodeEditor::updateSyntaxHighlightingStates(...))
+    ImVector<SHSpan> shSpans;           // cached token spans of the segment [shSpansStart,shSpansEnd) of the line (see CodeEditor::TextLineWithSHCached(...))
+    int shSpansStart,shSpansEnd;        // in bytes, from the start of the line. shSpansStart<0 means that the cache is not valid
+    unsigned char shSpansState;         // lexer state used to build shSpans
+    inline void invalidateSHSpans() {shSpansStart=shSpansEnd=-1;shSpans.clear();}
+
+    void reset() {text=LineText();}
     int size() {return text.size();}
-    Line(const ImString& txt="") : text(txt),attributes(0),
+    Line() : attributes(0),
     lineNumber(-1),offset(0),offsetInUTF8chars(0),numUTF8chars(0),
     foldingStartTag(NULL),foldingStartOffset(0),foldingEndLine(NULL),
-    foldingEndOffset(0),foldingStartLine(NULL) {}
+    foldingEndOffset(0),foldingStartLine(NULL),
+    shStateIn(SH_STATE_UNKNOWN),shStateOut(SH_STATE_UNKNOWN),shSpansStart(-1),shSpansEnd(-1),shSpansState(SH_STATE_NONE) {}
 
     inline bool isFoldable() const {return (attributes&AT_FOLDING_START);}
     inline bool isFolded() const {return (attributes&AT_FOLDING_START) && (attributes&AT_FOLDING_START_FOLDED);}
@@ -757,16 +799,24 @@ bool Lines::remove(int lineNum)    {
     Line* line = (*this)[lineNum];
     for (int i=lineNum,isz=size()-1;i<isz;i++)   (*this)[i] = (*this)[i+1];
     resize(size()-1);
-    IMGUI_DELETE(Line,line);line=NULL;
+    freeLine(line);line=NULL;
     return true;
 }
 
+void Lines::freeLine(Line* line)    {
+    if (linePool && line>=linePool && line<linePool+linePoolSize) line->~Line(); // the block is freed by destroy()
+    else {IMGUI_DELETE(Line,line);}
+}
+
 void Lines::destroy(bool keepFirstLine) {
     for (int i=size()-1;i>=0;i--)  {
         Line*& line = (*this)[i];
-        IMGUI_DELETE(Line,line);line=NULL;
+        freeLine(line);line=NULL;
     }
     Base::clear();
+    if (linePool) {ImGui::MemFree(linePool);linePool=NULL;}
+    linePoolSize=0;
+    textBuffer.clear();
     if (keepFirstLine) add();
 }
 
@@ -784,7 +834,7 @@ void Lines::getText(ImString &rv, int startLineNum, int startLineOffsetBytes, in
     rv+=(*this)[startLineNum]->text.substr(startLineOffsetBytes);
     if (startLineNum!=endLineNum) rv+=cr;
     for (int ln=startLineNum+1;ln<=endLineNum-1;ln++) {
-        rv+=(*this)[ln]->text;
+        rv+=(*this)[ln]->text.c_str();
         rv+=cr;
     }
     rv+=(*this)[endLineNum]->text.substr(0,endLineOffsetBytes);
@@ -842,7 +892,7 @@ void Lines::getText(ImString &rv, int startTotalOffsetInBytes, int endTotalOffse
             return;
         }
         offset = tmpOffset;
-        if (rv.size()>0) rv+=line->text;
+        if (rv.size()>0) rv+=line->text.c_str();
         if (lnsz>ln+1)  {
             tmpOffset = offset+CR_SIZE;
             if (rv.size()>0)    {
@@ -859,54 +909,145 @@ void Lines::getText(ImString &rv, int startTotalOffsetInBytes, int endTotalOffse
 }
 
 
-void Lines::SplitText(const char *text, ImVector<Line*> &lines,ImString* pOptionalCRout)    {
-    IM_ASSERT(lines.size()==0); // replacement to the line below
-    //lines.clear();  //MMMmhhh, should we call delete on all the line* ?
+// Lines::SplitText(...) splits the text in chunks that start at the beginning of a line, and processes them in parallel:
+// pass 0 counts the lines of each chunk, pass 1 creates the lines, pass 2 adds the offsets of the previous chunks.
+struct LinesSplitTextJob {
+    struct Chunk {
+        int start,end;                      // in bytes, [start,end) inside buf
+        int numLines,firstLine;             // lines starting in this chunk
+        unsigned numBytes,numUTF8chars;     // sum of the line sizes (without newline chars)
+        unsigned offsetBase,offsetInUTF8charsBase;
+        unsigned nl_n,nl_rn,nl_r,nl_nr;
+    };
+    ImVector<Chunk> chunks;
+    char* buf;
+    Line* linePool;
+    Line** lines;
+    int pass;
+
+    inline static int NewLineSize(const char* p,const char* end) {
+        // Same rules of the old (serial) parser: "\n\r" and "\r\n" count as a single newline
+        if (*p=='\n') return (p+1<end && *(p+1)=='\r') ? 2 : 1;
+        if (*p=='\r') return (p+1<end && *(p+1)=='\n') ? 2 : 1;
+        return 0;
+    }
+    static void Run(int start,int end,void* userPtr) {
+        LinesSplitTextJob& job = *((LinesSplitTextJob*) userPtr);
+        for (int ci=start;ci<end;ci++)  {
+            Chunk& c = job.chunks[ci];
+            const bool isLastChunk = (ci==job.chunks.size()-1);
+            if (job.pass==0)    {
+                c.numLines = 0;c.nl_n=c.nl_rn=c.nl_r=c.nl_nr=0;
+                for (const char *p=job.buf+c.start,*pe=job.buf+c.end;p<pe;) {
+                    const int nls = NewLineSize(p,pe);
+                    if (nls==0) {++p;continue;}
+                    if (*p=='\n') {if (nls==2) ++c.nl_nr;else ++c.nl_n;}
+                    else {if (nls==2) ++c.nl_rn;else ++c.nl_r;}
+                    ++c.numLines;p+=nls;
+                }
+                if (isLastChunk) ++c.numLines;   // the last line has no newline
+            }
+            else if (job.pass==1)   {
+                c.numBytes = c.numUTF8chars = 0;
+                int lineIndex = c.firstLine;
+                const char *lineStart = job.buf+c.start,*pe=job.buf+c.end;
+                for (const char* p=lineStart;;)  {
+                    const int nls = p<pe ? NewLineSize(p,pe) : 0;
+                    if (nls==0 && p<pe) {++p;continue;}
+                    if (p==pe && !isLastChunk) break;
+                    Line* line = job.lines[lineIndex] = IM_PLACEMENT_NEW(&job.linePool[lineIndex]) Line;
+                    line->text.chars = lineStart;
+                    line->text.numChars = (int)(p-lineStart);
+                    line->lineNumber = lineIndex;
+                    line->offset = c.numBytes;
+                    line->offsetInUTF8chars = c.numUTF8chars;
+                    line->numUTF8chars = ImGui::CountUTF8Chars(lineStart,p);
+                    c.numBytes+=line->text.numChars;
+                    c.numUTF8chars+=line->numUTF8chars;
+                    ++lineIndex;
+                    if (p==pe) break;
+                    job.buf[p-job.buf] = '\0';  // terminates the line text
+                    p+=nls;lineStart=p;
+                }
+                IM_ASSERT(lineIndex==c.firstLine+c.numLines);
+            }
+            else if (c.offsetBase>0 || c.offsetInUTF8charsBase>0)    {
+                for (int i=c.firstLine,isz=c.firstLine+c.numLines;i<isz;i++)    {
+                    Line* line = job.lines[i];
+                    line->offset+=c.offsetBase;
+                    line->offsetInUTF8chars+=c.offsetInUTF8charsBase;
+                }
+            }
+        }
+    }
+};
+
+void Lines::SplitText(const char *text,ImString* pOptionalCRout)    {
+    IM_ASSERT(size()==0 && !linePool);
     if (pOptionalCRout) *pOptionalCRout="\n";
     if (!text) return;
-    ImString ln("");char c;unsigned offsetInBytes=0,offsetInUTF8Chars=0;
-    unsigned nl_n=0,nl_rn=0,nl_r=0,nl_nr=0;Line* line=NULL;
-    for (int i=0,isz=strlen(text);i<isz;i++)    {
-	line = NULL;
-        c=text[i];
-        if (c=='\n')    {
-	    line = IMGUI_NEW(Line);
-            if (i+1<isz && text[i+1]=='\r') {++i;++nl_nr;}
-            else ++nl_n;
-        }
-        else if (c=='\r')   {
-	    line = IMGUI_NEW(Line);
-            if (i+1<isz && text[i+1]=='\n') {++i;++nl_rn;}
-            else ++nl_r;
+    const int textLen = (int) strlen(text);
+    textBuffer.resize(textLen+1);
+    memcpy(&textBuffer[0],text,textLen+1);
+
+    LinesSplitTextJob job;
+    job.buf = &textBuffer[0];
+    // Find the chunks: each chunk (but the first) starts right after a newline
+    static const int chunkSize = 256*1024;
+    {
+        LinesSplitTextJob::Chunk c;memset(&c,0,sizeof(c));
+        int start = 0;
+        for (int nominal = chunkSize;nominal<textLen;nominal+=chunkSize) {
+            int p = nominal;
+            while (p<textLen && !((job.buf[p-1]=='\n' || job.buf[p-1]=='\r') && job.buf[p]!='\n' && job.buf[p]!='\r')) ++p;
+            if (p>=textLen) break;
+            c.start = start;c.end = p;job.chunks.push_back(c);
+            start = nominal = p;
         }
-	if (line)   {
-	    //-----------------------------
-	    line->text =		ln;
-	    line->lineNumber =		lines.size();
-	    line->offset =		offsetInBytes;
-	    line->offsetInUTF8chars =	offsetInUTF8Chars;
-        line->numUTF8chars =	ImGui::CountUTF8Chars(line->text.c_str());
-	    lines.push_back(line);
-	    //-----------------------------
-	    offsetInBytes+=line->size();
-	    offsetInUTF8Chars+=line->numUTF8chars;
-	    ln="";continue;
-	}
-        ln+=c;
+        c.start = start;c.end = textLen;job.chunks.push_back(c);
+    }
+    const int numChunks = job.chunks.size();
+
+    job.pass = 0;
+#   ifdef IMGUICODEEDITOR_HAS_THREADS
+    if (numChunks>1) ImGuiHelper::ThreadPool::GetDefault().parallelFor(0,numChunks,&LinesSplitTextJob::Run,&job,1);
+    else
+#   endif //IMGUICODEEDITOR_HAS_THREADS
+    LinesSplitTextJob::Run(0,numChunks,&job);
+
+    int numLines = 0;unsigned nl_n=0,nl_rn=0,nl_r=0,nl_nr=0;
+    for (int i=0;i<numChunks;i++) {
+        LinesSplitTextJob::Chunk& c = job.chunks[i];
+        c.firstLine = numLines;numLines+=c.numLines;
+        nl_n+=c.nl_n;nl_rn+=c.nl_rn;nl_r+=c.nl_r;nl_nr+=c.nl_nr;
+    }
+    linePool = (Line*) ImGui::MemAlloc(sizeof(Line)*numLines);
+    linePoolSize = numLines;
+    Base::resize(numLines);
+    job.linePool = linePool;
+    job.lines = &(*this)[0];
+
+    job.pass = 1;
+#   ifdef IMGUICODEEDITOR_HAS_THREADS
+    if (numChunks>1) ImGuiHelper::ThreadPool::GetDefault().parallelFor(0,numChunks,&LinesSplitTextJob::Run,&job,1);
+    else
+#   endif //IMGUICODEEDITOR_HAS_THREADS
+    LinesSplitTextJob::Run(0,numChunks,&job);
+
+    unsigned offsetBase = 0,offsetInUTF8charsBase = 0;
+    for (int i=0;i<numChunks;i++) {
+        LinesSplitTextJob::Chunk& c = job.chunks[i];
+        c.offsetBase = offsetBase;c.offsetInUTF8charsBase = offsetInUTF8charsBase;
+        offsetBase+=c.numBytes;offsetInUTF8charsBase+=c.numUTF8chars;
+    }
+    if (numChunks>1) {
+        job.pass = 2;
+#       ifdef IMGUICODEEDITOR_HAS_THREADS
+        ImGuiHelper::ThreadPool::GetDefault().parallelFor(0,numChunks,&LinesSplitTextJob::Run,&job,1);
+#       else //IMGUICODEEDITOR_HAS_THREADS
+        LinesSplitTextJob::Run(0,numChunks,&job);
+#       endif //IMGUICODEEDITOR_HAS_THREADS
     }
-    line = IMGUI_NEW(Line);
-    line->text=ln;
-    //-----------------------------
-    line->text =		ln;
-    line->lineNumber =		lines.size();
-    line->offset =		offsetInBytes;
-    line->offsetInUTF8chars =	offsetInUTF8Chars;
-    line->numUTF8chars =	ImGui::CountUTF8Chars(line->text.c_str());
-    lines.push_back(line);
-    //-----------------------------
-    offsetInBytes+=line->size();
-    offsetInUTF8Chars+=line->numUTF8chars;
-    ln="";
 
     if (pOptionalCRout) {
         if (nl_n<nl_rn || nl_n<nl_r)    *pOptionalCRout= nl_rn >= nl_r ? "\r\n" : "\r";
@@ -917,10 +1058,7 @@ void Lines::SplitText(const char *text, ImVector<Line*> &lines,ImString* pOption
 void Lines::setText(const char *text)   {
     destroy(text ? false : true);
     if (!text) return;
-    ImVector<Line*> Lines;SplitText(text,Lines,&cr);
-    for (int i=0,isz=Lines.size();i<isz;i++) {
-        Base::push_back(Lines[i]);
-    }
+    SplitText(text,&cr);
 }
 
 void CodeEditor::SetFonts(const ImFont *normal, const ImFont *bold, const ImFont *italic, const ImFont *boldItalic)  {
@@ -1858,6 +1996,8 @@ void CodeEditor::setText(const char *text, Language _lang) {
     if (lang!=_lang)    {
         shTypeKeywordMap.clear();
         shTypePunctuationMap.clear();
+        memset(shKeywordFirstChars,0,sizeof(shKeywordFirstChars));shKeywordLengths=0;
+        memset(shPunctuationTable,-1,sizeof(shPunctuationTable));
 
         FoldingStringVector* fsv = GetGlobalFoldingStringVectorForLanguage(_lang);
         if (fsv)    {
@@ -1866,6 +2006,10 @@ void CodeEditor::setText(const char *text, Language _lang) {
                 const ImVectorEx<const char*>& v = fsv->keywords[i];
                 for (int j=0,jsz=v.size();j<jsz;j++) {
                     shTypeKeywordMap.put((MyKeywordMapType::KeyType)v[j],i);
+                    const unsigned char c = (unsigned char) v[j][0];
+                    const int len = strlen(v[j]);
+                    shKeywordFirstChars[c>>5]|=(1U<<(c&31));
+                    shKeywordLengths|=(1U<<(len<31?len:31));
                     //fprintf(stderr,"Putting in shTypeMap: \"%s\",%d\n",v[j],i);
                 }
             }
@@ -1873,12 +2017,14 @@ void CodeEditor::setText(const char *text, Language _lang) {
             for (int i=0,isz = strlen(fsv->punctuationStringsMerged);i<isz;i++)  {
                 const char c = fsv->punctuationStringsMerged[i];
                 shTypePunctuationMap.put(c,fsv->punctuationStringsMergedSHMap[i]);
+                shPunctuationTable[(unsigned char)c] = (signed char) fsv->punctuationStringsMergedSHMap[i];
                 //fprintf(stderr,"Putting in shTypePunctuationMap: '%c',%d\n",c,fsv->punctuationStringsMergedSHMap[i]);
             }
         }
     }
     lang = _lang;
     lines.setText(text);
+    updateSyntaxHighlightingStates(0);
     if (enableTextFolding) {
         ParseTextForFolding(false,true);
     }
@@ -1918,7 +2064,7 @@ void CodeEditor::ParseTextForFolding(bool forceAllSegmentsFoldedOrNot, bool fold
     for (int i=0;i<numLines; i++) {
         line = lines[i];
         if (!line) continue;
-        const ImString& text = line->text;
+        const LineText& text = line->text;
         if (text.size() == 0)   continue;
         foldingStrings.resetTemporaryLineData();
 
@@ -1961,7 +2107,7 @@ void CodeEditor::ParseTextForFolding(bool forceAllSegmentsFoldedOrNot, bool fold
                     if (fs.gainOneLineWhenPossible && i > 1 && TrimSpacesAndTabs(text.substr(0, fs.matchStartBeg)).length() == 0) {
                         Line* prevline = lines[i - 1];
                         if (prevline) {
-                            ImString prevText = prevline->text;
+                            ImString prevText = prevline->text.c_str();
                             if (TrimSpacesAndTabs(prevText).length() != 0) {
                                 gainOneLine = true;
                                 //fs.foldingPoints.push_back(FoldingString::FoldingPoint (i - 1, prevText.length(), prevline->offset + prevText.length(), true, fs.openCnt));
@@ -2118,6 +2264,22 @@ static bool gCurlineStartedWithDiesis;
 static Line* gCurline;
 static bool gIsCurlineHovered;
 static bool gIsCursorChanged;
+static ImVector<Line::SHSpan>* gCurlineSHSpans = NULL;  // when not NULL, AddTextLineWithSH(...) records the spans it draws here
+
+// Draws [text,text_end) with the SyntaxHighlightingType sht (or as plain text if sht<0) and records it in gCurlineSHSpans
+static void AddTextLineWithSH(ImDrawList* drawList,ImVec2& pos,int sht,const char* text,const char* text_end)  {
+    ImGuiContext& g = *GImGui;
+    if (sht>=0 && sht<SH_COUNT) ImGui::ImDrawListAddTextLine(drawList,CodeEditor::ImFonts[CodeEditor::style.font_syntax_highlighting[sht]], g.FontSize, pos, CodeEditor::style.color_syntax_highlighting[sht], text, text_end);
+    else {sht=-1;ImGui::ImDrawListAddTextLine(drawList,g.Font, g.FontSize, pos, ImGui::GetColorU32(ImGuiCol_Text), text, text_end);}
+    if (g.LogEnabled) ImGui::LogRenderedText(&pos, text, text_end);
+    if (gCurlineSHSpans && text_end>text) {
+        // Spans are contiguous: we just need to store where they end (adjacent spans of the same type are merged)
+        ImVector<Line::SHSpan>& spans = *gCurlineSHSpans;
+        const int end = (spans.size()>0 ? spans[spans.size()-1].end : 0) + (int)(text_end-text);
+        if (spans.size()>0 && spans[spans.size()-1].sht==sht) spans[spans.size()-1].end = end;
+        else {Line::SHSpan span;span.end=end;span.sht=sht;spans.push_back(span);}
+    }
+}
 
 // Main method
 void CodeEditor::render()   {
@@ -2303,6 +2465,17 @@ void CodeEditor::render()   {
     int lineStart,lineEnd;
     ImGui::CalcListClipping(lines.size(),lineHeight, &lineStart, &lineEnd);
     // Ensure that lineStart is not hidden
+    if (lineStart<lines.size()-1 && lineStart>0 && lines[lineStart]->isHidden())  {
+        // Jump past the outermost folded region that contains lineStart: the folding links form a nesting tree, so this is O(depth) instead of O(hidden lines)
+        const Line* folded = NULL;
+        for (const Line* ln = lines[lineStart]->foldingStartLine;ln;ln = ln->foldingStartLine)   {
+            if (ln->isFolded() && ln->foldingEndLine && ln->foldingEndLine->lineNumber>=lineStart) folded = ln;
+        }
+        if (folded) {
+            if (io.MouseWheel>=0) lineStart = folded->lineNumber;
+            else {const int delta = folded->foldingEndLine->lineNumber-lineStart;lineStart+=delta;lineEnd+=delta;}
+        }
+    }
     while (lineStart<lines.size()-1 && lineStart>0 && (lines[lineStart]->isHidden() || (lines[lineStart]->canFoldingBeMergedWithLineAbove() && lines[lineStart]->isFolded()))) {
         if (io.MouseWheel>=0) {--lineStart;/*--lineEnd;*/}
         else {++lineStart;++lineEnd;}
@@ -2374,7 +2547,7 @@ void CodeEditor::render()   {
 
                     // draw sh text before the folding point
                     if (line->foldingStartOffset>0) {
-                        this->TextLineWithSH("%.*s",line->foldingStartOffset-startOffset,&line->text[startOffset]);
+                        this->TextLineWithSHCached(line,startOffset,line->foldingStartOffset);
                         ImGui::SameLine(0,0);
                     }
 
@@ -2431,7 +2604,7 @@ void CodeEditor::render()   {
 
                     // draw sh text before the folding point (that is not folded now)
                     if (line->foldingStartOffset>0) {
-                        this->TextLineWithSH("%.*s",line->foldingStartOffset-startOffset,&line->text[startOffset]);
+                        this->TextLineWithSHCached(line,startOffset,line->foldingStartOffset);
                         ImGui::SameLine(0,0);
                     }
 
@@ -2443,12 +2616,12 @@ void CodeEditor::render()   {
                     ImGui::PopStyleColor();
                     ImGui::PopFont();
                 }
-                else this->TextLineWithSH("%s",&line->text[startOffset]);
+                else this->TextLineWithSHCached(line,startOffset);
             }
             else if (line->isFoldingEnd())  {
                 if (line->foldingStartLine->isFolded()) {
                     // End line of a folded region. Here we must just display what's left after the foldngEndOffset.
-                    this->TextLineWithSH("%s",&line->text[line->foldingEndOffset+line->foldingStartLine->foldingStartTag->end.size()]);
+                    this->TextLineWithSHCached(line,line->foldingEndOffset+line->foldingStartLine->foldingStartTag->end.size());
                     //fprintf(stderr,"Line[%d] is a folded folding end\n",line->lineNumber);
                 }
                 else if (line->foldingStartLine->foldingStartTag->kind==FOLDING_TYPE_COMMENT) {
@@ -2464,9 +2637,9 @@ void CodeEditor::render()   {
 
                     // draw the end of the line parsed
                     ImGui::SameLine(0,0);
-                    this->TextLineWithSH("%s",&line->text[line->foldingEndOffset+line->foldingStartLine->foldingStartTag->end.size()]);
+                    this->TextLineWithSHCached(line,line->foldingEndOffset+line->foldingStartLine->foldingStartTag->end.size());
                 }
-                else this->TextLineWithSH("%s",line->text.c_str());
+                else this->TextLineWithSHCached(line,0);
             }
             else if (line->foldingStartLine && line->foldingStartLine->foldingStartTag->kind==FOLDING_TYPE_COMMENT) {
                 // Internal lines of an unfolded comment region
@@ -2477,7 +2650,7 @@ void CodeEditor::render()   {
                 ImGui::PopStyleColor();
                 ImGui::PopFont();
             }
-            else this->TextLineWithSH("%s",line->text.c_str());
+            else this->TextLineWithSHCached(line,0);
 
             const bool nextLineMergeble = (i+1<lines.size() && lines[i+1]->canFoldingBeMergedWithLineAbove() && lines[i+1]->isFolded());
             if (nextLineMergeble) {
@@ -2703,7 +2876,7 @@ void CodeEditor::render()   {
 }
 
 
-void CodeEditor::TextLineUnformattedWithSH(const char* text, const char* text_end)  {
+void CodeEditor::TextLineUnformattedWithSH(const char* text, const char* text_end, int shStateIn)  {
     ImGuiWindow* window = ImGui::GetCurrentWindow();
     if (window->SkipItems) return;
 
@@ -2737,13 +2910,13 @@ void CodeEditor::TextLineUnformattedWithSH(const char* text, const char* text_en
             gIsCurlineHovered = ImGui::IsItemHovered();
 
             // Render (we don't hide text after ## in this end-user function)
-            RenderTextLineWrappedWithSH(bb.Min, text_begin, text_end);
+            RenderTextSegmentWithSH(bb.Min, text_begin, text_end, shStateIn);
         }
         else {
             const ImVec2 old_text_pos = text_pos;
 
             gIsCurlineHovered = false;
-            RenderTextLineWrappedWithSH(text_pos, text_begin, text_end);
+            RenderTextSegmentWithSH(text_pos, text_begin, text_end, shStateIn);
 
             const ImVec2 text_size(text_pos.x-old_text_pos.x,ImGui::GetTextLineHeight());
             ImRect bb(old_text_pos, old_text_pos + text_size);
@@ -2806,10 +2979,7 @@ void CodeEditor::RenderTextLineWrappedWithSH(ImVec2& pos, const char* text, cons
     const FoldingStringVector* fsv = GetGlobalFoldingStringVectorForLanguage(this->lang);
     if (!fsv || lang==LANG_NONE)	{
         const int text_len = (int)(text_end - text);
-        if (text_len > 0)   {
-            ImGui::ImDrawListAddTextLine(window->DrawList,g.Font, g.FontSize, pos, ImGui::GetColorU32(ImGuiCol_Text), text, text_end);
-            if (g.LogEnabled) ImGui::LogRenderedText(&pos, text, text_end);
-        }
+        if (text_len > 0)   AddTextLineWithSH(window->DrawList,pos,-1,text,text_end);
         return;
     }
 
@@ -2824,10 +2994,7 @@ void CodeEditor::RenderTextLineWrappedWithSH(ImVec2& pos, const char* text, cons
                 if (tk!=text) RenderTextLineWrappedWithSH(pos,text,tk,true);    // Draw until "//"
                 text = tk;
                 const int text_len = (int)(text_end - text);
-                if (text_len > 0)   {
-                    ImGui::ImDrawListAddTextLine(window->DrawList,const_cast<ImFont*>(ImFonts[style.font_syntax_highlighting[SH_COMMENT]]), g.FontSize, pos, style.color_syntax_highlighting[SH_COMMENT], text, text_end);
-                    if (g.LogEnabled) ImGui::LogRenderedText(&pos, text, text_end);
-                }
+                if (text_len > 0)   AddTextLineWithSH(window->DrawList,pos,SH_COMMENT,text,text_end);
                 return;
             }
             else if (tki==1) {	// Found "/*"
@@ -2838,10 +3005,7 @@ void CodeEditor::RenderTextLineWrappedWithSH(ImVec2& pos, const char* text, cons
                 if (tk2) endCmt = tk2+strlen(startComments[2]);
                 text = tk;
                 const int text_len = (int)(endCmt - text);
-                if (text_len > 0)   {
-                    ImGui::ImDrawListAddTextLine(window->DrawList,const_cast<ImFont*>(ImFonts[style.font_syntax_highlighting[SH_COMMENT]]), g.FontSize, pos, style.color_syntax_highlighting[SH_COMMENT], text, endCmt);
-                    if (g.LogEnabled) ImGui::LogRenderedText(&pos, text, endCmt);
-                }
+                if (text_len > 0)   AddTextLineWithSH(window->DrawList,pos,SH_COMMENT,text,endCmt);
                 if (tk2 && endCmt<text_end) RenderTextLineWrappedWithSH(pos,endCmt,text_end);    // Draw after "*/"
                 return;
             }
@@ -2861,8 +3025,7 @@ void CodeEditor::RenderTextLineWrappedWithSH(ImVec2& pos, const char* text, cons
                     const char* endStringSH = tk2==NULL ? text_end : (tk2+1);
                     // Draw String:
                     const ImVec2 oldPos = pos;
-                    ImGui::ImDrawListAddTextLine(window->DrawList,const_cast<ImFont*>(ImFonts[style.font_syntax_highlighting[SH_STRING]]), g.FontSize, pos, style.color_syntax_highlighting[SH_STRING], tk, endStringSH);
-                    if (g.LogEnabled) ImGui::LogRenderedText(&pos, tk, endStringSH);
+                    AddTextLineWithSH(window->DrawList,pos,SH_STRING,tk,endStringSH);
                     const float token_width = pos.x - oldPos.x;  //MyCalcTextWidth(tk,endStringSH);
                     // TEST: Mouse interaction on token (gIsCurlineHovered == true when CTRL is pressed)-------------------
                     if (gIsCurlineHovered) {
@@ -2887,6 +3050,7 @@ void CodeEditor::RenderTextLineWrappedWithSH(ImVec2& pos, const char* text, cons
                     }
                     return;
                 }
+                else AddTextLineWithSH(window->DrawList,pos,SH_STRING,tk,text_end);  // unterminated string delimiter at the end of the line
             }
             return;
         }
@@ -2903,16 +3067,14 @@ void CodeEditor::RenderTextLineWrappedWithSH(ImVec2& pos, const char* text, cons
     // skip tabs and spaces
     while (*s==sp || *s==tab)	{
     if (s+1==text_end)  {
-        ImGui::ImDrawListAddTextLine(window->DrawList,g.Font, g.FontSize, pos, ImGui::GetColorU32(ImGuiCol_Text), text, text_end);
-        if (g.LogEnabled) ImGui::LogRenderedText(&pos, text, text_end);
+        AddTextLineWithSH(window->DrawList,pos,-1,text,text_end);
         return;
     }
     ++s;
     }
     if (s>text)	{
         // Draw Tabs and spaces
-        ImGui::ImDrawListAddTextLine(window->DrawList,g.Font, g.FontSize, pos, ImGui::GetColorU32(ImGuiCol_Text), text, s);
-        if (g.LogEnabled) ImGui::LogRenderedText(&pos, text, s);
+        AddTextLineWithSH(window->DrawList,pos,-1,text,s);
         text=s;
     }
 
@@ -2949,10 +3111,8 @@ void CodeEditor::RenderTextLineWrappedWithSH(ImVec2& pos, const char* text, cons
                 const char* ch = s+j;
                 int sht = -1;
                 if (tokenIsNumber && *ch=='.') {sht = SH_NUMBER;++tokenIsNumber;}
-                if (sht==-1 && !shTypePunctuationMap.get(*ch,sht)) sht = -1;
-                if (sht>=0 && sht<SH_COUNT) ImGui::ImDrawListAddTextLine(window->DrawList,const_cast<ImFont*>(ImFonts[style.font_syntax_highlighting[sht]]), g.FontSize, pos, style.color_syntax_highlighting[sht], s+j, s+j+1);
-                else ImGui::ImDrawListAddTextLine(window->DrawList,g.Font, g.FontSize, pos, ImGui::GetColorU32(ImGuiCol_Text), s+j, s+j+1);
-                if (g.LogEnabled) ImGui::LogRenderedText(&pos, s+j, s+j+1);
+                if (sht==-1) sht = shPunctuationTable[(unsigned char)*ch];
+                AddTextLineWithSH(window->DrawList,pos,sht,s+j,s+j+1);
             }
         }
         s+=offset;
@@ -2977,15 +3137,8 @@ void CodeEditor::RenderTextLineWrappedWithSH(ImVec2& pos, const char* text, cons
                 if (tokenIsNumber) sht = SH_NUMBER;
             }
             const ImVec2 oldPos = pos;
-            if (sht>=0 || shTypeKeywordMap.get(tok,sht)) {
-                //fprintf(stderr,"Getting shTypeMap: \"%s\",%d\n",tok,sht);
-                ImGui::ImDrawListAddTextLine(window->DrawList,const_cast<ImFont*>(ImFonts[style.font_syntax_highlighting[sht]]), g.FontSize, pos, style.color_syntax_highlighting[sht], tok, tok+len_tok);
-            }
-            else {
-                //fprintf(stderr,"Not Getting shTypeMap: \"%s\",%d\n",tok,sht);
-                ImGui::ImDrawListAddTextLine(window->DrawList,g.Font, g.FontSize, pos, ImGui::GetColorU32(ImGuiCol_Text), tok, tok+len_tok);
-            }
-            if (g.LogEnabled) ImGui::LogRenderedText(&pos, tok, tok+len_tok);
+            if (sht<0 && !getKeywordSH(tok,len_tok,sht)) sht = -1;
+            AddTextLineWithSH(window->DrawList,pos,sht,tok,tok+len_tok);
             const float token_width = pos.x - oldPos.x;//MyCalcTextWidth(tok,tok+len_tok);   // We'll use this later
             // TEST: Mouse interaction on token (gIsCurlineHovered == true when CTRL is pressed)-------------------
             if (gIsCurlineHovered) {
@@ -3017,13 +3170,129 @@ void CodeEditor::RenderTextLineWrappedWithSH(ImVec2& pos, const char* text, cons
             const char* ch = s+j;
             int sht = -1;
             if (tokenIsNumber && *ch=='.') {sht = SH_NUMBER;++tokenIsNumber;}
-            if (sht==-1 && !shTypePunctuationMap.get(*ch,sht)) sht = -1;
-            if (sht>=0 && sht<SH_COUNT) ImGui::ImDrawListAddTextLine(window->DrawList,const_cast<ImFont*>(ImFonts[style.font_syntax_highlighting[sht]]), g.FontSize, pos, style.color_syntax_highlighting[sht], s+j, s+j+1);
-            else ImGui::ImDrawListAddTextLine(window->DrawList,g.Font, g.FontSize, pos, ImGui::GetColorU32(ImGuiCol_Text), s+j, s+j+1);
-            if (g.LogEnabled) ImGui::LogRenderedText(&pos, s+j, s+j+1);
+            if (sht==-1) sht = shPunctuationTable[(unsigned char)*ch];
+            AddTextLineWithSH(window->DrawList,pos,sht,s+j,s+j+1);
+        }
+    }
+
+}
+
+// Returns the closing string delimiter (or NULL): delimiters preceded by the escape char are skipped (like in RenderTextLineWrappedWithSH(...))
+inline static const char* FindStringEnd(const char* text,const char* text_end,char delimiter,char escapeChar)    {
+    for (const char* p = text;p<text_end;p++)   {
+        if (*p==delimiter && (p==text || *(p-1)!=escapeChar)) return p;
+    }
+    return NULL;
+}
+// Returns the lexer state at the end of [text,text_end), using the same rules of RenderTextLineWrappedWithSH(...)
+static unsigned char ScanLineSHState(const FoldingStringVector* fsv,const char* text,const char* text_end,unsigned char state)   {
+    if (!fsv) return Line::SH_STATE_NONE;
+    const char* startComments[3] = {fsv->singleLineComment,fsv->multiLineCommentStart,fsv->multiLineCommentEnd};
+    const char* endComments[3] = {fsv->singleLineComment+strlen(fsv->singleLineComment),fsv->multiLineCommentStart+strlen(fsv->multiLineCommentStart),fsv->multiLineCommentEnd+strlen(fsv->multiLineCommentEnd)};
+    const int numStringDelimiters = fsv->stringDelimiterChars ? strlen(fsv->stringDelimiterChars) : 0;
+    if (state==Line::SH_STATE_UNKNOWN || (text==text_end && state!=Line::SH_STATE_MULTILINE_COMMENT)) state = Line::SH_STATE_NONE;
+    while (text<text_end)   {
+        if (state==Line::SH_STATE_MULTILINE_COMMENT)   {
+            const char* tk = FindNextToken<1>(text,text_end,&startComments[2],&endComments[2]);	// Look for "*/"
+            if (!tk) return state;
+            text = tk + (endComments[2]-startComments[2]);
+            state = Line::SH_STATE_NONE;
+        }
+        else if (state>=Line::SH_STATE_STRING && state<Line::SH_STATE_STRING+numStringDelimiters)  {
+            const char* tk = FindStringEnd(text,text_end,fsv->stringDelimiterChars[state-Line::SH_STATE_STRING],fsv->stringEscapeChar);
+            if (!tk) return (*(text_end-1)==fsv->stringEscapeChar) ? state : (unsigned char) Line::SH_STATE_NONE;   // The string continues on the next line only if the line ends with the escape char
+            text = tk+1;
+            state = Line::SH_STATE_NONE;
         }
+        else {
+            int tki=-1;
+            const char* tk = FindNextToken<2>(text,text_end,startComments,endComments,&tki,fsv->stringDelimiterChars,fsv->stringEscapeChar,false);
+            if (!tk || tki==0) return Line::SH_STATE_NONE;  // No token or "//"
+            if (tki==1) {text = tk + (endComments[1]-startComments[1]);state = Line::SH_STATE_MULTILINE_COMMENT;}
+            else {text = tk+1;state = (unsigned char) (Line::SH_STATE_STRING + tki-2);}
+        }
+    }
+    return state;
+}
+void CodeEditor::updateSyntaxHighlightingStates(int startLineNum)    {
+    if (startLineNum<0) startLineNum=0;
+    if (startLineNum>=lines.size()) return;
+    const FoldingStringVector* fsv = (lang==LANG_NONE) ? NULL : GetGlobalFoldingStringVectorForLanguage(lang);
+    unsigned char state = startLineNum>0 ? lines[startLineNum-1]->shStateOut : (unsigned char) Line::SH_STATE_NONE;
+    if (state==Line::SH_STATE_UNKNOWN) state = Line::SH_STATE_NONE;
+    lines[startLineNum]->invalidateSHSpans();   // Its text has changed
+    for (int i=startLineNum,isz=lines.size();i<isz;i++) {
+        Line* line = lines[i];
+        // Stop when the state converges: the following lines can't be affected
+        if (i>startLineNum && line->shStateIn==state) break;
+        if (line->shStateIn!=state) {line->shStateIn=state;line->invalidateSHSpans();}
+        state = line->shStateOut = ScanLineSHState(fsv,line->text.c_str(),line->text.c_str()+line->text.size(),state);
+    }
+}
+void CodeEditor::RenderTextSegmentWithSH(ImVec2& pos, const char* text, const char* text_end, int shStateIn)  {
+    // Handles the start of a segment that continues a multiline comment or string of the line above
+    const FoldingStringVector* fsv = (lang==LANG_NONE || shStateIn==Line::SH_STATE_NONE || shStateIn==Line::SH_STATE_UNKNOWN) ? NULL : GetGlobalFoldingStringVectorForLanguage(lang);
+    if (fsv && text<text_end) {
+        ImGuiWindow* window = ImGui::GetCurrentWindow();
+        const char* tk = NULL;int sht = SH_COMMENT;
+        if (shStateIn==Line::SH_STATE_MULTILINE_COMMENT) {
+            const char* startComments[1] = {fsv->multiLineCommentEnd};
+            const char* endComments[1] = {fsv->multiLineCommentEnd+strlen(fsv->multiLineCommentEnd)};
+            tk = FindNextToken<1>(text,text_end,startComments,endComments);   // Look for "*/"
+            if (tk) tk+=endComments[0]-startComments[0];
+        }
+        else if (fsv->stringDelimiterChars && shStateIn-Line::SH_STATE_STRING<(int)strlen(fsv->stringDelimiterChars)) {
+            sht = SH_STRING;
+            tk = FindStringEnd(text,text_end,fsv->stringDelimiterChars[shStateIn-Line::SH_STATE_STRING],fsv->stringEscapeChar);
+            if (tk) ++tk;
+        }
+        else tk = text;
+        if (!tk) tk = text_end;
+        if (tk>text) AddTextLineWithSH(window->DrawList,pos,sht,text,tk);
+        text = tk;
+    }
+    if (text<text_end) RenderTextLineWrappedWithSH(pos,text,text_end);
+}
+void CodeEditor::TextLineWithSHCached(Line* line,int startOffset,int endOffset)  {
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    if (window->SkipItems) return;
+    if (endOffset<0 || endOffset>(int)line->text.size()) endOffset = line->text.size();
+    if (startOffset>endOffset) startOffset = endOffset;
+    const char* text = line->text.c_str() + startOffset;
+    const char* text_end = line->text.c_str() + endOffset;
+    const unsigned char shStateIn = startOffset==0 ? line->shStateIn : (unsigned char) Line::SH_STATE_NONE;
+
+    // When CTRL is down RenderTextLineWrappedWithSH(...) must process the tokens for mouse interaction: we don't use the cache
+    if (ImGui::GetIO().KeyCtrl) {TextLineUnformattedWithSH(text,text_end,shStateIn);return;}
+
+    ImVec2 text_pos = window->DC.CursorPos;
+    text_pos.y += window->DC.CurrentLineTextBaseOffset;
+    const ImVec2 old_text_pos = text_pos;
+    gIsCurlineHovered = false;
+
+    if (line->shSpansStart==startOffset && line->shSpansEnd==endOffset && line->shSpansState==shStateIn)   {
+        // Draw the cached spans
+        const char* b = text;
+        for (int i=0,isz=line->shSpans.size();i<isz;i++)    {
+            const Line::SHSpan& span = line->shSpans[i];
+            AddTextLineWithSH(window->DrawList,text_pos,span.sht,b,text+span.end);
+            b = text+span.end;
+        }
+    }
+    else {
+        // Tokenize the segment and record its spans
+        line->invalidateSHSpans();
+        gCurlineSHSpans = &line->shSpans;
+        RenderTextSegmentWithSH(text_pos, text, text_end, shStateIn);
+        gCurlineSHSpans = NULL;
+        line->shSpansStart = startOffset;line->shSpansEnd = endOffset;line->shSpansState = shStateIn;
     }
 
+    const ImVec2 text_size(text_pos.x-old_text_pos.x,ImGui::GetTextLineHeight());
+    ImRect bb(old_text_pos, old_text_pos + text_size);
+    ImGui::ItemSize(text_size);
+    if (!ImGui::ItemAdd(bb, 0))  return;
+    gIsCurlineHovered = ImGui::IsItemHovered();
 }
 
 template <int NUM_TOKENS> inline static const char* FindPrevToken(const char* text,const char* text_end,const char* token_start[NUM_TOKENS],const char* token_end[NUM_TOKENS],int* pTokenIndexOut=NULL,const char* optionalStringDelimiters=NULL,const char stringEscapeChar='\\',bool skipEscapeChar=false,bool findNewLineCharToo=false) {
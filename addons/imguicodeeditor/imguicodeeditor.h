@@ -178,7 +178,7 @@ class Lines : public ImVector<Line*> {
 protected:
     typedef ImVector<Line*> Base;
 public:
-    Lines(const ImString& text="") {cr="\n";clear();setText(text);}
+    Lines(const ImString& text="") : linePool(NULL),linePoolSize(0) {cr="\n";clear();setText(text);}
     ~Lines() {destroy();}
     void clear() {destroy(true);}
     IMGUI_API Line* add(int lineNum=-1);
@@ -194,8 +194,14 @@ public:
 protected:
     IMGUI_API void destroy(bool keepFirstLine=false);
     void push_back(const Line*) {}
-    IMGUI_API static void SplitText(const char* text, ImVector<Line *> &lines, ImString *pOptionalCRout=NULL);
+    IMGUI_API void SplitText(const char* text, ImString *pOptionalCRout=NULL);
+    IMGUI_API void freeLine(Line* line);
     ImString cr;  // "\n" or "\r\n"
+    // Storage used by setText(...): the chars of all the lines are copied into a single buffer ('\0' separated),
+    // and all the Line objects are allocated in a single block (lines added later are allocated one by one).
+    ImVector<char> textBuffer;
+    Line* linePool;
+    int linePoolSize;
     friend class CodeEditor;
     friend class FoldSegment;
     friend class FoldingString;
@@ -221,7 +227,10 @@ public:
     CodeEditor() : inited(false),showIconMargin(true),
     showLineNumbers(true),enableTextFolding(true),scrollToLine(-1),
     show_left_pane(false),show_style_editor(true),show_load_save_buttons(true),/*colorEditMode(ImGuiColorEditMode_RGB),*/
-    lang(LANG_NONE) {}
+    lang(LANG_NONE) {
+        memset(shKeywordFirstChars,0,sizeof(shKeywordFirstChars));shKeywordLengths=0;
+        memset(shPunctuationTable,-1,sizeof(shPunctuationTable));
+    }
     IMGUI_API void render();
     IMGUI_API static void SetFonts(const ImFont* normal,const ImFont* bold=NULL,const ImFont* italic=NULL,const ImFont* boldItalic=NULL);
 
@@ -316,10 +325,22 @@ public:
     Language lang;
     MyKeywordMapType shTypeKeywordMap;
     ImHashMapChar    shTypePunctuationMap;
+    // Fast lookup tables built together with the maps above (so that most tokens can be rejected without hashing them)
+    unsigned int shKeywordFirstChars[256/32];   // bit set of the first chars of the keywords
+    unsigned int shKeywordLengths;              // bit set of the lengths of the keywords (lengths >= 31 share the last bit)
+    signed char  shPunctuationTable[256];       // SyntaxHighlightingType of each punctuation char, or -1
+    inline bool getKeywordSH(char* tok,int len_tok,int& sht) const {
+        const unsigned char c = (unsigned char) tok[0];
+        if (!(shKeywordFirstChars[c>>5]&(1U<<(c&31))) || !(shKeywordLengths&(1U<<(len_tok<31?len_tok:31)))) return false;
+        return shTypeKeywordMap.get(tok,sht);
+    }
+    IMGUI_API void updateSyntaxHighlightingStates(int startLineNum=0);    // must be called after the text of lines[startLineNum] has changed
 private:
     static bool StaticInited;
     IMGUI_API void RenderTextLineWrappedWithSH(ImVec2 &pos, const char *text, const char *text_end, bool skipLineCommentProcessing=false);
-    IMGUI_API void TextLineUnformattedWithSH(const char *text, const char *text_end);
+    IMGUI_API void RenderTextSegmentWithSH(ImVec2 &pos, const char *text, const char *text_end, int shStateIn);
+    IMGUI_API void TextLineUnformattedWithSH(const char *text, const char *text_end, int shStateIn=0);
+    IMGUI_API void TextLineWithSHCached(Line* line,int startOffset,int endOffset=-1);
     IMGUI_API void TextLineWithSHV(const char *fmt, va_list args);
     IMGUI_API void TextLineWithSH(const char *fmt...);
 
@@ -54,6 +54,11 @@
 #define IMGUIFS_CDECL
 #endif
 
+// The Dialog and UnZipFile use the threading layer of imguihelper when it's available
+#if (defined(IMGUIHELPER_H_) && defined(IMGUIHELPER_HAS_THREADS))
+#   define IMGUIFS_HAS_THREADS
+#endif
+
 #ifdef IMGUIFS_NO_EXTRA_METHODS
 // We copy the code for FILENAME_MAX and PATH_MAX
 #   include <stdint.h>             // this is included by imgui.cpp, and the following headers might redefine incorrectly some types otherwise.
@@ -489,152 +494,196 @@ protected:
     File() {}
 };
 */
+// A directory listing that stores all its strings in a single buffer (PathStringVector items are MAX_PATH_BYTES long each).
+// stat(...) is called at most once per entry when scanning, and the sorters just compare the cached values.
+struct DirectoryEntry {
+    int pathOffset,nameOffset;  // in DirectoryListing::chars
+    time_t mtime;
+    off_t size;
+    int extensionType;          // FileExtensionType, -1 for none, -2 if not calculated yet (used only by the Dialog)
+};
+struct DirectoryListing {
+    ImVector<char> chars;
+    ImVector<DirectoryEntry> entries;
+    bool hasStatData;           // mtime and size are valid
+    DirectoryListing() : hasStatData(false) {}
+    inline int size() const {return entries.size();}
+    inline const char* getPath(int i) const {return &chars[entries[i].pathOffset];}
+    inline const char* getName(int i) const {return &chars[entries[i].nameOffset];}
+    void clear() {chars.clear();entries.clear();}
+    void freeMemory() {ImVector<char> c;chars.swap(c);ImVector<DirectoryEntry> e;entries.swap(e);}
+    void swap(DirectoryListing& o) {chars.swap(o.chars);entries.swap(o.entries);const bool tmp=hasStatData;hasStatData=o.hasStatData;o.hasStatData=tmp;}
+    // "directory" must not end with a slash. The stored path is "directory/name".
+    void add(const char* directory,const char* name,time_t mtime=0,off_t size=0)    {
+        const int dirLen = (int)strlen(directory),nameLen = (int)strlen(name);
+        const int start = chars.size();
+        chars.resize(start+dirLen+1+nameLen+1);
+        char* p = &chars[start];
+        memcpy(p,directory,dirLen);p[dirLen]='/';
+        memcpy(&p[dirLen+1],name,nameLen+1);
+        addEntry(start,start+dirLen+1,mtime,size);
+    }
+    void addPathAndName(const char* path,const char* name,time_t mtime=0,off_t size=0)    {
+        const int pathLen = (int)strlen(path),nameLen = (int)strlen(name);
+        const int start = chars.size();
+        chars.resize(start+pathLen+1+nameLen+1);
+        memcpy(&chars[start],path,pathLen+1);
+        memcpy(&chars[start+pathLen+1],name,nameLen+1);
+        addEntry(start,start+pathLen+1,mtime,size);
+    }
+    void append(const DirectoryListing& o,int startEntry=0)  {
+        for (int i=startEntry,isz=o.size();i<isz;i++) {
+            const DirectoryEntry& oe = o.entries[i];
+            const char* path = o.getPath(i);
+            const int pathSize = (int)strlen(path)+1;
+            const int nameDelta = oe.nameOffset-oe.pathOffset;
+            if (nameDelta>0 && nameDelta<pathSize) {    // the name is the tail of the path (see add(...))
+                const int start = chars.size();
+                chars.resize(start+pathSize);
+                memcpy(&chars[start],path,pathSize);
+                addEntry(start,start+nameDelta,oe.mtime,oe.size);
+            }
+            else addPathAndName(path,o.getName(i),oe.mtime,oe.size);
+            entries[entries.size()-1].extensionType = oe.extensionType;
+        }
+    }
+    void copyTo(PathStringVector& pathsOut,FilenameStringVector* pOptionalNamesOut) const {
+        pathsOut.clear();pathsOut.reserve(size());
+        if (pOptionalNamesOut) {pOptionalNamesOut->clear();pOptionalNamesOut->reserve(size());}
+        for (int i=0,isz=size();i<isz;i++) {
+            String::PushBack(pathsOut,getPath(i));
+            if (pOptionalNamesOut) String::PushBack(*pOptionalNamesOut,getName(i));
+        }
+    }
+    void sort(Sorting sorting);
+protected:
+    void addEntry(int pathOffset,int nameOffset,time_t mtime,off_t size) {
+        entries.resize(entries.size()+1);
+        DirectoryEntry& e = entries[entries.size()-1];
+        e.pathOffset = pathOffset;e.nameOffset = nameOffset;
+        e.mtime = mtime;e.size = size;e.extensionType = -2;
+    }
+};
+inline static bool SortingNeedsStatData(int sorting) {return sorting>=(int)SORT_ORDER_LAST_MODIFICATION && sorting<=(int)SORT_ORDER_SIZE_INVERSE;}
 class SortingHelper {
 public:
-    typedef int (*SorterSignature)(const struct dirent **e1,const struct dirent **e2);
-    inline static const SorterSignature& SetSorter(Sorting sorting) {
-        const int isort =(int) sorting;
-        if (isort>=0 && isort<(int)SORT_ORDER_COUNT) return (sorter = Sorters[isort]);
-        return (sorter = Sorters[0]);
-    }
+    struct Item {const char* name;const char* ext;time_t mtime;off_t size;int index;};
+    typedef int (IMGUIFS_CDECL *SorterSignature)(const void* i1,const void* i2);
+    const static SorterSignature Sorters[];  // one per Sorting/2: inverse sortings just reverse the result
 protected:
     SortingHelper() {}
-    const static SorterSignature Sorters[];
-    static struct stat stat1;
-    static struct stat stat2;
-    static SorterSignature sorter;
     // Possible problem: sorting is in ASCII with these methods
-    static int IMGUIFS_CDECL Alphasort(const struct dirent **e1,const struct dirent **e2)    {
-        return strcasecmp((*e1)->d_name,(*e2)->d_name);
-    }
-    static int IMGUIFS_CDECL Alphasortinverse (const struct dirent **e1,const struct dirent **e2)    {
-        return -strcasecmp((*e1)->d_name,(*e2)->d_name);
-    }
-    // Please note that calling stat(...) every time inside sorters is a suicide! And that I'm doing right that! (but I guess and hope that on many systems the calls get cached somewhere: otherwise it would take ages to sort)
-    static int IMGUIFS_CDECL Lastmodsort (const struct dirent **e1,const struct dirent **e2)    {
-        if (stat((*e1)->d_name,&stat1)==-1) return -1;
-        if (stat((*e2)->d_name,&stat2)==-1) return  1;
-        return (stat1.st_mtime < stat2.st_mtime ? -1 : stat1.st_mtime > stat2.st_mtime ? 1 : 0);
-    }
-    static int IMGUIFS_CDECL Lastmodsortinverse(const struct dirent **e1,const struct dirent **e2)    {
-        if (stat((*e1)->d_name,&stat1)==-1) return  1;
-        if (stat((*e2)->d_name,&stat2)==-1) return -1;
-        return (stat2.st_mtime < stat1.st_mtime ? -1 : stat2.st_mtime > stat1.st_mtime ? 1 : 0);
-    }
-    static int IMGUIFS_CDECL Sizesort (const struct dirent **e1,const struct dirent **e2)    {
-        if (stat((*e1)->d_name,&stat1)==-1) return -1;
-        if (stat((*e2)->d_name,&stat2)==-1) return  1;
-        return (stat1.st_size < stat2.st_size ? -1 : stat1.st_size > stat2.st_size ? 1 : 0);
-    }
-    static int IMGUIFS_CDECL Sizesortinverse(const struct dirent **e1,const struct dirent **e2)    {
-        if (stat((*e1)->d_name,&stat1)==-1) return  1;
-        if (stat((*e2)->d_name,&stat2)==-1) return -1;
-        return (stat2.st_size < stat1.st_size ? -1 : stat2.st_size > stat1.st_size ? 1 : 0);
-    }
-    // Please note that calculating the file extension every time inside sorters is a suicide (well, much less than before...)!
-    static int IMGUIFS_CDECL Typesort(const struct dirent **e1,const struct dirent **e2)    {
-        static const int dot = (int) '.';
-        const char * p1 = strrchr((const char*) (*e1)->d_name, dot );
-        const char * p2 = strrchr((const char*) (*e2)->d_name, dot );
-        if (!p1) return (!p2?0:-1);
-        else if (!p2)   return 1;
-        return strcasecmp(p1,p2);
+    static int IMGUIFS_CDECL Alphasort(const void* i1,const void* i2)    {
+        return strcasecmp(((const Item*)i1)->name,((const Item*)i2)->name);
     }
-    static int IMGUIFS_CDECL Typesortinverse (const struct dirent **e1,const struct dirent **e2)    {
-        static const int dot = (int) '.';
-        const char * p1 = strrchr((const char*) (*e1)->d_name, dot );
-        const char * p2 = strrchr((const char*) (*e2)->d_name, dot );
-        if (!p1) return (!p2?0:1);
-        else if (!p2)   return -1;
-        return -strcasecmp(p1,p2);
+    static int IMGUIFS_CDECL Lastmodsort(const void* i1,const void* i2)    {
+        const Item& e1 = *((const Item*)i1);const Item& e2 = *((const Item*)i2);
+        return (e1.mtime < e2.mtime ? -1 : e1.mtime > e2.mtime ? 1 : strcasecmp(e1.name,e2.name));
+    }
+    static int IMGUIFS_CDECL Sizesort(const void* i1,const void* i2)    {
+        const Item& e1 = *((const Item*)i1);const Item& e2 = *((const Item*)i2);
+        return (e1.size < e2.size ? -1 : e1.size > e2.size ? 1 : strcasecmp(e1.name,e2.name));
+    }
+    static int IMGUIFS_CDECL Typesort(const void* i1,const void* i2)    {
+        const Item& e1 = *((const Item*)i1);const Item& e2 = *((const Item*)i2);
+        if (!e1.ext) return (!e2.ext ? strcasecmp(e1.name,e2.name) : -1);
+        else if (!e2.ext) return 1;
+        const int rv = strcasecmp(e1.ext,e2.ext);
+        return rv!=0 ? rv : strcasecmp(e1.name,e2.name);
     }
-
 };
-const SortingHelper::SorterSignature SortingHelper::Sorters[] = {&SortingHelper::Alphasort,&SortingHelper::Alphasortinverse,&SortingHelper::Lastmodsort,&SortingHelper::Lastmodsortinverse,&SortingHelper::Sizesort,&SortingHelper::Sizesortinverse,&SortingHelper::Typesort,&SortingHelper::Typesortinverse};
-SortingHelper::SorterSignature SortingHelper::sorter;
-struct stat SortingHelper::stat1;
-struct stat SortingHelper::stat2;
+const SortingHelper::SorterSignature SortingHelper::Sorters[] = {&SortingHelper::Alphasort,&SortingHelper::Lastmodsort,&SortingHelper::Sizesort,&SortingHelper::Typesort};
+void DirectoryListing::sort(Sorting sorting)   {
+    const int n = entries.size();
+    if (n<2) return;
+    int isort = (int) sorting;
+    if (isort<0 || isort>=(int)SORT_ORDER_COUNT) isort = 0;
+    ImVector<SortingHelper::Item> items;items.resize(n);
+    for (int i=0;i<n;i++) {
+        const DirectoryEntry& e = entries[i];
+        SortingHelper::Item& it = items[i];
+        it.name = &chars[e.nameOffset];
+        it.ext = strrchr(it.name,'.');
+        it.mtime = e.mtime;it.size = e.size;
+        it.index = i;
+    }
+    qsort(&items[0],n,sizeof(SortingHelper::Item),SortingHelper::Sorters[isort/2]);
+    const bool inverse = (isort%2)==1;
+    ImVector<DirectoryEntry> sorted;sorted.resize(n);
+    for (int i=0;i<n;i++) sorted[inverse ? (n-1-i) : i] = entries[items[i].index];
+    entries.swap(sorted);
+}
 class Directory {
 public:
-    static void GetDirectories(const char* directoryName,PathStringVector& result,FilenameStringVector* pOptionalNamesOut=NULL,Sorting sorting= SORT_ORDER_ALPHABETIC)   {
-        result.clear();if (pOptionalNamesOut) pOptionalNamesOut->clear();
-        static char tempString[MAX_PATH_BYTES];size_t sz;
-        struct dirent **eps = NULL;
-
-        sz = strlen(directoryName);
-        static char directoryName2[MAX_PATH_BYTES];
+    // Called by Scan(...) every few entries: returning false stops the scan
+    typedef bool (*ScanProgressCallback)(void* userPtr);
+    // Reads "directoryName" (without sorting it) appending its subdirectories to pDirsOut and its files to pFilesOut (both optional).
+    // stat(...) is called once per entry when "readStatData" is true (mtime and size are needed for sorting by date or size),
+    // or when the file system doesn't report the entry type.
+    // "lowercaseWantedExtensions" (optional) is something like ".png;.jpg": it filters the files only.
+    // Returns false if the directory can't be opened or if the callback has stopped the scan.
+    static bool Scan(const char* directoryName,DirectoryListing* pDirsOut,DirectoryListing* pFilesOut,bool readStatData,const char* lowercaseWantedExtensions=NULL,ScanProgressCallback progressCallback=NULL,void* userPtr=NULL,int progressCallbackStep=256)   {
+        char directoryName2[MAX_PATH_BYTES];
+        char directoryNameWithoutSlash[MAX_PATH_BYTES];
+        const size_t sz = strlen(directoryName);
         strcpy(directoryName2,directoryName);
 #       ifdef _WIN32
         if (sz>0 && directoryName[sz-1]==':') {directoryName2[sz]='\\';directoryName2[sz+1]='\0';}
 #       endif //_WIN32
-        const int n = scandir (directoryName2, &eps, DirentGetDirectories, SortingHelper::SetSorter(sorting));
-
-        static char directoryNameWithoutSlash[MAX_PATH_BYTES];
         if (sz>0 && directoryName[sz-1] == '/') String::Substr(directoryName,directoryNameWithoutSlash,0,sz-1);
         else strcpy(directoryNameWithoutSlash,directoryName);
+        if (pDirsOut) pDirsOut->hasStatData = readStatData;
+        if (pFilesOut) pFilesOut->hasStatData = readStatData;
+        if (lowercaseWantedExtensions && lowercaseWantedExtensions[0]=='\0') lowercaseWantedExtensions = NULL;
 
-        if (n >= 0) {
-        result.reserve((size_t)n);
-        if (pOptionalNamesOut) pOptionalNamesOut->reserve((size_t)n);
-            for (int cnt = 0; cnt < n; ++cnt)    {
-                const char* pName = &eps[cnt]->d_name[0];
-                sz = strlen(pName);
-		if (sz>0) {
-            if (strcmp(pName,".")!=0 && strcmp(pName,"..")!=0 && pName[0]!='.' && pName[sz-1]!='~'
-#               ifdef __EMSCRIPTEN__
-                && (!(
-                    strcmp(pName,"fd")==0 && strcmp(directoryNameWithoutSlash,"/proc/self")==0
-                ))
-#               endif //__EMSCRIPTEN__
-            )    {
-			strcpy(tempString,directoryNameWithoutSlash);
-			strcat(tempString,"/");
-			strcat(tempString,pName);
-			String::PushBack(result,tempString);
-			if (pOptionalNamesOut) String::PushBack(*pOptionalNamesOut,pName);
-		    }
-		}
-		free(eps[cnt]);
+        DIR* dir = opendir(directoryName2);
+        if (!dir) return false;
+        char path[MAX_PATH_BYTES];
+        struct stat statbuf;
+        int cnt = 0;bool ok = true;
+        const struct dirent* de = NULL;
+        while ((de = readdir(dir)))  {
+            if (progressCallback && (++cnt)%progressCallbackStep==0 && !progressCallback(userPtr)) {ok=false;break;}
+            const char* pName = &de->d_name[0];
+            const size_t nameSz = strlen(pName);
+            if (nameSz==0 || pName[0]=='.' || pName[nameSz-1]=='~') continue;  // this skips "." and ".." too
+            bool isDir = de->d_type==DT_DIR, isFile = de->d_type==DT_REG;
+            const bool isUnknown = de->d_type==DT_UNKNOWN;
+            if (!isDir && !isFile && !isUnknown) continue;
+            if (!isUnknown && !(isDir ? pDirsOut : pFilesOut)) continue;
+            if (isFile && lowercaseWantedExtensions && !MatchesExtension(pName,lowercaseWantedExtensions)) continue;
+#           ifdef __EMSCRIPTEN__
+            if (isDir && strcmp(pName,"fd")==0 && strcmp(directoryNameWithoutSlash,"/proc/self")==0) continue;
+#           endif //__EMSCRIPTEN__
+            time_t mtime = 0;off_t size = 0;
+            if (readStatData || isUnknown) {
+                strcpy(path,directoryNameWithoutSlash);
+                strcat(path,"/");
+                strcat(path,pName);
+                if (stat(path,&statbuf)!=-1) {
+                    mtime = statbuf.st_mtime;size = statbuf.st_size;
+                    if (isUnknown) {isDir = S_ISDIR(statbuf.st_mode);isFile = S_ISREG(statbuf.st_mode);}
+                }
+                if (isUnknown && isFile && lowercaseWantedExtensions && !MatchesExtension(pName,lowercaseWantedExtensions)) continue;
             }
+            if (isDir && pDirsOut) pDirsOut->add(directoryNameWithoutSlash,pName,mtime,size);
+            else if (isFile && pFilesOut) pFilesOut->add(directoryNameWithoutSlash,pName,mtime,size);
         }
-        if (eps) {free(eps);eps=NULL;}
+        closedir(dir);
+        if (ok && progressCallback) ok = progressCallback(userPtr);
+        return ok;
+    }
+    static void GetDirectories(const char* directoryName,PathStringVector& result,FilenameStringVector* pOptionalNamesOut=NULL,Sorting sorting= SORT_ORDER_ALPHABETIC)   {
+        DirectoryListing dirs;
+        Scan(directoryName,&dirs,NULL,SortingNeedsStatData(sorting));
+        dirs.sort(sorting);
+        dirs.copyTo(result,pOptionalNamesOut);
     }
     static void GetFiles(const char* directoryName,PathStringVector& result,FilenameStringVector* pOptionalNamesOut=NULL, Sorting sorting= SORT_ORDER_ALPHABETIC)    {
-        result.clear();if (pOptionalNamesOut) pOptionalNamesOut->clear();
-        static char tempString[MAX_PATH_BYTES];size_t sz;
-        struct dirent **eps = NULL;
-
-        sz = strlen(directoryName);
-        static char directoryName2[MAX_PATH_BYTES];
-        strcpy(directoryName2,directoryName);
-#       ifdef _WIN32
-        if (sz>0 && directoryName[sz-1]==':') {directoryName2[sz]='\\';directoryName2[sz+1]='\0';}
-#       endif //_WIN32
-        const int n = scandir (directoryName2, &eps, DirentGetFiles, SortingHelper::SetSorter(sorting));
-
-        static char directoryNameWithoutSlash[MAX_PATH_BYTES];
-        if (sz>0 && directoryName[sz-1] == '/') String::Substr(directoryName,directoryNameWithoutSlash,0,sz-1);
-        else strcpy(directoryNameWithoutSlash,directoryName);
-
-        if (n >= 0) {
-        result.reserve((size_t)n);
-        if (pOptionalNamesOut) pOptionalNamesOut->reserve((size_t)n);
-            for (int cnt = 0; cnt < n; ++cnt)    {
-                const char* pName = &eps[cnt]->d_name[0];
-		sz = strlen(pName);
-		if (sz>0) {
-		    if (pName[0]!='.' && pName[sz-1]!='~')    {
-			strcpy(tempString,directoryNameWithoutSlash);
-			strcat(tempString,"/");
-			strcat(tempString,pName);
-			String::PushBack(result,tempString);
-			if (pOptionalNamesOut) String::PushBack(*pOptionalNamesOut,pName);
-		    }
-		}
-		free(eps[cnt]);
-            }
-        }
-        if (eps) {free(eps);eps=NULL;}
+        DirectoryListing files;
+        Scan(directoryName,NULL,&files,SortingNeedsStatData(sorting));
+        files.sort(sorting);
+        files.copyTo(result,pOptionalNamesOut);
     }
 
     // e.g. ".txt;.jpg;.png". To use unwantedExtensions, set wantedExtensions="".
@@ -832,13 +881,23 @@ public:
 protected:
     Directory() {}
 
-    static int DirentGetDirectories(const struct dirent *de) {
-        if (de->d_type==DT_DIR) return 1;
-        return 0;
-    }
-    static int DirentGetFiles(const struct dirent *de) {
-        if (de->d_type==DT_REG) return 1;
-        return 0;
+    // "lowercaseExtensions" is something like ".png;.jpg"
+    static bool MatchesExtension(const char* fileName,const char* lowercaseExtensions) {
+        const char* ext = strrchr(fileName,'.');
+        if (!ext) return false;
+        const size_t extLen = strlen(ext);
+        for (const char* e = lowercaseExtensions;*e!='\0';)  {
+            const char* eEnd = strchr(e,';');
+            const size_t len = eEnd ? (size_t)(eEnd-e) : strlen(e);
+            if (len==extLen)    {
+                size_t i=0;
+                for (;i<len;i++) {if (tolower(ext[i])!=e[i]) break;}
+                if (i==len) return true;
+            }
+            if (!eEnd) break;
+            e = eEnd+1;
+        }
+        return false;
     }
 
 #   ifdef _WIN32
@@ -882,222 +941,217 @@ struct UnZipFileImpl {
     unzFile uf;
     char zipFilePath[MAX_PATH_BYTES];
 
-    struct unz_file_info64_plus {
-        unz_file_info64 info;
-        char path[MAX_PATH_BYTES];
-        char name[MAX_PATH_BYTES];
-        void assign(const char* _path,const char* _name,const unz_file_info64& _info) {
-            strcpy(path,_path);strcpy(name,_name);
-            memcpy(&info,&_info,sizeof(info));
-        }
-        static void Sort(ImVector<unz_file_info64_plus>& fileInfos,Sorting sorting) {
-            if (fileInfos.size()==0) return;
-            typedef int (*Sorter)(const void *, const void *);
-            Sorter sorter = NULL;
-            switch (sorting)    {
-            case SORT_ORDER_ALPHABETIC:                 sorter = &unz_file_info64_plus::Alphasort;break;
-            case SORT_ORDER_ALPHABETIC_INVERSE:         sorter = &unz_file_info64_plus::Alphasortinverse;break;
-            case SORT_ORDER_LAST_MODIFICATION:          sorter = &unz_file_info64_plus::LastModsort;break;
-            case SORT_ORDER_LAST_MODIFICATION_INVERSE:  sorter = &unz_file_info64_plus::LastModsortinverse;break;
-            case SORT_ORDER_SIZE:                       sorter = &unz_file_info64_plus::Sizesort;break;
-            case SORT_ORDER_SIZE_INVERSE:               sorter = &unz_file_info64_plus::Sizesortinverse;break;
-            case SORT_ORDER_TYPE:                       sorter = &unz_file_info64_plus::Typesort;break;
-            case SORT_ORDER_TYPE_INVERSE:               sorter = &unz_file_info64_plus::Typesortinverse;break;
-            default: break;
+    // Index of the central directory, built once in load(): unzLocateFile(...) scans all the entries at every call,
+    // and listing a folder used to walk the whole central directory too.
+    struct Entry {
+        int pathOffset,nameOffset;  // in "chars": the path inside the zip file (with '/' separators and no trailing slash) and its last component
+        ImU32 hash;
+        int nextInBucket;           // next entry with the same (hash & hashMask)
+        int parent;                 // directory entry, or -1 for the root
+        int firstChild,lastChild,nextSibling;   // children are kept in central directory order
+        bool isDirectory;
+        bool isInZip;               // false for the directories implied by the paths of the other entries
+        bool isEncrypted;
+        unz64_file_pos filePos;     // valid if isInZip
+        uLong dosDate;
+        ZPOS64_T compressedSize,uncompressedSize;
+        inline bool hasZeroSize() const {return compressedSize==0 && uncompressedSize==0;}
+        // The zip entries that the listings (and exists(...)) report as files
+        inline bool isListedFile() const {return !isDirectory && !hasZeroSize();}
+    };
+    ImVector<char> chars;
+    ImVector<Entry> entries;
+    ImVector<int> buckets;          // first entry of each hash bucket (or -1). Its size is a power of two.
+    int rootFirstChild,rootLastChild;
+#   ifdef IMGUIFS_HAS_THREADS
+    volatile int ufInUse;           // concurrent readers that find "uf" busy open their own unzFile
+#   endif //IMGUIFS_HAS_THREADS
+
+    UnZipFileImpl() : uf(NULL),rootFirstChild(-1),rootLastChild(-1) {
+        zipFilePath[0]='\0';
+#       ifdef IMGUIFS_HAS_THREADS
+        ufInUse = 0;
+#       endif //IMGUIFS_HAS_THREADS
+    }
+    inline const char* getPath(int e) const {return &chars[entries[e].pathOffset];}
+    inline const char* getName(int e) const {return &chars[entries[e].nameOffset];}
+
+    void clearIndex()   {
+        ImVector<char> c;chars.swap(c);
+        ImVector<Entry> e;entries.swap(e);
+        ImVector<int> b;buckets.swap(b);
+        rootFirstChild = rootLastChild = -1;
+    }
+    // typeFilter: 0 = any entry, 1 = files only, 2 = directories only. Returns the first matching entry in central directory order, or -1.
+    int find(const char* path,int pathLen,int typeFilter=0) const  {
+        if (buckets.size()==0) return -1;
+        const ImU32 hash = ImHashData(path,(size_t)pathLen);
+        for (int e = buckets[(int)(hash&(ImU32)(buckets.size()-1))];e>=0;e = entries[e].nextInBucket)   {
+            const Entry& en = entries[e];
+            if (en.hash==hash && (typeFilter==0 || (typeFilter==2)==en.isDirectory) && strncmp(getPath(e),path,pathLen)==0 && getPath(e)[pathLen]=='\0') return e;
+        }
+        return -1;
+    }
+    // Cleans a path inside the zip file: no leading "./", '/' separators, no trailing slashes. Returns its length.
+    static int CleanPath(const char* pathInsideZip,char* rv)  {
+        if (!pathInsideZip) pathInsideZip = "";
+        if (pathInsideZip[0]=='.' && (pathInsideZip[1]=='/' || pathInsideZip[1]=='\\')) pathInsideZip+=2;
+        int len = 0;
+        for (;pathInsideZip[len]!='\0' && len<MAX_PATH_BYTES-1;len++) rv[len] = (pathInsideZip[len]=='\\') ? '/' : pathInsideZip[len];
+        while (len>0 && rv[len-1]=='/') --len;
+        rv[len]='\0';
+        return len;
+    }
+    // "info" and "filePos" are NULL for implied directories
+    int addEntry(const char* path,int pathLen,bool isDirectory,const unz_file_info64* info,const unz64_file_pos* filePos)   {
+        if (isDirectory)    {
+            const int e = find(path,pathLen,2);
+            if (e>=0) {
+                // Already implied by a previous entry: we just store its zip info
+                if (info && !entries[e].isInZip) fillEntryInfo(entries[e],info,filePos);
+                return e;
             }
-            if (sorter) qsort(&fileInfos[0],fileInfos.size(),sizeof(unz_file_info64_plus),sorter);
-        }
-        //void qsort( void *ptr, size_t count, size_t size,int (*comp)(const void *, const void *) );
-        inline static int IMGUIFS_CDECL Alphasort(const void* e1,const void* e2) {
-            return strcasecmp(static_cast<const unz_file_info64_plus*>(e1)->name,static_cast<const unz_file_info64_plus*>(e2)->name);
-        }
-        inline static int IMGUIFS_CDECL Alphasortinverse(const void* e1,const void* e2) {
-            return -strcasecmp(static_cast<const unz_file_info64_plus*>(e1)->name,static_cast<const unz_file_info64_plus*>(e2)->name);
-        }
-        inline static int IMGUIFS_CDECL LastModsort(const void* e1,const void* e2) {  // or tmu_date ?
-            const uLong& dosDate1 = static_cast<const unz_file_info64_plus*>(e1)->info.dosDate;
-            const uLong& dosDate2 = static_cast<const unz_file_info64_plus*>(e2)->info.dosDate;
-            return (dosDate1<dosDate2) ? -1 : (dosDate1>dosDate2) ? 1 : 0;
-        }
-        inline static int IMGUIFS_CDECL LastModsortinverse(const void* e1,const void* e2) {
-            const uLong& dosDate1 = static_cast<const unz_file_info64_plus*>(e1)->info.dosDate;
-            const uLong& dosDate2 = static_cast<const unz_file_info64_plus*>(e2)->info.dosDate;
-            return (dosDate1<dosDate2) ? 1 : (dosDate1>dosDate2) ? -1 : 0;
-        }
-        inline static int IMGUIFS_CDECL Sizesort(const void* e1,const void* e2) {
-            const ZPOS64_T& size1 = static_cast<const unz_file_info64_plus*>(e1)->info.uncompressed_size;
-            const ZPOS64_T& size2 = static_cast<const unz_file_info64_plus*>(e2)->info.uncompressed_size;
-            return (size1<size2) ? -1 : (size1>size2) ? 1 : 0;
-        }
-        inline static int IMGUIFS_CDECL Sizesortinverse(const void* e1,const void* e2) {
-            const ZPOS64_T& size1 = static_cast<const unz_file_info64_plus*>(e1)->info.uncompressed_size;
-            const ZPOS64_T& size2 = static_cast<const unz_file_info64_plus*>(e2)->info.uncompressed_size;
-            return (size1<size2) ? 1 : (size1>size2) ? -1 : 0;
-        }
-        inline static int IMGUIFS_CDECL Typesort(const void* e1,const void* e2) {
-            static const int dot = (int) '.';
-            const char * p1 = strrchr((const char*) static_cast<const unz_file_info64_plus*>(e1)->name, dot );
-            const char * p2 = strrchr((const char*) static_cast<const unz_file_info64_plus*>(e2)->name, dot );
-            if (!p1) return (!p2?0:-1);
-            else if (!p2)   return 1;
-            return strcasecmp(p1,p2);
-        }
-        inline static int IMGUIFS_CDECL Typesortinverse(const void* e1,const void* e2) {
-            static const int dot = (int) '.';
-            const char * p1 = strrchr((const char*) static_cast<const unz_file_info64_plus*>(e1)->name, dot );
-            const char * p2 = strrchr((const char*) static_cast<const unz_file_info64_plus*>(e2)->name, dot );
-            if (!p1) return (!p2?0:-1);
-            else if (!p2)   return -1;
-            return -strcasecmp(p1,p2);
         }
-    };
-
-    bool getFilesOrDirectories(bool fileMode,const char* directoryName,PathStringVector& result,FilenameStringVector* pOptionalNamesOut,Sorting sorting,bool prefixResultWithTheFullPathOfTheZipFile) const  {
-        result.clear();if (pOptionalNamesOut) pOptionalNamesOut->clear();
-        if (!uf) return false;
-        char dirName[MAX_PATH_BYTES];
-
-        // copy a clean directoryName into dirName
-        size_t dirNameLen = 0;
-        if (directoryName)  {
-            dirNameLen = strlen(directoryName);
-            if (dirNameLen>1 && directoryName[0]=='.' && (directoryName[1]=='/' || directoryName[1]=='\\')) {
-                strcpy(dirName,&directoryName[2]);
+        int parent = -1,nameStart = 0;
+        for (int i=pathLen-1;i>=0;--i) {
+            if (path[i]=='/') {
+                if (i>0) parent = addEntry(path,i,true,NULL,NULL);
+                nameStart = i+1;
+                break;
             }
-            else strcpy(dirName,directoryName);
         }
-        else strcpy(dirName,directoryName ? directoryName : "");
-        dirNameLen = strlen(dirName);
-        while (dirNameLen>0 && (dirName[dirNameLen-1]=='/' || dirName[dirNameLen-1]=='\\')) {dirName[dirNameLen-1]='\0';--dirNameLen;}
-
-        // get gi
-        uLong i;unz_global_info64 gi;int err;
-        err = unzGetGlobalInfo64(uf,&gi);
+        const int index = entries.size();
+        const int pathOffset = chars.size();
+        chars.resize(pathOffset+pathLen+1);
+        memcpy(&chars[pathOffset],path,pathLen);chars[pathOffset+pathLen]='\0';
+        entries.resize(index+1);
+        Entry& en = entries[index];
+        en.pathOffset = pathOffset;en.nameOffset = pathOffset+nameStart;
+        en.hash = ImHashData(path,(size_t)pathLen);
+        en.parent = parent;en.firstChild = en.lastChild = en.nextSibling = -1;
+        en.isDirectory = isDirectory;
+        en.isInZip = false;en.isEncrypted = false;
+        en.dosDate = 0;en.compressedSize = en.uncompressedSize = 0;
+        if (info) fillEntryInfo(en,info,filePos);
+        // tree
+        int& firstChild = parent>=0 ? entries[parent].firstChild : rootFirstChild;
+        int& lastChild = parent>=0 ? entries[parent].lastChild : rootLastChild;
+        if (lastChild>=0) entries[lastChild].nextSibling = index;
+        else firstChild = index;
+        lastChild = index;
+        // hash table
+        if (entries.size()*2>buckets.size()) rehash(buckets.size()>0 ? buckets.size()*2 : 1024);
+        else {
+            int& bucket = buckets[(int)(en.hash&(ImU32)(buckets.size()-1))];
+            en.nextInBucket = bucket;bucket = index;
+        }
+        return index;
+    }
+    void rehash(int numBuckets) {
+        buckets.resize(numBuckets);
+        for (int i=0;i<numBuckets;i++) buckets[i]=-1;
+        // we go backwards so that the buckets list the entries in central directory order
+        for (int e=entries.size()-1;e>=0;--e) {
+            int& bucket = buckets[(int)(entries[e].hash&(ImU32)(numBuckets-1))];
+            entries[e].nextInBucket = bucket;bucket = e;
+        }
+    }
+    inline static void fillEntryInfo(Entry& en,const unz_file_info64* info,const unz64_file_pos* filePos) {
+        en.isInZip = true;
+        en.isEncrypted = (info->flag & 1) != 0;
+        en.filePos = *filePos;
+        en.dosDate = info->dosDate;
+        en.compressedSize = info->compressed_size;en.uncompressedSize = info->uncompressed_size;
+    }
+    bool buildIndex()   {
+        clearIndex();
+        if (!uf) return false;
+        unz_global_info64 gi;
+        int err = unzGetGlobalInfo64(uf,&gi);
         if (err!=UNZ_OK) {
             fprintf(stderr,"error %d with zipfile in unzGetGlobalInfo \n",err);
             return false;
         }
-
-        ImVector<unz_file_info64_plus> fileInfos;
-
-        // Fill fileInfos
-        char tmp[MAX_PATH_BYTES]="";char filename_inzip[MAX_PATH_BYTES]="";const char charCrypt[2]="*";
-        unz_file_info64 file_info;bool ok=false;
-        err = unzGoToFirstFile(uf);
-        if (err!=UNZ_OK)  {
-            fprintf(stderr,"error %d with zipfile in unzGoToFirstFile",err);
-            return false;
-        }
-
-        for (i=0;i<gi.number_entry;i++)	{
+        entries.reserve((int)gi.number_entry);
+        char filename_inzip[MAX_PATH_BYTES]="";char path[MAX_PATH_BYTES]="";
+        unz_file_info64 file_info;unz64_file_pos filePos;
+        for (err = unzGoToFirstFile(uf);err==UNZ_OK;err = unzGoToNextFile(uf))    {
             err = unzGetCurrentFileInfo64(uf,&file_info,filename_inzip,sizeof(filename_inzip),NULL,0,NULL,0);
+            if (err==UNZ_OK) err = unzGetFilePos64(uf,&filePos);
             if (err!=UNZ_OK) {
                 fprintf(stderr,"Error %d with zipfile in unzGetCurrentFileInfo\n",err);
                 return false;
             }
-
-            ok = false;
-            size_t filename_inzip_len = strlen(filename_inzip);
-            const bool hasZeroSize = file_info.compressed_size == 0 && file_info.uncompressed_size == 0;
+            const size_t filename_inzip_len = strlen(filename_inzip);
             const bool isDirectory = filename_inzip_len>0 && (filename_inzip[filename_inzip_len-1]=='/' || filename_inzip[filename_inzip_len-1]=='\\');
-            ok = fileMode ? (!isDirectory && !hasZeroSize) : (isDirectory && hasZeroSize) ? true : false;
-
-            if (ok) {
-                if (dirNameLen>0)   {
-                    if (dirNameLen>=filename_inzip_len) ok = false;
-                    if (strncmp(dirName,filename_inzip,dirNameLen)!=0) ok = false;
-                    if (filename_inzip[dirNameLen]!='/' && filename_inzip[dirNameLen]!='\\') ok = false;
-                    if (!fileMode && dirNameLen+1 == filename_inzip_len) ok = false;
-                }
-                if (ok) {
-                    // remove trailing dash from filename_inzip
-                    if (filename_inzip_len>0 && (filename_inzip[filename_inzip_len-1]=='/' || filename_inzip[filename_inzip_len-1]=='\\')) {filename_inzip[filename_inzip_len-1]='\0';--filename_inzip_len;}   // remove trailing dash
-
-                    strcpy(tmp,dirNameLen>0 ? &filename_inzip[dirNameLen+1] : filename_inzip);  // Here "tmp" if the plain name, and "filename_inzip" the full name
-                    size_t tmpLen = strlen(tmp);
-                    for (size_t k=0;k<tmpLen;k++) {
-                        if (tmp[k]=='/' || tmp[k]=='\\') {
-                            if (fileMode || k!=tmpLen-1)
-                            {ok = false;break;}
-                        }
-                    }
-                    if (ok) {
-                        if ((file_info.flag & 1) != 0) strcat(tmp,charCrypt); // Optional display a '*' in the file name only if it is crypted
-
-                        size_t fileInfosSize = fileInfos.size();
-                        fileInfos.resize(fileInfosSize+1);
-                        fileInfos[fileInfosSize].assign(filename_inzip,tmp,file_info);
-                        //fprintf(stderr,"%s\t%s\t%u\t%u\n",filename_inzip,tmp,(unsigned)file_info.compressed_size,(unsigned)file_info.uncompressed_size);
-                    }
-                }
-            }
-
-           if (i<gi.number_entry-1)  {
-                err = unzGoToNextFile(uf);
-                if (err!=UNZ_OK)  {
-                    fprintf(stderr,"error %d with zipfile in unzGoToNextFile\n",err);
-                    return false;
-                }
-            }
-
-        } // for loop
-
-if (fileInfos.size()>0) {
-    //sorting:
-    if (!fileMode && sorting >= SORT_ORDER_SIZE) sorting = (Sorting)(sorting%2);
-    unz_file_info64_plus::Sort(fileInfos,sorting);
-
-    for (size_t j=0,jsz=fileInfos.size();j<jsz;j++) {
-        const unz_file_info64_plus& fip = fileInfos[j];
-        //const unz_file_info64& fi = fip.info;
-
-        const size_t resultSize = result.size();
-        result.resize(resultSize+1);
-        char* pResult = &result[resultSize][0];
-        pResult[0]='\0';
-        if (prefixResultWithTheFullPathOfTheZipFile) {
-            strcpy(pResult,zipFilePath);
-            strcat(pResult,"/");
+            const int pathLen = CleanPath(filename_inzip,path);
+            if (pathLen>0) addEntry(path,pathLen,isDirectory,&file_info,&filePos);
         }
-        strcat(pResult,fip.path);
-
-
-        if (pOptionalNamesOut)  {
-            pOptionalNamesOut->resize(resultSize+1);
-            char* pName = &(*pOptionalNamesOut)[resultSize][0];
-            strcpy(pName,fip.name);
-
-            //const unz_file_info64& file_info = fip.info;
-            //fprintf(stderr,"%s\t%s\t%u\t%u\n",pResult,pName,(unsigned)file_info.compressed_size,(unsigned)file_info.uncompressed_size);
+        if (err!=UNZ_END_OF_LIST_OF_FILE) {
+            fprintf(stderr,"error %d with zipfile in unzGoToNextFile\n",err);
+            return false;
         }
-
+        return true;
     }
 
-}
-/*
- if ((file_info.flag & 1) != 0) strcat(tmp,charCrypt);
-                    const size_t resultSize = result.size();
-                    result.resize(resultSize+1);
-                    char* pResult = &result[resultSize][0];
-                    strcpy(pResult,filename_inzip);
-
-                    if (pOptionalNamesOut)  {
-                        pOptionalNamesOut->resize(resultSize+1);
-                        char* pName = &(*pOptionalNamesOut)[resultSize][0];
-                        strcpy(pName,tmp);
-                        if ((file_info.flag & 1) != 0) strcat(pName,charCrypt); // display a '*' if the file is crypted
-
-                        //fprintf(stderr,"%s\t%s\t%u\t%u\t%d\n",pResult,pName,(unsigned)file_info.compressed_size,(unsigned)file_info.uncompressed_size,isDirectory);
-                    }
-*/
-        err = unzGoToFirstFile(uf);
-        if (err!=UNZ_OK)  {
-            fprintf(stderr,"error %d with zipfile in unzGoToFirstFile",err);
-            return false;
-        }
-        unzCloseCurrentFile(uf);
+    // The directory listing used by getFiles(...), getDirectories(...) and by the Dialog
+    bool getListing(bool fileMode,const char* directoryName,DirectoryListing& listing,Sorting sorting,bool prefixResultWithTheFullPathOfTheZipFile) const  {
+        listing.clear();listing.hasStatData = true;
+        if (!uf) return false;
+        char dirName[MAX_PATH_BYTES];
+        const int dirNameLen = CleanPath(directoryName,dirName);
+        int child = rootFirstChild;
+        if (dirNameLen>0) {
+            const int dir = find(dirName,dirNameLen,2);
+            child = dir>=0 ? entries[dir].firstChild : -1;
+        }
+        char prefix[MAX_PATH_BYTES]="";
+        if (prefixResultWithTheFullPathOfTheZipFile) {strcpy(prefix,zipFilePath);strcat(prefix,"/");}
+        const int prefixLen = (int)strlen(prefix);
+        char path[MAX_PATH_BYTES];char name[MAX_PATH_BYTES];
+        for (;child>=0;child = entries[child].nextSibling)  {
+            const Entry& en = entries[child];
+            if (!(fileMode ? en.isListedFile() : en.isDirectory)) continue;
+            strcpy(path,prefix);strcpy(&path[prefixLen],getPath(child));
+            strcpy(name,getName(child));
+            if (en.isEncrypted) strcat(name,"*");   // Optional display a '*' in the file name only if it is crypted
+            listing.addPathAndName(path,name,(time_t)en.dosDate,(off_t)en.uncompressedSize);
+        }
+        if (!fileMode && sorting >= SORT_ORDER_SIZE) sorting = (Sorting)(sorting%2);
+        listing.sort(sorting);
         return true;
+    }
+    bool getFilesOrDirectories(bool fileMode,const char* directoryName,PathStringVector& result,FilenameStringVector* pOptionalNamesOut,Sorting sorting,bool prefixResultWithTheFullPathOfTheZipFile) const  {
+        DirectoryListing listing;
+        const bool ok = getListing(fileMode,directoryName,listing,sorting,prefixResultWithTheFullPathOfTheZipFile);
+        listing.copyTo(result,pOptionalNamesOut);
+        return ok;
+    }
 
+    // Returns an unzFile positioned on the file entry "filePath" (or NULL). It must be passed to releaseHandle(...).
+    // When "uf" is used by another thread, we open a new handle to the zip file: so many files can be extracted concurrently.
+    unzFile acquireHandle(const char* filePath) const  {
+        if (!uf || !filePath) return NULL;
+        char path[MAX_PATH_BYTES];
+        const int e = find(path,CleanPath(filePath,path),1);
+        if (e<0 || !entries[e].isInZip) return NULL;
+        unzFile h = uf;
+#       ifdef IMGUIFS_HAS_THREADS
+        if (!ImGuiHelper::AtomicCompareAndSwap(const_cast<volatile int*>(&ufInUse),0,1))   {
+            h = unzOpen64(zipFilePath);
+            if (!h) return NULL;
+        }
+#       endif //IMGUIFS_HAS_THREADS
+        if (unzGoToFilePos64(h,&entries[e].filePos)!=UNZ_OK) {releaseHandle(h);return NULL;}
+        return h;
+    }
+    void releaseHandle(unzFile h) const {
+#       ifdef IMGUIFS_HAS_THREADS
+        if (h!=uf) {unzClose(h);return;}
+        ImGuiHelper::AtomicStore(const_cast<volatile int*>(&ufInUse),0);
+#       else //IMGUIFS_HAS_THREADS
+        (void)h;
+#       endif //IMGUIFS_HAS_THREADS
     }
 
     static bool PathSplitFirstZipFolder(const char* path, char* rv1,char* rv2,bool rv1IsAbsolutePath=true)  {
@@ -1159,6 +1213,7 @@ bool UnZipFile::load(const char* zipFilePath,bool reloadIfAlreadyLoaded) {
     if (zipFilePath) {
         Path::GetAbsolutePath(zipFilePath,im->zipFilePath);
         im->uf = unzOpen64(im->zipFilePath);
+        if (im->uf && !im->buildIndex()) close();
     }
     //else if (im->zipFilePath) im->uf = unzOpen64(im->zipFilePath);
     return im->uf!=NULL;
@@ -1171,6 +1226,7 @@ bool UnZipFile::isValid() const {
 }
 void UnZipFile::close() {
     if (im->uf) {unzClose(im->uf);im->uf=NULL;}
+    im->clearIndex();
 }
 bool UnZipFile::getDirectories(const char* directoryName,PathStringVector& result,FilenameStringVector* pOptionalNamesOut,Sorting sorting,bool prefixResultWithTheFullPathOfTheZipFile) const  {
     return im->getFilesOrDirectories(false,directoryName,result,pOptionalNamesOut,sorting,prefixResultWithTheFullPathOfTheZipFile);
@@ -1180,69 +1236,89 @@ bool UnZipFile::getFiles(const char* directoryName,PathStringVector& result,File
 }
 unsigned int UnZipFile::getFileSize(const char* filePath) const   {
     if (!im->uf || !filePath) return 0;
-    if (unzLocateFile(im->uf,filePath,0)!=UNZ_OK) return 0;
-    unz_file_info64 file_info;char filename_inzip[2048];
-    int err = unzGetCurrentFileInfo64(im->uf,&file_info,filename_inzip,sizeof(filename_inzip),NULL,0,NULL,0);
-    if (err!=UNZ_OK)  return 0;
-    unsigned int sz = file_info.uncompressed_size;
-    if (sz==file_info.uncompressed_size) return sz;
+    char path[MAX_PATH_BYTES];
+    const int e = im->find(path,UnZipFileImpl::CleanPath(filePath,path),1);
+    if (e<0) return 0;
+    const ZPOS64_T size = im->entries[e].uncompressedSize;
+    unsigned int sz = (unsigned int) size;
+    if (sz==size) return sz;
     return 0;
 }
-template<typename CharType> static bool UnZipFileGetFileContentBase(ImGuiFs::UnZipFileImpl* im,const char* filePath,ImVector<CharType>& bufferOut,const char* password)   {
+template<typename CharType> static bool UnZipFileGetFileContentBase(const ImGuiFs::UnZipFileImpl* im,const char* filePath,ImVector<CharType>& bufferOut,const char* password)   {
     bufferOut.clear();
-    if (!im->uf || !filePath) return false;
-    if (unzLocateFile(im->uf,filePath,0)!=UNZ_OK) return false;
+    unzFile uf = im->acquireHandle(filePath);
+    if (!uf) return false;
     unz_file_info64 file_info;char filename_inzip[2048];    // it's the filename without path
-    int err = unzGetCurrentFileInfo64(im->uf,&file_info,filename_inzip,sizeof(filename_inzip),NULL,0,NULL,0);
+    int err = unzGetCurrentFileInfo64(uf,&file_info,filename_inzip,sizeof(filename_inzip),NULL,0,NULL,0);
     if (err<0)  {
         fprintf(stderr,"Error while unzipping: \"%s\": %d with zipfile in unzGetCurrentFileInfo\n",filePath,err);
+        im->releaseHandle(uf);
         return false;
     }
     //if (file_info.uncompressed_size>MAX_UNSIGNED_INT) return false; // where is MAX_UNSIGNED_INT ???
-    err = unzOpenCurrentFilePassword(im->uf,password);
+    err = unzOpenCurrentFilePassword(uf,password);
     if (err<0)  {
         fprintf(stderr,"Error while unzipping: \"%s\": %d with zipfile in unzOpenCurrentFilePassword\n",filePath,err);
+        im->releaseHandle(uf);
         return false;
     }
     bufferOut.resize(file_info.uncompressed_size);
     if ((unsigned)bufferOut.size()<file_info.uncompressed_size) {
         fprintf(stderr,"Error while unzipping: \"%s\": file is too big.\n",filePath);
         ImVector<CharType> tmp;bufferOut.swap(tmp);
-        unzCloseCurrentFile (im->uf);
+        unzCloseCurrentFile (uf);
+        im->releaseHandle(uf);
         return false;
     }
-    err = unzReadCurrentFile(im->uf,&bufferOut[0],bufferOut.size());
+    err = bufferOut.size()>0 ? unzReadCurrentFile(uf,&bufferOut[0],bufferOut.size()) : 0;
     if (err<0) {
         fprintf(stderr,"Error while unzipping: \"%s\": %d with zipfile in unzReadCurrentFile\n",filePath,err);
         ImVector<CharType> tmp;bufferOut.swap(tmp);
-        unzCloseCurrentFile (im->uf);
+        unzCloseCurrentFile (uf);
+        im->releaseHandle(uf);
         return false;
     }
-    err = unzCloseCurrentFile (im->uf);
+    err = unzCloseCurrentFile (uf);
     if (err<0) {
         fprintf(stderr,"Error while unzipping: \"%s\": %d with zipfile in unzCloseCurrentFile\n",filePath,err);
     }
+    im->releaseHandle(uf);
     return true;
 }
 bool UnZipFile::getFileContent(const char* filePath,ImVector<unsigned char>& bufferOut,const char* password) const    {return UnZipFileGetFileContentBase<unsigned char>(im,filePath,bufferOut,password);}
 bool UnZipFile::getFileContent(const char* filePath,ImVector<char>& bufferOut,const char* password) const    {return UnZipFileGetFileContentBase<char>(im,filePath,bufferOut,password);}
+struct UnZipFileGetFileContentsJob {
+    const UnZipFileImpl* im;
+    const char* const* filePaths;
+    ImVector<unsigned char>* buffersOut;
+    const char* password;
+    volatile int numExtracted;
+    static void Extract(int start,int end,void* userPtr)   {
+        UnZipFileGetFileContentsJob& j = *((UnZipFileGetFileContentsJob*)userPtr);
+        int numExtracted = 0;
+        for (int i=start;i<end;i++) {if (UnZipFileGetFileContentBase<unsigned char>(j.im,j.filePaths[i],j.buffersOut[i],j.password)) ++numExtracted;}
+#       ifdef IMGUIFS_HAS_THREADS
+        ImGuiHelper::AtomicAdd(&j.numExtracted,numExtracted);
+#       else //IMGUIFS_HAS_THREADS
+        j.numExtracted+=numExtracted;
+#       endif //IMGUIFS_HAS_THREADS
+    }
+};
+int UnZipFile::getFileContents(const char* const* filePaths,int numFiles,ImVector<unsigned char>* buffersOut,const char* password) const {
+    if (!im->uf || numFiles<=0) return 0;
+    UnZipFileGetFileContentsJob job;
+    job.im = im;job.filePaths = filePaths;job.buffersOut = buffersOut;job.password = password;job.numExtracted = 0;
+#   ifdef IMGUIFS_HAS_THREADS
+    ImGuiHelper::ThreadPool::GetDefault().parallelFor(0,numFiles,&UnZipFileGetFileContentsJob::Extract,&job,1);
+#   else //IMGUIFS_HAS_THREADS
+    UnZipFileGetFileContentsJob::Extract(0,numFiles,&job);
+#   endif //IMGUIFS_HAS_THREADS
+    return job.numExtracted;
+}
 bool UnZipFile::exists(const char* pathInsideZip,bool reportOnlyFiles,bool reportOnlyDirectories) const {
     if (!im->uf || !pathInsideZip) return false;
     char path[MAX_PATH_BYTES];
-
-    // copy a clean pathInsideZip into path
-    size_t dirNameLen = 0;
-    if (pathInsideZip)  {
-        dirNameLen = strlen(pathInsideZip);
-        if (dirNameLen>1 && pathInsideZip[0]=='.' && (pathInsideZip[1]=='/' || pathInsideZip[1]=='\\')) {
-            strcpy(path,&pathInsideZip[2]);
-        }
-        else strcpy(path,pathInsideZip);
-    }
-    else strcpy(path,pathInsideZip ? pathInsideZip : "");
-
-    dirNameLen = strlen(path);
-    while (dirNameLen>0 && (path[dirNameLen-1]=='/' || path[dirNameLen-1]=='\\')) {path[dirNameLen-1]='\0';--dirNameLen;}
+    const int pathLen = UnZipFileImpl::CleanPath(pathInsideZip,path);
 
     bool onlyDirs = false,onlyFiles=false;
     if ((reportOnlyFiles || reportOnlyDirectories) && !(reportOnlyFiles && reportOnlyDirectories)) {
@@ -1250,33 +1326,14 @@ bool UnZipFile::exists(const char* pathInsideZip,bool reportOnlyFiles,bool repor
         onlyFiles = reportOnlyFiles;
     }
 
-    if (strlen(path)==0 && !onlyFiles) return true;   // base zip folder
+    if (pathLen==0) return !onlyFiles;   // base zip folder
 
-    if (!onlyFiles) {path[dirNameLen++]='/';path[dirNameLen]='\0';}
-
-    bool found = (unzLocateFile(im->uf,path,0)==UNZ_OK);    // it becames the current file
-
-    //fprintf(stderr,"%s %s %s\n",pathInsideZip,path,found?"true":"false");
-
-    if (found && (onlyDirs || onlyFiles)) {
-        unz_file_info64 file_info;
-        char filename_inzip[2048];    // it's the filename without path
-        int err = unzGetCurrentFileInfo64(im->uf,&file_info,filename_inzip,sizeof(filename_inzip),NULL,0,NULL,0);
-        if (err!=UNZ_OK)  {
-            fprintf(stderr,"Error while checking: \"%s\": %d in unzGetCurrentFileInfo\n",pathInsideZip,err);
-            found = false;
-        }
-        else    {
-            size_t filename_inzip_len = strlen(filename_inzip);
-            const bool hasZeroSize = file_info.compressed_size == 0 && file_info.uncompressed_size == 0;
-            const bool isDirectory = filename_inzip_len>0 && (filename_inzip[filename_inzip_len-1]=='/' || filename_inzip[filename_inzip_len-1]=='\\');
-            found = onlyFiles ? (!isDirectory && !hasZeroSize) : onlyDirs ? (isDirectory && hasZeroSize) : false;
-        }
-
-    }
-    unzCloseCurrentFile(im->uf);
-
-    return found;
+    const int e = im->find(path,pathLen,onlyFiles ? 1 : onlyDirs ? 2 : 0);
+    if (e<0) return false;
+    const UnZipFileImpl::Entry& en = im->entries[e];
+    if (onlyFiles) return en.isListedFile();
+    if (onlyDirs) return en.isDirectory;
+    return true;
 }
 bool UnZipFile::fileExists(const char* pathInsideZip) const {
     return exists(pathInsideZip,true,false);
@@ -1286,12 +1343,13 @@ bool UnZipFile::directoryExists(const char* pathInsideZip) const    {
 }
 UnZipFile::UnZipFile(const char* zipFilePath)  {
     im = (UnZipFileImpl*) ImGui::MemAlloc(sizeof(UnZipFileImpl));
-    im->uf = NULL;im->zipFilePath[0]='\0';
+    IM_PLACEMENT_NEW(im) UnZipFileImpl();
     load(zipFilePath);
 }
 UnZipFile::~UnZipFile() {
     if (im) {
         close();
+        im->~UnZipFileImpl();
         ImGui::MemFree(im);
         im=NULL;
     }
@@ -1705,10 +1763,84 @@ public:
     size_t getInfoSize() const {return info.size();}
 };
 
+// Scans a folder for the Dialog. When threads are available this happens in a worker thread, so that huge or slow (e.g. network) folders
+// don't freeze the UI: the entries found so far are streamed to the Dialog, and replaced by the sorted listing at the end.
+struct DirectoryScanJob {
+    char directory[MAX_PATH_BYTES];
+    char wantedExtensions[MAX_PATH_BYTES];  // lowercase
+    bool scanFiles;
+    int sortingMode,sortingModeForDirectories;
+    DirectoryListing dirs,files;            // owned by the worker thread until "finished" is set
+#   ifdef IMGUIFS_HAS_THREADS
+    ImGuiHelper::Mutex mutex;               // protects newDirs and newFiles
+    DirectoryListing newDirs,newFiles;      // entries published by the worker thread but not fetched by the Dialog yet
+    int numPublishedDirs,numPublishedFiles; // used by the worker thread only
+    volatile int cancelRequested,finished;
+    ImGuiHelper::ThreadHandle thread;
+#   endif //IMGUIFS_HAS_THREADS
+
+    DirectoryScanJob(const char* _directory,const char* fileFilterExtensionString,bool _scanFiles,int _sortingMode,int _sortingModeForDirectories)
+        : scanFiles(_scanFiles),sortingMode(_sortingMode),sortingModeForDirectories(_sortingModeForDirectories) {
+        strcpy(directory,_directory);
+        String::ToLower(fileFilterExtensionString ? fileFilterExtensionString : "",wantedExtensions);
+#       ifdef IMGUIFS_HAS_THREADS
+        numPublishedDirs=numPublishedFiles=0;
+        cancelRequested=finished=0;
+        thread = NULL;
+#       endif //IMGUIFS_HAS_THREADS
+    }
+    void run(bool readStatData,Directory::ScanProgressCallback cb=NULL) {
+        if (Directory::Scan(directory,&dirs,scanFiles ? &files : NULL,readStatData,wantedExtensions,cb,this))  {
+            dirs.sort((Sorting)sortingModeForDirectories);
+            files.sort((Sorting)sortingMode);
+        }
+    }
+    inline static DirectoryScanJob* Create(const char* _directory,const char* fileFilterExtensionString,bool _scanFiles,int _sortingMode,int _sortingModeForDirectories) {
+        DirectoryScanJob* job = (DirectoryScanJob*) ImGui::MemAlloc(sizeof(DirectoryScanJob));
+        IM_PLACEMENT_NEW(job) DirectoryScanJob(_directory,fileFilterExtensionString,_scanFiles,_sortingMode,_sortingModeForDirectories);
+        return job;
+    }
+    inline static void Destroy(DirectoryScanJob* job) {
+        job->~DirectoryScanJob();
+        ImGui::MemFree(job);
+    }
+#   ifdef IMGUIFS_HAS_THREADS
+    // Worker thread
+    static bool PublishCallback(void* userPtr)  {
+        DirectoryScanJob& j = *((DirectoryScanJob*)userPtr);
+        {
+            ImGuiHelper::ScopedLock lock(j.mutex);
+            j.newDirs.append(j.dirs,j.numPublishedDirs);
+            j.newFiles.append(j.files,j.numPublishedFiles);
+        }
+        j.numPublishedDirs = j.dirs.size();j.numPublishedFiles = j.files.size();
+        return ImGuiHelper::AtomicLoad(&j.cancelRequested)==0;
+    }
+    static void ThreadFunction(void* userPtr) {
+        DirectoryScanJob& j = *((DirectoryScanJob*)userPtr);
+        j.run(true,&PublishCallback);   // we always read mtime and size, so that changing the sorting mode won't need a new scan
+        ImGuiHelper::AtomicStore(&j.finished,1);    // the Dialog can use (or destroy) the job after this
+    }
+    // Dialog thread: appends the entries published so far to the passed listings
+    void fetchNewEntries(DirectoryListing& dirsOut,DirectoryListing& filesOut) {
+        ImGuiHelper::ScopedLock lock(mutex);
+        dirsOut.append(newDirs);newDirs.clear();
+        filesOut.append(newFiles);newFiles.clear();
+    }
+    inline bool isFinished() {return ImGuiHelper::AtomicLoad(&finished)!=0;}
+#   endif //IMGUIFS_HAS_THREADS
+protected:
+    DirectoryScanJob(const DirectoryScanJob&) {}
+    void operator=(const DirectoryScanJob&) {}
+};
+
 struct Internal {
-    PathStringVector dirs,files;
-    FilenameStringVector dirNames,fileNames,currentSplitPath;
-    ImVector<int> fileExtensionTypes;
+    DirectoryListing dirs,files;
+    ImVector<int> visibleDirs,visibleFiles;     // indices of the entries that pass the filter
+    char visibleEntriesFilter[256];             // the filter text used to fill visibleDirs and visibleFiles
+    DirectoryScanJob* scan;                     // the scan in progress (if any)
+    ImVector<DirectoryScanJob*> cancelledScans; // scans that must still be joined
+    FilenameStringVector currentSplitPath;
     char currentFolder[MAX_PATH_BYTES];
     bool forceRescan;
     bool open;
@@ -1753,9 +1885,10 @@ struct Internal {
     bool forceSetWindowPositionAndSize;
 
 
+    Internal() : scan(NULL) {visibleEntriesFilter[0]='\0';}
     ~Internal() {
-	dirs.clear();files.clear();
-	dirNames.clear();fileNames.clear();
+        cancelScan();
+        releaseCancelledScans(true);
 	currentSplitPath.clear();
     }
 
@@ -1764,11 +1897,100 @@ struct Internal {
     inline static void FreeMemory(FilenameStringVector& v) {FilenameStringVector o;v.swap(o);}
 #   endif //FILENAME_MAX!=DIRENT_MAX_PATH
     void freeMemory() {
-        FreeMemory(dirs);FreeMemory(files);
-        FreeMemory(dirNames);FreeMemory(fileNames);FreeMemory(currentSplitPath);
+        cancelScan();
+        dirs.freeMemory();files.freeMemory();
+        {ImVector<int> o;visibleDirs.swap(o);}{ImVector<int> o;visibleFiles.swap(o);}
+        FreeMemory(currentSplitPath);
         FreeMemory(FolderInfo::SplitPath);  // Not too sure about this...
     }
 
+    // Fills visibleDirs and visibleFiles starting from the passed entries (the previous ones are kept)
+    void filterEntries(int firstDir=0,int firstFile=0)  {
+        if (firstDir==0) visibleDirs.clear();
+        if (firstFile==0) visibleFiles.clear();
+        for (int i=firstDir,isz=dirs.size();i<isz;i++) {if (filter.PassFilter(dirs.getName(i))) visibleDirs.push_back(i);}
+        for (int i=firstFile,isz=files.size();i<isz;i++) {if (filter.PassFilter(files.getName(i))) visibleFiles.push_back(i);}
+        strcpy(visibleEntriesFilter,filter.InputBuf);
+    }
+    void startScan(const char* directory,const char* fileFilterExtensionString,bool scanFiles,int sortingModeForDirectories) {
+        cancelScan();
+        dirs.clear();files.clear();
+        DirectoryScanJob* job = DirectoryScanJob::Create(directory,fileFilterExtensionString,scanFiles,sortingMode,sortingModeForDirectories);
+#       ifdef IMGUIFS_HAS_THREADS
+        job->thread = ImGuiHelper::ThreadCreate(&DirectoryScanJob::ThreadFunction,job);
+        if (job->thread) {scan = job;filterEntries();return;}
+#       endif //IMGUIFS_HAS_THREADS
+        job->run(SortingNeedsStatData(sortingMode) || SortingNeedsStatData(sortingModeForDirectories));
+        dirs.swap(job->dirs);files.swap(job->files);
+        DirectoryScanJob::Destroy(job);
+        filterEntries();
+    }
+#   ifdef IMGUI_USE_MINIZIP
+    void listZipFolder(const char* zipPath,bool listFiles,int sortingModeForDirectories)   {
+        unz.im->getListing(false,zipPath,dirs,(Sorting)sortingModeForDirectories,true);
+        if (listFiles) unz.im->getListing(true,zipPath,files,(Sorting)sortingMode,true);
+    }
+#   endif //IMGUI_USE_MINIZIP
+    // Must be called every frame: it fetches the entries found by the scan in progress (if any)
+    void updateScan()   {
+        releaseCancelledScans(false);
+#       ifdef IMGUIFS_HAS_THREADS
+        if (!scan) return;
+        if (!scan->isFinished())  {
+            const int firstDir = dirs.size(),firstFile = files.size();
+            scan->fetchNewEntries(dirs,files);
+            if (dirs.size()!=firstDir || files.size()!=firstFile) filterEntries(firstDir,firstFile);
+            return;
+        }
+        ImGuiHelper::ThreadJoin(scan->thread);
+        dirs.swap(scan->dirs);files.swap(scan->files);
+        if (scan->sortingMode!=sortingMode) {
+            // The user has changed the sorting mode while scanning
+            dirs.sort((Sorting)GetSortingModeForDirectories(sortingMode));
+            files.sort((Sorting)sortingMode);
+        }
+        DirectoryScanJob::Destroy(scan);scan = NULL;
+        filterEntries();
+#       endif //IMGUIFS_HAS_THREADS
+    }
+    void cancelScan()   {
+        if (!scan) return;
+#       ifdef IMGUIFS_HAS_THREADS
+        ImGuiHelper::AtomicStore(&scan->cancelRequested,1);
+        cancelledScans.push_back(scan); // we don't wait for the worker thread here
+#       endif //IMGUIFS_HAS_THREADS
+        scan = NULL;
+    }
+    void releaseCancelledScans(bool waitForThem)  {
+#       ifdef IMGUIFS_HAS_THREADS
+        for (int i=cancelledScans.size()-1;i>=0;--i) {
+            DirectoryScanJob* job = cancelledScans[i];
+            if (!waitForThem && !job->isFinished()) continue;
+            ImGuiHelper::ThreadJoin(job->thread);
+            DirectoryScanJob::Destroy(job);
+            cancelledScans.erase(cancelledScans.begin()+i);
+        }
+#       else //IMGUIFS_HAS_THREADS
+        IM_ASSERT(cancelledScans.size()==0);(void)waitForThem;
+#       endif //IMGUIFS_HAS_THREADS
+    }
+    // Directories don't report their size or their file extensions (so if needed we sort them alphabetically)
+    inline static int GetSortingModeForDirectories(int sortingMode) {
+        return (sortingMode <= (int)SORT_ORDER_LAST_MODIFICATION_INVERSE) ? sortingMode : (sortingMode%2);
+    }
+    // Pushes the 4 button colors starting at "colorSetBackground" (popping the ones pushed before) and returns the text color
+    inline static const ImVec4& SetButtonColors(const ImVec4* colorSet,int colorSetBackground,int& pushedColorSetBackground) {
+        if (pushedColorSetBackground!=colorSetBackground) {
+            if (pushedColorSetBackground>=0) ImGui::PopStyleColor(4);
+            ImGui::PushStyleColor(ImGuiCol_Text,colorSet[colorSetBackground+3]);
+            ImGui::PushStyleColor(ImGuiCol_Button,colorSet[colorSetBackground]);
+            ImGui::PushStyleColor(ImGuiCol_ButtonHovered,colorSet[colorSetBackground+1]);
+            ImGui::PushStyleColor(ImGuiCol_ButtonActive,colorSet[colorSetBackground+2]);
+            pushedColorSetBackground = colorSetBackground;
+        }
+        return colorSet[colorSetBackground+3];
+    }
+
     void resetVariables() {
         strcpy(currentFolder,"./");
         forceRescan = false;
@@ -2006,7 +2228,7 @@ const char* ChooseFileMainMethod(Dialog& ist,const char* directory,const bool _i
         I.editLocationCheckButtonPressed = false;
         I.history.reset(); // reset history
         I.history.switchTo(I.currentFolder);    // init history
-    I.dirs.clear();I.files.clear();I.dirNames.clear();I.fileNames.clear();I.currentSplitPath.clear();I.fileExtensionTypes.clear();
+        I.cancelScan();I.dirs.clear();I.files.clear();I.visibleDirs.clear();I.visibleFiles.clear();I.currentSplitPath.clear();
         strcpy(&I.newDirectoryName[0],"New Folder");
         if (_saveFileName) {
             //strcpy(&I.saveFileName[0],_saveFileName);
@@ -2057,47 +2279,24 @@ const char* ChooseFileMainMethod(Dialog& ist,const char* directory,const bool _i
 
     if (I.forceRescan)    {
         I.forceRescan = false;
+        const int sortingModeForDirectories = Internal::GetSortingModeForDirectories(I.sortingMode);
 #       ifndef IMGUI_USE_MINIZIP
-        const int sortingModeForDirectories = (I.sortingMode <= (int)SORT_ORDER_LAST_MODIFICATION_INVERSE) ? I.sortingMode : (I.sortingMode%2);
-        Directory::GetDirectories(I.currentFolder,I.dirs,&I.dirNames,(Sorting)sortingModeForDirectories);  // this is because directories don't return their size or their file extensions (so if needed we sort them alphabetically)
-
-        if (!isSelectFolderDialog)  {
-            if (!fileFilterExtensionString || strlen(fileFilterExtensionString)==0) Directory::GetFiles(I.currentFolder,I.files,&I.fileNames,(Sorting)I.sortingMode);
-            else                                        Directory::GetFiles(I.currentFolder,I.files,fileFilterExtensionString,NULL,&I.fileNames,(Sorting)I.sortingMode);
-            if (Dialog::DrawFileIconCallback) ImGuiFsDrawIconStruct::Get().fillExtensionTypesFromFilenames(I.fileExtensionTypes,I.fileNames);
-        }
-        else {
-            I.files.clear();I.fileNames.clear();I.fileExtensionTypes.clear();
-            I.saveFileName[0]='\0';
-            char currentFolderName[MAX_FILENAME_BYTES];
-            Path::GetFileName(I.currentFolder,currentFolderName);
-            const size_t currentFolderNameSize = strlen(currentFolderName);
-            if (currentFolderNameSize==0 || currentFolderName[currentFolderNameSize-1]==':') strcat(currentFolderName,"/");
-            strcat(I.saveFileName,currentFolderName);
-        }
+        I.startScan(I.currentFolder,fileFilterExtensionString,!isSelectFolderDialog,sortingModeForDirectories);
 #       else //IMGUI_USE_MINIZIP
-        const int sortingModeForDirectories = (I.sortingMode <= (int)SORT_ORDER_LAST_MODIFICATION_INVERSE) ? I.sortingMode : (I.sortingMode%2);
         char basePath[MAX_PATH_BYTES];basePath[0]='\0';char zipPath[MAX_PATH_BYTES];zipPath[0]='\0';
         const bool isInsideZipFile = PathSplitFirstZipFolder(I.currentFolder,basePath,zipPath);
-        if (!isInsideZipFile) Directory::GetDirectories(basePath,I.dirs,&I.dirNames,(Sorting)sortingModeForDirectories);  // this is because directories don't return their size or their file extensions (so if needed we sort them alphabetically)
+        if (!isInsideZipFile) I.startScan(basePath,fileFilterExtensionString,!isSelectFolderDialog,sortingModeForDirectories);
         else {
-            if (I.unz.load(basePath,false))  I.unz.getDirectories(zipPath,I.dirs,&I.dirNames,(Sorting)sortingModeForDirectories,true);
+            I.cancelScan();
+            I.dirs.clear();I.files.clear();
+            if (I.unz.load(basePath,false))  {
+                I.listZipFolder(zipPath,!isSelectFolderDialog,sortingModeForDirectories);
+            }
             else I.unz.close();
+            I.filterEntries();
         }
-
-        if (!isSelectFolderDialog)  {
-            if (!isInsideZipFile)   {
-                if (!fileFilterExtensionString || strlen(fileFilterExtensionString)==0) Directory::GetFiles(I.currentFolder,I.files,&I.fileNames,(Sorting)I.sortingMode);
-                else                                        Directory::GetFiles(I.currentFolder,I.files,fileFilterExtensionString,NULL,&I.fileNames,(Sorting)I.sortingMode);
-                if (Dialog::DrawFileIconCallback) ImGuiFsDrawIconStruct::Get().fillExtensionTypesFromFilenames(I.fileExtensionTypes,I.fileNames);
-            }
-            else if (I.unz.isValid()) {
-                /*if (!fileFilterExtensionString || strlen(fileFilterExtensionString)==0)*/ I.unz.getFiles(zipPath,I.files,&I.fileNames,(Sorting)I.sortingMode,true);
-                //else                                        I.unz.getFiles(zipPath,I.files,fileFilterExtensionString,NULL,&I.fileNames,(Sorting)I.sortingMode,true);
-            }
-       }
-        else {
-            I.files.clear();I.fileNames.clear();
+#       endif //IMGUI_USE_MINIZIP
+        if (isSelectFolderDialog)   {
             I.saveFileName[0]='\0';
             char currentFolderName[MAX_FILENAME_BYTES];
             Path::GetFileName(I.currentFolder,currentFolderName);
@@ -2105,10 +2304,8 @@ const char* ChooseFileMainMethod(Dialog& ist,const char* directory,const bool _i
             if (currentFolderNameSize==0 || currentFolderName[currentFolderNameSize-1]==':') strcat(currentFolderName,"/");
             strcat(I.saveFileName,currentFolderName);
         }
-#       endif //IMGUI_USE_MINIZIP
 
         I.history.getCurrentSplitPath(I.currentSplitPath);
-        I.totalNumBrowsingEntries = (int)(I.dirs.size()+I.files.size());
 
         //I.calculateBrowsingDataTableSizes();    // can we move it down ?
 
@@ -2118,6 +2315,7 @@ const char* ChooseFileMainMethod(Dialog& ist,const char* directory,const bool _i
         if (I.history.getCurrentFolderInfo()) I.history.getCurrentFolderInfo()->display();
 #       endif //DEBUG_HISTORY
     }
+    I.updateScan();
 
     if (I.rescan) {
         I.rescan = false; // Mandatory
@@ -2507,7 +2705,14 @@ const char* ChooseFileMainMethod(Dialog& ist,const char* directory,const bool _i
             if (newSortingMode!=oldSortingMode) {
                 I.sortingMode = newSortingMode;
                 //printf("sortingMode = %d\n",sortingMode);
-                I.forceRescan = true;
+                if (I.scan) {}  // The listing will be sorted again when the scan ends
+                else if ((I.dirs.hasStatData && I.files.hasStatData) || !SortingNeedsStatData(newSortingMode)) {
+                    // We can just sort the listing we have
+                    I.dirs.sort((Sorting)Internal::GetSortingModeForDirectories(newSortingMode));
+                    I.files.sort((Sorting)newSortingMode);
+                    I.filterEntries();
+                }
+                else I.forceRescan = true;
             }
 
             //-- Browsing per row -----------------------------------
@@ -2522,6 +2727,10 @@ const char* ChooseFileMainMethod(Dialog& ist,const char* directory,const bool _i
                 ImGui::PopStyleColor();
             }
             //-- End browsing per row -------------------------------
+            if (I.scan) {
+                ImGui::SameLine();
+                ImGui::TextDisabled("   Scanning... %d entries",I.dirs.size()+I.files.size());
+            }
         }
     }
     //-----------------------------------------------------------------------------
@@ -2533,103 +2742,68 @@ const char* ChooseFileMainMethod(Dialog& ist,const char* directory,const bool _i
     {
         if (ImGui::BeginChild("BrowsingFrame",ImVec2(0,(isSaveFileDialog || isSelectFolderDialog)?(ImGui::GetContentRegionAvail().y-1.2f*ImGui::GetTextLineHeightWithSpacing()-ImGui::GetStyle().WindowPadding.y):0)))  {
 
+        if (strcmp(I.visibleEntriesFilter,I.filter.InputBuf)!=0) I.filterEntries();
+        const int numVisibleDirs = I.visibleDirs.size();
+        I.totalNumBrowsingEntries = numVisibleDirs + (isSelectFolderDialog ? 0 : I.visibleFiles.size());
         I.calculateBrowsingDataTableSizes(ImGui::GetWindowSize());  // (Actually we could save this call every frame, but it's difficult to detect whn we need it)
 
         // ImGui::SetScrollPosHere();   // possible future ref: while drawing to place the scroll bar making a certain entry visible
-        // Also we don't do any maual clipping here (for long directories using a clipper might be useful)
 
-        ImGui::Columns(I.numBrowsingColumns);
+        // We lay out the entries in a grid and submit only the rows that are visible (folders can contain many thousands of entries)
+        const int numColumns = I.numBrowsingColumns;
+        const int numRows = Internal::BrowsingPerRow ? ((I.totalNumBrowsingEntries+numColumns-1)/numColumns) : I.numBrowsingEntriesPerColumn;
+        ImGui::Columns(numColumns);
 
         static int id;
         ImGui::PushID(&id);
-        int cntEntries = 0;
-        // Directories --------------------------------------------------------------
-        if (I.dirs.size()>0)   {
-            ImGui::PushStyleColor(ImGuiCol_Text,ColorSet[Internal::ImGuiCol_Dialog_Directory_Text]);
-            ImGui::PushStyleColor(ImGuiCol_Button,ColorSet[Internal::ImGuiCol_Dialog_Directory_Background]);
-            ImGui::PushStyleColor(ImGuiCol_ButtonHovered,ColorSet[Internal::ImGuiCol_Dialog_Directory_Hover]);
-            ImGui::PushStyleColor(ImGuiCol_ButtonActive,ColorSet[Internal::ImGuiCol_Dialog_Directory_Pressed]);
-            const ImVec4& iconsColor = ColorSet[Internal::ImGuiCol_Dialog_Directory_Text];
+        int pushedColorSet = -1;
+#       ifdef IMGUI_USE_MINIZIP
+        //const FolderInfo* fi = I.history.getCurrentFolderInfo();
+        const bool acceptZipFilesForBrowsing = !isBrowsingInsideZipFile;//(fi && (fi->splitPathIndexOfZipFile<0 || fi->splitPathIndexOfZipFile>fi->splitPathIndex));
+#       endif //IMGUI_USE_MINIZIP
 
-            for (int i=0,sz=(int)I.dirs.size();i<sz;i++) {
-                const char* dirName = &I.dirNames[i][0];
-                if (I.filter.PassFilter(dirName)) {
+        ImGuiListClipper clipper(I.totalNumBrowsingEntries>0 ? numRows : 0);
+        while (clipper.Step())  {
+        for (int row=clipper.DisplayStart;row<clipper.DisplayEnd;row++) {
+            for (int col=0;col<numColumns;col++)   {
+                const int entry = Internal::BrowsingPerRow ? (row*numColumns+col) : (col*numRows+row);
+                if (entry>=I.totalNumBrowsingEntries) {ImGui::NextColumn();continue;}
+                if (entry<numVisibleDirs)   {
+                    // Directory --------------------------------------------------------------
+                    const int i = I.visibleDirs[entry];
+                    const ImVec4& iconsColor = Internal::SetButtonColors(ColorSet,Internal::ImGuiCol_Dialog_Directory_Background,pushedColorSet);
                     if (Dialog::DrawFolderIconCallback && Dialog::DrawFolderIconCallback(false,&iconsColor)) ImGui::SameLine();
-                    if (ImGui::SmallButton(dirName)) {
-                        strcpy(I.currentFolder,I.dirs[i]);
+                    if (ImGui::SmallButton(I.dirs.getName(i))) {
+                        strcpy(I.currentFolder,I.dirs.getPath(i));
                         strcpy(I.editLocationInputText,I.currentFolder);
                         I.history.switchTo(I.currentFolder);
                         I.forceRescan = true;
                         //------------------------------------------------------------------------------------------------------------------------------
                     }
-                    ++cntEntries;
-                    if (Internal::BrowsingPerRow) ImGui::NextColumn();
-                    else if (cntEntries==I.numBrowsingEntriesPerColumn) {
-                        cntEntries = 0;
-                        ImGui::NextColumn();
-                    }
                 }
-            }
-
-            ImGui::PopStyleColor();
-            ImGui::PopStyleColor();
-            ImGui::PopStyleColor();
-            ImGui::PopStyleColor();
-        }
-        // Files ----------------------------------------------------------------------
-        if (!isSelectFolderDialog && I.files.size()>0)   {
-            ImGui::PushStyleColor(ImGuiCol_Text,ColorSet[Internal::ImGuiCol_Dialog_File_Text]);
-            ImGui::PushStyleColor(ImGuiCol_Button,ColorSet[Internal::ImGuiCol_Dialog_File_Background]);
-            ImGui::PushStyleColor(ImGuiCol_ButtonHovered,ColorSet[Internal::ImGuiCol_Dialog_File_Hover]);
-            ImGui::PushStyleColor(ImGuiCol_ButtonActive,ColorSet[Internal::ImGuiCol_Dialog_File_Pressed]);
-            const ImVec4* pIconsColor = &ColorSet[Internal::ImGuiCol_Dialog_File_Text];
-
-#           ifdef IMGUI_USE_MINIZIP
-            //const FolderInfo* fi = I.history.getCurrentFolderInfo();
-            const bool acceptZipFilesForBrowsing = !isBrowsingInsideZipFile;//(fi && (fi->splitPathIndexOfZipFile<0 || fi->splitPathIndexOfZipFile>fi->splitPathIndex));
-            bool isZipFile = false;bool hasZipExtension = false;
-
-            /* // DEBUG-- TO DELETE --
-            static bool old = true;
-            if (old!=acceptZipFilesForBrowsing) {
-                old = acceptZipFilesForBrowsing;
-                fprintf(stderr,"acceptZipFilesForBrowsing=%s %d %d\n",acceptZipFilesForBrowsing?"true":"false",fi->splitPathIndexOfZipFile,fi->splitPathIndex);
-            }*/        
-#           endif //IMGUI_USE_MINIZIP	    
-
-            for (int i=0,sz=(int)I.files.size();i<sz;i++) {
-                const char* fileName = &I.fileNames[i][0];
-                if (I.filter.PassFilter(fileName)) {
+                else {
+                    // File ----------------------------------------------------------------------
+                    const int i = I.visibleFiles[entry-numVisibleDirs];
+                    const char* fileName = I.files.getName(i);
+                    const char* filePath = I.files.getPath(i);
+                    int colorSet = Internal::ImGuiCol_Dialog_File_Background;
 #                   ifdef IMGUI_USE_MINIZIP
-                    if (acceptZipFilesForBrowsing)  {
-                        hasZipExtension = Path::HasZipExtension(fileName);
-                        if (hasZipExtension && !isZipFile)  {
-                            ImGui::PopStyleColor(4);
-                            ImGui::PushStyleColor(ImGuiCol_Text,ColorSet[Internal::ImGuiCol_Dialog_ZipDirectory_Text]);
-                            ImGui::PushStyleColor(ImGuiCol_Button,ColorSet[Internal::ImGuiCol_Dialog_ZipDirectory_Background]);
-                            ImGui::PushStyleColor(ImGuiCol_ButtonHovered,ColorSet[Internal::ImGuiCol_Dialog_ZipDirectory_Hover]);
-                            ImGui::PushStyleColor(ImGuiCol_ButtonActive,ColorSet[Internal::ImGuiCol_Dialog_ZipDirectory_Pressed]);
-                            pIconsColor = &ColorSet[Internal::ImGuiCol_Dialog_ZipDirectory_Text];
-                        }
-                        else if (!hasZipExtension && isZipFile) {
-                            ImGui::PopStyleColor(4);
-                            ImGui::PushStyleColor(ImGuiCol_Text,ColorSet[Internal::ImGuiCol_Dialog_File_Text]);
-                            ImGui::PushStyleColor(ImGuiCol_Button,ColorSet[Internal::ImGuiCol_Dialog_File_Background]);
-                            ImGui::PushStyleColor(ImGuiCol_ButtonHovered,ColorSet[Internal::ImGuiCol_Dialog_File_Hover]);
-                            ImGui::PushStyleColor(ImGuiCol_ButtonActive,ColorSet[Internal::ImGuiCol_Dialog_File_Pressed]);
-                            pIconsColor = &ColorSet[Internal::ImGuiCol_Dialog_File_Text];
-                        }
-                        isZipFile = hasZipExtension;
-                    }
+                    const bool isZipFile = acceptZipFilesForBrowsing && Path::HasZipExtension(fileName);
+                    if (isZipFile) colorSet = Internal::ImGuiCol_Dialog_ZipDirectory_Background;
 #                   endif //IMGUI_USE_MINIZIP
-                    if (Dialog::DrawFileIconCallback && Dialog::DrawFileIconCallback(I.fileExtensionTypes[i],pIconsColor)) ImGui::SameLine();
+                    const ImVec4& iconsColor = Internal::SetButtonColors(ColorSet,colorSet,pushedColorSet);
+                    if (Dialog::DrawFileIconCallback)   {
+                        int& extensionType = I.files.entries[i].extensionType;
+                        if (extensionType==-2) extensionType = ImGuiFsDrawIconStruct::Get().getExtensionType(strrchr(fileName,'.'));
+                        if (Dialog::DrawFileIconCallback(extensionType,&iconsColor)) ImGui::SameLine();
+                    }
                     if (ImGui::SmallButton(fileName)) {
                         if (!isSaveFileDialog)  {
-                            strcpy(rv,I.files[i]);
+                            strcpy(rv,filePath);
                             I.open = true;
                         }
                         else {
-                            Path::GetFileName(I.files[i],I.saveFileName);
+                            Path::GetFileName(filePath,I.saveFileName);
                         }
                     }
 #                   if (defined(__EMSCRIPTEN__) && defined(EMSCRIPTEN_SAVE_SHELL))
@@ -2639,7 +2813,7 @@ const char* ChooseFileMainMethod(Dialog& ist,const char* directory,const bool _i
                             ImGui::SetTooltip("%s","right click to download this file locally");
                             if (ImGui::GetIO().MouseClicked[1]) {
                                 strcpy(tmpString,"saveFileFromMemoryFSToDisk('");
-                                strcat(tmpString,I.files[i]);strcat(tmpString,"','");
+                                strcat(tmpString,filePath);strcat(tmpString,"','");
                                 strcat(tmpString,fileName);strcat(tmpString,"')");
 
                                 emscripten_run_script(tmpString);
@@ -2651,7 +2825,7 @@ const char* ChooseFileMainMethod(Dialog& ist,const char* directory,const bool _i
                                 ImGui::SetTooltip("%s","right click to download this file locally");
                                 if (ImGui::GetIO().MouseClicked[1]) {
                                     strcpy(tmpString,"saveFileFromMemoryFSToDisk('");
-                                    strcat(tmpString,I.files[i]);strcat(tmpString,"','");
+                                    strcat(tmpString,filePath);strcat(tmpString,"','");
                                     strcat(tmpString,fileName);strcat(tmpString,"')");
 
                                     emscripten_run_script(tmpString);
@@ -2660,7 +2834,7 @@ const char* ChooseFileMainMethod(Dialog& ist,const char* directory,const bool _i
                             else if (isZipFile)  {
                                 ImGui::SetTooltip("right click to browse it");
                                 if (ImGui::GetIO().MouseClicked[1])  {
-                                    strcpy(I.currentFolder,I.files[i]);
+                                    strcpy(I.currentFolder,filePath);
                                     strcpy(I.editLocationInputText,I.currentFolder);
                                     I.history.switchTo(I.currentFolder);
                                     I.forceRescan = true;
@@ -2670,10 +2844,10 @@ const char* ChooseFileMainMethod(Dialog& ist,const char* directory,const bool _i
                         }
 #                       endif // IMGUI_USE_MINIZIP
 #                   elif IMGUI_USE_MINIZIP // (defined(__EMSCRIPTEN__) && defined(EMSCRIPTEN_SAVE_SHELL))
-                    if (isZipFile)  {
-                        if (ImGui::IsItemHovered()) ImGui::SetTooltip("right click to browse it");
+                    if (isZipFile && ImGui::IsItemHovered())  {
+                        ImGui::SetTooltip("right click to browse it");
                         if (ImGui::GetIO().MouseClicked[1])  {
-                            strcpy(I.currentFolder,I.files[i]);
+                            strcpy(I.currentFolder,filePath);
                             strcpy(I.editLocationInputText,I.currentFolder);
                             I.history.switchTo(I.currentFolder);
                             I.forceRescan = true;
@@ -2681,20 +2855,12 @@ const char* ChooseFileMainMethod(Dialog& ist,const char* directory,const bool _i
                         }
                     }
 #                   endif //(defined(__EMSCRIPTEN__) && defined(EMSCRIPTEN_SAVE_SHELL))
-                    ++cntEntries;
-                    if (Internal::BrowsingPerRow) ImGui::NextColumn();
-                    else if (cntEntries==I.numBrowsingEntriesPerColumn) {
-                        cntEntries = 0;
-                        ImGui::NextColumn();
-                    }
                 }
+                ImGui::NextColumn();
             }
-
-            ImGui::PopStyleColor();
-            ImGui::PopStyleColor();
-            ImGui::PopStyleColor();
-            ImGui::PopStyleColor();
         }
+        }
+        if (pushedColorSet>=0) ImGui::PopStyleColor(4);
         //-----------------------------------------------------------------------------
         ImGui::PopID();
         }   // ImGui::BeginChild(...)
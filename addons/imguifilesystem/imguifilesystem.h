@@ -211,6 +211,8 @@ extern void FileGetExtensionTypesFromFilenames(ImVector<int>& fileExtensionTypes
 extern bool FileDownload(const char* path,const char* optionalSaveFileName);
 #endif // (defined(__EMSCRIPTEN__) && defined(EMSCRIPTEN_SAVE_SHELL))
 #ifdef IMGUI_USE_MINIZIP
+// The central directory is indexed once in load(), so that the lookups and the directory listings below don't scan the whole zip file.
+// After load() all the const methods can be called concurrently (from different threads).
 class UnZipFile {
 public:
 UnZipFile(const char* zipFilePath=NULL);
@@ -225,12 +227,15 @@ bool getFiles(const char* directoryName,PathStringVector& result,FilenameStringV
 unsigned int getFileSize(const char* filePath) const;
 bool getFileContent(const char* filePath,ImVector<unsigned char>& bufferOut,const char* password=NULL) const;
 bool getFileContent(const char* filePath,ImVector<char>& bufferOut,const char* password=NULL) const;
+// Extracts many files at once (in parallel when imguihelper's threads are available). "buffersOut" must have "numFiles" items. Returns the number of files extracted.
+int getFileContents(const char* const* filePaths,int numFiles,ImVector<unsigned char>* buffersOut,const char* password=NULL) const;
 bool exists(const char* pathInsideZip, bool reportOnlyFiles=false, bool reportOnlyDirectories=false) const;
 bool fileExists(const char* pathInsideZip) const;
 bool directoryExists(const char* pathInsideZip) const;
 ~UnZipFile();
 protected:
 struct UnZipFileImpl* im;
+friend struct Internal; // The Dialog reads the index directly
 };
 
 // eg: path="C://MyDocuments/myzipfile.zip/myzipFile/something" -> rv1="C://MyDocuments/myzipfile.zip", rv2="myzipFile/something"
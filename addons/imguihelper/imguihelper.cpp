@@ -580,16 +580,79 @@ void PutInForeground(const char* optionalRootWindowName)  {
 
 #ifndef NO_IMGUIHELPER_SERIALIZATION
 #include <stdio.h>  // FILE
+#if (!defined(NO_IMGUIHELPER_SERIALIZATION_LOAD) && !defined(NO_IMGUIHELPER_SERIALIZATION_MMAP))
+#   ifdef _WIN32
+#       include <windows.h>    // CreateFileMapping(...)
+#   else //_WIN32
+#       include <sys/mman.h>   // mmap(...)
+#       include <sys/stat.h>   // fstat(...)
+#       include <fcntl.h>      // open(...)
+#   endif //_WIN32
+#endif //NO_IMGUIHELPER_SERIALIZATION_MMAP
 namespace ImGuiHelper   {
 
 static const char* FieldTypeNames[ImGui::FT_COUNT+1] = {"INT","UNSIGNED","FLOAT","DOUBLE","STRING","ENUM","BOOL","COLOR","TEXTLINE","CUSTOM","COUNT"};
-static const char* FieldTypeFormats[ImGui::FT_COUNT]={"%d","%u","%f","%f","%s","%d","%d","%f","%s","%s"};
 static const char* FieldTypeFormatsWithCustomPrecision[ImGui::FT_COUNT]={"%.*d","%*u","%.*f","%.*f","%*s","%*d","%*d","%.*f","%*s","%*s"};
 
 #ifndef NO_IMGUIHELPER_SERIALIZATION_LOAD
 void Deserializer::clear() {
-    if (f_data) ImGui::MemFree(f_data);
-    f_data = NULL;f_size=0;
+    if (f_data) {
+#       ifndef NO_IMGUIHELPER_SERIALIZATION_MMAP
+        if (f_mapped)   {
+#           ifdef _WIN32
+            UnmapViewOfFile(f_data);
+#           else //_WIN32
+            munmap(f_data,f_size);
+#           endif //_WIN32
+        }
+        else
+#       endif //NO_IMGUIHELPER_SERIALIZATION_MMAP
+        ImGui::MemFree(f_data);
+    }
+    f_data = NULL;f_size=0;f_mapped=false;
+}
+// Maps the whole file in memory (read-only): parse(...) reads it in place, without copying it
+bool Deserializer::mapFile(const char *filename) {
+    clear();
+#   ifndef NO_IMGUIHELPER_SERIALIZATION_MMAP
+    if (!filename) return false;
+#   ifdef _WIN32
+#       if (!defined(__CYGWIN__) && !defined(__GNUC__))
+    // UTF-8 filename, like ImFileOpen(...)
+    const int filename_wsize = ImTextCountCharsFromUtf8(filename, NULL) + 1;
+    ImVector<ImWchar> buf;buf.resize(filename_wsize);
+    ImTextStrFromUtf8(&buf[0], filename_wsize, filename, NULL);
+    HANDLE file = CreateFileW((const wchar_t*)&buf[0],GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,NULL);
+#       else
+    HANDLE file = CreateFileA(filename,GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,NULL);
+#       endif
+    if (file==INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file,&size) || size.QuadPart<=0 || size.HighPart!=0 || size.LowPart>0x7FFFFFFF) {CloseHandle(file);return false;}
+    HANDLE mapping = CreateFileMappingA(file,NULL,PAGE_READONLY,0,0,NULL);
+    CloseHandle(file);
+    if (!mapping) return false;
+    f_data = (char*) MapViewOfFile(mapping,FILE_MAP_READ,0,0,0);
+    CloseHandle(mapping);   // The view keeps the mapping alive
+    if (!f_data) return false;
+    f_size = (size_t) size.LowPart;
+#   else //_WIN32
+    const int fd = open(filename,O_RDONLY);
+    if (fd<0) return false;
+    struct stat st;
+    if (fstat(fd,&st)!=0 || !S_ISREG(st.st_mode) || st.st_size<=0 || st.st_size>0x7FFFFFFF) {close(fd);return false;}
+    void* data = mmap(NULL,(size_t)st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+    close(fd);  // The mapping keeps the file alive
+    if (data==MAP_FAILED) return false;
+    f_data = (char*) data;
+    f_size = (size_t) st.st_size;
+#   endif //_WIN32
+    f_mapped = true;
+    return true;
+#   else //NO_IMGUIHELPER_SERIALIZATION_MMAP
+    (void)filename;
+    return false;
+#   endif //NO_IMGUIHELPER_SERIALIZATION_MMAP
 }
 bool Deserializer::loadFromFile(const char *filename) {
     clear();
@@ -630,23 +693,135 @@ bool Deserializer::allocate(size_t sizeToAllocate, const char *optionalTextToCop
     if (optionalTextToCopy && optionalTextToCopySize>0) memcpy(f_data,optionalTextToCopy,optionalTextToCopySize>f_size ? f_size:optionalTextToCopySize);
     return true;
 }
-Deserializer::Deserializer(const char *filename) : f_data(NULL),f_size(0) {
-    if (filename) loadFromFile(filename);
+Deserializer::Deserializer(const char *filename) : f_data(NULL),f_size(0),f_mapped(false) {
+    if (filename && !mapFile(filename)) loadFromFile(filename);
 }
-Deserializer::Deserializer(const char *text, size_t textSizeInBytes) : f_data(NULL),f_size(0) {
+Deserializer::Deserializer(const char *text, size_t textSizeInBytes) : f_data(NULL),f_size(0),f_mapped(false) {
     allocate(textSizeInBytes,text,textSizeInBytes);
 }
 
+// Numeric values are parsed by hand: sscanf(...) would call strlen(...) on the whole rest of the buffer for every field (and a mapped file has no '\0' at its end).
+// These functions never read past 'end'. Like sscanf(...) they skip whitespace (newlines included) before each value.
+// Uncommon inputs (too many digits, huge exponents, "inf", hex floats...) are copied into a '\0' terminated buffer and still go through sscanf(...).
+static inline bool IsSpaceChar(char c) {return c==' ' || (c>='\t' && c<='\r');}
+static inline bool IsDigitChar(char c) {return c>='0' && c<='9';}
+static bool ParseValueWithScanf(const char*& p,const char* end,const char* format,void* pValue) {
+    int len = 0;
+    while (p+len<end && !IsSpaceChar(p[len])) ++len;
+    char smallToken[64];ImVector<char> bigToken;    // long tokens (e.g. doubles written with "%f") must not be truncated
+    char* token = smallToken;
+    if (len>=(int)sizeof(smallToken)) {bigToken.resize(len+1);token = &bigToken[0];}
+    memcpy(token,p,len);token[len]='\0';
+    int numChars = 0;
+    if (sscanf(token,format,pValue,&numChars)!=1) return false;
+    p+=numChars;
+    return true;
+}
+// Reads [+-]digits when the digits fit 32 bits. Returns false otherwise (and the slow path must be used).
+static inline bool ParseInteger(const char*& p,const char* end,bool& negative,unsigned int& value) {
+    const char* s = p;negative = false;value = 0;
+    if (s<end && (*s=='-' || *s=='+')) {negative = (*s=='-');++s;}
+    const char* digits = s;
+    for (;s<end && IsDigitChar(*s);++s) {
+        const unsigned int d = (unsigned int)(*s-'0');
+        if (value > (0xFFFFFFFFu-d)/10u) return false;
+        value = value*10u + d;
+    }
+    if (s==digits) return false;
+    p = s;
+    return true;
+}
+static bool ParseValue(const char*& p,const char* end,int& v) {
+    while (p<end && IsSpaceChar(*p)) ++p;
+    const char* s = p;bool negative;unsigned int u;
+    if (!ParseInteger(s,end,negative,u) || u > (negative ? 0x80000000u : 0x7FFFFFFFu)) return ParseValueWithScanf(p,end,"%d%n",&v);
+    v = negative ? (int)(0u-u) : (int)u;p = s;
+    return true;
+}
+static bool ParseValue(const char*& p,const char* end,unsigned& v) {
+    while (p<end && IsSpaceChar(*p)) ++p;
+    const char* s = p;bool negative;unsigned int u;
+    if (!ParseInteger(s,end,negative,u)) return ParseValueWithScanf(p,end,"%u%n",&v);
+    v = negative ? 0u-u : u;p = s;  // Like "%u"
+    return true;
+}
+// Reads [+-]digits[.digits][(e|E)[+-]digits] as mantissa*10^exponent10, with up to 15 significant digits in the mantissa (so that it's an exact double)
+static bool ParseSimpleReal(const char*& p,const char* end,bool& negative,double& mantissa,int& exponent10) {
+    const char* s = p;negative = false;mantissa = 0;exponent10 = 0;
+    if (s<end && (*s=='-' || *s=='+')) {negative = (*s=='-');++s;}
+    int numDigits = 0,numSignificantDigits = 0,numPendingZeros = 0;    // Zeros after the significant digits are added only if other digits follow (e.g. "0.500000")
+    for (bool fractionalPart = false;s<end;++s) {
+        if (IsDigitChar(*s)) {
+            ++numDigits;
+            if (fractionalPart) --exponent10;
+            if (*s=='0') {if (mantissa!=0) ++numPendingZeros;continue;}
+            numSignificantDigits+=numPendingZeros+1;
+            if (numSignificantDigits>15) return false;
+            for (;numPendingZeros>0;--numPendingZeros) mantissa*=10.0;
+            mantissa = mantissa*10.0 + (double)(*s-'0');
+        }
+        else if (*s=='.' && !fractionalPart) fractionalPart = true;
+        else break;
+    }
+    if (numDigits==0) return false;
+    exponent10+=numPendingZeros;
+    if (s<end && (*s=='e' || *s=='E')) {
+        ++s;bool negativeExp = false;
+        if (s<end && (*s=='-' || *s=='+')) {negativeExp = (*s=='-');++s;}
+        if (s==end || !IsDigitChar(*s)) return false;
+        int e = 0;
+        while (s<end && IsDigitChar(*s)) {if (e<10000) e = e*10 + (*s-'0');++s;}
+        exponent10+= negativeExp ? -e : e;
+    }
+    if (s<end && (*s=='.' || (*s>='a' && *s<='z') || (*s>='A' && *s<='Z'))) return false;  // e.g. "0x1p3"
+    p = s;
+    return true;
+}
+static const double powersOf10Double[23] = {1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22};
+static bool ParseValue(const char*& p,const char* end,float& v) {
+    static const float powersOf10[11] = {1e0f,1e1f,1e2f,1e3f,1e4f,1e5f,1e6f,1e7f,1e8f,1e9f,1e10f};
+    while (p<end && IsSpaceChar(*p)) ++p;
+    const char* s = p;bool negative;double mantissa;int exponent10;
+    if (!ParseSimpleReal(s,end,negative,mantissa,exponent10) || exponent10<-22 || exponent10>22) return ParseValueWithScanf(p,end,"%f%n",&v);
+    float f;
+    if (mantissa<=16777216.0 && exponent10>=-10 && exponent10<=10) {
+        // Exactly rounded: the mantissa and the power of 10 are both exact floats (a single float operation)
+        f = (float) mantissa;
+        f = exponent10<0 ? f/powersOf10[-exponent10] : f*powersOf10[exponent10];
+    }
+    else {
+        // Exactly rounded double, then float: this rounds twice, that can only go wrong when the double is (almost) halfway between two floats
+        double d = mantissa;
+        d = exponent10<0 ? d/powersOf10Double[-exponent10] : d*powersOf10Double[exponent10];
+        if (d!=0 && (d<1.2e-38 || d>3.4e38 || (float)(d*(1.0+1e-12))!=(float)(d*(1.0-1e-12)))) return ParseValueWithScanf(p,end,"%f%n",&v);
+        f = (float) d;
+    }
+    v = negative ? -f : f;p = s;
+    return true;
+}
+static bool ParseValue(const char*& p,const char* end,double& v) {
+    while (p<end && IsSpaceChar(*p)) ++p;
+    const char* s = p;bool negative;double d;int exponent10;
+    if (!ParseSimpleReal(s,end,negative,d,exponent10) || exponent10<-22 || exponent10>22) return ParseValueWithScanf(p,end,"%lf%n",&v);
+    d = exponent10<0 ? d/powersOf10Double[-exponent10] : d*powersOf10Double[exponent10];
+    v = negative ? -d : d;p = s;
+    return true;
+}
+template <typename T> static bool ParseValues(const char* p,const char* end,T* values,int numValues) {
+    for (int i=0;i<numValues;i++) {if (!ParseValue(p,end,values[i])) return false;}
+    return true;
+}
+
 const char* Deserializer::parse(Deserializer::ParseCallback cb, void *userPtr, const char *optionalBufferStart) const {
     if (!cb || !f_data || f_size==0) return NULL;
     //------------------------------------------------
     // Parse file in memory
     char name[128];name[0]='\0';
-    char typeName[32];char format[32]="";bool quitParsing = false;
+    char typeName[32];bool quitParsing = false;
     char charBuffer[sizeof(double)*10];void* voidBuffer = (void*) &charBuffer[0];
     static char textBuffer[2050];
     const char* varName = NULL;int numArrayElements = 0;FieldType ft = ImGui::FT_COUNT;
-    const char* buf_end = f_data + f_size-1;
+    const char* buf_end = f_data + (f_mapped ? f_size : f_size-1);   // Buffers (but not mapped files) end with a '\0' (or another char that must be skipped)
     for (const char* line_start = optionalBufferStart ? optionalBufferStart : f_data; line_start < buf_end; )
     {
         const char* line_end = line_start;
@@ -654,12 +829,13 @@ const char* Deserializer::parse(Deserializer::ParseCallback cb, void *userPtr, c
 
         if (name[0]=='\0' && line_start[0] == '[' && line_end > line_start && line_end[-1] == ']')
         {
-            ImFormatString(name, IM_ARRAYSIZE(name), "%.*s", (int)(line_end-line_start-2), line_start+1);
+            int nameLen = (int)(line_end-line_start-2);if (nameLen>IM_ARRAYSIZE(name)-1) nameLen = IM_ARRAYSIZE(name)-1;
+            memcpy(name,line_start+1,nameLen);name[nameLen]='\0';
             //fprintf(stderr,"name: %s\n",name);  // dbg
 
             // Here we have something like: FLOAT-4:VariableName
             // We have to split into FLOAT 4 VariableName
-            varName = NULL;numArrayElements = 0;ft = ImGui::FT_COUNT;format[0]='\0';
+            varName = NULL;numArrayElements = 0;ft = ImGui::FT_COUNT;
             const char* colonCh = strchr(name,':');
             const char* minusCh = strchr(name,'-');
             if (!colonCh) {
@@ -704,12 +880,14 @@ const char* Deserializer::parse(Deserializer::ParseCallback cb, void *userPtr, c
                             }
                             //Process soon here, as the string can be multiline
                             line_start = ++line_end;
+                            if (line_start < buf_end && line_start[-1]=='\r' && line_start[0]=='\n') line_start = ++line_end;  // "\r\n"
                             //--------------------------------------------------------
                             int cnt = 0;
                             while (line_end < buf_end && cnt++ < numArrayElements-1) ++line_end;
                             textBuffer[0]=textBuffer[2049]='\0';
-                            const int maxLen = numArrayElements>0 ? (cnt>2049?2049:cnt) : 0;
-                            strncpy(textBuffer,line_start,maxLen+1);
+                            int maxLen = numArrayElements>0 ? (cnt>2049?2049:cnt) : 0;
+                            if (maxLen > buf_end-line_start) maxLen = buf_end > line_start ? (int)(buf_end-line_start) : 0;
+                            memcpy(textBuffer,line_start,maxLen);
                             textBuffer[maxLen]='\0';
                             quitParsing = cb(ft,numArrayElements,(void*)textBuffer,varName,userPtr);
                             //fprintf(stderr,"Deserializer::parse(...) value:\"%s\" to type:%d numArrayElements:%d varName:%s maxLen:%d\n",textBuffer,(int)ft,numArrayElements,varName,maxLen);  // dbg
@@ -720,15 +898,6 @@ const char* Deserializer::parse(Deserializer::ParseCallback cb, void *userPtr, c
                             ft = ImGui::FT_COUNT;name[0]='\0';varName=NULL; // mandatory                            
 
                         }
-                        else if (!isTextOrCustomType) {
-                            format[0]='\0';
-                            for (int t=0;t<numArrayElements;t++) {
-                                if (t>0) strcat(format," ");
-                                strcat(format,FieldTypeFormats[ft]);
-                            }
-                            // DBG:
-                            //fprintf(stderr,"Deserializer::parse(...) DBG: line:%s type:%d numArrayElements:%d varName:%s format:%s\n",name,(int)ft,numArrayElements,varName,format);  // dbg
-                        }
                     }
                 }
             }
@@ -739,59 +908,40 @@ const char* Deserializer::parse(Deserializer::ParseCallback cb, void *userPtr, c
             case ImGui::FT_FLOAT:
             case ImGui::FT_COLOR:
             {
-                float* p = (float*) voidBuffer;
-                if ( (numArrayElements==1 && sscanf(line_start, format, p)==numArrayElements) ||
-                     (numArrayElements==2 && sscanf(line_start, format, &p[0],&p[1])==numArrayElements) ||
-                     (numArrayElements==3 && sscanf(line_start, format, &p[0],&p[1],&p[2])==numArrayElements) ||
-                     (numArrayElements==4 && sscanf(line_start, format, &p[0],&p[1],&p[2],&p[3])==numArrayElements))
+                if (ParseValues(line_start,buf_end,(float*) voidBuffer,numArrayElements))
                      quitParsing = cb(ft,numArrayElements,voidBuffer,varName,userPtr);
-                else fprintf(stderr,"Deserializer::parse(...) Error converting value:\"%s\" to type:%d numArrayElements:%d varName:%s\n",line_start,(int)ft,numArrayElements,varName);  // dbg
+                else fprintf(stderr,"Deserializer::parse(...) Error converting value:\"%.*s\" to type:%d numArrayElements:%d varName:%s\n",(int)(line_end-line_start),line_start,(int)ft,numArrayElements,varName);  // dbg
             }
             break;
             case ImGui::FT_DOUBLE:  {
-                double* p = (double*) voidBuffer;
-                if ( (numArrayElements==1 && sscanf(line_start, format, p)==numArrayElements) ||
-                     (numArrayElements==2 && sscanf(line_start, format, &p[0],&p[1])==numArrayElements) ||
-                     (numArrayElements==3 && sscanf(line_start, format, &p[0],&p[1],&p[2])==numArrayElements) ||
-                     (numArrayElements==4 && sscanf(line_start, format, &p[0],&p[1],&p[2],&p[3])==numArrayElements))
+                if (ParseValues(line_start,buf_end,(double*) voidBuffer,numArrayElements))
                      quitParsing = cb(ft,numArrayElements,voidBuffer,varName,userPtr);
-                else fprintf(stderr,"Deserializer::parse(...) Error converting value:\"%s\" to type:%d numArrayElements:%d varName:%s\n",line_start,(int)ft,numArrayElements,varName);  // dbg
+                else fprintf(stderr,"Deserializer::parse(...) Error converting value:\"%.*s\" to type:%d numArrayElements:%d varName:%s\n",(int)(line_end-line_start),line_start,(int)ft,numArrayElements,varName);  // dbg
             }
             break;
             case ImGui::FT_INT:
             case ImGui::FT_ENUM:
             {
-                int* p = (int*) voidBuffer;
-                if ( (numArrayElements==1 && sscanf(line_start, format, p)==numArrayElements) ||
-                     (numArrayElements==2 && sscanf(line_start, format, &p[0],&p[1])==numArrayElements) ||
-                     (numArrayElements==3 && sscanf(line_start, format, &p[0],&p[1],&p[2])==numArrayElements) ||
-                     (numArrayElements==4 && sscanf(line_start, format, &p[0],&p[1],&p[2],&p[3])==numArrayElements))
+                if (ParseValues(line_start,buf_end,(int*) voidBuffer,numArrayElements))
                      quitParsing = cb(ft,numArrayElements,voidBuffer,varName,userPtr);
-                else fprintf(stderr,"Deserializer::parse(...) Error converting value:\"%s\" to type:%d numArrayElements:%d varName:%s\n",line_start,(int)ft,numArrayElements,varName);  // dbg
+                else fprintf(stderr,"Deserializer::parse(...) Error converting value:\"%.*s\" to type:%d numArrayElements:%d varName:%s\n",(int)(line_end-line_start),line_start,(int)ft,numArrayElements,varName);  // dbg
             }
             break;
             case ImGui::FT_BOOL:
             {
                 bool* p = (bool*) voidBuffer;
                 int tmp[4];
-                if ( (numArrayElements==1 && sscanf(line_start, format, &tmp[0])==numArrayElements) ||
-                     (numArrayElements==2 && sscanf(line_start, format, &tmp[0],&tmp[1])==numArrayElements) ||
-                     (numArrayElements==3 && sscanf(line_start, format, &tmp[0],&tmp[1],&tmp[2])==numArrayElements) ||
-                     (numArrayElements==4 && sscanf(line_start, format, &tmp[0],&tmp[1],&tmp[2],&tmp[3])==numArrayElements))    {
+                if (ParseValues(line_start,buf_end,tmp,numArrayElements))    {
                      for (int i=0;i<numArrayElements;i++) p[i] = tmp[i];
-                     quitParsing = cb(ft,numArrayElements,voidBuffer,varName,userPtr);quitParsing = cb(ft,numArrayElements,voidBuffer,varName,userPtr);
+                     quitParsing = cb(ft,numArrayElements,voidBuffer,varName,userPtr);
                 }
-                else fprintf(stderr,"Deserializer::parse(...) Error converting value:\"%s\" to type:%d numArrayElements:%d varName:%s\n",line_start,(int)ft,numArrayElements,varName);  // dbg
+                else fprintf(stderr,"Deserializer::parse(...) Error converting value:\"%.*s\" to type:%d numArrayElements:%d varName:%s\n",(int)(line_end-line_start),line_start,(int)ft,numArrayElements,varName);  // dbg
             }
             break;
             case ImGui::FT_UNSIGNED:  {
-                unsigned* p = (unsigned*) voidBuffer;
-                if ( (numArrayElements==1 && sscanf(line_start, format, p)==numArrayElements) ||
-                     (numArrayElements==2 && sscanf(line_start, format, &p[0],&p[1])==numArrayElements) ||
-                     (numArrayElements==3 && sscanf(line_start, format, &p[0],&p[1],&p[2])==numArrayElements) ||
-                     (numArrayElements==4 && sscanf(line_start, format, &p[0],&p[1],&p[2],&p[3])==numArrayElements))
+                if (ParseValues(line_start,buf_end,(unsigned*) voidBuffer,numArrayElements))
                      quitParsing = cb(ft,numArrayElements,voidBuffer,varName,userPtr);
-                else fprintf(stderr,"Deserializer::parse(...) Error converting value:\"%s\" to type:%d numArrayElements:%d varName:%s\n",line_start,(int)ft,numArrayElements,varName);  // dbg
+                else fprintf(stderr,"Deserializer::parse(...) Error converting value:\"%.*s\" to type:%d numArrayElements:%d varName:%s\n",(int)(line_end-line_start),line_start,(int)ft,numArrayElements,varName);  // dbg
             }
             break;
             case ImGui::FT_CUSTOM:
@@ -802,13 +952,14 @@ const char* Deserializer::parse(Deserializer::ParseCallback cb, void *userPtr, c
                     textBuffer[0]=textBuffer[2049]='\0';
                     const int maxLen = (line_end-line_start)>2049?2049:(line_end-line_start);
                     if (maxLen<=0) break;
-                    strncpy(textBuffer,line_start,maxLen+1);textBuffer[maxLen]='\0';
+                    memcpy(textBuffer,line_start,maxLen);textBuffer[maxLen]='\0';
                     quitParsing = cb(ft,i,(void*)textBuffer,varName,userPtr);
 
                     //fprintf(stderr,"%d) \"%s\"\n",i,textBuffer);  // Dbg
 
                     if (quitParsing) break;
                     line_start = line_end+1;
+                    if (line_start < buf_end && line_end[0]=='\r' && line_start[0]=='\n') ++line_start;   // "\r\n"
                     line_end = line_start;
                     if (line_end == buf_end) break;
                     while (line_end < buf_end && *line_end != '\n' && *line_end != '\r') line_end++;
@@ -816,7 +967,7 @@ const char* Deserializer::parse(Deserializer::ParseCallback cb, void *userPtr, c
             }
             break;
             default:
-            fprintf(stderr,"Deserializer::parse(...) Warning missing value type:\"%s\" to type:%d numArrayElements:%d varName:%s\n",line_start,(int)ft,numArrayElements,varName);  // dbg
+            fprintf(stderr,"Deserializer::parse(...) Warning missing value type:\"%.*s\" to type:%d numArrayElements:%d varName:%s\n",(int)(line_end-line_start),line_start,(int)ft,numArrayElements,varName);  // dbg
             break;
             }
             //---------------------------------------------------------------------------------
@@ -824,6 +975,7 @@ const char* Deserializer::parse(Deserializer::ParseCallback cb, void *userPtr, c
         }
 
         line_start = line_end+1;
+        if (line_start < buf_end && line_end[0]=='\r' && line_start[0]=='\n') ++line_start;   // "\r\n"
 
         if (quitParsing) return line_start;
     }
@@ -1142,6 +1294,564 @@ int StringAppend(ImVector<char>& v,const char* fmt, ...) {
 } //namespace ImGuiHelper
 #endif //NO_IMGUIHELPER_SERIALIZATION
 
+#ifdef IMGUIHELPER_HAS_THREADS
+#ifdef _WIN32
+#include <windows.h>
+#else //_WIN32
+#include <pthread.h>
+#include <sys/time.h>   // gettimeofday
+#include <errno.h>      // ETIMEDOUT
+#endif //_WIN32
+namespace ImGuiHelper   {
+
+#ifdef _WIN32
+struct ThreadHandleData {
+    HANDLE thread;
+    ThreadFunction fn;
+    void* userPtr;
+};
+static DWORD WINAPI ThreadHandleDataRun(LPVOID p) {
+    ThreadHandleData* t = (ThreadHandleData*) p;
+    t->fn(t->userPtr);
+    return 0;
+}
+ThreadHandle ThreadCreate(ThreadFunction threadFunction,void* userPtr)  {
+    if (!threadFunction) return NULL;
+    ThreadHandleData* t = (ThreadHandleData*) ImGui::MemAlloc(sizeof(ThreadHandleData));
+    t->fn = threadFunction;t->userPtr = userPtr;
+    t->thread = ::CreateThread(NULL,0,ThreadHandleDataRun,t,0,NULL);
+    if (!t->thread) {ImGui::MemFree(t);return NULL;}
+    return t;
+}
+void ThreadJoin(ThreadHandle thread)    {
+    if (!thread) return;
+    WaitForSingleObject(thread->thread,INFINITE);
+    CloseHandle(thread->thread);
+    ImGui::MemFree(thread);
+}
+void ThreadSleep(int milliseconds)  {Sleep(milliseconds);}
+double GetTimeInMilliseconds()  {
+    static LARGE_INTEGER frequency = {0};
+    if (frequency.QuadPart==0) QueryPerformanceFrequency(&frequency);
+    LARGE_INTEGER counter;QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart*1000.0/(double)frequency.QuadPart;
+}
+int GetNumHardwareThreads() {
+    SYSTEM_INFO si;GetSystemInfo(&si);
+    return si.dwNumberOfProcessors>0 ? (int)si.dwNumberOfProcessors : 1;
+}
+
+int AtomicAdd(volatile int* pValue,int amount)  {return (int)InterlockedExchangeAdd((volatile LONG*)pValue,(LONG)amount)+amount;}
+int AtomicLoad(volatile int* pValue)    {return (int)InterlockedCompareExchange((volatile LONG*)pValue,0,0);}
+void AtomicStore(volatile int* pValue,int value)    {InterlockedExchange((volatile LONG*)pValue,(LONG)value);}
+bool AtomicCompareAndSwap(volatile int* pValue,int expectedValue,int newValue)  {return InterlockedCompareExchange((volatile LONG*)pValue,(LONG)newValue,(LONG)expectedValue)==(LONG)expectedValue;}
+
+Mutex::Mutex()  {
+    m = ImGui::MemAlloc(sizeof(CRITICAL_SECTION));
+    InitializeCriticalSection((CRITICAL_SECTION*)m);
+}
+Mutex::~Mutex() {
+    DeleteCriticalSection((CRITICAL_SECTION*)m);
+    ImGui::MemFree(m);m=NULL;
+}
+void Mutex::lock()  {EnterCriticalSection((CRITICAL_SECTION*)m);}
+void Mutex::unlock()    {LeaveCriticalSection((CRITICAL_SECTION*)m);}
+
+Event::Event()  {e = (void*) CreateEventA(NULL,FALSE,FALSE,NULL);}
+Event::~Event() {if (e) CloseHandle((HANDLE)e);e=NULL;}
+void Event::signal()    {SetEvent((HANDLE)e);}
+bool Event::wait(int timeoutInMs)   {return WaitForSingleObject((HANDLE)e,timeoutInMs<0 ? INFINITE : (DWORD)timeoutInMs)==WAIT_OBJECT_0;}
+#else //_WIN32
+struct ThreadHandleData {
+    pthread_t thread;
+    ThreadFunction fn;
+    void* userPtr;
+};
+static void* ThreadHandleDataRun(void* p) {
+    ThreadHandleData* t = (ThreadHandleData*) p;
+    t->fn(t->userPtr);
+    return NULL;
+}
+ThreadHandle ThreadCreate(ThreadFunction threadFunction,void* userPtr)  {
+    if (!threadFunction) return NULL;
+    ThreadHandleData* t = (ThreadHandleData*) ImGui::MemAlloc(sizeof(ThreadHandleData));
+    t->fn = threadFunction;t->userPtr = userPtr;
+    if (pthread_create(&t->thread,NULL,ThreadHandleDataRun,t)!=0) {ImGui::MemFree(t);return NULL;}
+    return t;
+}
+void ThreadJoin(ThreadHandle thread)    {
+    if (!thread) return;
+    pthread_join(thread->thread,NULL);
+    ImGui::MemFree(thread);
+}
+void ThreadSleep(int milliseconds)  {usleep(milliseconds*1000);}
+double GetTimeInMilliseconds()  {
+    struct timeval tv;gettimeofday(&tv,NULL);
+    return (double)tv.tv_sec*1000.0+(double)tv.tv_usec*0.001;
+}
+int GetNumHardwareThreads() {
+    const long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n>0 ? (int)n : 1;
+}
+
+int AtomicAdd(volatile int* pValue,int amount)  {return __sync_add_and_fetch(pValue,amount);}
+int AtomicLoad(volatile int* pValue)    {return __sync_add_and_fetch(pValue,0);}    // like the Win32 version: an interlocked operation is visible to race detectors too
+void AtomicStore(volatile int* pValue,int value)    {
+    int cur = __sync_add_and_fetch(pValue,0),prev;  // an interlocked exchange (__sync_lock_test_and_set is only an acquire barrier)
+    while ((prev=__sync_val_compare_and_swap(pValue,cur,value))!=cur) cur = prev;
+}
+bool AtomicCompareAndSwap(volatile int* pValue,int expectedValue,int newValue)  {return __sync_bool_compare_and_swap(pValue,expectedValue,newValue);}
+
+Mutex::Mutex()  {
+    m = ImGui::MemAlloc(sizeof(pthread_mutex_t));
+    pthread_mutex_init((pthread_mutex_t*)m,NULL);
+}
+Mutex::~Mutex() {
+    pthread_mutex_destroy((pthread_mutex_t*)m);
+    ImGui::MemFree(m);m=NULL;
+}
+void Mutex::lock()  {pthread_mutex_lock((pthread_mutex_t*)m);}
+void Mutex::unlock()    {pthread_mutex_unlock((pthread_mutex_t*)m);}
+
+struct EventData {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool signaled;
+};
+Event::Event()  {
+    EventData* ed = (EventData*) ImGui::MemAlloc(sizeof(EventData));
+    pthread_mutex_init(&ed->mutex,NULL);
+    pthread_cond_init(&ed->cond,NULL);
+    ed->signaled = false;
+    e = ed;
+}
+Event::~Event() {
+    EventData* ed = (EventData*) e;
+    pthread_cond_destroy(&ed->cond);
+    pthread_mutex_destroy(&ed->mutex);
+    ImGui::MemFree(ed);e=NULL;
+}
+void Event::signal()    {
+    EventData* ed = (EventData*) e;
+    pthread_mutex_lock(&ed->mutex);
+    ed->signaled = true;
+    pthread_cond_signal(&ed->cond);
+    pthread_mutex_unlock(&ed->mutex);
+}
+bool Event::wait(int timeoutInMs)   {
+    EventData* ed = (EventData*) e;
+    pthread_mutex_lock(&ed->mutex);
+    if (timeoutInMs<0) {
+        while (!ed->signaled) pthread_cond_wait(&ed->cond,&ed->mutex);
+    }
+    else if (!ed->signaled)    {
+        struct timeval now;gettimeofday(&now,NULL);
+        struct timespec ts;
+        long long nsec = (long long)now.tv_usec*1000LL + (long long)timeoutInMs*1000000LL;
+        ts.tv_sec = now.tv_sec + (time_t)(nsec/1000000000LL);
+        ts.tv_nsec = (long)(nsec%1000000000LL);
+        while (!ed->signaled) {
+            if (pthread_cond_timedwait(&ed->cond,&ed->mutex,&ts)==ETIMEDOUT) break;
+        }
+    }
+    const bool rv = ed->signaled;
+    ed->signaled = false;
+    pthread_mutex_unlock(&ed->mutex);
+    return rv;
+}
+#endif //_WIN32
+
+// Used by the main thread only
+static float TextureUploadBudgetPerFrame = 4.f;
+static double TextureUploadTimeInFrame = 0.0;
+static int TextureUploadFrame = -1;
+static int NumTextureUploadsInFrame = 0;
+void SetTextureUploadBudgetPerFrame(float milliseconds) {TextureUploadBudgetPerFrame = milliseconds;}
+bool IsTextureUploadBudgetAvailable()   {
+    const int frame = ImGui::GetFrameCount();
+    if (frame!=TextureUploadFrame) {TextureUploadFrame=frame;TextureUploadTimeInFrame=0.0;NumTextureUploadsInFrame=0;}
+    return NumTextureUploadsInFrame==0 || TextureUploadTimeInFrame<(double)TextureUploadBudgetPerFrame;
+}
+void ConsumeTextureUploadBudget(double milliseconds)    {
+    IsTextureUploadBudgetAvailable();   // resets the counters on a new frame
+    TextureUploadTimeInFrame+=milliseconds;
+    ++NumTextureUploadsInFrame;
+}
+
+struct ThreadPoolTask {
+    ThreadPool::TaskFunction fn;
+    void* userPtr;
+};
+struct ThreadPoolData {
+    ImVector<ThreadHandle> threads;
+    Mutex queueMutex;
+    ImVector<ThreadPoolTask> queue;     // FIFO: the queued tasks are in [queueStart,queue.size())
+    int queueStart;
+    Event wakeUp;                       // auto-reset: a worker that pops a task wakes up the next one if the queue is still not empty
+    Event idle;
+    volatile int numPendingTasks;       // queued + running
+    volatile int stopRequested;
+    bool popTask(ThreadPoolTask& t) {
+        ScopedLock lock(queueMutex);
+        if (queueStart>=queue.size()) return false;
+        t = queue[queueStart++];
+        if (queueStart==queue.size()) {queue.resize(0);queueStart=0;}
+        else wakeUp.signal();
+        return true;
+    }
+    void runTask(const ThreadPoolTask& t) {
+        t.fn(t.userPtr);
+        taskDone(1);
+    }
+    void taskDone(int numTasks) {
+        if (AtomicAdd(&numPendingTasks,-numTasks)==0) idle.signal();
+    }
+    // Removes the queued (= not started) tasks matching fn and userPtr. Returns their number.
+    int removeTasks(ThreadPool::TaskFunction fn,void* userPtr) {
+        ScopedLock lock(queueMutex);
+        int j = queueStart;
+        for (int i=queueStart,isz=queue.size();i<isz;i++)  {
+            if (queue[i].fn!=fn || queue[i].userPtr!=userPtr) queue[j++] = queue[i];
+        }
+        const int numRemoved = queue.size()-j;
+        queue.resize(j);
+        if (queueStart==queue.size()) {queue.resize(0);queueStart=0;}
+        return numRemoved;
+    }
+};
+static void ThreadPoolWorker(void* userPtr) {
+    ThreadPoolData* d = (ThreadPoolData*) userPtr;
+    ThreadPoolTask t;
+    for (;;)    {
+        if (d->popTask(t)) d->runTask(t);
+        else if (AtomicLoad(&d->stopRequested)) break;
+        else d->wakeUp.wait();
+    }
+    d->wakeUp.signal(); // so that the next worker can exit too
+}
+ThreadPool::ThreadPool(int numThreads) {
+    d = (ThreadPoolData*) ImGui::MemAlloc(sizeof(ThreadPoolData));
+    IM_PLACEMENT_NEW(d) ThreadPoolData();
+    d->queueStart = 0;d->numPendingTasks = 0;d->stopRequested = 0;
+    if (numThreads<=0) numThreads = ImMax(GetNumHardwareThreads()-1,1);
+    for (int i=0;i<numThreads;i++)  {
+        ThreadHandle t = ThreadCreate(ThreadPoolWorker,d);
+        if (t) d->threads.push_back(t);
+    }
+}
+ThreadPool::~ThreadPool() {
+    AtomicStore(&d->stopRequested,1);
+    d->wakeUp.signal();
+    for (int i=0;i<d->threads.size();i++) ThreadJoin(d->threads[i]);
+    d->~ThreadPoolData();
+    ImGui::MemFree(d);d=NULL;
+}
+int ThreadPool::getNumThreads() const {return d->threads.size();}
+void ThreadPool::enqueue(TaskFunction task,void* userPtr) {
+    ThreadPoolTask t;t.fn = task;t.userPtr = userPtr;
+    AtomicAdd(&d->numPendingTasks,1);
+    if (d->threads.size()==0) {d->runTask(t);return;}   // no worker could be created
+    {
+        ScopedLock lock(d->queueMutex);
+        d->queue.push_back(t);
+    }
+    d->wakeUp.signal();
+}
+void ThreadPool::waitIdle()  {
+    while (AtomicLoad(&d->numPendingTasks)>0) d->idle.wait(10);
+}
+struct ThreadPoolForJob {
+    ThreadPool::ForFunction fn;
+    void* userPtr;
+    int start,end,grainSize,numChunks;
+    volatile int nextChunk,numChunksDone;
+    volatile int numHelpers;    // helper tasks that can still access this struct
+    Event done;
+    void run() {
+        for (int c=AtomicAdd(&nextChunk,1)-1;c<numChunks;c=AtomicAdd(&nextChunk,1)-1)  {
+            const int s = start+c*grainSize;
+            fn(s,(end-s)>grainSize ? (s+grainSize) : end,userPtr);
+            if (AtomicAdd(&numChunksDone,1)==numChunks) done.signal();
+        }
+    }
+    static void HelperTask(void* userPtr) {
+        ThreadPoolForJob* j = (ThreadPoolForJob*) userPtr;
+        j->run();
+        AtomicAdd(&j->numHelpers,-1);  // j can't be accessed after this line
+    }
+};
+void ThreadPool::parallelFor(int start,int end,ForFunction fn,void* userPtr,int grainSize) {
+    if (end<=start) return;
+    if (grainSize<1) grainSize = 1;
+    const int numChunks = (end-start-1)/grainSize+1;
+    const int numHelpers = ImMin(numChunks-1,d->threads.size());
+    if (numHelpers<=0) {fn(start,end,userPtr);return;}
+    ThreadPoolForJob j;
+    j.fn = fn;j.userPtr = userPtr;j.start = start;j.end = end;j.grainSize = grainSize;j.numChunks = numChunks;
+    j.nextChunk = j.numChunksDone = 0;j.numHelpers = numHelpers;
+    for (int i=0;i<numHelpers;i++) enqueue(ThreadPoolForJob::HelperTask,&j);
+    j.run();
+    while (AtomicLoad(&j.numChunksDone)<numChunks) j.done.wait();
+    // All the chunks are done: helpers that haven't started yet are useless (and they must not run after we return)
+    const int numRemoved = d->removeTasks(ThreadPoolForJob::HelperTask,&j);
+    if (numRemoved>0)   {
+        AtomicAdd(&j.numHelpers,-numRemoved);
+        d->taskDone(numRemoved);
+    }
+    while (AtomicLoad(&j.numHelpers)>0) ThreadSleep(0);  // the running ones are just leaving j.run()
+}
+ThreadPool& ThreadPool::GetDefault() {
+    static ThreadPool pool;
+    return pool;
+}
+
+struct AsyncLogSinkData {
+    ImGuiLogSink sink;
+    Mutex ringMutex;
+    ImVector<char> ring;        // fixed size circular buffer written by the UI thread and drained by the writer thread
+    int ringStart,ringUsed;
+    volatile int numDroppedBytes;
+    Event wakeUp;
+    volatile int stopRequested;
+    ThreadHandle thread;
+    int maxLatencyInMs;
+    FILE* file;                 // NULL in buffer mode
+    bool gzCompress;
+    Mutex bufferMutex;
+    ImVector<char> buffer;      // buffer mode output (zero-terminated)
+    ImVector<char> batch;       // used by the writer thread only
+#   ifdef IMGUI_USE_ZLIB
+    ImVector<char> gzBatch;     // used by the writer thread only
+#   endif //IMGUI_USE_ZLIB
+
+    AsyncLogSinkData() : ringStart(0),ringUsed(0),numDroppedBytes(0),stopRequested(0),thread(NULL),maxLatencyInMs(100),file(NULL),gzCompress(false) {
+        sink.WriteFn = &AsyncLogSinkData::WriteFn;
+        sink.CloseFn = &AsyncLogSinkData::CloseFn;
+        sink.UserData = this;
+    }
+
+    // UI thread: just a copy into the ring buffer. It never waits for I/O.
+    static void WriteFn(ImGuiLogSink* sink,const char* text,int text_len) {
+        AsyncLogSinkData* d = (AsyncLogSinkData*) sink->UserData;
+        bool mustWakeUp = false;
+        d->ringMutex.lock();
+        const int capacity = d->ring.size();
+        const int numBytes = ImMin(text_len,capacity-d->ringUsed);
+        if (numBytes>0) {
+            const int writePos = (d->ringStart+d->ringUsed)%capacity;
+            const int firstPart = ImMin(numBytes,capacity-writePos);
+            memcpy(&d->ring[writePos],text,firstPart);
+            if (numBytes>firstPart) memcpy(&d->ring[0],text+firstPart,numBytes-firstPart);
+            d->ringUsed+=numBytes;
+        }
+        mustWakeUp = d->ringUsed*2>=capacity;
+        d->ringMutex.unlock();
+        if (numBytes<text_len) AtomicAdd(&d->numDroppedBytes,text_len-numBytes);
+        if (mustWakeUp) d->wakeUp.signal();
+    }
+    static void CloseFn(ImGuiLogSink* sink) {
+        AsyncLogSinkData* d = (AsyncLogSinkData*) sink->UserData;
+        d->wakeUp.signal(); // Make the writer thread write what's left ASAP
+    }
+
+    // Writer thread
+    bool drainRing() {
+        batch.resize(0);
+        ringMutex.lock();
+        if (ringUsed>0) {
+            const int capacity = ring.size();
+            const int firstPart = ImMin(ringUsed,capacity-ringStart);
+            batch.resize(ringUsed);
+            memcpy(&batch[0],&ring[ringStart],firstPart);
+            if (ringUsed>firstPart) memcpy(&batch[firstPart],&ring[0],ringUsed-firstPart);
+            ringStart = (ringStart+ringUsed)%capacity;
+            ringUsed = 0;
+        }
+        ringMutex.unlock();
+        return batch.size()>0;
+    }
+    void writeBatch()   {
+        if (file)   {
+#           ifdef IMGUI_USE_ZLIB
+            if (gzCompress) {
+                if (ImGui::GzCompressFromMemory(&batch[0],batch.size(),gzBatch)) fwrite(&gzBatch[0],1,gzBatch.size(),file);
+            }
+            else
+#           endif //IMGUI_USE_ZLIB
+            fwrite(&batch[0],1,batch.size(),file);
+            fflush(file);
+        }
+        else {
+            ScopedLock lock(bufferMutex);
+            const int startSz = buffer.size()>0 ? buffer.size()-1 : 0;
+            buffer.resize(startSz+batch.size()+1);
+            memcpy(&buffer[startSz],&batch[0],batch.size());
+            buffer[buffer.size()-1]='\0';
+        }
+    }
+    static void ThreadRun(void* userPtr)   {
+        AsyncLogSinkData* d = (AsyncLogSinkData*) userPtr;
+        for (;;)    {
+            d->wakeUp.wait(d->maxLatencyInMs);
+            const bool stop = AtomicLoad(&d->stopRequested)!=0;
+            if (d->drainRing()) d->writeBatch();
+            if (stop) break;
+        }
+    }
+};
+
+AsyncLogSink::AsyncLogSink() {
+    d = (AsyncLogSinkData*) ImGui::MemAlloc(sizeof(AsyncLogSinkData));
+    IM_PLACEMENT_NEW(d) AsyncLogSinkData();
+}
+AsyncLogSink::~AsyncLogSink() {
+    close();
+    d->~AsyncLogSinkData();
+    ImGui::MemFree(d);d=NULL;
+}
+static bool AsyncLogSinkStart(AsyncLogSinkData* d,int ringBufferSizeInBytes,int maxLatencyInMs)  {
+    d->ring.resize(ringBufferSizeInBytes>0 ? ringBufferSizeInBytes : 1024*1024);
+    d->ringStart = d->ringUsed = 0;
+    d->numDroppedBytes = 0;
+    d->stopRequested = 0;
+    d->maxLatencyInMs = maxLatencyInMs>0 ? maxLatencyInMs : 1;
+    d->thread = ThreadCreate(&AsyncLogSinkData::ThreadRun,d);
+    return d->thread!=NULL;
+}
+bool AsyncLogSink::openFile(const char* filePath,bool appendMode,bool gzCompress,int ringBufferSizeInBytes,int maxLatencyInMs) {
+    close();
+    if (!filePath || filePath[0]=='\0') return false;
+    d->file = ImFileOpen(filePath,appendMode ? "ab" : "wb");
+    if (!d->file) return false;
+#   ifdef IMGUI_USE_ZLIB
+    d->gzCompress = gzCompress;
+#   else //IMGUI_USE_ZLIB
+    IM_ASSERT(!gzCompress);  // gzCompress needs IMGUI_USE_ZLIB
+    d->gzCompress = false;
+#   endif //IMGUI_USE_ZLIB
+    if (!AsyncLogSinkStart(d,ringBufferSizeInBytes,maxLatencyInMs)) {fclose(d->file);d->file=NULL;return false;}
+    return true;
+}
+bool AsyncLogSink::openBuffer(int ringBufferSizeInBytes,int maxLatencyInMs) {
+    close();
+    d->gzCompress = false;
+    return AsyncLogSinkStart(d,ringBufferSizeInBytes,maxLatencyInMs);
+}
+void AsyncLogSink::close()  {
+    if (!d->thread) return;
+    logFinish();
+    AtomicStore(&d->stopRequested,1);
+    d->wakeUp.signal();
+    ThreadJoin(d->thread);d->thread=NULL;
+    if (d->file) {fclose(d->file);d->file=NULL;}
+    d->ring.clear();
+}
+bool AsyncLogSink::isOpen() const {return d->thread!=NULL;}
+void AsyncLogSink::logBegin(int auto_open_depth) {
+    IM_ASSERT(isOpen());
+    if (isOpen()) ImGui::LogToSink(&d->sink,auto_open_depth);
+}
+void AsyncLogSink::logFinish()    {
+    if (isLogging()) ImGui::LogFinish();
+}
+bool AsyncLogSink::isLogging() const {
+    ImGuiContext* g = ImGui::GetCurrentContext();
+    return g && g->LogEnabled && g->LogSink==&d->sink;
+}
+int AsyncLogSink::getNumDroppedBytes() const {return AtomicLoad(&d->numDroppedBytes);}
+const ImVector<char>& AsyncLogSink::lockBuffer() {d->bufferMutex.lock();return d->buffer;}
+void AsyncLogSink::unlockBuffer()  {d->bufferMutex.unlock();}
+void AsyncLogSink::clearBuffer()   {ScopedLock lock(d->bufferMutex);d->buffer.clear();}
+
+} //namespace ImGuiHelper
+#endif //IMGUIHELPER_HAS_THREADS
+
+
+#if (defined(IMGUI_USE_ZLIB) || (defined(YES_IMGUIBZ2) && !defined(BZ_DECOMPRESS_ONLY)))
+namespace ImGuiHelper {
+// Block compression shared by the gzip and bzip2 helpers (pigz/pbzip2 style).
+// Every block is compressed independently into a complete gzip member (or bzip2 stream), and the blocks are concatenated in order.
+// So the output does not depend on the number of threads, and it can be read by the usual decompressors.
+typedef bool (*CompressFromMemoryFunction)(const char* memoryBuffer,int memoryBufferSize,ImVector<char>& rv,bool clearRvBeforeUsage);
+struct CompressBlocksData {
+    CompressFromMemoryFunction compress;
+    const char* input;
+    int inputSize;
+    int blockSize;
+    int firstBlock;
+    ImVector<char>* outputs;    // One per block of the current batch
+    volatile int numFailures;
+    static void CompressBlocks(int start,int end,void* userPtr) {
+        CompressBlocksData* d = (CompressBlocksData*) userPtr;
+        for (int i=start;i<end;i++) {
+            const int offset = (d->firstBlock+i)*d->blockSize;
+            const int size = ImMin(d->blockSize,d->inputSize-offset);
+            if (!d->compress(&d->input[offset],size,d->outputs[i],true)) {
+#               ifdef IMGUIHELPER_HAS_THREADS
+                AtomicAdd(&d->numFailures,1);
+#               else //IMGUIHELPER_HAS_THREADS
+                d->numFailures++;
+#               endif //IMGUIHELPER_HAS_THREADS
+            }
+        }
+    }
+};
+// Appends the result to rv (if not NULL) and/or writes it to f (if not NULL).
+// Only a batch of (2 * number of threads) compressed blocks is kept in memory at a time.
+static bool CompressBlocks(CompressFromMemoryFunction compress,const char* input,int inputSize,int blockSizeInBytes,ImVector<char>* rv,FILE* f) {
+    if (inputSize<=0 || !input) return false;
+    if (blockSizeInBytes<=0) blockSizeInBytes = inputSize;
+    const int numBlocks = inputSize/blockSizeInBytes + (inputSize%blockSizeInBytes ? 1 : 0);
+#   ifdef IMGUIHELPER_HAS_THREADS
+    ThreadPool& pool = ThreadPool::GetDefault();
+    const int batchSize = ImMin(numBlocks,2*(pool.getNumThreads()+1));
+#   else //IMGUIHELPER_HAS_THREADS
+    const int batchSize = 1;
+#   endif //IMGUIHELPER_HAS_THREADS
+
+    CompressBlocksData d;
+    d.compress = compress;d.input = input;d.inputSize = inputSize;d.blockSize = blockSizeInBytes;d.numFailures = 0;
+    d.outputs = (ImVector<char>*) ImGui::MemAlloc(batchSize*sizeof(ImVector<char>));
+    for (int i=0;i<batchSize;i++) IM_PLACEMENT_NEW(&d.outputs[i]) ImVector<char>();
+
+    for (d.firstBlock=0;d.firstBlock<numBlocks && d.numFailures==0;d.firstBlock+=batchSize) {
+        const int numBatchBlocks = ImMin(batchSize,numBlocks-d.firstBlock);
+#       ifdef IMGUIHELPER_HAS_THREADS
+        if (numBatchBlocks>1) pool.parallelFor(0,numBatchBlocks,&CompressBlocksData::CompressBlocks,&d,1);
+        else
+#       endif //IMGUIHELPER_HAS_THREADS
+        CompressBlocksData::CompressBlocks(0,numBatchBlocks,&d);
+        if (d.numFailures>0) break;
+        for (int i=0;i<numBatchBlocks;i++) {
+            const ImVector<char>& out = d.outputs[i];
+            if (rv) {
+                const int startRv = rv->size();
+                rv->resize(startRv+out.size());
+                memcpy(&(*rv)[startRv],&out[0],out.size());
+            }
+            if (f && fwrite(&out[0],1,out.size(),f)!=(size_t)out.size()) {d.numFailures++;break;}
+        }
+    }
+
+    for (int i=0;i<batchSize;i++) d.outputs[i].~ImVector<char>();
+    ImGui::MemFree(d.outputs);d.outputs=NULL;
+    return d.numFailures==0;
+}
+#   ifndef NO_IMGUIHELPER_SERIALIZATION
+#   ifndef NO_IMGUIHELPER_SERIALIZATION_SAVE
+static bool CompressBlocksToFile(CompressFromMemoryFunction compress,const char* filePath,const char* input,int inputSize,int blockSizeInBytes) {
+    if (!filePath || inputSize<=0 || !input) return false;
+    FILE* f = ImFileOpen(filePath,"wb");
+    if (!f) return false;
+    bool ok = CompressBlocks(compress,input,inputSize,blockSizeInBytes,NULL,f);
+    if (fclose(f)!=0) ok = false;
+    return ok;
+}
+#   endif //NO_IMGUIHELPER_SERIALIZATION_SAVE
+#   endif //NO_IMGUIHELPER_SERIALIZATION
+} //namespace ImGuiHelper
+#endif //(defined(IMGUI_USE_ZLIB) || (defined(YES_IMGUIBZ2) && !defined(BZ_DECOMPRESS_ONLY)))
+
 
 #ifdef IMGUI_USE_ZLIB	// requires linking to library -lZlib
 #include <zlib.h>
@@ -1189,20 +1899,29 @@ bool GzDecompressFromMemory(const char* memoryBuffer,int memoryBufferSize,ImVect
     myZStream.zfree = Z_NULL;
 
     bool done = false;
+    uLong prevMembersOut = 0;  // total_out is reset at every gzip member
     if (inflateInit2(&myZStream, (16+MAX_WBITS)) == Z_OK) {
         int err = Z_OK;
         while (!done) {
-            if (myZStream.total_out >= (uLong)(rv.size()-startRv)) rv.resize(rv.size()+memoryChunk);    // not enough space: we add the memoryChunk each step
-
-            myZStream.next_out = (Bytef *) (&rv[startRv] + myZStream.total_out);
-            myZStream.avail_out = rv.size() - startRv - myZStream.total_out;
-
-            if ((err = inflate (&myZStream, Z_SYNC_FLUSH))==Z_STREAM_END) done = true;
+            if (prevMembersOut + myZStream.total_out >= (uLong)(rv.size()-startRv)) rv.resize(rv.size()+memoryChunk);    // not enough space: we add the memoryChunk each step
+
+            myZStream.next_out = (Bytef *) (&rv[startRv] + prevMembersOut + myZStream.total_out);
+            myZStream.avail_out = rv.size() - startRv - prevMembersOut - myZStream.total_out;
+
+            if ((err = inflate (&myZStream, Z_SYNC_FLUSH))==Z_STREAM_END) {
+                done = true;
+                // Concatenated gzip members (e.g. from GzCompressFromMemoryParallel(...)): go on if another gzip header follows
+                if (myZStream.avail_in>=2 && myZStream.next_in[0]==0x1f && myZStream.next_in[1]==0x8b) {
+                    prevMembersOut+=myZStream.total_out;
+                    if (inflateReset(&myZStream)!=Z_OK) {done = false;break;}
+                    done = false;
+                }
+            }
             else if (err != Z_OK)  break;
         }
         if ((err=inflateEnd(&myZStream))!= Z_OK) done = false;
     }
-    rv.resize(startRv+(done ? myZStream.total_out : 0));
+    rv.resize(startRv+(done ? (prevMembersOut + myZStream.total_out) : 0));
 
     return done;
 }
@@ -1239,6 +1958,19 @@ bool GzCompressFromMemory(const char* memoryBuffer,int memoryBufferSize,ImVector
 
     return done;
 }
+bool GzCompressFromMemoryParallel(const char* memoryBuffer,int memoryBufferSize,ImVector<char>& rv,bool clearRvBeforeUsage,int blockSizeInBytes)  {
+    if (clearRvBeforeUsage) rv.clear();
+    const int startRv = rv.size();
+    if (!ImGuiHelper::CompressBlocks(&GzCompressFromMemory,memoryBuffer,memoryBufferSize,blockSizeInBytes,&rv,NULL)) {rv.resize(startRv);return false;}
+    return true;
+}
+#ifndef NO_IMGUIHELPER_SERIALIZATION
+#ifndef NO_IMGUIHELPER_SERIALIZATION_SAVE
+bool GzCompressToFile(const char* filePath,const char* memoryBuffer,int memoryBufferSize,int blockSizeInBytes)  {
+    return ImGuiHelper::CompressBlocksToFile(&GzCompressFromMemory,filePath,memoryBuffer,memoryBufferSize,blockSizeInBytes);
+}
+#endif //NO_IMGUIHELPER_SERIALIZATION_SAVE
+#endif //NO_IMGUIHELPER_SERIALIZATION
 #   ifdef YES_IMGUISTRINGIFIER
 bool GzBase64DecompressFromMemory(const char* input,ImVector<char>& rv) {
     rv.clear();ImVector<char> v;
@@ -1295,6 +2027,21 @@ bool Bz2Base85DecompressFromFile(const char* filePath, ImVector<char>& rv)   {
 #   endif //#YES_IMGUISTRINGIFIER
 #           endif //NO_IMGUIHELPER_SERIALIZATION_LOAD
 #       endif //NO_IMGUIHELPER_SERIALIZATION
+#       ifndef BZ_DECOMPRESS_ONLY
+bool Bz2CompressFromMemoryParallel(const char* memoryBuffer,int memoryBufferSize,ImVector<char>& rv,bool clearRvBeforeUsage,int blockSizeInBytes)  {
+    if (clearRvBeforeUsage) rv.clear();
+    const int startRv = rv.size();
+    if (!ImGuiHelper::CompressBlocks(&Bz2CompressFromMemory,memoryBuffer,memoryBufferSize,blockSizeInBytes,&rv,NULL)) {rv.resize(startRv);return false;}
+    return true;
+}
+#           ifndef NO_IMGUIHELPER_SERIALIZATION
+#           ifndef NO_IMGUIHELPER_SERIALIZATION_SAVE
+bool Bz2CompressToFile(const char* filePath,const char* memoryBuffer,int memoryBufferSize,int blockSizeInBytes)  {
+    return ImGuiHelper::CompressBlocksToFile(&Bz2CompressFromMemory,filePath,memoryBuffer,memoryBufferSize,blockSizeInBytes);
+}
+#           endif //NO_IMGUIHELPER_SERIALIZATION_SAVE
+#           endif //NO_IMGUIHELPER_SERIALIZATION
+#       endif //BZ_DECOMPRESS_ONLY
 } // namespace ImGui
 #   endif //YES_IMGUIBZ2
 
@@ -5,6 +5,10 @@
 #include <imgui.h>
 #endif //IMGUI_API
 
+#ifndef NO_IMGUIHELPER_THREADS
+#define IMGUIHELPER_HAS_THREADS
+#endif //NO_IMGUIHELPER_THREADS
+
 
 namespace ImGui {
 
@@ -77,6 +81,16 @@ IMGUI_API bool GzBase85DecompressFromFile(const char* filePath,ImVector<char>& r
 #       endif //NO_IMGUIHELPER_SERIALIZATION
 IMGUI_API bool GzDecompressFromMemory(const char* memoryBuffer,int memoryBufferSize,ImVector<char>& rv,bool clearRvBeforeUsage=true);
 IMGUI_API bool GzCompressFromMemory(const char* memoryBuffer,int memoryBufferSize,ImVector<char>& rv,bool clearRvBeforeUsage=true);
+// Like GzCompressFromMemory(...), but the input is split into blocks that are compressed concurrently (on ImGuiHelper::ThreadPool::GetDefault())
+// into separate gzip members, concatenated in order (like pigz -i). The output does not depend on the number of threads, and it can be read by
+// GzDecompressFromMemory(...) and gunzip. A smaller blockSizeInBytes gives more parallelism, a larger one gives a (slightly) better compression ratio.
+IMGUI_API bool GzCompressFromMemoryParallel(const char* memoryBuffer,int memoryBufferSize,ImVector<char>& rv,bool clearRvBeforeUsage=true,int blockSizeInBytes=1024*1024);
+#       ifndef NO_IMGUIHELPER_SERIALIZATION
+#           ifndef NO_IMGUIHELPER_SERIALIZATION_SAVE
+// Same output as GzCompressFromMemoryParallel(...), but the compressed blocks are written to filePath as they're ready (without building the whole output in memory)
+IMGUI_API bool GzCompressToFile(const char* filePath,const char* memoryBuffer,int memoryBufferSize,int blockSizeInBytes=1024*1024);
+#           endif //NO_IMGUIHELPER_SERIALIZATION_SAVE
+#       endif //NO_IMGUIHELPER_SERIALIZATION
 #   ifdef YES_IMGUISTRINGIFIER
 IMGUI_API bool GzBase64DecompressFromMemory(const char* input,ImVector<char>& rv);
 IMGUI_API bool GzBase85DecompressFromMemory(const char* input,ImVector<char>& rv);
@@ -96,7 +110,17 @@ IMGUI_API bool Bz2Base85DecompressFromFile(const char* filePath,ImVector<char>&
 #   endif //#YES_IMGUISTRINGIFIER
 #           endif //NO_IMGUIHELPER_SERIALIZATION_LOAD
 #       endif //NO_IMGUIHELPER_SERIALIZATION
-// TODO: we can add helpers to compress bz2 as well...
+#       ifndef BZ_DECOMPRESS_ONLY
+// Like ImGui::Bz2CompressFromMemory(...), but the input is split into blocks that are compressed concurrently into separate bzip2 streams,
+// concatenated in order (like pbzip2). Bz2DecompressFromMemory(...) and bunzip2 can read the result.
+IMGUI_API bool Bz2CompressFromMemoryParallel(const char* memoryBuffer,int memoryBufferSize,ImVector<char>& rv,bool clearRvBeforeUsage=true,int blockSizeInBytes=900*1000);
+#           ifndef NO_IMGUIHELPER_SERIALIZATION
+#           ifndef NO_IMGUIHELPER_SERIALIZATION_SAVE
+// Same output as Bz2CompressFromMemoryParallel(...), but the compressed blocks are written to filePath as they're ready (without building the whole output in memory)
+IMGUI_API bool Bz2CompressToFile(const char* filePath,const char* memoryBuffer,int memoryBufferSize,int blockSizeInBytes=900*1000);
+#           endif //NO_IMGUIHELPER_SERIALIZATION_SAVE
+#           endif //NO_IMGUIHELPER_SERIALIZATION
+#       endif //BZ_DECOMPRESS_ONLY
 #   endif //YES_IMGUIBZ2
 
 #   ifdef YES_IMGUISTRINGIFIER
@@ -141,12 +165,14 @@ IMGUI_API bool FileExists(const char* filePath);
 class Deserializer {
     char* f_data;
     size_t f_size;
+    bool f_mapped;  // f_data is a read-only memory mapping of the file (without a trailing '\0')
     void clear();
     bool loadFromFile(const char* filename);
+    bool mapFile(const char* filename);
     bool allocate(size_t sizeToAllocate,const char* optionalTextToCopy=NULL,size_t optionalTextToCopySize=0);
     public:
-    IMGUI_API Deserializer() : f_data(NULL),f_size(0) {}
-    IMGUI_API Deserializer(const char* filename);                     // From file
+    IMGUI_API Deserializer() : f_data(NULL),f_size(0),f_mapped(false) {}
+    IMGUI_API Deserializer(const char* filename);                     // From file (memory-mapped without copies when possible; define NO_IMGUIHELPER_SERIALIZATION_MMAP to always read it into a buffer)
     IMGUI_API Deserializer(const char* text,size_t textSizeInBytes);  // From memory (and optionally from file through GetFileContent(...))
     IMGUI_API ~Deserializer() {clear();}
     IMGUI_API bool isValid() const {return (f_data && f_size>0);}
@@ -226,6 +252,114 @@ IMGUI_API void StringAppend(char*& destText, const char* textToAppend, bool allo
 // returns the number of chars appended.
 IMGUI_API int StringAppend(ImVector<char>& v,const char* fmt, ...);
 
+#ifdef IMGUIHELPER_HAS_THREADS
+// Minimal portable threading layer (Win32 API on Windows, pthreads elsewhere: some systems need to link to -lpthread).
+// It's used by the addons that can move some work off the UI thread. Define NO_IMGUIHELPER_THREADS to remove it.
+typedef void (*ThreadFunction)(void* userPtr);
+struct ThreadHandleData;
+typedef ThreadHandleData* ThreadHandle;
+IMGUI_API ThreadHandle ThreadCreate(ThreadFunction threadFunction,void* userPtr);   // returns NULL on failure
+IMGUI_API void ThreadJoin(ThreadHandle thread);                                       // waits for the thread to exit and releases the handle
+IMGUI_API void ThreadSleep(int milliseconds);
+IMGUI_API int GetNumHardwareThreads();
+IMGUI_API double GetTimeInMilliseconds();   // High resolution wall clock (with an unspecified origin)
+
+// A per-frame time budget, shared by the addons that upload the textures of asynchronously decoded images.
+// When it's exhausted, the uploads are postponed to the next frames (but one upload per frame is always allowed).
+IMGUI_API void SetTextureUploadBudgetPerFrame(float milliseconds);  // Default: 4 ms
+IMGUI_API bool IsTextureUploadBudgetAvailable();
+IMGUI_API void ConsumeTextureUploadBudget(double milliseconds);
+
+// Atomic operations on ints (they all act as full memory barriers)
+IMGUI_API int AtomicAdd(volatile int* pValue,int amount);                          // returns the new value
+IMGUI_API int AtomicLoad(volatile int* pValue);
+IMGUI_API void AtomicStore(volatile int* pValue,int value);
+IMGUI_API bool AtomicCompareAndSwap(volatile int* pValue,int expectedValue,int newValue);
+
+class Mutex {
+    void* m;
+    public:
+    IMGUI_API Mutex();
+    IMGUI_API ~Mutex();
+    IMGUI_API void lock();
+    IMGUI_API void unlock();
+protected:
+    void operator=(const Mutex&) {}
+    Mutex(const Mutex&) {}
+};
+class ScopedLock {
+    Mutex& m;
+    public:
+    ScopedLock(Mutex& mutex) : m(mutex) {m.lock();}
+    ~ScopedLock() {m.unlock();}
+protected:
+    void operator=(const ScopedLock&) {}
+};
+// Auto-reset event: wait() returns as soon as signal() has been called (by any thread), or when the timeout expires.
+class Event {
+    void* e;
+    public:
+    IMGUI_API Event();
+    IMGUI_API ~Event();
+    IMGUI_API void signal();
+    IMGUI_API bool wait(int timeoutInMs=-1);  // returns false on timeout. timeoutInMs<0 waits forever
+protected:
+    void operator=(const Event&) {}
+    Event(const Event&) {}
+};
+
+// A fixed set of worker threads that run the enqueued tasks in FIFO order.
+// numThreads<=0 means GetNumHardwareThreads()-1 workers (at least one): parallelFor(...) uses the calling thread too.
+class ThreadPool {
+    struct ThreadPoolData* d;
+    public:
+    typedef void (*TaskFunction)(void* userPtr);
+    typedef void (*ForFunction)(int start,int end,void* userPtr);   // must process the items in [start,end)
+    IMGUI_API ThreadPool(int numThreads=0);
+    IMGUI_API ~ThreadPool();    // Runs the tasks still in the queue, then joins the workers
+    IMGUI_API int getNumThreads() const;
+    IMGUI_API void enqueue(TaskFunction task,void* userPtr);
+    IMGUI_API void waitIdle();  // Waits until the queue is empty and no task is running
+    // Splits [start,end) into chunks of grainSize items and processes them on the workers and on the calling thread.
+    // Returns when all the chunks have been processed. It can be called from inside a task too.
+    IMGUI_API void parallelFor(int start,int end,ForFunction fn,void* userPtr,int grainSize=1);
+    IMGUI_API static ThreadPool& GetDefault();  // Shared pool, created on first usage
+protected:
+    void operator=(const ThreadPool&) {}
+    ThreadPool(const ThreadPool&) {}
+};
+
+// A log destination for ImGui::LogToSink() (see imgui_internal.h) that keeps log I/O off the UI thread.
+// The UI thread just copies the text logged in each frame into a fixed-size ring buffer: when the ring buffer is full the excess text
+// is dropped (and counted) instead of blocking, so the cost on the UI thread is bounded by a memcpy.
+// A background thread drains the ring buffer (at most every maxLatencyInMs, or earlier when the ring buffer is half full)
+// and writes the batches to a file (as concatenated gzip members when gzCompress is true and IMGUI_USE_ZLIB is defined),
+// or appends them to an in-memory buffer.
+class AsyncLogSink {
+    struct AsyncLogSinkData* d;
+    public:
+    IMGUI_API AsyncLogSink();
+    IMGUI_API ~AsyncLogSink();
+    IMGUI_API bool openFile(const char* filePath,bool appendMode=true,bool gzCompress=false,int ringBufferSizeInBytes=1024*1024,int maxLatencyInMs=100);
+    IMGUI_API bool openBuffer(int ringBufferSizeInBytes=1024*1024,int maxLatencyInMs=100);
+    IMGUI_API void close();     // Calls logFinish() if needed, then waits for the background thread to write everything
+    IMGUI_API bool isOpen() const;
+
+    IMGUI_API void logBegin(int auto_open_depth=-1);  // Same as ImGui::LogToSink(...). Must be open.
+    IMGUI_API void logFinish();                       // Same as ImGui::LogFinish() (if logging to this sink)
+    IMGUI_API bool isLogging() const;
+
+    IMGUI_API int getNumDroppedBytes() const;         // Bytes lost because the ring buffer was full
+    // openBuffer() mode only: the text written so far (zero-terminated). Must be paired with unlockBuffer().
+    IMGUI_API const ImVector<char>& lockBuffer();
+    IMGUI_API void unlockBuffer();
+    IMGUI_API void clearBuffer();
+protected:
+    void operator=(const AsyncLogSink&) {}
+    AsyncLogSink(const AsyncLogSink&) {}
+};
+#endif //IMGUIHELPER_HAS_THREADS
+
 } // ImGuiHelper
 
 #ifndef NO_IMGUIKNOWNCOLOR_DEFINITIONS
@@ -10,6 +10,11 @@
 
 #include <stdlib.h> // qsort
 
+// ListView::sort(...) can run in a worker thread when the threading layer of imguihelper is available
+#if (defined(IMGUIHELPER_H_) && defined(IMGUIHELPER_HAS_THREADS))
+#   define IMGUILISTVIEW_HAS_THREADS
+#endif
+
 // Enforce cdecl calling convention for functions called by the standard library, in case compilation settings changed the default to e.g. __vectorcall
 #ifdef _MSC_VER
 #define IMGUILV_CDECL __cdecl
@@ -34,6 +39,11 @@ bool ListViewBase::render(float listViewHeight, const ImVector<int> *pOptionalCo
     const bool mustFetchHeaderData = (int)m_headerData.size()<numColumns;
     if (mustFetchHeaderData) updateHeaderData();
 
+    // When the filter is active we display (and clip) only the rows in m_filteredRows
+    const bool useFilteredRows = mustFilterRows();
+    if (useFilteredRows && (m_filterDirty || m_filterNumRows!=numRows)) updateFilteredRows();
+    const int numDisplayedRows = useFilteredRows ? m_filteredRows.size() : (int) numRows;
+
     int columnSortingIndex = -1;
 
     static ImVec4 transparentColor(1,1,1,0);
@@ -101,14 +111,21 @@ bool ListViewBase::render(float listViewHeight, const ImVector<int> *pOptionalCo
     if (!skipDisplaying) {
         const float textLineHeight = ImGui::GetTextLineHeight();
         float itemHeight = ImGui::GetTextLineHeightWithSpacing();        
-        int displayStart = 0, displayEnd = (int) numRows;
+        int displayStart = 0, displayEnd = numDisplayedRows;
 
-        ImGui::CalcListClipping(numRows, itemHeight, &displayStart, &displayEnd);
+        ImGui::CalcListClipping(numDisplayedRows, itemHeight, &displayStart, &displayEnd);
 
-        if (scrollToRow>=0) {
-            if (displayStart>scrollToRow)  displayStart = scrollToRow;
-            else if (displayEnd<=scrollToRow)   displayEnd = scrollToRow+1;
-            else scrollToRow = -1;   // we reset it now
+        int scrollToDisplayedRow = scrollToRow;
+        if (scrollToRow>=0 && useFilteredRows)  {
+            // m_filteredRows is sorted: binary search (-1 if the row does not pass the filter)
+            int lo = 0, hi = numDisplayedRows;
+            while (lo<hi) {const int mid = (lo+hi)/2;if (m_filteredRows[mid]<scrollToRow) lo = mid+1;else hi = mid;}
+            scrollToDisplayedRow = (lo<numDisplayedRows && m_filteredRows[lo]==scrollToRow) ? lo : -1;
+        }
+        if (scrollToDisplayedRow>=0) {
+            if (displayStart>scrollToDisplayedRow)  displayStart = scrollToDisplayedRow;
+            else if (displayEnd<=scrollToDisplayedRow)   displayEnd = scrollToDisplayedRow+1;
+            else scrollToDisplayedRow = scrollToRow = -1;   // we reset it now
         }
 
         ImGui::SetCursorPosY(ImGui::GetCursorPosY() + (displayStart * itemHeight));
@@ -145,11 +162,12 @@ bool ListViewBase::render(float listViewHeight, const ImVector<int> *pOptionalCo
                 ImGui::PushStyleColor(ImGuiCol_HeaderHovered,transparentColor);
                 ImGui::PushStyleColor(ImGuiCol_HeaderActive,transparentColor);
             }
-            for (int row = displayStart; row < displayEnd; ++row) {
+            for (int displayedRow = displayStart; displayedRow < displayEnd; ++displayedRow) {
+                const int row = useFilteredRows ? m_filteredRows[displayedRow] : displayedRow;
                 isThisRowSelected = (selectedRow == row);
                 mustDisplayEditor = isThisRowSelected && hdEditable && selectedColumn==col && hd->type.headerType!=HT_CUSTOM  && hd->type.headerType!=HT_ICON && editorAllowed;
 
-                if (colID==0 && row==scrollToRow) ImGui::SetScrollHereY();
+                if (colID==0 && displayedRow==scrollToDisplayedRow) ImGui::SetScrollHereY();
 
                 cd.reset();
                 getCellData((size_t)row,col,cd);
@@ -398,7 +416,7 @@ bool ListViewBase::render(float listViewHeight, const ImVector<int> *pOptionalCo
         }
         ImGui::Columns(1);
 
-        ImGui::SetCursorPosY(ImGui::GetCursorPosY() + ((numRows - displayEnd) * itemHeight));
+        ImGui::SetCursorPosY(ImGui::GetCursorPosY() + ((numDisplayedRows - displayEnd) * itemHeight));
         firstTimeDrawingRows = false;
     }   // skipDisplaying
     if (!useFullHeight) ImGui::EndChild();
@@ -418,58 +436,349 @@ bool ListViewBase::render(float listViewHeight, const ImVector<int> *pOptionalCo
     return rowSelectionChanged; // Optional data we might want to expose: local variable: 'colSelectionChanged' and class variable: 'isInEditingMode'.
 }
 
+void ListViewBase::setFilter(const char* filterText,int filterColumn) {
+    ImStrncpy(m_filter.InputBuf,filterText ? filterText : "",IM_ARRAYSIZE(m_filter.InputBuf));
+    m_filter.Build();
+    m_filterColumn = filterColumn;
+    m_filterDirty = true;
+    m_filterIsExternal = onFilterChanged(m_filter,m_filterColumn);
+}
+
+bool ListViewBase::renderFilter(const char* label,float width) {
+    if (!m_filter.Draw(label,width)) return false;
+    m_filterDirty = true;
+    m_filterIsExternal = onFilterChanged(m_filter,m_filterColumn);
+    return true;
+}
+
+int ListViewBase::getNumDisplayedRows() const {
+    if (!mustFilterRows()) return (int) getNumRows();
+    if (m_filterDirty || m_filterNumRows!=getNumRows()) updateFilteredRows();
+    return m_filteredRows.size();
+}
+
+void ListViewBase::updateFilteredRows() const {
+    const size_t numRows = getNumRows();
+    const int numColumns = (int) getNumColumns();
+    m_filteredRows.resize(0);
+    if (m_filterNumRows!=numRows || m_filterTextsColumn!=m_filterColumn) m_filterTextsDirty = true;
+    m_filterNumRows = numRows;
+    m_filterDirty = false;
+    if (!mustFilterRows() || m_filterColumn>=numColumns) return;
+
+    if (m_filterTextsDirty) {
+        // We can't call updateHeaderData() here: render(...) uses it to detect the first frame
+        ImVector<HeaderData> tmpHeaderData;
+        if ((int)m_headerData.size()<numColumns) {
+            tmpHeaderData.resize(numColumns);
+            for (int col=0;col<numColumns;col++) {tmpHeaderData[col].reset();getHeaderData(col,tmpHeaderData[col]);}
+        }
+        ImVector<HeaderData>& headerData = tmpHeaderData.size()>0 ? tmpHeaderData : m_headerData;
+
+        // When filtering all the columns, we join the cell texts of each row with '\t' (so that "-excl" filters work as expected)
+        const int startColumn = m_filterColumn>=0 ? m_filterColumn : 0;
+        const int endColumn = m_filterColumn>=0 ? m_filterColumn+1 : numColumns;
+        m_filterTexts.resize(0);m_filterTextOffsets.resize((int)numRows*2);
+        CellData cd;
+        for (size_t row=0;row<numRows;row++) {
+            m_filterTextOffsets[row*2] = m_filterTexts.size();
+            for (int col=startColumn;col<endColumn;col++) {
+                HeaderData& hd = headerData[col];
+                cd.reset();getCellData(row,col,cd);
+                const char* txt = hd.type.headerType==HT_CUSTOM ? cd.customText : GetTextFromCellFieldDataPtr(hd,cd.fieldPtr);
+                if (!txt) txt = "";
+                const int len = (int) strlen(txt);
+                if (col>startColumn) m_filterTexts.push_back('\t');
+                if (len>0) {const int sz = m_filterTexts.size();m_filterTexts.resize(sz+len);memcpy(&m_filterTexts[sz],txt,len);}
+            }
+            m_filterTextOffsets[row*2+1] = m_filterTexts.size();
+            m_filterTexts.push_back('\0');   // needed: ImStristr(...) can read past the end of the haystack while matching
+        }
+        m_filterTexts.push_back('\0');
+        m_filterTextsColumn = m_filterColumn;
+        m_filterTextsDirty = false;
+    }
+
+    const char* texts = &m_filterTexts[0];
+    for (size_t row=0;row<numRows;row++) {
+        if (m_filter.PassFilter(texts+m_filterTextOffsets[row*2],texts+m_filterTextOffsets[row*2+1])) m_filteredRows.push_back((int)row);
+    }
+}
+
+void ListViewBase::permuteFilterTexts(const ImVector<int>& newToOldRows) const {
+    m_filterDirty = true;
+    if (m_filterTextsDirty || m_filterTextOffsets.size()!=newToOldRows.size()*2) {m_filterTextsDirty = true;return;}
+    ImVector<int> offsets;offsets.resize(m_filterTextOffsets.size());
+    for (int i=0,isz=newToOldRows.size();i<isz;i++) {
+        const int oldRow = newToOldRows[i];
+        offsets[i*2] = m_filterTextOffsets[oldRow*2];
+        offsets[i*2+1] = m_filterTextOffsets[oldRow*2+1];
+    }
+    m_filterTextOffsets.swap(offsets);
+}
+
+// ListView::sort(...) extracts the sorting keys of all the rows once (in the UI thread, through ItemBase::getDataPtr(...)), and then sorts
+// a row permutation with a LSD radix sort on them (in a worker thread when the rows are many). The values are mapped to ImU64 keys that
+// preserve their order (inverted for descending sorting). Strings use their first 8 bytes as key (= collation key): ties are broken with
+// strcmp(...) on a copy of the rest of the strings, so that the worker thread never touches the items.
+struct ListViewSortJob {
+    int numRows;
+    int numKeys;                    // ImU64 keys per row (one per sorted array element)
+    ImVector<ImU64> keys;           // numRows*numKeys
+    bool ascending;
+    bool hasStrings;
+    ImVector<char> strings;         // zero terminated tails (after the first 8 bytes) of the strings that are not shorter than 8 bytes
+    ImVector<int> stringOffsets;    // per row offset in strings (or -1)
+    ImVector<int> perm;             // result: perm[i] is the index (in ListView::items) of the row that goes to position i
+#   ifdef IMGUILISTVIEW_HAS_THREADS
+    volatile int cancelRequested;
+    volatile int finished;          // 0: queued or running, 1: finished (the ListView owns the job), 2: abandoned by the ListView (the task destroys the job)
+#   endif //IMGUILISTVIEW_HAS_THREADS
+
+    ListViewSortJob() : numRows(0),numKeys(0),ascending(true),hasStrings(false) {
+#       ifdef IMGUILISTVIEW_HAS_THREADS
+        cancelRequested=finished=0;
+#       endif //IMGUILISTVIEW_HAS_THREADS
+    }
+    inline static ListViewSortJob* Create() {
+        ListViewSortJob* job = (ListViewSortJob*) ImGui::MemAlloc(sizeof(ListViewSortJob));
+        IM_PLACEMENT_NEW(job) ListViewSortJob();
+        return job;
+    }
+    inline static void Destroy(ListViewSortJob* job) {
+        job->~ListViewSortJob();
+        ImGui::MemFree(job);
+    }
+
+    inline static ImU64 KeyFromInt(int v)           {return (ImU64) (((unsigned)v)^0x80000000U);}
+    inline static ImU64 KeyFromFloat(float v)       {
+        if (v==0.f) v=0.f;  // -0.f == 0.f
+        unsigned u;memcpy(&u,&v,sizeof(u));
+        return (ImU64) ((u&0x80000000U) ? ~u : (u|0x80000000U));
+    }
+    inline static ImU64 KeyFromDouble(double v)     {
+        if (v==0.0) v=0.0;  // -0.0 == 0.0
+        ImU64 u;memcpy(&u,&v,sizeof(u));
+        const ImU64 signBit = ((ImU64)1)<<63;
+        return (u&signBit) ? ~u : (u|signBit);
+    }
+    inline static ImU64 KeyFromString(const char* s) {
+        ImU64 k = 0;
+        for (int i=0;i<8;i++) {k<<=8;if (*s) k|=(unsigned char)*s++;}
+        return k;
+    }
+
+    // UI thread
+    bool init(const ImVector<ListView::ItemBase*>& items,size_t column,ListViewBase::HeaderType headerType,const int* arrayIndices,bool _ascending) {
+        numRows = items.size();ascending = _ascending;
+        hasStrings = (headerType==ListViewBase::HT_STRING || headerType==ListViewBase::HT_CUSTOM);
+        if (hasStrings) numKeys = 1;
+        else if (headerType==ListViewBase::HT_ICON) numKeys = 3;
+        else {numKeys = 0;while (numKeys<4 && arrayIndices[numKeys]>=0) ++numKeys;}
+        if (numKeys==0) return false;
+        keys.resize(numRows*numKeys);
+        if (hasStrings) {stringOffsets.resize(numRows);strings.resize(0);}
+        for (int row=0;row<numRows;row++) {
+            const ListView::ItemBase* it = items[row];
+            ImU64* k = &keys[row*numKeys];
+            if (hasStrings) {
+                const char* s = headerType==ListViewBase::HT_CUSTOM ? it->getCustomText(column) : (const char*) it->getDataPtr(column);
+                if (!s) s = "";
+                k[0] = KeyFromString(s);
+                int& offset = stringOffsets[row];offset = -1;
+                if ((k[0]&0xFF)!=0) {
+                    // The key does not contain the whole string: we need its tail to break ties
+                    const int len = (int) strlen(&s[8])+1;
+                    offset = strings.size();
+                    strings.resize(offset+len);
+                    memcpy(&strings[offset],&s[8],len);
+                }
+            }
+            else {
+                const void* ptr = it->getDataPtr(column);
+                if (headerType==ListViewBase::HT_ICON) {
+                    const ListViewBase::CellData::IconData& id = *((const ListViewBase::CellData::IconData*) ptr);
+                    k[0] = (ImU64) (size_t) id.user_texture_id;
+                    k[1] = KeyFromFloat(id.uv0.y);
+                    k[2] = KeyFromFloat(id.uv0.x);
+                }
+                else for (int ki=0;ki<numKeys;ki++) {
+                    const int ai = arrayIndices[ki];
+                    switch (headerType) {
+                    case ListViewBase::HT_INT:
+                    case ListViewBase::HT_ENUM:     k[ki] = KeyFromInt(*((const int*)ptr+ai));break;
+                    case ListViewBase::HT_UNSIGNED: k[ki] = (ImU64) *((const unsigned*)ptr+ai);break;
+                    case ListViewBase::HT_FLOAT:
+                    case ListViewBase::HT_COLOR:    k[ki] = KeyFromFloat(*((const float*)ptr+ai));break;
+                    case ListViewBase::HT_DOUBLE:   k[ki] = KeyFromDouble(*((const double*)ptr+ai));break;
+                    case ListViewBase::HT_BOOL:     k[ki] = *((const bool*)ptr+ai) ? 0 : 1;break;   // true comes first
+                    default: return false;
+                    }
+                }
+            }
+            if (!ascending) for (int ki=0;ki<numKeys;ki++) k[ki] = ~k[ki];
+        }
+        return true;
+    }
+
+    inline bool isCancelled() {
+#       ifdef IMGUILISTVIEW_HAS_THREADS
+        return ImGuiHelper::AtomicLoad(&cancelRequested)!=0;
+#       else //IMGUILISTVIEW_HAS_THREADS
+        return false;
+#       endif //IMGUILISTVIEW_HAS_THREADS
+    }
+    inline int compareStrings(int row0,int row1) const {
+        const int rv = strcmp(&strings[stringOffsets[row0]],&strings[stringOffsets[row1]]);
+        return ascending ? rv : -rv;
+    }
+    void sortByStrings(int* v,int* tmp,int n) const {
+        // Stable merge sort (insertion sort for small ranges)
+        if (n<=16) {
+            for (int i=1;i<n;i++) {
+                const int x = v[i];int j = i;
+                while (j>0 && compareStrings(v[j-1],x)>0) {v[j]=v[j-1];--j;}
+                v[j] = x;
+            }
+            return;
+        }
+        const int h = n/2;
+        sortByStrings(v,tmp,h);sortByStrings(v+h,tmp,n-h);
+        if (compareStrings(v[h-1],v[h])<=0) return;
+        memcpy(tmp,v,h*sizeof(int));
+        int i=0,j=h,o=0;
+        while (i<h && j<n) v[o++] = (compareStrings(v[j],tmp[i])<0) ? v[j++] : tmp[i++];
+        while (i<h) v[o++] = tmp[i++];
+    }
+
+    // Worker thread (or UI thread)
+    void run() {
+        perm.resize(numRows);
+        for (int i=0;i<numRows;i++) perm[i]=i;
+        if (numRows<2) return;
+        ImVector<int> tmpPerm;tmpPerm.resize(numRows);
+        ImVector<ImU64> cur,tmpCur;cur.resize(numRows);tmpCur.resize(numRows);
+        static const int numDigits = (int)sizeof(ImU64);
+        int counts[numDigits][256];
+        // LSD: from the least significant key to the most significant one (each pass is stable)
+        for (int ki=numKeys-1;ki>=0;ki--) {
+            if (isCancelled()) return;
+            memset(counts,0,sizeof(counts));
+            for (int i=0;i<numRows;i++) {
+                const ImU64 k = cur[i] = keys[perm[i]*numKeys+ki];
+                for (int d=0;d<numDigits;d++) ++counts[d][(k>>(d*8))&0xFF];
+            }
+            for (int d=0;d<numDigits;d++) {
+                const int shift = d*8;
+                int* c = counts[d];
+                if (c[(cur[0]>>shift)&0xFF]==numRows) continue;    // all the keys share this digit
+                if (isCancelled()) return;
+                for (int b=0,sum=0;b<256;b++) {const int cnt=c[b];c[b]=sum;sum+=cnt;}
+                for (int i=0;i<numRows;i++) {
+                    const int dst = c[(cur[i]>>shift)&0xFF]++;
+                    tmpCur[dst] = cur[i];tmpPerm[dst] = perm[i];
+                }
+                cur.swap(tmpCur);perm.swap(tmpPerm);
+            }
+        }
+        if (hasStrings) {
+            // Break ties among strings with the same (full) 8 bytes key
+            for (int i=0;i<numRows;) {
+                int j = i+1;
+                while (j<numRows && cur[j]==cur[i]) ++j;
+                const ImU64 k = ascending ? cur[i] : ~cur[i];
+                if (j-i>1 && (k&0xFF)!=0) sortByStrings(&perm[i],&tmpPerm[0],j-i);
+                i = j;
+            }
+        }
+    }
+#   ifdef IMGUILISTVIEW_HAS_THREADS
+    static void RunTask(void* userPtr) {
+        ListViewSortJob& j = *((ListViewSortJob*)userPtr);
+        j.run();
+        // the ListView can use (or destroy) the job after this, unless it has abandoned it
+        if (!ImGuiHelper::AtomicCompareAndSwap(&j.finished,0,1)) Destroy(&j);
+    }
+    inline bool isFinished() {return ImGuiHelper::AtomicLoad(&finished)==1;}
+#   endif //IMGUILISTVIEW_HAS_THREADS
+
+    // UI thread
+    void apply(ImVector<ListView::ItemBase*>& items) const {
+        IM_ASSERT(perm.size()==items.size());
+        ImVector<ListView::ItemBase*> sorted;sorted.resize(items.size());
+        for (int i=0,isz=items.size();i<isz;i++) sorted[i] = items[perm[i]];
+        items.swap(sorted);
+    }
+};
+
 bool ListView::sort(size_t column) {
     if ((int)column>=headers.size()) return false;
     Header& h = headers[column];
     HeaderData::Sorting& hds = h.hd.sorting;
     if (!hds.sortable) return false;
 
-    // void qsort( void *ptr, size_t count, size_t size,int (*comp)(const void *, const void *) );
+    cancelSorting();
     bool& sortingOrder = hds.sortingAscending;
-    ItemBase::SortingHelper sorter((int)column,sortingOrder,&hds.sortableElementsOfPossibleArray[0]);   // This IS actually used!
-    typedef int (*CompareDelegate)(const void *, const void *);
-    CompareDelegate compareFunction = NULL;
-
-    switch (h.hd.type.headerType)  {
-    case HT_BOOL:
-        compareFunction = ItemBase::SortingHelper::Compare_HT_BOOL;
-        break;
-    case HT_CUSTOM:
-        compareFunction = ItemBase::SortingHelper::Compare_HT_CUSTOM;
-        break;
-    case HT_INT:
-    case HT_ENUM:
-        compareFunction = ItemBase::SortingHelper::Compare<int>;
-        break;
-    case HT_UNSIGNED:
-        compareFunction = ItemBase::SortingHelper::Compare<unsigned>;
-        break;
-    case HT_FLOAT:
-    case HT_COLOR:
-        compareFunction = ItemBase::SortingHelper::Compare<float>;
-        break;
-    case HT_DOUBLE:
-        compareFunction = ItemBase::SortingHelper::Compare<double>;
-        break;
-    case HT_STRING:
-        compareFunction = ItemBase::SortingHelper::Compare<char*>;
-        break;
-    case HT_ICON:
-        compareFunction = ItemBase::SortingHelper::Compare_HT_ICON;
-        break;
-    default:
+    ListViewSortJob* job = ListViewSortJob::Create();
+    if (!job->init(items,column,h.hd.type.headerType,&hds.sortableElementsOfPossibleArray[0],sortingOrder)) {
+        ListViewSortJob::Destroy(job);
         return false;
     }
-    if (!compareFunction) return false;
-
-    qsort((void *) &items[0],items.size(),sizeof(ItemBase*),compareFunction);
     sortingOrder = !sortingOrder;   // next time it sorts backwards
 
+#   ifdef IMGUILISTVIEW_HAS_THREADS
+    if (minNumRowsForBackgroundSorting>0 && items.size()>=minNumRowsForBackgroundSorting) {
+        // render(...) keeps displaying the old order and applies the new one when it's ready (see updateSorting())
+        sortJob = job;
+        ImGuiHelper::ThreadPool::GetDefault().enqueue(&ListViewSortJob::RunTask,job);
+        return true;
+    }
+#   endif //IMGUILISTVIEW_HAS_THREADS
+
+    job->run();
+    job->apply(items);
+    permuteFilterTexts(job->perm);
+    ListViewSortJob::Destroy(job);
+
     updateSelectedRow(); // rows get shuffled after sorting: the visible selection is still correct (the boolean flag ItemBase::selected is stored in our row-item),
     // but the 'selectedRow' field is not updated and must be adjusted
     return true;
 }
 
+bool ListView::updateSorting() const {
+#   ifdef IMGUILISTVIEW_HAS_THREADS
+    if (!sortJob || !sortJob->isFinished()) return false;
+    ListViewSortJob* job = sortJob;sortJob = NULL;
+    const bool ok = (job->perm.size()==items.size());    // otherwise the user has added or removed some items in the meantime
+    if (ok) {
+        ListView* lv = const_cast<ListView*>(this);
+        job->apply(lv->items);
+        permuteFilterTexts(job->perm);
+        lv->updateSelectedRow();
+    }
+    ListViewSortJob::Destroy(job);
+    return ok;
+#   else //IMGUILISTVIEW_HAS_THREADS
+    return false;
+#   endif //IMGUILISTVIEW_HAS_THREADS
+}
+
+void ListView::cancelSorting() {
+#   ifdef IMGUILISTVIEW_HAS_THREADS
+    if (!sortJob) return;
+    // We don't wait for the job: it can still be queued behind other tasks of the pool. If it hasn't finished, it's abandoned
+    // (it doesn't touch the items: it just stops as soon as it can and destroys itself).
+    ImGuiHelper::AtomicStore(&sortJob->cancelRequested,1);
+    if (!ImGuiHelper::AtomicCompareAndSwap(&sortJob->finished,0,2)) ListViewSortJob::Destroy(sortJob);
+    sortJob = NULL;
+#   endif //IMGUILISTVIEW_HAS_THREADS
+}
+
+bool ListView::render(float listViewHeight, const ImVector<int> *pOptionalColumnReorderVector, int maxNumColumnToDisplay, float contentRegionWidthForHorizontalScrolling) const {
+    if (sortJob) updateSorting();
+    return ListViewBase::render(listViewHeight,pOptionalColumnReorderVector,maxNumColumnToDisplay,contentRegionWidthForHorizontalScrolling);
+}
+
 #ifndef IMGUILISTVIEW_NOTESTDEMO
 class MyListViewTestItem : public ImGui::ListView::ItemBase {
 public:
@@ -574,6 +883,8 @@ void TestListView() {
     }
     */
 
+    lv.renderFilter("Filter rows (inc,-exc)");                   // optional: row filtering (lv.setFilter(...) can be used to filter a single column)
+
     static int maxListViewHeight=200;                             // optional: by default is -1 = as height as needed
     ImGui::SliderInt("ListView Height",&maxListViewHeight,-1,500);// Just Testing "maxListViewHeight" here:
 
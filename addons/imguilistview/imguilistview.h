@@ -53,6 +53,10 @@
 /*
 LAST REVISION:
 --------------
+-> ListView::sort(...) does not call qsort(...) with a virtual getDataPtr(...) per comparison anymore: it extracts the sorting keys once and sorts a row permutation with
+   a radix sort (strings use cached collation keys). With many rows (ListView::minNumRowsForBackgroundSorting) and imguihelper threads, it runs in a worker thread.
+   Strings (HT_STRING and HT_CUSTOM) are now sorted by their text (with strcmp order).
+-> Added row filtering to ListViewBase (setFilter(...), renderFilter(...)): only the rows that pass the filter are clipped and displayed.
 -> Added a new first argument of ListViewBase::render(...) called "listViewHeight": it defaults to -1 (= full height), but can be set
    to the maximum height of the list view in pixel. Handy if something must be drawn below a long list view.
 -> Added "columnWidth" argument to the ListView::Header::ctr(...) to define the starting column witdh in pixels (default is -1=auto).
@@ -284,7 +288,8 @@ public:
     // end virtual methods that can/must be implemented by derived classes:-----------
 
     // ctr dctr
-    ListViewBase() : selectedRow(-1),selectedColumn(-1),editingModePresent(false),editorAllowed(false),scrollToRow(-1),lastSortedColumn(-1),firstTimeDrawingRows(true),/*colorEditingMode(ImGuiColorEditMode_RGB),*/popupMenuOpenAtSelectedColumn(-1),selectedRowPopupMenu(NULL),selectedRowPopupMenuUserData(NULL) {}
+    ListViewBase() : selectedRow(-1),selectedColumn(-1),editingModePresent(false),editorAllowed(false),scrollToRow(-1),lastSortedColumn(-1),firstTimeDrawingRows(true),/*colorEditingMode(ImGuiColorEditMode_RGB),*/popupMenuOpenAtSelectedColumn(-1),selectedRowPopupMenu(NULL),selectedRowPopupMenuUserData(NULL),
+    m_filterColumn(-1),m_filterDirty(true),m_filterNumRows(0),m_filterTextsDirty(true),m_filterTextsColumn(-1),m_filterIsExternal(false) {}
     virtual ~ListViewBase() {}
 
     // (single) selection API
@@ -367,9 +372,21 @@ public:
     }
 
     float getMaxPossibleHeight() const {
-        return ImGui::GetTextLineHeightWithSpacing()*((float)getNumRows()+0.25f);
+        return ImGui::GetTextLineHeightWithSpacing()*((float)getNumDisplayedRows()+0.25f);
     }
 
+    // Row filtering: when the filter is active only the rows whose cell text (in 'filterColumn', or in any column when 'filterColumn'<0) passes it are displayed.
+    // The syntax is the one of ImGuiTextFilter ("incl,-excl"). The cell texts are cached, so that changing the filter text does not format all the cells again:
+    // the cache is rebuilt when the filter column or the number of rows change. Call invalidateFilter() after changing some cell values.
+    // Derived classes can filter the rows by themselves (see onFilterChanged(...)).
+    IMGUI_API void setFilter(const char* filterText,int filterColumn=-1);
+    IMGUI_API bool renderFilter(const char* label="Filter (inc,-exc)",float width=0.f);    // Draws the filter text box (ImGuiTextFilter::Draw(...)). Returns true when the filter changes.
+    void clearFilter() {m_filter.Clear();m_filterDirty=true;m_filterIsExternal=onFilterChanged(m_filter,m_filterColumn);}
+    inline void invalidateFilter() const {m_filterDirty=m_filterTextsDirty=true;}
+    inline bool isFilterActive() const {return m_filter.IsActive();}
+    inline int getFilterColumn() const {return m_filterColumn;}
+    IMGUI_API int getNumDisplayedRows() const;  // getNumRows() or the number of rows that pass the filter
+
     //ImGuiColorEditMode getColorEditingMode() const {return colorEditingMode;}
     //void setColorEditingMode(ImGuiColorEditMode mode) {colorEditingMode = mode;}
 
@@ -386,6 +403,23 @@ private:
     mutable int popupMenuOpenAtSelectedColumn;
     PopupMenuDelegate selectedRowPopupMenu;
     void* selectedRowPopupMenuUserData;
+    ImGuiTextFilter m_filter;
+    int m_filterColumn;
+    mutable bool m_filterDirty;
+    mutable size_t m_filterNumRows;         // getNumRows() when m_filteredRows was built
+    mutable ImVector<int> m_filteredRows;   // ascending row indices that pass m_filter (used only when m_filter is active)
+    mutable bool m_filterTextsDirty;
+    mutable int m_filterTextsColumn;        // m_filterColumn when m_filterTexts was built
+    mutable ImVector<char> m_filterTexts;   // cached cell texts of m_filterTextsColumn (or of all the columns, joined by '\t'), one per row
+    mutable ImVector<int> m_filterTextOffsets;  // 2 per row: [begin,end) of the row text in m_filterTexts
+    bool m_filterIsExternal;                // the last onFilterChanged(...) returned true
+    void updateFilteredRows() const;
+    inline bool mustFilterRows() const {return m_filter.IsActive() && !m_filterIsExternal;}
+protected:
+    // Called when the filter changes. Derived classes that can filter the rows faster by themselves (e.g. in a database query) can override it:
+    // when it returns true, the rows are not filtered (nor their cell texts cached) here, so getNumRows() and getCellData(...) must already skip the rows that don't pass the filter.
+    virtual bool onFilterChanged(const ImGuiTextFilter& /*filter*/,int /*filterColumn*/) {return false;}
+    IMGUI_API void permuteFilterTexts(const ImVector<int>& newToOldRows) const; // keeps the filter cache valid after the rows have been reordered (e.g. by sorting)
     template<typename T> inline static T GetRadiansToDegs() {
         static T factor = T(180)/(3.1415926535897932384626433832795029);
         return factor;
@@ -565,6 +599,7 @@ public:
 };
 
 
+struct ListViewSortJob;
 
 class ListView : public ListViewBase {
 public:
@@ -696,9 +731,15 @@ public:
         friend class ListView;
     };
     ImVector<Header>    headers;    // one per column
-    ImVector<ItemBase*> items;      // one per row
+    ImVector<ItemBase*> items;      // one per row (please don't add or remove items while isSorting() is true)
+
+    // When threads are available (imguihelper), sort(...) on at least this number of rows runs in a worker thread:
+    // the old row order keeps being displayed until the sorted one is ready. Set it to -1 to always sort synchronously.
+    int minNumRowsForBackgroundSorting;
 public:
+    ListView() : minNumRowsForBackgroundSorting(100000),sortJob(NULL) {}
     virtual ~ListView() {
+        cancelSorting();
         for (size_t i=0,isz=items.size();i<isz;i++) {
             ItemBase*& item = items[i];
             item->~ItemBase();              // ImVector does not call it
@@ -730,11 +771,17 @@ public:
     }
 
     IMGUI_API bool sort(size_t column);
+    IMGUI_API virtual bool render(float listViewHeight=-1, const ImVector<int> *pOptionalColumnReorderVector=NULL, int maxNumColumnToDisplay=-1, float contentRegionWidthForHorizontalScrolling=-1) const;
 
     size_t getNumColumns() const {return headers.size();}
     size_t getNumRows() const {return items.size();}
 
+    inline bool isSorting() const {return sortJob!=NULL;}
+    IMGUI_API void cancelSorting();     // discards the background sorting (if any)
+
 protected:
+    mutable ListViewSortJob* sortJob;
+    bool updateSorting() const;         // applies the result of a finished background sorting
 
 };
 typedef ListView::Header ListViewHeader;
@@ -305,6 +305,9 @@ bool NodeGraphEditor::Style::Edit(NodeGraphEditor::Style& s) {
     changed|=ImGui::DragFloat(  "link_control_point_distance",&s.link_control_point_distance,dragSpeed,10.f,200.f,prec);
     changed|=ImGui::DragInt(  "link_num_segments",&s.link_num_segments,dragSpeed,0,16.f);
     ImGui::Spacing();
+    changed|=ImGui::DragFloat(  "lod_zoom_threshold",&s.lod_zoom_threshold,0.01f,0.f,1.f,"%1.2f");
+    if (ImGui::IsItemHovered()) ImGui::SetTooltip("%s","Below this zoom factor nodes are drawn as plain boxes\nand links as straight lines (0 = never).");
+    ImGui::Spacing();
     changed|=ImGui::ColorEdit4( "color_node_title",&s.color_node_title.x);
     changed|=ImGui::EditColorImU32( "color_node_title_background",s.color_node_title_background);
     changed|=ImGui::DragFloat("color_node_title_background_gradient",&s.color_node_title_background_gradient,0.01f,0.f,.5f,"%1.3f");
@@ -354,6 +357,7 @@ bool NodeGraphEditor::Style::Save(const NodeGraphEditor::Style &style,ImGuiHelpe
     s.save(ImGui::FT_FLOAT,&style.link_line_width,"link_line_width");
     s.save(ImGui::FT_FLOAT,&style.link_control_point_distance,"link_control_point_distance");
     s.save(ImGui::FT_INT,&style.link_num_segments,"link_num_segments");
+    s.save(ImGui::FT_FLOAT,&style.lod_zoom_threshold,"lod_zoom_threshold");
 
     s.save(ImGui::FT_COLOR,&style.color_node_title.x,"color_node_title",4);
     tmpColor = ImColor(style.color_node_title_background);s.save(ImGui::FT_COLOR,&tmpColor.x,"color_node_title_background",4);
@@ -381,6 +385,7 @@ static bool StyleParser(ImGuiHelper::FieldType ft,int /*numArrayElements*/,void*
         else if (strcmp(name,"link_line_width")==0)                         s.link_line_width = tmp.x;
         else if (strcmp(name,"link_control_point_distance")==0)             s.link_control_point_distance = tmp.x;
         else if (strcmp(name,"color_node_title_background_gradient")==0)    s.color_node_title_background_gradient = tmp.x;
+        else if (strcmp(name,"lod_zoom_threshold")==0)                      s.lod_zoom_threshold = tmp.x;
     break;
     case FT_INT:
         if (strcmp(name,"link_num_segments")==0)                            s.link_num_segments = *((int*)pValue);
@@ -488,6 +493,7 @@ void NodeGraphEditor::render()
 {
     if (!inited) inited=true;
     static const ImVec4 transparent = ImVec4(1,1,1,0);
+    if (evaluationEnabled) updateEvaluation();
 
     const ImGuiIO io = ImGui::GetIO();
 
@@ -738,7 +744,8 @@ void NodeGraphEditor::render()
 
                 if (io.KeyCtrl && ImGui::GetCurrentWindow()==GImGui->HoveredWindow && (io.MouseWheel || io.MouseClicked[2]))   {
                     // Zoom / Scale window
-                    float new_font_scale = ImClamp(fontScaleToTrack + g.IO.MouseWheel * 0.075f, 0.50f, 2.50f);
+                    const float min_font_scale = style.lod_zoom_threshold>0.f ? 0.15f : 0.50f;    // nodes are drawn as plain boxes below style.lod_zoom_threshold, so we can zoom out further
+                    float new_font_scale = ImClamp(fontScaleToTrack + g.IO.MouseWheel * 0.075f, min_font_scale, 2.50f);
                     if (io.MouseClicked[2]) new_font_scale = 1.f;   // MMB = RESET ZOOM
                     float scale = new_font_scale/fontScaleToTrack;
                     if (scale!=1)	{
@@ -763,7 +770,8 @@ void NodeGraphEditor::render()
                 nodesHaveZeroSize = true;
                 for (int i=0,isz=nodes.size();i<isz;i++)    {
                     Node* node = nodes[i];
-                    node->Size = ImVec2(0,0);   // we must reset the size
+                    // we must reset the size: we rescale the last measured one (if any), so that culling keeps working until the node is measured again
+                    node->Size = node->lodSize.x>0.f ? (node->lodSize*currentFontWindowScale + style.node_window_padding + style.node_window_padding) : ImVec2(0,0);
                 }
                 // These two lines makes the scaling work around the mouse position AFAICS
                 if (io.FontAllowUserScaling)	{
@@ -779,6 +787,9 @@ void NodeGraphEditor::render()
                 oldFontWindowScale = currentFontWindowScale;
                 maxConnectorNameWidth = 0.f;
             }
+            // Level of detail: when zoomed out, nodes are drawn as plain boxes (no widgets, no text) and links as straight lines
+            const bool lodMode = style.lod_zoom_threshold>0.f && currentFontWindowScale<style.lod_zoom_threshold;
+            const float nodeRounding = lodMode ? 0.f : style.node_rounding;
 
             const float NODE_SLOT_RADIUS = style.node_slots_radius*currentFontWindowScale;
             const float NODE_SLOT_RADIUS_SQUARED = (NODE_SLOT_RADIUS*NODE_SLOT_RADIUS);
@@ -873,8 +884,14 @@ void NodeGraphEditor::render()
                 const ImVec2 nodePos = node->GetPos(currentFontWindowScale);
                 if (activeNode==node) activeNodeIndex = node_idx;
 
+                if (lodMode) {
+                    // No widgets are emitted: we rescale the content size measured at the last full-detail frame
+                    const ImVec2 contentSize = node->lodSize.x>0.f ? node->lodSize : ImVec2(node->baseWidthOverride>0 ? node->baseWidthOverride : nodesBaseWidth,ImGui::GetTextLineHeightWithSpacing()/currentFontWindowScale);
+                    node->Size = contentSize*currentFontWindowScale + NODE_WINDOW_PADDING + NODE_WINDOW_PADDING;
+                }
+
                 // culling attempt
-                if (enableNodeCulling && !nodesHaveZeroSize) {
+                if (enableNodeCulling && node->Size.x>0.f) {
                     const ImRect cullRect(nodePos,nodePos+node->Size);
                     if (!windowClipRect.Overlaps(cullRect)) {
                         ++numberOfCulledNodes;
@@ -893,199 +910,202 @@ void NodeGraphEditor::render()
 
                 // Display node contents first
                 draw_list->ChannelsSetCurrent(activeNodeIndex==node_idx ? 4 : 2); // Foreground
-                bool old_any_active = ImGui::IsAnyItemActive();
-                ImGui::SetCursorScreenPos(node_rect_min + NODE_WINDOW_PADDING);
-
-                bool nodeInEditMode = false;
-                ImGui::BeginGroup(); // Lock horizontal position
-                ImGui::SetNextTreeNodeOpen(node->isOpen,ImGuiCond_Always);
-
+                bool nodeInEditMode = false, node_widgets_active = false;
                 ImU32 titleTextColorU32 = 0, titleBgColorU32 = 0;float titleBgGradient = -1.f;
                 node->getDefaultTitleBarColors(titleTextColorU32,titleBgColorU32,titleBgGradient);
-
-                ImVec4 titleTextColor = node->overrideTitleTextColor ? ImGui::ColorConvertU32ToFloat4(node->overrideTitleTextColor) : titleTextColorU32 ? ImGui::ColorConvertU32ToFloat4(titleTextColorU32) : style.color_node_title;
-                if (titleTextColor.w==0.f) titleTextColor = defaultTextColor;
-                ImGui::PushStyleColor(ImGuiCol_Text,titleTextColor);    // titleTextColor (these 3 lines can be moved down to leave the TreeNode triangle always 'defaultTextColor')
-
-                ImGui::PushStyleColor(ImGuiCol_Header,transparent);ImGui::PushStyleColor(ImGuiCol_HeaderActive,transparent);ImGui::PushStyleColor(ImGuiCol_HeaderHovered,transparent);    // Moved from outside loop
-                if (ImGui::TreeNode(node,"%s","")) {ImGui::TreePop();node->isOpen = true;}
-                else node->isOpen = false;
-                ImGui::PopStyleColor(3);   // Moved from outside loop
-                ImGui::SameLine(0,2);
-
-                // titleTextColor: the 3 lines above can be moved here  to leave the TreeNode triangle always 'defaultTextColor'
-                static char NewNodeName[IMGUINODE_MAX_NAME_LENGTH]="";
-                static bool mustStartEditingNodeName = false;
-                if (!node->isInEditingMode) {
-                    ImGui::Text("%s",node->Name);
-                    if (ImGui::IsItemHovered()) {
-                        const char* tooltip = node->getTooltip();
-			if (tooltip && tooltip[0]!='\0') {
-			    ImGuiStyle& igStyle = ImGui::GetStyle();
-			    igStyle.WindowPadding.x = igStyle.WindowPadding.y =4.f;
-			    ImGui::SetTooltip("%s",tooltip);
-			    igStyle.WindowPadding.x = igStyle.WindowPadding.y =0.f;
-			}
-                        if (isLMBDoubleClicked) {
-                            nodeThatIsBeingEditing = node;
-                            node->isInEditingMode = mustStartEditingNodeName = true;
-                            strcpy(&NewNodeName[0],node->Name);
+                if (!lodMode) {
+                    bool old_any_active = ImGui::IsAnyItemActive();
+                    ImGui::SetCursorScreenPos(node_rect_min + NODE_WINDOW_PADDING);
+
+                    ImGui::BeginGroup(); // Lock horizontal position
+                    ImGui::SetNextTreeNodeOpen(node->isOpen,ImGuiCond_Always);
+
+                    ImVec4 titleTextColor = node->overrideTitleTextColor ? ImGui::ColorConvertU32ToFloat4(node->overrideTitleTextColor) : titleTextColorU32 ? ImGui::ColorConvertU32ToFloat4(titleTextColorU32) : style.color_node_title;
+                    if (titleTextColor.w==0.f) titleTextColor = defaultTextColor;
+                    ImGui::PushStyleColor(ImGuiCol_Text,titleTextColor);    // titleTextColor (these 3 lines can be moved down to leave the TreeNode triangle always 'defaultTextColor')
+
+                    ImGui::PushStyleColor(ImGuiCol_Header,transparent);ImGui::PushStyleColor(ImGuiCol_HeaderActive,transparent);ImGui::PushStyleColor(ImGuiCol_HeaderHovered,transparent);    // Moved from outside loop
+                    if (ImGui::TreeNode(node,"%s","")) {ImGui::TreePop();node->isOpen = true;}
+                    else node->isOpen = false;
+                    ImGui::PopStyleColor(3);   // Moved from outside loop
+                    ImGui::SameLine(0,2);
+
+                    // titleTextColor: the 3 lines above can be moved here  to leave the TreeNode triangle always 'defaultTextColor'
+                    static char NewNodeName[IMGUINODE_MAX_NAME_LENGTH]="";
+                    static bool mustStartEditingNodeName = false;
+                    if (!node->isInEditingMode) {
+                        ImGui::Text("%s",node->Name);
+                        if (ImGui::IsItemHovered()) {
+                            const char* tooltip = node->getTooltip();
+			    if (tooltip && tooltip[0]!='\0') {
+			        ImGuiStyle& igStyle = ImGui::GetStyle();
+			        igStyle.WindowPadding.x = igStyle.WindowPadding.y =4.f;
+			        ImGui::SetTooltip("%s",tooltip);
+			        igStyle.WindowPadding.x = igStyle.WindowPadding.y =0.f;
+			    }
+                            if (isLMBDoubleClicked) {
+                                nodeThatIsBeingEditing = node;
+                                node->isInEditingMode = mustStartEditingNodeName = true;
+                                strcpy(&NewNodeName[0],node->Name);
+                            }
                         }
                     }
-                }
-                else {
-                    if (mustStartEditingNodeName) {ImGui::SetKeyboardFocusHere();}
-                    if (ImGui::InputText("###imguiNodeGraphEditorNodeRename",NewNodeName,IMGUINODE_MAX_NAME_LENGTH,ImGuiInputTextFlags_EnterReturnsTrue))   {
-                        if (NewNodeName[0]!='\0' && strcmp(node->Name,NewNodeName)!=0) overrideNodeName(node,NewNodeName);
-                        node->isInEditingMode = mustStartEditingNodeName = false;
-                        nodeThatIsBeingEditing = NULL;
-                    }
-                    else if (!mustStartEditingNodeName && !ImGui::IsItemActive()) {
-                        node->isInEditingMode = mustStartEditingNodeName = false;
+                    else {
+                        if (mustStartEditingNodeName) {ImGui::SetKeyboardFocusHere();}
+                        if (ImGui::InputText("###imguiNodeGraphEditorNodeRename",NewNodeName,IMGUINODE_MAX_NAME_LENGTH,ImGuiInputTextFlags_EnterReturnsTrue))   {
+                            if (NewNodeName[0]!='\0' && strcmp(node->Name,NewNodeName)!=0) overrideNodeName(node,NewNodeName);
+                            node->isInEditingMode = mustStartEditingNodeName = false;
+                            nodeThatIsBeingEditing = NULL;
+                        }
+                        else if (!mustStartEditingNodeName && !ImGui::IsItemActive()) {
+                            node->isInEditingMode = mustStartEditingNodeName = false;
+                        }
+                        mustStartEditingNodeName = false;
                     }
-                    mustStartEditingNodeName = false;
-                }
-                ImGui::PopStyleColor();                                 // titleTextColor
-
-                // Note: if node->isOpen, we'll draw the buttons later, because we need node->Size that is not known
-                // BUTTONS ========================================================
-                const bool canPaste = sourceCopyNode && sourceCopyNode->typeID==node->typeID;
-                const bool canCopy = node->canBeCopied();
-                static const ImVec4 transparentColor(1,1,1,0);
-                const ImVec2 nodeTitleBarButtonsStartCursor = node->isOpen ? ImGui::GetCursorPos() : ImVec2(0,0);
-                if (!node->isOpen && !node->isInEditingMode)    {
-                    ImGui::SameLine();
-                    //== Actual code to draw buttons (same code is copied below) =====================
-                    ImGui::PushStyleColor(ImGuiCol_Button,transparentColor);
-                    ImGui::PushStyleColor(ImGuiCol_ButtonHovered,ImVec4(0.75,0.75,0.75,0.5));
-                    ImGui::PushStyleColor(ImGuiCol_ButtonActive,ImVec4(0.75,0.75,0.75,0.77));
-                    ImGui::PushStyleColor(ImGuiCol_Text,titleTextColor);
-                    ImGui::PushID("NodeButtons");
-                    if (show_node_copy_paste_buttons)   {
-                        static const ImVec2 vec2zero(0,0);
-                        ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing,vec2zero);
-                        ImGui::PushStyleVar(ImGuiStyleVar_ItemInnerSpacing,vec2zero);
-                        if (canPaste) {
-                            if (ImGui::SmallButton(NodeGraphEditor::CloseCopyPasteChars[2])) {
-                                node_to_paste_from_copy_source = node_hovered_in_scene = node;
+                    ImGui::PopStyleColor();                                 // titleTextColor
+
+                    // Note: if node->isOpen, we'll draw the buttons later, because we need node->Size that is not known
+                    // BUTTONS ========================================================
+                    const bool canPaste = sourceCopyNode && sourceCopyNode->typeID==node->typeID;
+                    const bool canCopy = node->canBeCopied();
+                    static const ImVec4 transparentColor(1,1,1,0);
+                    const ImVec2 nodeTitleBarButtonsStartCursor = node->isOpen ? ImGui::GetCursorPos() : ImVec2(0,0);
+                    if (!node->isOpen && !node->isInEditingMode)    {
+                        ImGui::SameLine();
+                        //== Actual code to draw buttons (same code is copied below) =====================
+                        ImGui::PushStyleColor(ImGuiCol_Button,transparentColor);
+                        ImGui::PushStyleColor(ImGuiCol_ButtonHovered,ImVec4(0.75,0.75,0.75,0.5));
+                        ImGui::PushStyleColor(ImGuiCol_ButtonActive,ImVec4(0.75,0.75,0.75,0.77));
+                        ImGui::PushStyleColor(ImGuiCol_Text,titleTextColor);
+                        ImGui::PushID("NodeButtons");
+                        if (show_node_copy_paste_buttons)   {
+                            static const ImVec2 vec2zero(0,0);
+                            ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing,vec2zero);
+                            ImGui::PushStyleVar(ImGuiStyleVar_ItemInnerSpacing,vec2zero);
+                            if (canPaste) {
+                                if (ImGui::SmallButton(NodeGraphEditor::CloseCopyPasteChars[2])) {
+                                    node_to_paste_from_copy_source = node_hovered_in_scene = node;
+                                }
+			        if (ImGui::IsItemHovered()) NodeGraphEditorSetTooltip("Paste");
+                                ImGui::SameLine(0);
                             }
-			    if (ImGui::IsItemHovered()) NodeGraphEditorSetTooltip("Paste");
-                            ImGui::SameLine(0);
-                        }
-                        if (canCopy)	{
-                            if (ImGui::SmallButton(NodeGraphEditor::CloseCopyPasteChars[1])) {
-                                node_hovered_in_scene = node;
-                                copyNode(node);
+                            if (canCopy)	{
+                                if (ImGui::SmallButton(NodeGraphEditor::CloseCopyPasteChars[1])) {
+                                    node_hovered_in_scene = node;
+                                    copyNode(node);
+                                }
+			        if (ImGui::IsItemHovered()) NodeGraphEditorSetTooltip("Copy");
+                                ImGui::SameLine(0);
                             }
-			    if (ImGui::IsItemHovered()) NodeGraphEditorSetTooltip("Copy");
-                            ImGui::SameLine(0);
                         }
-                    }
-                    if (ImGui::SmallButton(NodeGraphEditor::CloseCopyPasteChars[0])) {
-                        node_hovered_in_scene = node;
-                        if (!hasLinks(node))  {menuNode = node;mustDeleteANodeSoon=true;}
-                        else {
-                            menuNode = node;
-                            open_delete_only_context_menu = true;  // will ask to delete node later
+                        if (ImGui::SmallButton(NodeGraphEditor::CloseCopyPasteChars[0])) {
+                            node_hovered_in_scene = node;
+                            if (!hasLinks(node))  {menuNode = node;mustDeleteANodeSoon=true;}
+                            else {
+                                menuNode = node;
+                                open_delete_only_context_menu = true;  // will ask to delete node later
+                            }
                         }
+		        if (ImGui::IsItemHovered()) NodeGraphEditorSetTooltip("Delete");
+		        if (show_node_copy_paste_buttons) ImGui::PopStyleVar(2);
+                        ImGui::PopID();
+                        ImGui::PopStyleColor(4);
+                        //== End actual code to draw buttons (same code is copied below) ====================
                     }
-		    if (ImGui::IsItemHovered()) NodeGraphEditorSetTooltip("Delete");
-		    if (show_node_copy_paste_buttons) ImGui::PopStyleVar(2);
-                    ImGui::PopID();
-                    ImGui::PopStyleColor(4);
-                    //== End actual code to draw buttons (same code is copied below) ====================
-                }
-                //=================================================================
+                    //=================================================================
 
-                ImGui::Spacing();
+                    ImGui::Spacing();
 
-                if (node->isOpen)
-                {
-                    if (!node->isInEditingMode) ImGui::Spacing();
-                    // ------------------------------------------------------------------
-                    //ImGui::BeginGroup();
-                    // this code goes into a virtual method==============================
-                    nodeInEditMode|=node->render(currentNodeWidth);
-                    //===================================================================
-                    //ImGui::EndGroup();
-                    //-------------------------------------------------------------------
-                    isLMBDraggingForMakingLinks&=!nodeInEditMode;   // Don't create links while dragging the mouse to edit node values
-                }
-                ImGui::EndGroup();
-                if (nodeInEditMode) node->startEditingTime = -1.f;
-                else if (node->startEditingTime!=0.f) {
-                    //if (nodeCallback)   {
-                    if (node->startEditingTime<0) node->startEditingTime = ImGui::GetTime();
-                    else if (ImGui::GetTime()-node->startEditingTime>nodeEditedTimeThreshold) {
-                        node->startEditingTime = 0.f;
-                        node_to_fire_edit_callback = node;
+                    if (node->isOpen)
+                    {
+                        if (!node->isInEditingMode) ImGui::Spacing();
+                        // ------------------------------------------------------------------
+                        //ImGui::BeginGroup();
+                        // this code goes into a virtual method==============================
+                        nodeInEditMode|=node->render(currentNodeWidth);
+                        if (nodeInEditMode) markNodeDirty(node);
+                        //===================================================================
+                        //ImGui::EndGroup();
+                        //-------------------------------------------------------------------
+                        isLMBDraggingForMakingLinks&=!nodeInEditMode;   // Don't create links while dragging the mouse to edit node values
+                    }
+                    ImGui::EndGroup();
+                    if (nodeInEditMode) node->startEditingTime = -1.f;
+                    else if (node->startEditingTime!=0.f) {
+                        //if (nodeCallback)   {
+                        if (node->startEditingTime<0) node->startEditingTime = ImGui::GetTime();
+                        else if (ImGui::GetTime()-node->startEditingTime>nodeEditedTimeThreshold) {
+                            node->startEditingTime = 0.f;
+                            node_to_fire_edit_callback = node;
+                        }
+                        //}
+                        //else node->startEditingTime = 0.f;
                     }
-                    //}
-                    //else node->startEditingTime = 0.f;
-                }
-
-                // Save the size of what we have emitted and whether any of the widgets are being used
-                bool node_widgets_active = (!old_any_active && ImGui::IsAnyItemActive());
-                node->Size = ImGui::GetItemRectSize() + NODE_WINDOW_PADDING + NODE_WINDOW_PADDING;
-                ImVec2 node_rect_max = node_rect_min + node->Size;
 
-                // Go backwards and display title bar buttons if node->isOpen
-                // BUTTONS ========================================================
-                if (node->Size.x!=0 && !node->isInEditingMode)    {
-                    const ImVec2 cursorPosToRestore = ImGui::GetCursorPos();
-                    ImGui::SetCursorPos(nodeTitleBarButtonsStartCursor);
-                    //--------------------------------------------
-                    ImGui::SameLine(-effectiveScrolling.x+nodePos.x+node->Size.x-textSizeButtonX-10
-                                    -(show_node_copy_paste_buttons ?
-                                          (
-                                              (canCopy?(textSizeButtonCopy+2):0) +
-                                              (canPaste?(textSizeButtonPaste+2):0)
-                                              )
-                                        : 0)
-                                    ,0);
-                    //== Actual code to draw buttons (same code is copied below) =====================
-                    ImGui::PushStyleColor(ImGuiCol_Button,transparentColor);
-                    ImGui::PushStyleColor(ImGuiCol_ButtonHovered,ImVec4(0.75,0.75,0.75,0.5));
-                    ImGui::PushStyleColor(ImGuiCol_ButtonActive,ImVec4(0.75,0.75,0.75,0.77));
-                    ImGui::PushStyleColor(ImGuiCol_Text,titleTextColor);
-                    ImGui::PushID("NodeButtons");
-                    if (show_node_copy_paste_buttons)   {
-                        static const ImVec2 vec2zero(0,0);
-                        ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing,vec2zero);
-                        ImGui::PushStyleVar(ImGuiStyleVar_ItemInnerSpacing,vec2zero);
-                        if (canPaste) {
-                            if (ImGui::SmallButton(NodeGraphEditor::CloseCopyPasteChars[2])) {
-                                node_to_paste_from_copy_source = node_hovered_in_scene = node;
+                    // Save the size of what we have emitted and whether any of the widgets are being used
+                    node_widgets_active = (!old_any_active && ImGui::IsAnyItemActive());
+                    node->Size = ImGui::GetItemRectSize() + NODE_WINDOW_PADDING + NODE_WINDOW_PADDING;
+                    node->lodSize = (node->Size - NODE_WINDOW_PADDING - NODE_WINDOW_PADDING)/currentFontWindowScale;
+
+                    // Go backwards and display title bar buttons if node->isOpen
+                    // BUTTONS ========================================================
+                    if (node->Size.x!=0 && !node->isInEditingMode)    {
+                        const ImVec2 cursorPosToRestore = ImGui::GetCursorPos();
+                        ImGui::SetCursorPos(nodeTitleBarButtonsStartCursor);
+                        //--------------------------------------------
+                        ImGui::SameLine(-effectiveScrolling.x+nodePos.x+node->Size.x-textSizeButtonX-10
+                                        -(show_node_copy_paste_buttons ?
+                                              (
+                                                  (canCopy?(textSizeButtonCopy+2):0) +
+                                                  (canPaste?(textSizeButtonPaste+2):0)
+                                                  )
+                                            : 0)
+                                        ,0);
+                        //== Actual code to draw buttons (same code is copied below) =====================
+                        ImGui::PushStyleColor(ImGuiCol_Button,transparentColor);
+                        ImGui::PushStyleColor(ImGuiCol_ButtonHovered,ImVec4(0.75,0.75,0.75,0.5));
+                        ImGui::PushStyleColor(ImGuiCol_ButtonActive,ImVec4(0.75,0.75,0.75,0.77));
+                        ImGui::PushStyleColor(ImGuiCol_Text,titleTextColor);
+                        ImGui::PushID("NodeButtons");
+                        if (show_node_copy_paste_buttons)   {
+                            static const ImVec2 vec2zero(0,0);
+                            ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing,vec2zero);
+                            ImGui::PushStyleVar(ImGuiStyleVar_ItemInnerSpacing,vec2zero);
+                            if (canPaste) {
+                                if (ImGui::SmallButton(NodeGraphEditor::CloseCopyPasteChars[2])) {
+                                    node_to_paste_from_copy_source = node_hovered_in_scene = node;
+                                }
+			        if (ImGui::IsItemHovered()) NodeGraphEditorSetTooltip("Paste");
+                                ImGui::SameLine(0);
                             }
-			    if (ImGui::IsItemHovered()) NodeGraphEditorSetTooltip("Paste");
-                            ImGui::SameLine(0);
-                        }
-                        if (canCopy)	{
-                            if (ImGui::SmallButton(NodeGraphEditor::CloseCopyPasteChars[1])) {
-                                node_hovered_in_scene = node;
-                                copyNode(node);
+                            if (canCopy)	{
+                                if (ImGui::SmallButton(NodeGraphEditor::CloseCopyPasteChars[1])) {
+                                    node_hovered_in_scene = node;
+                                    copyNode(node);
+                                }
+			        if (ImGui::IsItemHovered()) NodeGraphEditorSetTooltip("Copy");
+                                ImGui::SameLine(0);
                             }
-			    if (ImGui::IsItemHovered()) NodeGraphEditorSetTooltip("Copy");
-                            ImGui::SameLine(0);
                         }
-                    }
-                    if (ImGui::SmallButton(NodeGraphEditor::CloseCopyPasteChars[0])) {
-                        node_hovered_in_scene = node;
-                        if (!hasLinks(node))  {menuNode = node;mustDeleteANodeSoon=true;}
-                        else {
-                            menuNode = node;
-                            open_delete_only_context_menu = true;  // will ask to delete node later
+                        if (ImGui::SmallButton(NodeGraphEditor::CloseCopyPasteChars[0])) {
+                            node_hovered_in_scene = node;
+                            if (!hasLinks(node))  {menuNode = node;mustDeleteANodeSoon=true;}
+                            else {
+                                menuNode = node;
+                                open_delete_only_context_menu = true;  // will ask to delete node later
+                            }
                         }
+		        if (ImGui::IsItemHovered()) NodeGraphEditorSetTooltip("Delete");
+                        if (show_node_copy_paste_buttons) ImGui::PopStyleVar(2);
+                        ImGui::PopID();
+                        ImGui::PopStyleColor(4);
+                        //== End actual code to draw buttons (same code is copied below) ====================
+                        //-----------------------------------------------------------
+                        ImGui::SetCursorPos(cursorPosToRestore);
                     }
-		    if (ImGui::IsItemHovered()) NodeGraphEditorSetTooltip("Delete");
-                    if (show_node_copy_paste_buttons) ImGui::PopStyleVar(2);
-                    ImGui::PopID();
-                    ImGui::PopStyleColor(4);
-                    //== End actual code to draw buttons (same code is copied below) ====================
-                    //-----------------------------------------------------------
-                    ImGui::SetCursorPos(cursorPosToRestore);
+                    //=================================================================
                 }
-                //=================================================================
+                ImVec2 node_rect_max = node_rect_min + node->Size;
 
 
                 // Display node box
@@ -1140,7 +1160,7 @@ void NodeGraphEditor::render()
                                                                                                                                      (node->isSelected ? style.color_node_selected :
                                                                                                                                                          style.color_node));
 
-                draw_list->AddRectFilled(node_rect_min, node_rect_max, node_bg_color, style.node_rounding); // Bg
+                draw_list->AddRectFilled(node_rect_min, node_rect_max, node_bg_color, nodeRounding); // Bg
 
                 // Node Title Bg Color
                 const ImU32 nodeTitleBgColor = node->overrideTitleBgColor ? node->overrideTitleBgColor : titleBgColorU32 ? titleBgColorU32 : style.color_node_title_background;
@@ -1149,17 +1169,17 @@ void NodeGraphEditor::render()
 #                   ifndef SKIP_VERTICAL_GRADIENT
                     float fillGradientFactor = node->overrideTitleBgColorGradient>=0.f ? node->overrideTitleBgColorGradient : titleBgGradient>=0.f ? titleBgGradient : style.color_node_title_background_gradient;//0.15f;
                     if (node->isSelected) fillGradientFactor = -fillGradientFactor; // or if (node==activeNode)
-                    if (fillGradientFactor!=0.f)    {
-                        if (node->isOpen) ImGui::NGE_Draw::ImDrawListAddRectWithVerticalGradient(draw_list,node_rect_min, ImVec2(node_rect_max.x,node_rect_min.y+nodeTitleBarBgHeight), nodeTitleBgColor,fillGradientFactor,IM_COL32_BLACK_TRANS,style.node_rounding,1|2);
-                        else ImGui::NGE_Draw::ImDrawListAddRectWithVerticalGradient(draw_list,node_rect_min, node_rect_max, nodeTitleBgColor,fillGradientFactor,IM_COL32_BLACK_TRANS, style.node_rounding);
+                    if (fillGradientFactor!=0.f && !lodMode)    {
+                        if (node->isOpen) ImGui::NGE_Draw::ImDrawListAddRectWithVerticalGradient(draw_list,node_rect_min, ImVec2(node_rect_max.x,node_rect_min.y+nodeTitleBarBgHeight), nodeTitleBgColor,fillGradientFactor,IM_COL32_BLACK_TRANS,nodeRounding,1|2);
+                        else ImGui::NGE_Draw::ImDrawListAddRectWithVerticalGradient(draw_list,node_rect_min, node_rect_max, nodeTitleBgColor,fillGradientFactor,IM_COL32_BLACK_TRANS, nodeRounding);
                     }
                     else {
-                        if (node->isOpen) draw_list->AddRectFilled(node_rect_min, ImVec2(node_rect_max.x,node_rect_min.y+nodeTitleBarBgHeight), nodeTitleBgColor, style.node_rounding,1|2);
-                        else draw_list->AddRectFilled(node_rect_min, node_rect_max, nodeTitleBgColor, style.node_rounding);
+                        if (node->isOpen) draw_list->AddRectFilled(node_rect_min, ImVec2(node_rect_max.x,node_rect_min.y+nodeTitleBarBgHeight), nodeTitleBgColor, nodeRounding,1|2);
+                        else draw_list->AddRectFilled(node_rect_min, node_rect_max, nodeTitleBgColor, nodeRounding);
                     }
 #                   else // SKIP_VERTICAL_GRADIENT
-                    if (node->isOpen) draw_list->AddRectFilled(node_rect_min, ImVec2(node_rect_max.x,node_rect_min.y+nodeTitleBarBgHeight), nodeTitleBgColor, style.node_rounding,1|2);
-                    else draw_list->AddRectFilled(node_rect_min, node_rect_max, nodeTitleBgColor, style.node_rounding);
+                    if (node->isOpen) draw_list->AddRectFilled(node_rect_min, ImVec2(node_rect_max.x,node_rect_min.y+nodeTitleBarBgHeight), nodeTitleBgColor, nodeRounding,1|2);
+                    else draw_list->AddRectFilled(node_rect_min, node_rect_max, nodeTitleBgColor, nodeRounding);
 #                   undef SKIP_VERTICAL_GRADIENT
 #                   endif // SKIP_VERTICAL_GRADIENT
                 }
@@ -1171,7 +1191,7 @@ void NodeGraphEditor::render()
                                                                                            ((node_hovered_in_list == node || node_hovered_in_scene == node) ? style.color_node_frame_hovered :
                                                                                                                                                               style.color_node_frame));
                 const float lineThickness = ((activeNode == node) ? 3.0f : (node->isSelected ? 2.0f : 1.f))*currentFontWindowScale;
-                draw_list->AddRect(node_rect_min, node_rect_max, node_frame_color, style.node_rounding,0x0F,lineThickness);    // Frame
+                draw_list->AddRect(node_rect_min, node_rect_max, node_frame_color, nodeRounding,0x0F,lineThickness);    // Frame
 
                 // Line below node name
                 if (node->isOpen) {
@@ -1186,8 +1206,9 @@ void NodeGraphEditor::render()
                 const ImVec2 oldCursorScreenPos = ImGui::GetCursorScreenPos();
                 const ImVec2 mouseScreenPos = io.MousePos;;
                 ImVec2 connectorScreenPos,deltaPos;const bool canDeleteLinks = true;
-                const bool mustDeleteLinkIfSlotIsHovered = canDeleteLinks && io.MouseDoubleClicked[0];
-                const bool mustDetectIfSlotIsHoveredForDragNDrop = !cantDragAnything && !isSomeNodeMoving && (!isDragNodeValid || isLMBDraggingForMakingLinks);
+                const bool mustDeleteLinkIfSlotIsHovered = canDeleteLinks && io.MouseDoubleClicked[0] && !lodMode;
+                const bool mustDetectIfSlotIsHoveredForDragNDrop = !cantDragAnything && !isSomeNodeMoving && (!isDragNodeValid || isLMBDraggingForMakingLinks) && !lodMode;
+                const bool mustShowConnectionNames = show_connection_names && !lodMode;
                 ImGui::PushStyleColor(ImGuiCol_Text,style.color_node_input_slots_names);
                 const float connectorBorderThickness = NODE_SLOT_RADIUS*0.25f; // lineThickness = ((activeNode == node) ? 3.0f : (node->isSelected ? 2.0f : 1.f))*currentFontWindowScale;
                 ImVec2 connectorNameSize(0,0);
@@ -1200,7 +1221,7 @@ void NodeGraphEditor::render()
                 draw_list->PathArcTo(connectorScreenPos, NODE_SLOT_RADIUS, IM_PI-a_max, IM_PI+a_max, 12);
                 draw_list->PathFill(style.color_node_input_slots);
             }*/
-                    if (show_connection_names && node->InputNames[slot_idx][0]!='\0')   {
+                    if (mustShowConnectionNames && node->InputNames[slot_idx][0]!='\0')   {
                         const char* name = node->InputNames[slot_idx];
                         if (name)   {
                             connectorNameSize = ImGui::CalcTextSize(name);
@@ -1216,16 +1237,7 @@ void NodeGraphEditor::render()
                             if (mustDeleteLinkIfSlotIsHovered)  {
                                 // remove the link
                                 //printf("To be removed: input slot %d.\n",slot_idx);fflush(stdout);
-                                for (int link_idx=0;link_idx<links.size();link_idx++)   {
-                                    NodeLink& link = links[link_idx];
-                                    if (link.OutputNode == node && slot_idx == link.OutputSlot)   {
-                                        if (linkCallback) linkCallback(link,LS_DELETED,*this);
-                                        // remove link
-                                        if (link_idx+1 < links.size()) link = links[links.size()-1];    // swap with the last link
-                                        links.resize(links.size()-1);
-                                        --link_idx;
-                                    }
-                                }
+                                removeAnyLinkFromNodeInputSlot(node,slot_idx);
                             }
                             else if (isLMBDraggingForMakingLinks && !isDragNodeValid) {
                                 dragNode.node = node;
@@ -1243,16 +1255,7 @@ void NodeGraphEditor::render()
                                     if (!avoidCircularLinkLoopsInOut || !isNodeReachableFrom(dragNode.node,true,node))  {
                                         if (allowOnlyOneLinkPerInputSlot)   {
                                             // Remove all existing node links to node-slot_idx before adding new link:
-                                            for (int link_idx=0;link_idx<links.size();link_idx++)   {
-                                                NodeLink& link = links[link_idx];
-                                                if (link.OutputNode == node && slot_idx == link.OutputSlot)   {
-                                                    if (linkCallback) linkCallback(link,LS_DELETED,*this);
-                                                    // remove link
-                                                    if (link_idx+1 < links.size()) link = links[links.size()-1];    // swap with the last link
-                                                    links.resize(links.size()-1);
-                                                    --link_idx;
-                                                }
-                                            }
+                                            removeAnyLinkFromNodeInputSlot(node,slot_idx);
                                         }
                                         // create link
                                         addLink(dragNode.node,dragNode.inputSlotIdx,node,slot_idx,true);
@@ -1277,7 +1280,7 @@ void NodeGraphEditor::render()
                 draw_list->PathArcTo(connectorScreenPos, NODE_SLOT_RADIUS, -a_max, a_max, 12);
                 draw_list->PathFill(style.color_node_output_slots);
             }*/
-                    if (show_connection_names && node->OutputNames[slot_idx][0]!='\0')   {
+                    if (mustShowConnectionNames && node->OutputNames[slot_idx][0]!='\0')   {
                         const char* name = node->OutputNames[slot_idx];
                         if (name)   {
                             connectorNameSize = ImGui::CalcTextSize(name);
@@ -1293,16 +1296,7 @@ void NodeGraphEditor::render()
                             if (mustDeleteLinkIfSlotIsHovered)  {
                                 // remove the link
                                 //printf("To be removed: output slot %d.\n",slot_idx);fflush(stdout);
-                                for (int link_idx=0;link_idx<links.size();link_idx++)   {
-                                    NodeLink& link = links[link_idx];
-                                    if (link.InputNode == node && slot_idx == link.InputSlot)   {
-                                        if (linkCallback) linkCallback(link,LS_DELETED,*this);
-                                        // remove link
-                                        if (link_idx+1 < links.size()) link = links[links.size()-1];    // swap with the last link
-                                        links.resize(links.size()-1);
-                                        --link_idx;
-                                    }
-                                }
+                                removeAnyLinkFromNodeOutputSlot(node,slot_idx);
                             }
                             else if (isLMBDraggingForMakingLinks && !isDragNodeValid) {
                                 dragNode.node = node;
@@ -1320,16 +1314,7 @@ void NodeGraphEditor::render()
                                     if (!avoidCircularLinkLoopsInOut || !isNodeReachableFrom(node,true,dragNode.node))    {
                                         if (allowOnlyOneLinkPerInputSlot)   {
                                             // Remove all existing node links to dragNode before adding new link:
-                                            for (int link_idx=0;link_idx<links.size();link_idx++)   {
-                                                NodeLink& link = links[link_idx];
-                                                if (link.OutputNode == dragNode.node && dragNode.outputSlotIdx == link.OutputSlot)   {
-                                                    if (linkCallback) linkCallback(link,LS_DELETED,*this);
-                                                    // remove link
-                                                    if (link_idx+1 < links.size()) link = links[links.size()-1];    // swap with the last link
-                                                    links.resize(links.size()-1);
-                                                    --link_idx;
-                                                }
-                                            }
+                                            removeAnyLinkFromNodeInputSlot(dragNode.node,dragNode.outputSlotIdx);
                                         }
                                         // create link
                                         addLink(node,slot_idx,dragNode.node,dragNode.outputSlotIdx,true);
@@ -1382,13 +1367,14 @@ void NodeGraphEditor::render()
 
                     // highlight nearest link
                     if (mustCheckForNearestLink && nearestLinkId==-1 && (enableLinkCulling ? cullLink.Contains(io.MousePos) : true)) {
-                        const float distanceSquared = GetSquaredDistanceToBezierCurve(io.MousePos,p1,cp1, cp2,p2);
+                        const float distanceSquared = lodMode ? ImLengthSqr(io.MousePos-ImLineClosestPoint(p1,p2,io.MousePos)) : GetSquaredDistanceToBezierCurve(io.MousePos,p1,cp1, cp2,p2);
                         if (distanceSquared<hoveredLinkDistSqrThres) nearestLinkId=link_idx;
                         // dbg line:
                         //if (io.MouseDelta.x!=0.f || io.MouseDelta.y!=0.f)   fprintf(stderr,"%d) MP{%1.0f,%1.0f} p1{%1.0f,%1.0f} p2{%1.0f,%1.0f} distanceSquared=%1.4f hoveredLinkDistSqrThres=%1.4f\n",link_idx,io.MousePos.x,io.MousePos.y,p1.x,p1.y,p2.x,p2.y,distanceSquared,hoveredLinkDistSqrThres);
                     }
 
-                    draw_list->AddBezierCurve(p1,cp1,cp2,p2,style.color_link,(nearestLinkId!=link_idx) ? link_line_width : (link_line_width*2.f), style.link_num_segments);
+                    if (lodMode) draw_list->AddLine(p1,p2,style.color_link,(nearestLinkId!=link_idx) ? link_line_width : (link_line_width*2.f));
+                    else draw_list->AddBezierCurve(p1,cp1,cp2,p2,style.color_link,(nearestLinkId!=link_idx) ? link_line_width : (link_line_width*2.f), style.link_num_segments);
                 }
                 if (nearestLinkId!=-1 && io.MouseReleased[0]) {
                     //fprintf(stderr,"Removing link at: %d\n",nearestLinkId);
@@ -1624,6 +1610,7 @@ void NodeGraphEditor::render()
     if (node_to_paste_from_copy_source && sourceCopyNode && node_to_paste_from_copy_source->typeID==sourceCopyNode->typeID) {
         node_to_paste_from_copy_source->fields.copyPDataValuesFrom(sourceCopyNode->fields);
         node_to_paste_from_copy_source->onCopied();
+        markNodeDirty(node_to_paste_from_copy_source);
     }
 
     if (node_to_fire_edit_callback) {
@@ -1675,30 +1662,70 @@ void NodeGraphEditor::registerNodeTypes(const char *nodeTypeNames[], int numNode
 
 }
 
+// Removes the first occurrence of 'value' from 'v' (swapping it with the last element)
+static inline void NodeLinkIndicesRemove(ImVector<int>& v,int value)   {
+    for (int i=0,isz=v.size();i<isz;i++)    {
+        if (v[i]==value) {
+            if (i+1<isz) v[i] = v[isz-1];
+            v.resize(isz-1);
+            return;
+        }
+    }
+    IM_ASSERT(false);   // adjacency lists out of sync with 'links'
+}
+// Replaces the first occurrence of 'oldValue' in 'v' with 'newValue'
+static inline void NodeLinkIndicesReplace(ImVector<int>& v,int oldValue,int newValue)   {
+    for (int i=0,isz=v.size();i<isz;i++)    {
+        if (v[i]==oldValue) {v[i]=newValue;return;}
+    }
+    IM_ASSERT(false);   // adjacency lists out of sync with 'links'
+}
 bool NodeGraphEditor::removeLinkAt(int link_idx) {
     if (link_idx<0 || link_idx>=links.size()) return false;
     // remove link
     NodeLink& link = links[link_idx];
     if (linkCallback) linkCallback(link,LS_DELETED,*this);
-    if (link_idx+1 < links.size()) link = links[links.size()-1];    // swap with the last link
-    links.resize(links.size()-1);
+    markNodeDirty(link.OutputNode);
+    NodeLinkIndicesRemove(link.InputNode->outputLinkIndices,link_idx);
+    NodeLinkIndicesRemove(link.OutputNode->inputLinkIndices,link_idx);
+    const int last_idx = links.size()-1;
+    if (link_idx < last_idx) {
+        // swap with the last link
+        link = links[last_idx];
+        NodeLinkIndicesReplace(link.InputNode->outputLinkIndices,last_idx,link_idx);
+        NodeLinkIndicesReplace(link.OutputNode->inputLinkIndices,last_idx,link_idx);
+    }
+    links.resize(last_idx);
     return true;
 }
 void NodeGraphEditor::removeAnyLinkFromNode(Node* node, bool removeInputLinks, bool removeOutputLinks)  {
-    for (int link_idx=0;link_idx<links.size();link_idx++)    {
-        NodeLink& link = links[link_idx];
-        if ((removeOutputLinks && link.InputNode==node) || (removeInputLinks && link.OutputNode==node))    {
-            // remove link
-            if (linkCallback) linkCallback(link,LS_DELETED,*this);
-            if (link_idx+1 < links.size()) link = links[links.size()-1];    // swap with the last link
-            links.resize(links.size()-1);
-            --link_idx;
-        }
+    if (removeInputLinks)   {
+        while (node->inputLinkIndices.size()>0) removeLinkAt(node->inputLinkIndices[node->inputLinkIndices.size()-1]);
+    }
+    if (removeOutputLinks)  {
+        while (node->outputLinkIndices.size()>0) removeLinkAt(node->outputLinkIndices[node->outputLinkIndices.size()-1]);
+    }
+}
+void NodeGraphEditor::removeAnyLinkFromNodeInputSlot(Node* node,int input_slot)  {
+    // removeLinkAt(...) swaps the removed entry with the last one: iterating backward we never skip an entry
+    for (int i=node->inputLinkIndices.size()-1;i>=0;i--)    {
+        const int link_idx = node->inputLinkIndices[i];
+        if (links[link_idx].OutputSlot==input_slot) removeLinkAt(link_idx);
+    }
+}
+void NodeGraphEditor::removeAnyLinkFromNodeOutputSlot(Node* node,int output_slot)  {
+    for (int i=node->outputLinkIndices.size()-1;i>=0;i--)    {
+        const int link_idx = node->outputLinkIndices[i];
+        if (links[link_idx].InputSlot==output_slot) removeLinkAt(link_idx);
     }
 }
 bool NodeGraphEditor::isLinkPresent(Node *inputNode, int input_slot, Node *outputNode, int output_slot,int* pOptionalIndexInLinkArrayOut) const  {
     if (pOptionalIndexInLinkArrayOut) *pOptionalIndexInLinkArrayOut=-1;
-    for (int link_idx=0;link_idx<links.size();link_idx++)    {
+    if (!inputNode || !outputNode) return false;
+    // Any link between the two nodes is in both adjacency lists: we scan the shorter one
+    const ImVector<int>& candidates = (inputNode->outputLinkIndices.size() <= outputNode->inputLinkIndices.size()) ? inputNode->outputLinkIndices : outputNode->inputLinkIndices;
+    for (int i=0,isz=candidates.size();i<isz;i++)    {
+        const int link_idx = candidates[i];
         const NodeLink& l = links[link_idx];
         if (l.InputNode==inputNode && l.InputSlot==input_slot &&
             l.OutputNode==outputNode && l.OutputSlot==output_slot) {
@@ -1709,11 +1736,7 @@ bool NodeGraphEditor::isLinkPresent(Node *inputNode, int input_slot, Node *outpu
     return false;
 }
 bool NodeGraphEditor::hasLinks(Node *node) const    {
-    for (int i=0,isz=links.size();i<isz;i++)    {
-        const NodeLink& l = links[i];
-        if (l.InputNode==node || l.OutputNode==node) return true;
-    }
-    return false;
+    return node->inputLinkIndices.size()>0 || node->outputLinkIndices.size()>0;
 }
 int NodeGraphEditor::getAllNodesOfType(int typeID, ImVector<Node *> *pNodesOut, bool clearNodesOutBeforeUsage)  {
     if (pNodesOut && clearNodesOutBeforeUsage) pNodesOut->clear();
@@ -1758,9 +1781,9 @@ void NodeGraphEditor::copyNode(Node *n)	{
 
 void NodeGraphEditor::getInputNodesForNodeAndSlot(const Node* node,int input_slot,ImVector<Node *> &returnValueOut, ImVector<int> *pOptionalReturnValueOutputSlotOut) const  {
     returnValueOut.clear();if (pOptionalReturnValueOutputSlotOut) pOptionalReturnValueOutputSlotOut->clear();
-    for (int link_idx=0,link_idx_size=links.size();link_idx<link_idx_size;link_idx++)   {
-        const NodeLink& link = links[link_idx];
-        if (link.OutputNode == node && link.OutputSlot == input_slot)  {
+    for (int i=0,isz=node->inputLinkIndices.size();i<isz;i++)   {
+        const NodeLink& link = links[node->inputLinkIndices[i]];
+        if (link.OutputSlot == input_slot)  {
             returnValueOut.push_back(link.InputNode);
             if (pOptionalReturnValueOutputSlotOut) pOptionalReturnValueOutputSlotOut->push_back(link.InputSlot);
         }
@@ -1768,9 +1791,9 @@ void NodeGraphEditor::getInputNodesForNodeAndSlot(const Node* node,int input_slo
 }
 Node* NodeGraphEditor::getInputNodeForNodeAndSlot(const Node* node,int input_slot,int* pOptionalReturnValueOutputSlotOut) const    {
     if (pOptionalReturnValueOutputSlotOut) *pOptionalReturnValueOutputSlotOut=-1;
-    for (int link_idx=0,link_idx_size=links.size();link_idx<link_idx_size;link_idx++)   {
-        const NodeLink& link = links[link_idx];
-        if (link.OutputNode == node && link.OutputSlot == input_slot)  {
+    for (int i=0,isz=node->inputLinkIndices.size();i<isz;i++)   {
+        const NodeLink& link = links[node->inputLinkIndices[i]];
+        if (link.OutputSlot == input_slot)  {
             if (pOptionalReturnValueOutputSlotOut) *pOptionalReturnValueOutputSlotOut = link.InputSlot;
             return link.InputNode;
         }
@@ -1779,36 +1802,50 @@ Node* NodeGraphEditor::getInputNodeForNodeAndSlot(const Node* node,int input_slo
 }
 void NodeGraphEditor::getOutputNodesForNodeAndSlot(const Node* node,int output_slot,ImVector<Node *> &returnValueOut, ImVector<int> *pOptionalReturnValueInputSlotOut) const {
     returnValueOut.clear();if (pOptionalReturnValueInputSlotOut) pOptionalReturnValueInputSlotOut->clear();
-    for (int link_idx=0,link_idx_size=links.size();link_idx<link_idx_size;link_idx++)   {
-        const NodeLink& link = links[link_idx];
-        if (link.InputNode == node && link.InputSlot == output_slot)  {
+    for (int i=0,isz=node->outputLinkIndices.size();i<isz;i++)   {
+        const NodeLink& link = links[node->outputLinkIndices[i]];
+        if (link.InputSlot == output_slot)  {
             returnValueOut.push_back(link.OutputNode);
             if (pOptionalReturnValueInputSlotOut) pOptionalReturnValueInputSlotOut->push_back(link.OutputSlot);
         }
     }
 }
+// Iterative depth-first search: every node is expanded at most once (Node::traversalMark is our 'visited' flag),
+// so the cost is linear in the number of links even on diamond-shaped graphs, and cycles can't make it loop forever.
 bool NodeGraphEditor::isNodeReachableFrom(const Node *node1, int slot1, bool goBackward,const Node* nodeToFind,int* pOptionalNodeToFindSlotOut) const    {
-
-    for (int i=0,isz=links.size();i<isz;i++)    {
-        const NodeLink& l = links[i];
-        if (goBackward)  {
-            if (l.OutputNode == node1 && l.OutputSlot == slot1) {
-                if (l.InputNode == nodeToFind) {
-                    if (pOptionalNodeToFindSlotOut) *pOptionalNodeToFindSlotOut = l.InputSlot;
-                    return true;
-                }
-                if (isNodeReachableFrom(l.InputNode,goBackward,nodeToFind,pOptionalNodeToFindSlotOut)) return true;
+    if (slot1<0) return false;
+    if (++traversalMark==0) {
+        // wrap around: reset all the marks
+        for (int i=0,isz=nodes.size();i<isz;i++) nodes[i]->traversalMark = 0;
+        traversalMark = 1;
+    }
+    const unsigned int mark = traversalMark;
+    ImVector<const Node*>& stack = traversalStack;
+    stack.resize(0);
+    node1->traversalMark = mark;
+    const Node* n = node1;
+    int slot = slot1;   // only links from slot1 are followed from node1; from the other nodes we follow all their (valid) slots
+    for (;;)    {
+        const ImVector<int>& linkIndices = goBackward ? n->inputLinkIndices : n->outputLinkIndices;
+        const int numSlots = goBackward ? n->InputsCount : n->OutputsCount;
+        for (int i=0,isz=linkIndices.size();i<isz;i++)  {
+            const NodeLink& l = links[linkIndices[i]];
+            const int nSlot = goBackward ? l.OutputSlot : l.InputSlot;
+            if (slot>=0 ? (nSlot!=slot) : (nSlot>=numSlots)) continue;
+            const Node* next = goBackward ? l.InputNode : l.OutputNode;
+            if (next == nodeToFind) {
+                if (pOptionalNodeToFindSlotOut) *pOptionalNodeToFindSlotOut = goBackward ? l.InputSlot : l.OutputSlot;
+                return true;
             }
-        }
-        else {
-            if (l.InputNode == node1 && l.InputSlot == slot1) {
-                if (l.OutputNode == nodeToFind) {
-                    if (pOptionalNodeToFindSlotOut) *pOptionalNodeToFindSlotOut = l.OutputSlot;
-                    return true;
-                }
-                if (isNodeReachableFrom(l.OutputNode,goBackward,nodeToFind,pOptionalNodeToFindSlotOut)) return true;
+            if (next->traversalMark!=mark)  {
+                next->traversalMark = mark;
+                stack.push_back(next);
             }
         }
+        if (stack.size()==0) break;
+        n = stack[stack.size()-1];
+        stack.pop_back();
+        slot = -1;
     }
     return false;
 }
@@ -1823,6 +1860,164 @@ bool NodeGraphEditor::isNodeReachableFrom(const Node *node1, bool goBackward,con
     return false;
 }
 
+#if (defined(IMGUIHELPER_H_) && defined(IMGUIHELPER_HAS_THREADS))
+#   define IMGUINODEGRAPHEDITOR_EVALUATION_THREADS
+#endif
+// A snapshot of the part of the graph that must be evaluated: the worker threads never access NodeGraphEditor::links.
+struct NodeGraphEvaluationPass {
+    ImVector<Node*> nodes;                      // in topological order
+    ImVector<int> numPendingInputs;             // per node: links from the nodes of the pass that haven't been evaluated yet
+    ImVector<int> successorStart,successors;    // successors of nodes[i]: successors[successorStart[i]...successorStart[i+1]) (indices into nodes, one per link)
+    ImVector<int> inputStart;                   // inputs of nodes[i]: inputs[inputStart[i]...inputStart[i+1])
+    ImVector<NodeEvaluationInput> inputs;
+    ImVector<char> evaluated;                   // per node: evaluate(...) has been called (nodes are skipped after the pass has been cancelled)
+    volatile int cancelled;                     // set by NodeGraphEditor::waitForEvaluation(): the nodes that haven't started yet are skipped
+    NodeGraphEvaluationPass() : cancelled(0) {}
+    void evaluateNode(int i) {
+#       ifdef IMGUINODEGRAPHEDITOR_EVALUATION_THREADS
+        if (ImGuiHelper::AtomicLoad(&cancelled)) return;
+#       endif //IMGUINODEGRAPHEDITOR_EVALUATION_THREADS
+        Node* n = nodes[i];
+        n->evaluate(inputs.Data+inputStart[i],inputStart[i+1]-inputStart[i]);
+        evaluated[i] = 1;
+    }
+#   ifdef IMGUINODEGRAPHEDITOR_EVALUATION_THREADS
+    struct Task {NodeGraphEvaluationPass* pass;int index;};
+    ImVector<Task> tasks;
+    volatile int numNodesToEvaluate;
+    volatile int finished;  // set by the last task as its very last access to the pass
+    ImGuiHelper::Event done;
+    static void RunTask(void* userPtr) {
+        const Task& t = *((const Task*) userPtr);
+        NodeGraphEvaluationPass* p = t.pass;const int i = t.index;
+        p->evaluateNode(i);
+        for (int j=p->successorStart[i],jsz=p->successorStart[i+1];j<jsz;j++)    {
+            const int s = p->successors[j];
+            if (ImGuiHelper::AtomicAdd((volatile int*)&p->numPendingInputs[s],-1)==0) ImGuiHelper::ThreadPool::GetDefault().enqueue(RunTask,&p->tasks[s]);
+        }
+        if (ImGuiHelper::AtomicAdd(&p->numNodesToEvaluate,-1)==0) {
+            p->done.signal();
+            ImGuiHelper::AtomicStore(&p->finished,1);   // p can't be accessed after this line
+        }
+    }
+#   endif //IMGUINODEGRAPHEDITOR_EVALUATION_THREADS
+};
+bool NodeGraphEditor::publishEvaluation(bool waitForCompletion) {
+    if (!evaluationPass) return false;
+    NodeGraphEvaluationPass* p = evaluationPass;
+#   ifdef IMGUINODEGRAPHEDITOR_EVALUATION_THREADS
+    if (waitForCompletion) {while (!ImGuiHelper::AtomicLoad(&p->finished)) p->done.wait(1);}
+    else if (!ImGuiHelper::AtomicLoad(&p->finished)) return true;
+#   else //IMGUINODEGRAPHEDITOR_EVALUATION_THREADS
+    (void)waitForCompletion;
+#   endif //IMGUINODEGRAPHEDITOR_EVALUATION_THREADS
+    for (int i=0,isz=p->nodes.size();i<isz;i++) {
+        Node* n = p->nodes[i];
+        n->evaluationIndex = -1;
+        if (p->evaluated[i]) n->onEvaluationEnd();
+        else n->evaluationDirty = evaluationNeeded = true;  // skipped by a cancelled pass: evaluated by the next one
+    }
+    p->~NodeGraphEvaluationPass();
+    ImGui::MemFree(p);
+    evaluationPass = NULL;
+    return false;
+}
+void NodeGraphEditor::waitForEvaluation() {
+    if (!evaluationPass) return;
+#   ifdef IMGUINODEGRAPHEDITOR_EVALUATION_THREADS
+    ImGuiHelper::AtomicStore(&evaluationPass->cancelled,1);
+#   endif //IMGUINODEGRAPHEDITOR_EVALUATION_THREADS
+    publishEvaluation(true);
+}
+bool NodeGraphEditor::updateEvaluation(bool waitForCompletion) {
+    // Publish a finished evaluation
+    if (publishEvaluation(waitForCompletion)) return true;
+    if (!evaluationNeeded || !evaluationEnabled) return false;
+    evaluationNeeded = false;
+
+    // Collect the dirty nodes and all the nodes downstream of them (they get a temporary evaluationIndex)
+    ImVector<Node*> affected;
+    for (int i=0,isz=nodes.size();i<isz;i++)    {
+        Node* n = nodes[i];
+        if (n->evaluationDirty) {n->evaluationDirty = false;n->evaluationIndex = affected.size();affected.push_back(n);}
+    }
+    for (int k=0;k<affected.size();k++) {
+        const Node* n = affected[k];
+        for (int j=0,jsz=n->outputLinkIndices.size();j<jsz;j++) {
+            Node* o = links[n->outputLinkIndices[j]].OutputNode;
+            if (o->evaluationIndex<0) {o->evaluationDirty = false;o->evaluationIndex = affected.size();affected.push_back(o);}
+        }
+    }
+    if (affected.size()==0) return false;
+
+    // Topological sort (Kahn): nodes in (or downstream of) a circuit never reach zero pending inputs and are left out
+    ImVector<int> pending;pending.resize(affected.size(),0);
+    for (int k=0;k<affected.size();k++) {
+        const Node* n = affected[k];
+        for (int j=0,jsz=n->inputLinkIndices.size();j<jsz;j++) {
+            if (links[n->inputLinkIndices[j]].InputNode->evaluationIndex>=0) ++pending[k];
+        }
+    }
+    ImVector<Node*> sorted;sorted.reserve(affected.size());
+    for (int k=0;k<affected.size();k++) {if (pending[k]==0) sorted.push_back(affected[k]);}
+    for (int k=0;k<sorted.size();k++)   {
+        const Node* n = sorted[k];
+        for (int j=0,jsz=n->outputLinkIndices.size();j<jsz;j++) {
+            Node* o = links[n->outputLinkIndices[j]].OutputNode;
+            if (--pending[o->evaluationIndex]==0) sorted.push_back(o);
+        }
+    }
+    for (int k=0;k<affected.size();k++) affected[k]->evaluationIndex = -1;
+    if (sorted.size()==0) return false;
+
+    // Build the pass
+    NodeGraphEvaluationPass* p = (NodeGraphEvaluationPass*) ImGui::MemAlloc(sizeof(NodeGraphEvaluationPass));
+    IM_PLACEMENT_NEW(p) NodeGraphEvaluationPass();
+    p->nodes.swap(sorted);
+    const int numNodes = p->nodes.size();
+    for (int i=0;i<numNodes;i++) p->nodes[i]->evaluationIndex = i;
+    p->numPendingInputs.resize(numNodes,0);
+    p->evaluated.resize(numNodes,0);
+    p->successorStart.resize(numNodes+1);p->inputStart.resize(numNodes+1);
+    for (int i=0;i<numNodes;i++)    {
+        Node* n = p->nodes[i];
+        p->successorStart[i] = p->successors.size();
+        for (int j=0,jsz=n->outputLinkIndices.size();j<jsz;j++) {
+            const int s = links[n->outputLinkIndices[j]].OutputNode->evaluationIndex;
+            if (s>=0) {p->successors.push_back(s);++p->numPendingInputs[s];}
+        }
+        p->inputStart[i] = p->inputs.size();
+        for (int slot=0;slot<n->InputsCount;slot++) {
+            NodeEvaluationInput in;in.node = NULL;in.outputSlot = -1;
+            for (int j=0,jsz=n->inputLinkIndices.size();j<jsz;j++) {
+                const NodeLink& l = links[n->inputLinkIndices[j]];
+                if (l.OutputSlot==slot) {in.node = l.InputNode;in.outputSlot = l.InputSlot;break;}
+            }
+            p->inputs.push_back(in);
+        }
+        n->onEvaluationBegin();
+    }
+    p->successorStart[numNodes] = p->successors.size();
+    p->inputStart[numNodes] = p->inputs.size();
+    evaluationPass = p;
+
+    // Run it
+#   ifdef IMGUINODEGRAPHEDITOR_EVALUATION_THREADS
+    if (evaluationUseWorkerThreads) {
+        p->numNodesToEvaluate = numNodes;p->finished = 0;
+        p->tasks.resize(numNodes);
+        for (int i=0;i<numNodes;i++) {p->tasks[i].pass = p;p->tasks[i].index = i;}
+        ImVector<int> roots;    // numPendingInputs is modified by the workers as soon as the first root is enqueued
+        for (int i=0;i<numNodes;i++) {if (p->numPendingInputs[i]==0) roots.push_back(i);}
+        for (int i=0;i<roots.size();i++) ImGuiHelper::ThreadPool::GetDefault().enqueue(NodeGraphEvaluationPass::RunTask,&p->tasks[roots[i]]);
+        return waitForCompletion ? publishEvaluation(true) : true;
+    }
+    p->numNodesToEvaluate = 0;p->finished = 1;
+#   endif //IMGUINODEGRAPHEDITOR_EVALUATION_THREADS
+    for (int i=0;i<numNodes;i++) p->evaluateNode(i);
+    return publishEvaluation(true);
+}
+
 int NodeGraphEditor::getSelectedNodes(ImVector<Node *> &rv) {
     rv.resize(0);
     for (int i=0,isz=nodes.size();i<isz;i++)	{
@@ -1893,14 +2088,7 @@ bool NodeGraphEditor::overrideNodeInputSlots(Node* n,const char *slotNamesSepara
     n->mustOverrideInputSlots = true;
     const int OldInputSlots = n->InputsCount;
     n->InputsCount = ProcessSlotNamesSeparatedBySemicolons<IMGUINODE_MAX_INPUT_SLOTS>(slotNamesSeparatedBySemicolons,n->InputNames);
-    for (int i=n->InputsCount;i<OldInputSlots;i++) {
-        for (int j=0,jsz=links.size();j<jsz;j++)  {
-            NodeLink& l = links[j];
-            if (l.OutputNode==n && l.OutputSlot==i)  {
-                if (removeLinkAt(j)) --j;
-            }
-        }
-    }
+    for (int i=n->InputsCount;i<OldInputSlots;i++) removeAnyLinkFromNodeInputSlot(n,i);
     return true;
 }
 bool NodeGraphEditor::overrideNodeOutputSlots(Node* n,const char *slotNamesSeparatedBySemicolons)  {
@@ -1908,14 +2096,7 @@ bool NodeGraphEditor::overrideNodeOutputSlots(Node* n,const char *slotNamesSepar
     n->mustOverrideOutputSlots = true;
     const int OldOutputSlots = n->OutputsCount;
     n->OutputsCount = ProcessSlotNamesSeparatedBySemicolons<IMGUINODE_MAX_OUTPUT_SLOTS>(slotNamesSeparatedBySemicolons,n->OutputNames);
-    for (int i=n->OutputsCount;i<OldOutputSlots;i++) {
-        for (int j=0,jsz=links.size();j<jsz;j++)  {
-            NodeLink& l = links[j];
-            if (l.InputNode==n && l.InputSlot==i)  {
-                if (removeLinkAt(j)) --j;
-            }
-        }
-    }
+    for (int i=n->OutputsCount;i<OldOutputSlots;i++) removeAnyLinkFromNodeOutputSlot(n,i);
     return true;
 }
 
@@ -1981,7 +2162,53 @@ bool FieldInfo::copyPDataValueFrom(const FieldInfo &f) {
     return true;
 }
 #if (defined(IMGUIHELPER_H_) && !defined(NO_IMGUIHELPER_SERIALIZATION))
+// Binary field record: {int type; int size;} followed by 'size' bytes, padded to 4 bytes
+static inline int FieldInfoBinaryElementSize(int type)  {
+    switch (type)   {
+    case FT_INT:
+    case FT_ENUM:       return (int)sizeof(int);
+    case FT_UNSIGNED:   return (int)sizeof(unsigned);
+    case FT_FLOAT:
+    case FT_COLOR:      return (int)sizeof(float);
+    case FT_DOUBLE:     return (int)sizeof(double);
+    case FT_BOOL:       return (int)sizeof(bool);
+    default:            return 0;
+    }
+}
+static inline int FieldInfoBinaryPaddedSize(int size) {return (size+3)&~3;}
 #ifndef NO_IMGUIHELPER_SERIALIZATION_SAVE
+static void FieldInfoBinaryAppend(ImVector<char>& b,int type,const void* data,int size)  {
+    const int start = b.size();
+    const int header[2] = {type,size};
+    b.resize(start+(int)sizeof(header)+FieldInfoBinaryPaddedSize(size));
+    memcpy(&b[start],header,sizeof(header));
+    char* dst = &b[start+(int)sizeof(header)];
+    if (size>0) memcpy(dst,data,size);
+    for (int i=size,isz=FieldInfoBinaryPaddedSize(size);i<isz;i++) dst[i]='\0';
+}
+bool FieldInfo::serializeBinary(ImVector<char>& b) const {
+    const int elemSize = FieldInfoBinaryElementSize(type);
+    if (elemSize>0) {
+        FieldInfoBinaryAppend(b,type,pdata,elemSize*(numArrayElements<=0 ? 1 : numArrayElements));
+        return true;
+    }
+    switch (type) {
+    case FT_STRING:
+    case FT_TEXTLINE:
+        FieldInfoBinaryAppend(b,type,pdata,(int)strlen((const char*)pdata));
+        return true;
+    case FT_CUSTOM: {
+        // We don't know its layout: we store what its delegate writes in the text format
+        ImGuiHelper::Serializer s(256);
+        const bool ok = serializeFieldDelegate && serializeFieldDelegate(s,*this);
+        FieldInfoBinaryAppend(b,type,s.getBuffer(),ok ? s.getBufferSize() : 0);
+        return ok;
+    }
+    default:
+        FieldInfoBinaryAppend(b,type,NULL,0);
+        return false;
+    }
+}
 bool FieldInfo::serialize(ImGuiHelper::Serializer& s) const   {
     const char* fieldName = label;    
     const int ft = this->type;
@@ -2076,6 +2303,43 @@ const char* FieldInfo::deserialize(const ImGuiHelper::Deserializer& d,const char
     IM_ASSERT(true);	// Parse Custom type
     return start;
 }
+const char* FieldInfo::deserializeBinary(const char* start,const char* end)   {
+    int header[2];
+    if (!start || end-start<(int)sizeof(header)) return NULL;
+    memcpy(header,start,sizeof(header));
+    const int size = header[1];
+    const char* data = start+sizeof(header);
+    if (size<0 || end-data<size) return NULL;
+    const char* next = data+FieldInfoBinaryPaddedSize(size);
+    if (next>end) next = end;
+    if (header[0]!=type) return next;   // the node field layout has changed: we keep the default value
+    const int elemSize = FieldInfoBinaryElementSize(type);
+    if (elemSize>0) {
+        const int maxSize = elemSize*(numArrayElements<=0 ? 1 : numArrayElements);
+        memcpy(pdata,data,size<maxSize ? size : maxSize);
+        return next;
+    }
+    switch (type) {
+    case FT_STRING:
+    case FT_TEXTLINE: {
+        int len = size;
+        if (precision>0 && precision<len+1) len = precision-1;
+        char* dst = (char*) pdata;
+        memcpy(dst,data,len);
+        dst[len]='\0';
+    }
+        break;
+    case FT_CUSTOM:
+        if (size>0 && deserializeFieldDelegate) {
+            ImGuiHelper::Deserializer d(data,(size_t)size);
+            deserialize(d,NULL);
+        }
+        break;
+    default:
+        break;
+    }
+    return next;
+}
 #endif //NO_IMGUIHELPER_SERIALIZATION_LOAD
 #endif //NO_IMGUIHELPER_SERIALIZATION
 FieldInfo &FieldInfoVector::addField(int *pdata, int numArrayElements, const char *label, const char *tooltip, int precision, int lowerLimit, int upperLimit, void *userData)   {
@@ -2430,17 +2694,173 @@ bool FieldInfo::render(int nodeWidth)   {
 
 //-------------------------------------------------------------------------------
 #       if (defined(IMGUIHELPER_H_) && !defined(NO_IMGUIHELPER_SERIALIZATION))
+// Binary format (native endianness, every section is 4-byte aligned):
+// [NodeGraphBinaryHeader][string table][NodeGraphBinaryNode x numNodes][NodeGraphBinaryLink x numLinks][field records]
+#       define IMGUINODEGRAPHEDITOR_BINARY_VERSION 1
+static const char NodeGraphBinaryMagic[4] = {'N','G','E','B'};
+static const unsigned NodeGraphBinaryEndianTag = 0x01020304;
+struct NodeGraphBinaryHeader {
+    char magic[4];
+    int version;
+    unsigned endianTag;
+    int headerSize,nodeRecordSize,linkRecordSize;   // so that newer versions can append members to the records
+    int numNodes,numLinks,selectedNodeIndex;
+    float scrolling[2];
+    int stringTableOffset,stringTableSize;          // zero-terminated strings
+    int nodesOffset,linksOffset;
+    int fieldsOffset,fieldsSize;
+};
+enum NodeGraphBinaryNodeFlags {
+    NGBNF_IS_OPEN       = 1,
+    NGBNF_IS_SELECTED   = 2
+};
+struct NodeGraphBinaryNode {
+    int typeID,userID;
+    float Pos[2];
+    int flags;
+    ImU32 overrideTitleTextColor,overrideTitleBgColor;
+    float overrideTitleBgColorGradient;
+    int ovrNameString,ovrInputSlotsString,ovrOutputSlotsString;    // offsets in the string table or -1
+    int numFields,fieldsOffset,fieldsSize;                          // fieldsOffset is relative to NodeGraphBinaryHeader::fieldsOffset
+};
+struct NodeGraphBinaryLink {
+    int inputNode,inputSlot,outputNode,outputSlot;
+};
 #       ifndef NO_IMGUIHELPER_SERIALIZATION_SAVE
+// getNodeIndex(...) is O(N): when saving all the links we sort the node pointers once and use a binary search
+struct NodeGraphNodeIndexMap {
+    struct Entry {const Node* node;int index;};
+    ImVector<Entry> entries;
+    static int IMGUINGE_CDECL EntrySorter(const void* e0,const void* e1)   {
+        const Node* n0 = ((const Entry*)e0)->node;const Node* n1 = ((const Entry*)e1)->node;
+        return (n0<n1) ? -1 : (n1<n0) ? 1 : 0;
+    }
+    NodeGraphNodeIndexMap(const ImVector<Node*>& nodes) {
+        entries.resize(nodes.size());
+        for (int i=0,isz=nodes.size();i<isz;i++) {entries[i].node=nodes[i];entries[i].index=i;}
+        if (entries.size()>1) qsort(&entries[0],entries.size(),sizeof(Entry),&EntrySorter);
+    }
+    int getIndex(const Node* node) const {
+        int lo=0,hi=entries.size()-1;
+        while (lo<=hi)  {
+            const int mid = (lo+hi)/2;
+            const Node* n = entries[mid].node;
+            if (n==node) return entries[mid].index;
+            if (n<node) lo=mid+1;
+            else hi=mid-1;
+        }
+        return -1;
+    }
+};
+// Shared strings (e.g. overridden slot names) are stored once
+struct NodeGraphBinaryStringTable {
+    ImVector<char> buffer;
+    ImGuiStorage offsets;   // hash -> offset+1
+    int add(const char* str)    {
+        const ImGuiID hash = ImHashStr(str,0);
+        const int offset = offsets.GetInt(hash,0)-1;
+        if (offset>=0 && strcmp(&buffer[offset],str)==0) return offset;
+        const int start = buffer.size();
+        const int len = (int)strlen(str);
+        buffer.resize(start+len+1);
+        memcpy(&buffer[start],str,len+1);
+        if (offset<0) offsets.SetInt(hash,start+1);
+        return start;
+    }
+};
+static void NodeGraphBinaryJoinSlotNames(char* buffer,const char (*names)[IMGUINODE_MAX_SLOT_NAME_LENGTH],int count) {
+    buffer[0]='\0';
+    for (int st=0;st<count;st++) {
+        if (st>0) strcat(buffer,";");
+        strcat(buffer,&names[st][0]);
+    }
+}
+bool NodeGraphEditor::saveBinary(ImVector<char>& bufferOut)   {
+    const int numNodes = nodes.size();
+    const int numLinks = links.size();
+    NodeGraphNodeIndexMap nodeIndexMap(nodes);
+    NodeGraphBinaryStringTable strings;
+    ImVector<NodeGraphBinaryNode> nodeRecords;
+    ImVector<NodeGraphBinaryLink> linkRecords;
+    ImVector<char> fields;
+    char ovrBuffer[((IMGUINODE_MAX_INPUT_SLOTS>IMGUINODE_MAX_OUTPUT_SLOTS?IMGUINODE_MAX_INPUT_SLOTS:IMGUINODE_MAX_OUTPUT_SLOTS)+1)*IMGUINODE_MAX_SLOT_NAME_LENGTH];
+    //--------------------------------------------
+    nodeRecords.resize(numNodes);
+    for (int i=0;i<numNodes;i++)    {
+        const Node& n = (*nodes[i]);
+        NodeGraphBinaryNode& r = nodeRecords[i];
+        r.typeID = n.typeID;
+        r.userID = n.userID;
+        r.Pos[0] = n.Pos.x;r.Pos[1] = n.Pos.y;
+        r.flags = (n.isOpen ? NGBNF_IS_OPEN : 0) | (n.isSelected ? NGBNF_IS_SELECTED : 0);
+        r.overrideTitleTextColor = n.overrideTitleTextColor;
+        r.overrideTitleBgColor = n.overrideTitleBgColor;
+        r.overrideTitleBgColorGradient = n.overrideTitleBgColorGradient;
+        r.ovrNameString = n.mustOverrideName ? strings.add(n.Name) : -1;
+        r.ovrInputSlotsString = r.ovrOutputSlotsString = -1;
+        if (n.mustOverrideInputSlots)   {
+            NodeGraphBinaryJoinSlotNames(ovrBuffer,n.InputNames,n.InputsCount);
+            r.ovrInputSlotsString = strings.add(ovrBuffer);
+        }
+        if (n.mustOverrideOutputSlots)   {
+            NodeGraphBinaryJoinSlotNames(ovrBuffer,n.OutputNames,n.OutputsCount);
+            r.ovrOutputSlotsString = strings.add(ovrBuffer);
+        }
+        r.numFields = n.fields.size();
+        r.fieldsOffset = fields.size();
+        n.fields.serializeBinary(fields);
+        r.fieldsSize = fields.size()-r.fieldsOffset;
+    }
+    linkRecords.resize(numLinks);
+    for (int i=0;i<numLinks;i++)    {
+        const NodeLink& l = links[i];
+        NodeGraphBinaryLink& r = linkRecords[i];
+        r.inputNode = nodeIndexMap.getIndex(l.InputNode);
+        r.inputSlot = l.InputSlot;
+        r.outputNode = nodeIndexMap.getIndex(l.OutputNode);
+        r.outputSlot = l.OutputSlot;
+    }
+    //--------------------------------------------
+    NodeGraphBinaryHeader h;
+    memset(&h,0,sizeof(h));
+    memcpy(h.magic,NodeGraphBinaryMagic,sizeof(h.magic));
+    h.version = IMGUINODEGRAPHEDITOR_BINARY_VERSION;
+    h.endianTag = NodeGraphBinaryEndianTag;
+    h.headerSize = (int)sizeof(NodeGraphBinaryHeader);
+    h.nodeRecordSize = (int)sizeof(NodeGraphBinaryNode);
+    h.linkRecordSize = (int)sizeof(NodeGraphBinaryLink);
+    h.numNodes = numNodes;
+    h.numLinks = numLinks;
+    h.selectedNodeIndex = activeNode ? nodeIndexMap.getIndex(activeNode) : -1;
+    h.scrolling[0] = scrolling.x;h.scrolling[1] = scrolling.y;
+    h.stringTableOffset = h.headerSize;
+    h.stringTableSize = strings.buffer.size();
+    h.nodesOffset = h.stringTableOffset + FieldInfoBinaryPaddedSize(h.stringTableSize);
+    h.linksOffset = h.nodesOffset + numNodes*h.nodeRecordSize;
+    h.fieldsOffset = h.linksOffset + numLinks*h.linkRecordSize;
+    h.fieldsSize = fields.size();
+    bufferOut.resize(h.fieldsOffset+h.fieldsSize);
+    char* b = &bufferOut[0];
+    memset(b,0,h.nodesOffset);  // header padding and string table padding
+    memcpy(b,&h,sizeof(h));
+    if (h.stringTableSize>0) memcpy(b+h.stringTableOffset,&strings.buffer[0],h.stringTableSize);
+    if (numNodes>0) memcpy(b+h.nodesOffset,&nodeRecords[0],numNodes*h.nodeRecordSize);
+    if (numLinks>0) memcpy(b+h.linksOffset,&linkRecords[0],numLinks*h.linkRecordSize);
+    if (h.fieldsSize>0) memcpy(b+h.fieldsOffset,&fields[0],h.fieldsSize);
+    //--------------------------------------------
+    return true;
+}
 bool NodeGraphEditor::save(ImGuiHelper::Serializer& s)    {
     if (!s.isValid()) return false;
     const int numNodes = nodes.size();
     const int numLinks = links.size();
+    NodeGraphNodeIndexMap nodeIndexMap(nodes);
     int itmp;
     char ovrBuffer[((IMGUINODE_MAX_INPUT_SLOTS>IMGUINODE_MAX_OUTPUT_SLOTS?IMGUINODE_MAX_INPUT_SLOTS:IMGUINODE_MAX_OUTPUT_SLOTS)+1)*IMGUINODE_MAX_SLOT_NAME_LENGTH*200];
     //--------------------------------------------
     s.save(&scrolling.x,"scrolling",2);
     s.save(&numNodes,"num_nodes");
-    itmp = activeNode ? getNodeIndex(activeNode) : -1;s.save(&itmp,"selected_node_index");
+    itmp = activeNode ? nodeIndexMap.getIndex(activeNode) : -1;s.save(&itmp,"selected_node_index");
     s.save(&numLinks,"num_links");
     for (int i=0;i<numNodes;i++)    {
 	const Node& n = (*nodes[i]);
@@ -2476,10 +2896,10 @@ bool NodeGraphEditor::save(ImGuiHelper::Serializer& s)    {
     for (int i=0;i<numLinks;i++)    {
 	const NodeLink& l = links[i];
 	s.save(&i,"link_index");
-	itmp = getNodeIndex(l.InputNode);
+	itmp = nodeIndexMap.getIndex(l.InputNode);
 	s.save(&itmp,"InputNode");
 	s.save(&l.InputSlot,"InputSlot");
-	itmp = getNodeIndex(l.OutputNode);
+	itmp = nodeIndexMap.getIndex(l.OutputNode);
 	s.save(&itmp,"OutputNode");
 	s.save(&l.OutputSlot,"OutputSlot");
     }    
@@ -2587,7 +3007,7 @@ bool NodeGraphEditor::load(ImGuiHelper::Deserializer& d, const char ** pOptional
                                    cbn.overrideTitleBgColor>0 ? &cbn.overrideTitleBgColor : NULL,
                                    cbn.overrideTitleBgColorGradient>=0 ? &cbn.overrideTitleBgColorGradient : NULL);
         if (cbn.mustOvrInput)   overrideNodeInputSlots(n,cbn.ovrInput);
-        if (cbn.mustOvrOutput)  overrideNodeInputSlots(n,cbn.ovrOutput);
+        if (cbn.mustOvrOutput)  overrideNodeOutputSlots(n,cbn.ovrOutput);
         IM_ASSERT(n->fields.size()==cbn.numFields); // optional check (to remove)
         amount = n->fields.deserialize(d,amount);        
         addNode(n);
@@ -2616,6 +3036,74 @@ bool NodeGraphEditor::load(ImGuiHelper::Deserializer& d, const char ** pOptional
     //--------------------------------------------
     //return true;
 }
+bool NodeGraphEditor::IsBinaryFormat(const char* data,size_t dataSize)  {
+    return (data && dataSize>=sizeof(NodeGraphBinaryHeader) && memcmp(data,NodeGraphBinaryMagic,sizeof(NodeGraphBinaryMagic))==0);
+}
+bool NodeGraphEditor::loadBinary(const char* data,size_t dataSize)   {
+    if (!IsBinaryFormat(data,dataSize) || !nodeFactoryFunctionPtr) return false;
+    NodeGraphBinaryHeader h;
+    memcpy(&h,data,sizeof(h));
+    if (h.version<1 || h.version>IMGUINODEGRAPHEDITOR_BINARY_VERSION || h.endianTag!=NodeGraphBinaryEndianTag) return false;
+    if (h.headerSize<(int)sizeof(NodeGraphBinaryHeader) || h.nodeRecordSize<(int)sizeof(NodeGraphBinaryNode) || h.linkRecordSize<(int)sizeof(NodeGraphBinaryLink)) return false;
+    if (h.numNodes<0 || h.numLinks<0 || h.stringTableSize<0 || h.fieldsSize<0) return false;
+    if (h.stringTableOffset<0 || h.fieldsOffset<0 || h.nodesOffset<0 || h.linksOffset<0) return false;
+    // No sum or product below can wrap around
+    const size_t size = dataSize;
+    if ((size_t)h.stringTableOffset>size || (size_t)h.fieldsOffset>size || (size_t)h.nodesOffset>size || (size_t)h.linksOffset>size) return false;
+    if ((size_t)h.stringTableSize>size-h.stringTableOffset || (size_t)h.fieldsSize>size-h.fieldsOffset ||
+        (size_t)h.numNodes>(size-h.nodesOffset)/h.nodeRecordSize || (size_t)h.numLinks>(size-h.linksOffset)/h.linkRecordSize) return false;
+    const char* strings = data+h.stringTableOffset;
+    if (h.stringTableSize>0 && strings[h.stringTableSize-1]!='\0') return false;
+    const char* fields = data+h.fieldsOffset;
+    clear();
+    setModified(false);
+    //--------------------------------------------
+    scrolling = ImVec2(h.scrolling[0],h.scrolling[1]);
+    ImVector<Node*> loadedNodes;   // by file index (the node factory might refuse some nodes)
+    loadedNodes.resize(h.numNodes);
+    nodes.reserve(h.numNodes);
+    for (int i=0;i<h.numNodes;i++)    {
+        NodeGraphBinaryNode r;
+        memcpy(&r,data+(size_t)h.nodesOffset+(size_t)i*h.nodeRecordSize,sizeof(r));
+        Node* n = loadedNodes[i] = nodeFactoryFunctionPtr(r.typeID,ImVec2(r.Pos[0],r.Pos[1]),*this);
+        if (!n) continue;
+        n->userID = r.userID;
+        n->isOpen = (r.flags&NGBNF_IS_OPEN)!=0;
+        n->isSelected = (r.flags&NGBNF_IS_SELECTED)!=0;
+        if (r.ovrNameString>=0 && r.ovrNameString<h.stringTableSize)   overrideNodeName(n,strings+r.ovrNameString);
+        overrideNodeTitleBarColors(n,r.overrideTitleTextColor>0 ? &r.overrideTitleTextColor : NULL,
+                                   r.overrideTitleBgColor>0 ? &r.overrideTitleBgColor : NULL,
+                                   r.overrideTitleBgColorGradient>=0 ? &r.overrideTitleBgColorGradient : NULL);
+        if (r.ovrInputSlotsString>=0 && r.ovrInputSlotsString<h.stringTableSize)   overrideNodeInputSlots(n,strings+r.ovrInputSlotsString);
+        if (r.ovrOutputSlotsString>=0 && r.ovrOutputSlotsString<h.stringTableSize) overrideNodeOutputSlots(n,strings+r.ovrOutputSlotsString);
+        if (r.fieldsOffset>=0 && r.fieldsSize>=0 && r.fieldsOffset<=h.fieldsSize-r.fieldsSize)
+            n->fields.deserializeBinary(fields+r.fieldsOffset,fields+r.fieldsOffset+r.fieldsSize);
+        addNode(n);
+        AvailableNodeInfo* pOptionalNi = fetchAvailableNodeInfo(n->getType());
+        if (pOptionalNi) ++(pOptionalNi->curNumInstances);
+    }
+    if (h.selectedNodeIndex>=0 && h.selectedNodeIndex<h.numNodes) activeNode = loadedNodes[h.selectedNodeIndex];
+    links.reserve(h.numLinks);
+    for (int i=0;i<h.numLinks;i++)    {
+        NodeGraphBinaryLink r;
+        memcpy(&r,data+(size_t)h.linksOffset+(size_t)i*h.linkRecordSize,sizeof(r));
+        if (r.inputNode<0 || r.inputNode>=h.numNodes || r.outputNode<0 || r.outputNode>=h.numNodes || r.inputNode==r.outputNode) continue;
+        Node* inputNode = loadedNodes[r.inputNode];
+        Node* outputNode = loadedNodes[r.outputNode];
+        // A link goes from an output slot of its InputNode to an input slot of its OutputNode
+        if (inputNode && outputNode && r.inputSlot>=0 && r.inputSlot<inputNode->OutputsCount && r.outputSlot>=0 && r.outputSlot<outputNode->InputsCount)
+            addLink(inputNode,r.inputSlot,outputNode,r.outputSlot,true);
+    }
+    // Fire node->onLoad() events-----------------
+    for (int i=0,isz=nodes.size();i<isz;i++) {
+        nodes[i]->onLoaded();
+    }
+    maxConnectorNameWidth = 0;
+    oldFontWindowScale = 0;
+    //--------------------------------------------
+    setModified(false);
+    return true;
+}
 #       endif //NO_IMGUIHELPER_SERIALIZATION_LOAD
 #       endif //NO_IMGUIHELPER_SERIALIZATION
 //--------------------------------------------------------------------------------
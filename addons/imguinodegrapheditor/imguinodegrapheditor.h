@@ -171,6 +171,12 @@ enum FieldType {
 #       ifndef NO_IMGUIHELPER_SERIALIZATION_LOAD
         IMGUI_API const char* deserialize(const ImGuiHelper::Deserializer& d,const char* start);
 #       endif //NO_IMGUIHELPER_SERIALIZATION_LOAD
+#       ifndef NO_IMGUIHELPER_SERIALIZATION_SAVE
+        IMGUI_API bool serializeBinary(ImVector<char>& b) const;   // appends {type,size,raw value bytes} (FT_CUSTOM stores its text serialization)
+#       endif //NO_IMGUIHELPER_SERIALIZATION_SAVE
+#       ifndef NO_IMGUIHELPER_SERIALIZATION_LOAD
+        IMGUI_API const char* deserializeBinary(const char* start,const char* end); // returns the start of the next record or NULL
+#       endif //NO_IMGUIHELPER_SERIALIZATION_LOAD
 #       endif //NO_IMGUIHELPER_SERIALIZATION
 //--------------------------------------------------------------------------------
 
@@ -237,6 +243,11 @@ enum FieldType {
         }
         return rt;
     }
+    bool serializeBinary(ImVector<char>& b) const {
+        bool rt = true;
+        for (int i=0,isz=size();i<isz;i++) rt&=(*this)[i].serializeBinary(b);
+        return rt;
+    }
 #   endif //NO_IMGUIHELPER_SERIALIZATION_SAVE
 #   ifndef NO_IMGUIHELPER_SERIALIZATION_LOAD
     const char* deserialize(const ImGuiHelper::Deserializer& d,const char* start)   {
@@ -247,6 +258,13 @@ enum FieldType {
         }
         return pend;
     }
+    bool deserializeBinary(const char* start,const char* end)   {
+        for (int i=0,isz=size();i<isz;i++) {
+            FieldInfo& f = (*this)[i];
+            if (!(start = f.deserializeBinary(start,end))) return false;
+        }
+        return true;
+    }
 #   endif //NO_IMGUIHELPER_SERIALIZATION_LOAD
 #   endif //NO_IMGUIHELPER_SERIALIZATION
 //--------------------------------------------------------------------------------
@@ -257,6 +275,13 @@ protected:
 };
 //--------------------------------------------------------------------------------------------
 
+class Node;
+// What is linked to an input slot of a node, when the node is evaluated (see Node::evaluate(...))
+struct NodeEvaluationInput {
+    const Node* node;   // NULL if the input slot is not linked. If more links reach the slot, it's the node of the first one
+    int outputSlot;     // output slot of 'node'
+};
+
 class Node
 {
     public:
@@ -286,6 +311,14 @@ class Node
     virtual void onEdited() {}  // called (a few seconds) after the node has been edited
     virtual void onCopied() {}  // called after the node fileds has been copied from another node
     virtual void onLoaded() {}  // called after the node has been loaded (=deserialized from file)
+    // Graph evaluation (see NodeGraphEditor::setEvaluationEnabled(...)):
+    // UI thread: copy here the field values that evaluate(...) needs (the user can keep editing the fields while the evaluation runs)
+    virtual void onEvaluationBegin() {}
+    // Any thread: compute the node outputs from the outputs of the input nodes (that have already been evaluated).
+    // It must not touch the fields or the NodeGraphEditor: store the results in members that the UI thread reads only in onEvaluationEnd().
+    virtual void evaluate(const NodeEvaluationInput* inputs,int numInputs) {(void)inputs;(void)numInputs;}
+    // UI thread: the evaluation has been published: copy the results where render(...) can display them
+    virtual void onEvaluationEnd() {}
     virtual bool canBeCopied() const {return true;}
     // called on a class basis to set the default colors different from the ones defined in NodeGraphEditor::GetStyle()
     // [but on an instance basis these colors can still be overridden using the protected fields defined below, or better NodeGraphEditor::overrideNodeTitleBarColors(...)]
@@ -324,7 +357,7 @@ class Node
     float overrideTitleBgColorGradient;                 //-1 -> don't override
     bool isInEditingMode;
 
-    Node() : Pos(0,0),Size(0,0),isSelected(false),baseWidthOverride(-1),mustOverrideName(false),mustOverrideInputSlots(false),mustOverrideOutputSlots(false),overrideTitleTextColor(0),overrideTitleBgColor(0),overrideTitleBgColorGradient(-1.f),isInEditingMode(false),parentNodeGraphEditor(NULL) {}
+    Node() : Pos(0,0),Size(0,0),isSelected(false),baseWidthOverride(-1),mustOverrideName(false),mustOverrideInputSlots(false),mustOverrideOutputSlots(false),overrideTitleTextColor(0),overrideTitleBgColor(0),overrideTitleBgColorGradient(-1.f),isInEditingMode(false),parentNodeGraphEditor(NULL),traversalMark(0),lodSize(0,0),evaluationDirty(true),evaluationIndex(-1) {}
     IMGUI_API void init(const char* name, const ImVec2& pos,const char* inputSlotNamesSeparatedBySemicolons=NULL,const char* outputSlotNamesSeparatedBySemicolons=NULL,int _nodeTypeID=0/*,float currentWindowFontScale=-1.f*/);
 
     inline ImVec2 GetInputSlotPos(int slot_no,float currentFontWindowScale=1.f) const   { return ImVec2(Pos.x*currentFontWindowScale,           Pos.y*currentFontWindowScale + Size.y * ((float)slot_no+1) / ((float)InputsCount+1)); }
@@ -333,6 +366,7 @@ class Node
 
     friend struct NodeLink;
     friend class NodeGraphEditor;
+    friend struct NodeGraphEvaluationPass;
 
     // Helper static methods to simplify code of the derived classes
     // casts:
@@ -341,6 +375,13 @@ class Node
 
     private:
     class NodeGraphEditor* parentNodeGraphEditor;
+    // Adjacency lists, maintained by NodeGraphEditor: indices into NodeGraphEditor::links
+    ImVector<int> inputLinkIndices;     // links that end in one of our input slots (link.OutputNode==this)
+    ImVector<int> outputLinkIndices;    // links that start from one of our output slots (link.InputNode==this)
+    mutable unsigned int traversalMark; // 'visited' flag used by NodeGraphEditor::isNodeReachableFrom(...)
+    ImVec2 lodSize;                     // content size (without padding and zoom) measured at the last full-detail frame
+    bool evaluationDirty;               // must be evaluated again (see NodeGraphEditor::markNodeDirty(...))
+    int evaluationIndex;                // index in the running evaluation, or -1
 
     protected:
     NodeGraphEditor& getNodeGraphEditor() {IM_ASSERT(parentNodeGraphEditor);return *parentNodeGraphEditor;}
@@ -374,7 +415,7 @@ class NodeGraphEditor
 
     protected:
     ImVector<Node*> nodes;          // used as a garbage collector too
-    ImVector<NodeLink> links;
+    ImVector<NodeLink> links;       // never modify it directly: use addLink(...) and removeLinkAt(...) that keep the nodes' adjacency lists in sync
     ImVec2 scrolling;
     Node *activeNode;               // It's one of the selected nodes (ATM always the first, but the concept of 'active node' is never used by this code: i.e. we could have not included any 'active node' selection at all)
     Node *sourceCopyNode;           // this is owned by the NodeGraphEditor
@@ -431,6 +472,7 @@ class NodeGraphEditor
         float link_line_width;
         float link_control_point_distance;
         int link_num_segments;  // in AddBezierCurve(...)
+        float lod_zoom_threshold;   // below this zoom factor nodes are drawn as plain boxes and links as straight lines (0 = never)
         ImVec4 color_node_title;
         ImU32 color_node_title_background;
         float color_node_title_background_gradient;
@@ -463,6 +505,7 @@ class NodeGraphEditor
             link_line_width =           3.f;
             link_control_point_distance = 50.f;
             link_num_segments =         0;
+            lod_zoom_threshold =        0.5f;
 
             color_node_title = ImGui::GetStyle().Colors[ImGuiCol_Text];
             color_node_title_background = 0;//ImGui::ColorConvertFloat4ToU32(ImGui::GetStyle().Colors[ImGuiCol_TitleBgActive]);
@@ -535,12 +578,15 @@ class NodeGraphEditor
         nodesBaseWidth = 120.f;
         maxConnectorNameWidth = 0;
         nodeListFilterComboIndex = 0;
+        traversalMark = 0;
+        evaluationPass = NULL;evaluationEnabled = evaluationNeeded = false;evaluationUseWorkerThreads = true;
         setModified(false);
     }
     virtual ~NodeGraphEditor() {
         clear();
     }
     void clear() {
+        waitForEvaluation();
         if (linkCallback)   {
             for (int i=links.size()-1;i>=0;i--)  {
                 const NodeLink& link = links[i];
@@ -551,6 +597,7 @@ class NodeGraphEditor
         for (int i=nodes.size()-1;i>=0;i--)  {
             Node*& node = nodes[i];
             if (node)   {
+                node->inputLinkIndices.clear();node->outputLinkIndices.clear();
                 if (nodeCallback) nodeCallback(node,NS_DELETED,*this);
                 node->~Node();              // ImVector does not call it
                 ImGui::MemFree(node);       // items MUST be allocated by the user using ImGui::MemAlloc(...)
@@ -602,6 +649,7 @@ class NodeGraphEditor
 
     Node* addNode(int nodeType,const ImVec2& Pos=ImVec2(0,0))  {return addNode(nodeType,Pos,NULL);}
     bool deleteNode(Node* node) {
+        waitForEvaluation();
         if (node == activeNode)  activeNode = NULL;
         if (node == dragNode.node) dragNode.node = NULL;
         if (node == menuNode)  menuNode = NULL;
@@ -634,6 +682,9 @@ class NodeGraphEditor
         if (checkIfAlreadyPresent) insert = !isLinkPresent(inputNode,input_slot,outputNode,output_slot);
         if (insert) {
             links.push_back(NodeLink(inputNode,input_slot,outputNode,output_slot));
+            inputNode->outputLinkIndices.push_back(links.size()-1);
+            outputNode->inputLinkIndices.push_back(links.size()-1);
+            markNodeDirty(outputNode);
             if (linkCallback) linkCallback(links[links.size()-1],LS_ADDED,*this);
         }
         return insert;
@@ -645,6 +696,8 @@ class NodeGraphEditor
         return ok;
     }
     IMGUI_API void removeAnyLinkFromNode(Node* node,bool removeInputLinks=true,bool removeOutputLinks=true);
+    IMGUI_API void removeAnyLinkFromNodeInputSlot(Node* node,int input_slot);
+    IMGUI_API void removeAnyLinkFromNodeOutputSlot(Node* node,int output_slot);
     IMGUI_API bool isLinkPresent(Node* inputNode, int input_slot, Node* outputNode, int output_slot,int* pOptionalIndexInLinkArrayOut=NULL) const;
 
     // To be called INSIDE a window
@@ -681,6 +734,24 @@ class NodeGraphEditor
     const Node* getCopiedNode() const {return sourceCopyNode;}
 
 
+    // Graph evaluation: when enabled, render() evaluates the dirty nodes (see markNodeDirty(...)) and all the nodes downstream of them, in topological order.
+    // With IMGUIHELPER_HAS_THREADS and useWorkerThreads, the evaluation runs on ImGuiHelper::ThreadPool::GetDefault() (independent nodes in parallel)
+    // and it's published (Node::onEvaluationEnd()) by a later render() call, without blocking the UI. Otherwise it runs synchronously inside render().
+    // Nodes that become dirty while an evaluation is running are evaluated by the next one. Nodes in (or downstream of) a circuit are not evaluated.
+    void setEvaluationEnabled(bool enabled,bool useWorkerThreads=true) {
+        if (!enabled) waitForEvaluation();
+        evaluationEnabled = enabled;evaluationUseWorkerThreads = useWorkerThreads;
+    }
+    bool isEvaluationEnabled() const {return evaluationEnabled;}
+    bool isEvaluationRunning() const {return evaluationPass!=NULL;}
+    // Nodes are marked dirty when they are added, edited, pasted or when a link to one of their input slots is added or removed.
+    // Call this when a node must be evaluated again for other reasons.
+    void markNodeDirty(Node* node) {if (node) {node->evaluationDirty = evaluationNeeded = true;}}
+    // Called by render(): publishes a finished evaluation and starts a new one if some node is dirty. Returns true if an evaluation is still running.
+    IMGUI_API bool updateEvaluation(bool waitForCompletion=false);
+    // Cancels the running evaluation (the nodes that haven't started yet are skipped and left dirty) and waits for it. It never starts a new one.
+    IMGUI_API void waitForEvaluation();
+
     // It should be better not to add/delete node/links in the callbacks... (but all is untested here)
     void setNodeCallback(NodeCallback cb) {nodeCallback=cb;}
     void setLinkCallback(LinkCallback cb) {linkCallback=cb;}
@@ -694,6 +765,16 @@ class NodeGraphEditor
             ImGuiHelper::Serializer s(filename);
             return save(s);
         }
+        // Binary format: versioned header, string table, fixed-size node and link records and raw field values.
+        // Much faster than the text format on big graphs, but it's bound to the native endianness.
+        // saveBinary(bufferOut) does not clear the modified flag (the graph is not saved anywhere yet): saveBinary(filename) does, on success.
+        IMGUI_API bool saveBinary(ImVector<char>& bufferOut);
+        inline bool saveBinary(const char *filename)    {
+            ImVector<char> b;
+            if (!saveBinary(b) || !ImGuiHelper::SetFileContent(filename,(const unsigned char*)&b[0],b.size(),"wb")) return false;
+            setModified(false);
+            return true;
+        }
 #       endif //NO_IMGUIHELPER_SERIALIZATION_SAVE
 #       ifndef NO_IMGUIHELPER_SERIALIZATION_LOAD
         IMGUI_API bool load(ImGuiHelper::Deserializer& d, const char ** pOptionalBufferStart=NULL);
@@ -701,6 +782,19 @@ class NodeGraphEditor
             ImGuiHelper::Deserializer d(filename);
             return load(d);
         }
+        IMGUI_API bool loadBinary(const char* data,size_t dataSize);
+        inline bool loadBinary(const char* filename) {
+            ImVector<char> b;   // the whole file is read at once
+            return ImGuiHelper::GetFileContent(filename,b,true,"rb") && b.size()>0 && loadBinary(&b[0],(size_t)b.size());
+        }
+        IMGUI_API static bool IsBinaryFormat(const char* data,size_t dataSize);
+#       ifndef NO_IMGUIHELPER_SERIALIZATION_SAVE
+        // Converts a file written by save(...) to the binary format. The graph is loaded into this editor,
+        // so the node types must be registered (the field layout comes from the node factory).
+        inline bool convertTextFileToBinary(const char* textFilename,const char* binaryFilename) {
+            return load(textFilename) && saveBinary(binaryFilename);
+        }
+#       endif //NO_IMGUIHELPER_SERIALIZATION_SAVE
 #       endif //NO_IMGUIHELPER_SERIALIZATION_LOAD
 #       endif //NO_IMGUIHELPER_SERIALIZATION
 //--------------------------------------------------------------------------------
@@ -745,12 +839,18 @@ class NodeGraphEditor
         if (justCreatedNode) {
             justCreatedNode->parentNodeGraphEditor = this;
             nodes.push_back(justCreatedNode);
+            markNodeDirty(justCreatedNode);
             if (nodeCallback) nodeCallback(nodes[nodes.size()-1],NS_ADDED,*this);
         }
         return justCreatedNode;
     }
     IMGUI_API void copyNode(Node* n);
     IMGUI_API bool removeLinkAt(int link_idx);
+    mutable unsigned int traversalMark;             // incremented at each isNodeReachableFrom(...) call
+    mutable ImVector<const Node*> traversalStack;   // reused by isNodeReachableFrom(...)
+    struct NodeGraphEvaluationPass* evaluationPass; // the running evaluation, or NULL
+    bool publishEvaluation(bool waitForCompletion); // returns true if evaluationPass is still running
+    bool evaluationEnabled,evaluationNeeded,evaluationUseWorkerThreads;
     // Warning: node index changes when a node becomes active!
     inline int getNodeIndex(const Node* node) {
         for (int i=0;i<nodes.size();i++)    {
@@ -7,6 +7,10 @@
 
 #include "imguivariouscontrols.h"
 
+#if (defined(IMGUIHELPER_H_) && defined(IMGUIHELPER_HAS_THREADS))
+#   define IMGUIVARIOUSCONTROLS_HAS_THREADS
+#endif //IMGUIHELPER_HAS_THREADS
+
 #ifndef NO_IMGUIVARIOUSCONTROLS_ANIMATEDIMAGE
 #ifndef IMGUI_USE_AUTO_BINDING
 #ifndef STBI_INCLUDE_STB_IMAGE_H
@@ -862,10 +866,92 @@ struct AnimatedImageInternal {
     mutable ImTextureID texId;
     mutable ImVec2 uvFrame0,uvFrame1;   // used by persistentTexId
     mutable int lastImGuiFrameUpdate;
+    bool mustUploadPersistentTexture;   // set by decode(...): the upload is postponed when the image is loaded asynchronously
+#   ifdef IMGUIVARIOUSCONTROLS_HAS_THREADS
+    // Reads and decodes a gif file in a worker thread
+    struct LoadJob {
+        char* filePath;
+        bool useHoverModeIfSupported;
+        AnimatedImageInternal* decoded;
+        ImGuiHelper::ThreadHandle thread;
+        volatile int finished;
+
+        static void ThreadFunction(void* userPtr) {
+            LoadJob& j = *((LoadJob*) userPtr);
+#           if (!defined(STBI_NO_GIF) && !defined(IMGUIVARIOUSCONTROLS_NO_STDIO))
+            ScopedFileContent fc(j.filePath);
+            if (fc.gif_buffer) j.decoded->decode(fc.gif_buffer,fc.gif_buffer_size,j.useHoverModeIfSupported);
+#           endif //STBI_NO_GIF
+            ImGuiHelper::AtomicStore(&j.finished,1);
+        }
+        static LoadJob* Create(const char* filePath,bool useHoverModeIfSupported) {
+            LoadJob* j = (LoadJob*) ImGui::MemAlloc(sizeof(LoadJob));
+            IM_PLACEMENT_NEW (j) LoadJob();
+            const size_t len = strlen(filePath);
+            j->filePath = (char*) ImGui::MemAlloc(len+1);memcpy(j->filePath,filePath,len+1);
+            j->useHoverModeIfSupported = useHoverModeIfSupported;
+            j->decoded = (AnimatedImageInternal*) ImGui::MemAlloc(sizeof(AnimatedImageInternal));
+            IM_PLACEMENT_NEW (j->decoded) AnimatedImageInternal();
+            j->finished = 0;
+            j->thread = ImGuiHelper::ThreadCreate(&ThreadFunction,j);
+            if (!j->thread) Destroy(j);
+            return j;
+        }
+        // There's no way to stop the decoder: this waits for it
+        static void Destroy(LoadJob*& j) {
+            if (!j) return;
+            if (j->thread) {ImGuiHelper::ThreadJoin(j->thread);j->thread = 0;}
+            j->decoded->~AnimatedImageInternal();
+            ImGui::MemFree(j->decoded);j->decoded = NULL;
+            ImGui::MemFree(j->filePath);j->filePath = NULL;
+            j->~LoadJob();
+            ImGui::MemFree(j);
+            j = NULL;
+        }
+        bool isFinished() {return ImGuiHelper::AtomicLoad(&finished)!=0;}
+    };
+    LoadJob* loadJob;
+#   endif //IMGUIVARIOUSCONTROLS_HAS_THREADS
+
+    // Returns false if the texture can't be uploaded in this frame
+    bool finishLoading() {
+#       ifdef IMGUIVARIOUSCONTROLS_HAS_THREADS
+        if (loadJob) {
+            if (!loadJob->isFinished()) return false;
+            LoadJob* j = loadJob;loadJob = NULL;
+            clear();
+            // we take the decoded data
+            AnimatedImageInternal& d = *j->decoded;
+            w=d.w;h=d.h;frames=d.frames;
+            buffer=d.buffer;d.buffer=NULL;
+            delays.swap(d.delays);
+            numFramesPerRowInPersistentTexture=d.numFramesPerRowInPersistentTexture;numFramesPerColInPersistentTexture=d.numFramesPerColInPersistentTexture;
+            hoverModeIfSupported=d.hoverModeIfSupported;
+            mustUploadPersistentTexture=d.mustUploadPersistentTexture;d.mustUploadPersistentTexture=false;
+            LoadJob::Destroy(j);
+        }
+        if (mustUploadPersistentTexture || (frames==1 && !texId)) {
+            if (!ImGuiHelper::IsTextureUploadBudgetAvailable()) return false;
+            const double startTime = ImGuiHelper::GetTimeInMilliseconds();
+            uploadPersistentTexture();
+            if (frames==1 && !texId) AnimatedImage::GenerateOrUpdateTextureCb(texId,w,h,4,buffer,false,false,false);
+            ImGuiHelper::ConsumeTextureUploadBudget(ImGuiHelper::GetTimeInMilliseconds()-startTime);
+        }
+#       endif //IMGUIVARIOUSCONTROLS_HAS_THREADS
+        return true;
+    }
+    void uploadPersistentTexture() {
+        if (!mustUploadPersistentTexture) return;
+        IM_ASSERT(AnimatedImage::GenerateOrUpdateTextureCb!=NULL);	// Please use ImGui::AnimatedImage::SetGenerateOrUpdateTextureCallback(...) before calling this method
+        AnimatedImage::GenerateOrUpdateTextureCb(persistentTexId,w*numFramesPerRowInPersistentTexture,h*numFramesPerColInPersistentTexture,4,buffer,false,false,false);
+        STBI_FREE(buffer);buffer=NULL;
+        mustUploadPersistentTexture = false;
+    }
 
     inline void updateTexture() const   {
         // fix updateTexture() to use persistentTexID when necessary
         IM_ASSERT(AnimatedImage::GenerateOrUpdateTextureCb!=NULL);	// Please use ImGui::AnimatedImage::SetGenerateOrUpdateTextureCallback(...) before calling this method
+        if (!const_cast<AnimatedImageInternal*>(this)->finishLoading()) return;    // (it's the only method that can modify the image after loading)
         if (frames<=0) return;
         else if (frames==1) {
             if (!texId) AnimatedImage::GenerateOrUpdateTextureCb(texId,w,h,4,buffer,false,false,false);
@@ -940,19 +1026,28 @@ struct AnimatedImageInternal {
 #   endif //IMGUIVARIOUSCONTROLS_NO_STDIO
 
     public:
-    AnimatedImageInternal()  {buffer=NULL;persistentTexIdIsNotOwned=false;texId=persistentTexId=NULL;clear();}
+    AnimatedImageInternal()  {buffer=NULL;persistentTexIdIsNotOwned=false;texId=persistentTexId=NULL;initLoadJob();clear();}
     ~AnimatedImageInternal()  {clear();persistentTexIdIsNotOwned=false;}
 #	ifndef STBI_NO_GIF
 #   ifndef IMGUIVARIOUSCONTROLS_NO_STDIO
-    AnimatedImageInternal(char const *filename,bool useHoverModeIfSupported=false)  {buffer=NULL;persistentTexIdIsNotOwned = false;texId=persistentTexId=NULL;load(filename,useHoverModeIfSupported);}
+    AnimatedImageInternal(char const *filename,bool useHoverModeIfSupported=false)  {buffer=NULL;persistentTexIdIsNotOwned = false;texId=persistentTexId=NULL;initLoadJob();load(filename,useHoverModeIfSupported);}
 #   endif //IMGUIVARIOUSCONTROLS_NO_STDIO
-    AnimatedImageInternal(const unsigned char* memory_gif,int memory_gif_size,bool useHoverModeIfSupported=false)  {buffer=NULL;persistentTexIdIsNotOwned = false;texId=persistentTexId=NULL;load_from_memory(memory_gif,memory_gif_size,useHoverModeIfSupported);}
+    AnimatedImageInternal(const unsigned char* memory_gif,int memory_gif_size,bool useHoverModeIfSupported=false)  {buffer=NULL;persistentTexIdIsNotOwned = false;texId=persistentTexId=NULL;initLoadJob();load_from_memory(memory_gif,memory_gif_size,useHoverModeIfSupported);}
 #	endif //STBI_NO_GIF
     AnimatedImageInternal(ImTextureID myTexId,int animationImageWidth,int animationImageHeight,int numFrames,int numFramesPerRowInTexture,int numFramesPerColumnInTexture,float delayDetweenFramesInCs,bool useHoverMode=false) {
-        buffer=NULL;persistentTexIdIsNotOwned = false;texId=persistentTexId=NULL;
+        buffer=NULL;persistentTexIdIsNotOwned = false;texId=persistentTexId=NULL;initLoadJob();
         create(myTexId,animationImageWidth,animationImageHeight,numFrames,numFramesPerRowInTexture,numFramesPerColumnInTexture,delayDetweenFramesInCs,useHoverMode);
     }
+    inline void initLoadJob() {
+#       ifdef IMGUIVARIOUSCONTROLS_HAS_THREADS
+        loadJob = NULL;
+#       endif //IMGUIVARIOUSCONTROLS_HAS_THREADS
+    }
     void clear() {
+#       ifdef IMGUIVARIOUSCONTROLS_HAS_THREADS
+        LoadJob::Destroy(loadJob);
+#       endif //IMGUIVARIOUSCONTROLS_HAS_THREADS
+        mustUploadPersistentTexture = false;
         w=h=frames=lastFrameNum=0;delay=0.f;timer=-1.f;
         if (buffer) {STBI_FREE(buffer);buffer=NULL;} delays.clear();
         numFramesPerRowInPersistentTexture = numFramesPerColInPersistentTexture = 0;
@@ -968,8 +1063,23 @@ struct AnimatedImageInternal {
         ScopedFileContent fc(filename);
         return (fc.gif_buffer && load_from_memory(fc.gif_buffer,fc.gif_buffer_size,useHoverModeIfSupported));
     }
+#   ifdef IMGUIVARIOUSCONTROLS_HAS_THREADS
+    bool loadAsync(char const *filename,bool useHoverModeIfSupported=false)  {
+        clear();
+        loadJob = LoadJob::Create(filename,useHoverModeIfSupported);
+        return loadJob!=NULL;
+    }
+#   else //IMGUIVARIOUSCONTROLS_HAS_THREADS
+    bool loadAsync(char const *filename,bool useHoverModeIfSupported=false)  {return load(filename,useHoverModeIfSupported);}
+#   endif //IMGUIVARIOUSCONTROLS_HAS_THREADS
 #   endif //ifndef IMGUIVARIOUSCONTROLS_NO_STDIO
     bool load_from_memory(const unsigned char* gif_buffer,int gif_buffer_size,bool useHoverModeIfSupported=false)  {
+        if (!decode(gif_buffer,gif_buffer_size,useHoverModeIfSupported)) return false;
+        uploadPersistentTexture();
+        return true;
+    }
+    // The part of load_from_memory(...) that doesn't need the rendering context (so that it can run in a worker thread)
+    bool decode(const unsigned char* gif_buffer,int gif_buffer_size,bool useHoverModeIfSupported=false)  {
         clear();hoverModeIfSupported = false;
 
         int c=0, *int_delays=NULL;
@@ -1015,11 +1125,7 @@ struct AnimatedImageInternal {
                 numFramesPerColInPersistentTexture = maxNumFramesPerCol;
 
                 rearrangeBufferForPersistentTexture();
-
-                // generate persistentTexture,delete buffer
-                IM_ASSERT(AnimatedImage::GenerateOrUpdateTextureCb!=NULL);	// Please use ImGui::AnimatedImage::SetGenerateOrUpdateTextureCallback(...) before calling this method
-                AnimatedImage::GenerateOrUpdateTextureCb(persistentTexId,w*maxNumFramesPerRow,h*maxNumFramesPerCol,4,buffer,false,false,false);
-                STBI_FREE(buffer);buffer=NULL;
+                mustUploadPersistentTexture = true; // the persistentTexture will be generated (and the buffer deleted) by uploadPersistentTexture()
 
                 hoverModeIfSupported = useHoverModeIfSupported;
                 //fprintf(stderr,"%d x %d (%d x %d)\n",numFramesPerRowInPersistentTexture,numFramesPerColInPersistentTexture,(int)textureSize.x,(int)textureSize.y);
@@ -1056,6 +1162,11 @@ struct AnimatedImageInternal {
     }
 
     inline bool areAllFramesInASingleTexture() const {return persistentTexId!=NULL;}
+#   ifdef IMGUIVARIOUSCONTROLS_HAS_THREADS
+    inline bool isLoading() const {return loadJob!=NULL;}
+#   else //IMGUIVARIOUSCONTROLS_HAS_THREADS
+    inline bool isLoading() const {return false;}
+#   endif //IMGUIVARIOUSCONTROLS_HAS_THREADS
     void render(ImVec2 size=ImVec2(0,0), const ImVec2& uv0=ImVec2(0,0), const ImVec2& uv1=ImVec2(1,1), const ImVec4& tint_col=ImVec4(1,1,1,1), const ImVec4& border_col=ImVec4(0,0,0,0)) const  {
         ImGuiWindow* window = GetCurrentWindow();
         if (window->SkipItems)
@@ -1074,6 +1185,7 @@ struct AnimatedImageInternal {
             return;
 
         updateTexture();
+        if (!texId) return; // still loading
 
         ImVec2 uv_0 = uv0;
         ImVec2 uv_1 = uv1;
@@ -1171,7 +1283,7 @@ struct AnimatedImageInternal {
         if (bg_col.w > 0.0f)
             window->DrawList->AddRectFilled(image_bb.Min, image_bb.Max, GetColorU32(bg_col));
 
-        window->DrawList->AddImage(texId, image_bb.Min, image_bb.Max, uv_0, uv_1, GetColorU32(tint_col));
+        if (texId) window->DrawList->AddImage(texId, image_bb.Min, image_bb.Max, uv_0, uv_1, GetColorU32(tint_col));
 
         if (hasText) ImGui::RenderText(start,label);
         return pressed;
@@ -1281,6 +1393,7 @@ bool AnimatedImage::renderAsButton(const char *label, ImVec2 size, const ImVec2
 #ifndef STBI_NO_GIF
 #ifndef IMGUIVARIOUSCONTROLS_NO_STDIO
 bool AnimatedImage::load(const char *gif_filepath, bool useHoverModeIfSupported)    {return ptr->load(gif_filepath,useHoverModeIfSupported);}
+bool AnimatedImage::loadAsync(const char *gif_filepath, bool useHoverModeIfSupported)    {return ptr->loadAsync(gif_filepath,useHoverModeIfSupported);}
 #endif //IMGUIVARIOUSCONTROLS_NO_STDIO
 bool AnimatedImage::load_from_memory(const unsigned char* gif_buffer,int gif_buffer_size,bool useHoverModeIfSupported)  {return ptr->load_from_memory(gif_buffer,gif_buffer_size,useHoverModeIfSupported);}
 #endif //STBI_NO_GIF
@@ -1288,6 +1401,7 @@ bool AnimatedImage::create(ImTextureID myTexId, int animationImageWidth, int ani
 int AnimatedImage::getWidth() const {return ptr->getWidth();}
 int AnimatedImage::getHeight() const    {return ptr->getHeight();}
 int AnimatedImage::getNumFrames() const {return ptr->getNumFrames();}
+bool AnimatedImage::isLoading() const {return ptr->isLoading();}
 bool AnimatedImage::areAllFramesInASingleTexture() const    {return ptr->areAllFramesInASingleTexture();}
 #endif //NO_IMGUIVARIOUSCONTROLS_ANIMATEDIMAGE
 
@@ -1301,9 +1415,12 @@ bool AnimatedImage::areAllFramesInASingleTexture() const    {return ptr->areAllF
         return ImVec2((mp.x-uv0.x)*(zoomedImageSize.x)/(uv1.x-uv0.x)+startPos.x-cursorPosAtStart.x,(mp.y-uv0.y)*(zoomedImageSize.y)/(uv1.y-uv0.y)+startPos.y-cursorPosAtStart.y);
     }
 */
-bool ImageZoomAndPan(ImTextureID user_texture_id, const ImVec2& size,float aspectRatio,float& zoom,ImVec2& zoomCenter,int panMouseButtonDrag,int resetZoomAndPanMouseButton,const ImVec2& zoomMaxAndZoomStep)
+// Shared by the ImageZoomAndPan(...) overloads: it processes the user interaction and calculates where the image must be drawn.
+// pVisibleOut is set to false (and nothing must be drawn) when the item is clipped.
+static bool ImageZoomAndPanBehavior(const ImVec2& size,float aspectRatio,float& zoom,ImVec2& zoomCenter,int panMouseButtonDrag,int resetZoomAndPanMouseButton,const ImVec2& zoomMaxAndZoomStep,ImVec2& startPosOut,ImVec2& endPosOut,ImVec2& uv0Out,ImVec2& uv1Out,bool* pVisibleOut)
 {
     bool rv = false;
+    *pVisibleOut = false;
     ImGuiWindow* window = GetCurrentWindow();
     if (!window || window->SkipItems) return rv;
     ImVec2 curPos = ImGui::GetCursorPos();
@@ -1427,16 +1544,365 @@ bool ImageZoomAndPan(ImTextureID user_texture_id, const ImVec2& size,float aspec
     ItemSize(bb);
     if (!ItemAdd(bb, NULL)) return rv;*/
 
-    ImVec2 startPos=bb.Min,endPos=bb.Max;
+    ImVec2& startPos=startPosOut;ImVec2& endPos=endPosOut;
+    startPos=bb.Min;endPos=bb.Max;
     startPos.x+= remainingWndSize.x*.5f;
     startPos.y+= remainingWndSize.y*.5f;
     endPos.x = startPos.x + imageSz.x;
     endPos.y = startPos.y + imageSz.y;
+    uv0Out = uv0;uv1Out = uv1;
+    *pVisibleOut = true;
 
-    window->DrawList->AddImage(user_texture_id, startPos, endPos, uv0, uv1);
+    return rv;
+}
+bool ImageZoomAndPan(ImTextureID user_texture_id, const ImVec2& size,float aspectRatio,float& zoom,ImVec2& zoomCenter,int panMouseButtonDrag,int resetZoomAndPanMouseButton,const ImVec2& zoomMaxAndZoomStep)
+{
+    ImVec2 startPos,endPos,uv0,uv1;bool visible = false;
+    const bool rv = ImageZoomAndPanBehavior(size,aspectRatio,zoom,zoomCenter,panMouseButtonDrag,resetZoomAndPanMouseButton,zoomMaxAndZoomStep,startPos,endPos,uv0,uv1,&visible);
+    if (visible) GetCurrentWindow()->DrawList->AddImage(user_texture_id, startPos, endPos, uv0, uv1);
+    return rv;
+}
+
+#ifndef NO_IMGUIVARIOUSCONTROLS_TILEDIMAGE
+struct TiledImageInternal {
+    struct Level {
+        int w,h;
+        int numTilesX,numTilesY;
+        unsigned char* pixels;
+    };
+    struct Tile {
+        ImTextureID texID;
+        int level,tx,ty;
+        int tw,th;
+        int lastUsedFrame;
+        bool pinned;    // The tile of the coarsest level is never evicted: it's the fallback of all the others
+    };
+    int tileSize,maxResidentTiles,maxTileUploadsPerFrame;
+    int w,h,c;
+    ImVector<Level> levels;
+    volatile int numLevelsReady;
+    volatile int numRowsDone;
+    volatile int cancelRequested;
+    int numRowsTotal;
+#   ifdef IMGUIVARIOUSCONTROLS_HAS_THREADS
+    ImGuiHelper::ThreadHandle thread;
+#   endif //IMGUIVARIOUSCONTROLS_HAS_THREADS
+
+    ImVector<Tile> tiles;
+    ImGuiStorage tileMap;   // GetTileKey(...) -> tile index + 1
+    ImVector<unsigned char> tileBuffer;
+    int lastFrame,numUploadsThisFrame;
+
+    TiledImageInternal(int _tileSize,int _maxResidentTiles,int _maxTileUploadsPerFrame) {
+        tileSize = _tileSize<16 ? 16 : _tileSize;
+        maxResidentTiles = _maxResidentTiles<4 ? 4 : _maxResidentTiles;
+        maxTileUploadsPerFrame = _maxTileUploadsPerFrame<1 ? 1 : _maxTileUploadsPerFrame;
+        w=h=c=0;numLevelsReady=numRowsDone=cancelRequested=numRowsTotal=0;
+#       ifdef IMGUIVARIOUSCONTROLS_HAS_THREADS
+        thread = NULL;
+#       endif //IMGUIVARIOUSCONTROLS_HAS_THREADS
+        lastFrame=-1;numUploadsThisFrame=0;
+    }
+    ~TiledImageInternal() {clear();}
+
+    inline static int Load(volatile int* pValue) {
+#       ifdef IMGUIVARIOUSCONTROLS_HAS_THREADS
+        return ImGuiHelper::AtomicLoad(pValue);
+#       else //IMGUIVARIOUSCONTROLS_HAS_THREADS
+        return *pValue;
+#       endif //IMGUIVARIOUSCONTROLS_HAS_THREADS
+    }
+    inline static void Store(volatile int* pValue,int value) {
+#       ifdef IMGUIVARIOUSCONTROLS_HAS_THREADS
+        ImGuiHelper::AtomicStore(pValue,value);
+#       else //IMGUIVARIOUSCONTROLS_HAS_THREADS
+        *pValue = value;
+#       endif //IMGUIVARIOUSCONTROLS_HAS_THREADS
+    }
+    inline static ImGuiID GetTileKey(int level,int tx,int ty) {return (ImGuiID)((level<<28)|(ty<<14)|tx);}
 
+    void clear() {
+#       ifdef IMGUIVARIOUSCONTROLS_HAS_THREADS
+        if (thread) {
+            Store(&cancelRequested,1);
+            ImGuiHelper::ThreadJoin(thread);
+            thread = NULL;
+        }
+#       endif //IMGUIVARIOUSCONTROLS_HAS_THREADS
+        for (int i=0;i<tiles.size();i++) {
+            Tile& t = tiles[i];
+            if (t.texID) {
+                IM_ASSERT(TiledImage::FreeTextureCb);   // Please use TiledImage::SetFreeTextureCallback(...)
+                TiledImage::FreeTextureCb(t.texID);t.texID=NULL;
+            }
+        }
+        tiles.clear();tileMap.Clear();
+        for (int i=0;i<levels.size();i++) {if (levels[i].pixels) ImGui::MemFree(levels[i].pixels);}
+        levels.clear();
+        w=h=c=0;numLevelsReady=numRowsDone=cancelRequested=numRowsTotal=0;
+    }
+
+    bool setImage(const unsigned char* pixels,int _w,int _h,int _c) {
+        clear();
+        IM_ASSERT(pixels && _w>0 && _h>0 && (_c==1 || _c==3 || _c==4));
+        if (!pixels || _w<=0 || _h<=0 || (_c!=1 && _c!=3 && _c!=4)) return false;
+        // tile keys use 14 bits for each tile coordinate
+        if ((_w+tileSize-1)/tileSize>=(1<<14) || (_h+tileSize-1)/tileSize>=(1<<14)) return false;
+        w=_w;h=_h;c=_c;
+        int lw=w,lh=h;
+        for (;;) {
+            Level l;l.w=lw;l.h=lh;
+            l.numTilesX=(lw+tileSize-1)/tileSize;l.numTilesY=(lh+tileSize-1)/tileSize;
+            l.pixels = (unsigned char*) ImGui::MemAlloc((size_t)lw*(size_t)lh*(size_t)c);
+            if (!l.pixels) {clear();return false;}
+            levels.push_back(l);
+            if (levels.size()>1) numRowsTotal+=lh;
+            if (lw<=tileSize && lh<=tileSize) break;
+            lw=(lw+1)/2;lh=(lh+1)/2;
+        }
+        memcpy(levels[0].pixels,pixels,(size_t)w*(size_t)h*(size_t)c);
+        numLevelsReady = 1;
+#       ifdef IMGUIVARIOUSCONTROLS_HAS_THREADS
+        if (levels.size()>1) {
+            thread = ImGuiHelper::ThreadCreate(&ThreadFunction,this);
+            if (thread) return true;
+        }
+#       endif //IMGUIVARIOUSCONTROLS_HAS_THREADS
+        generatePyramid();
+        return true;
+    }
+    static void ThreadFunction(void* userPtr) {((TiledImageInternal*) userPtr)->generatePyramid();}
+    // Box filter. Level buffers are allocated in advance, so that 'levels' is never touched here.
+    void generatePyramid() {
+        for (int li=1,lsz=levels.size();li<lsz;li++) {
+            for (int y=0,ysz=levels[li].h;y<ysz;y++) {
+                if (Load(&cancelRequested)) return;
+                filterRow(li,y,0,levels[li].w);
+                Store(&numRowsDone,Load(&numRowsDone)+1);
+            }
+            Store(&numLevelsReady,li+1);
+        }
+    }
+    // Calculates the pixels [x0,x1) of row y of level li from level li-1
+    void filterRow(int li,int y,int x0,int x1) {
+        const size_t C = (size_t) c;
+        const Level& src = levels[li-1];
+        Level& dst = levels[li];
+        const unsigned char* row0 = &src.pixels[(size_t)(2*y)*(size_t)src.w*C];
+        const unsigned char* row1 = 2*y+1<src.h ? row0+(size_t)src.w*C : row0;
+        unsigned char* pdst = &dst.pixels[((size_t)y*(size_t)dst.w+(size_t)x0)*C];
+        for (int x=x0;x<x1;x++) {
+            const size_t o0 = (size_t)(2*x)*C;
+            const size_t o1 = 2*x+1<src.w ? o0+C : o0;
+            for (size_t ch=0;ch<C;ch++) {
+                *pdst++ = (unsigned char) (((unsigned)row0[o0+ch]+(unsigned)row0[o1+ch]+(unsigned)row1[o0+ch]+(unsigned)row1[o1+ch]+2)>>2);
+            }
+        }
+    }
+
+    bool updateImage(const unsigned char* pixels,int x0,int y0,int x1,int y1) {
+        IM_ASSERT(pixels);
+        if (!pixels || levels.size()==0) return false;
+        x0=ImMax(x0,0);y0=ImMax(y0,0);x1=ImMin(x1,w);y1=ImMin(y1,h);
+        if (x1<=x0 || y1<=y0) return true;
+#       ifdef IMGUIVARIOUSCONTROLS_HAS_THREADS
+        if (thread) {
+            // The worker reads the levels we're going to modify (it's not canceled: it has just one image to process)
+            ImGuiHelper::ThreadJoin(thread);
+            thread = NULL;
+        }
+#       endif //IMGUIVARIOUSCONTROLS_HAS_THREADS
+        const size_t C = (size_t) c;
+        for (int y=y0;y<y1;y++) {
+            const size_t offset = ((size_t)y*(size_t)w+(size_t)x0)*C;
+            memcpy(&levels[0].pixels[offset],&pixels[offset],(size_t)(x1-x0)*C);
+        }
+        for (int li=0,lsz=levels.size();li<lsz;li++) {
+            if (li>0) {
+                // The box filter maps source pixels [2x,2x+1] to x
+                x0/=2;y0/=2;x1=ImMin((x1+1)/2,levels[li].w);y1=ImMin((y1+1)/2,levels[li].h);
+                for (int y=y0;y<y1;y++) filterRow(li,y,x0,x1);
+            }
+            const int tx0 = x0/tileSize,ty0 = y0/tileSize,tx1 = (x1-1)/tileSize,ty1 = (y1-1)/tileSize;
+            for (int i=0,isz=tiles.size();i<isz;i++) {
+                Tile& t = tiles[i];
+                if (t.texID && t.level==li && t.tx>=tx0 && t.tx<=tx1 && t.ty>=ty0 && t.ty<=ty1) uploadTile(t);
+            }
+        }
+        return true;
+    }
+
+    void uploadTile(Tile& t) {
+        const Level& l = levels[t.level];
+        const size_t C = (size_t) c;
+        const int x0 = t.tx*tileSize,y0 = t.ty*tileSize;
+        tileBuffer.resize(t.tw*t.th*c);
+        for (int y=0;y<t.th;y++) memcpy(&tileBuffer[y*t.tw*c],&l.pixels[((size_t)(y0+y)*(size_t)l.w+(size_t)x0)*C],(size_t)t.tw*C);
+        IM_ASSERT(TiledImage::GenerateOrUpdateTextureCb);   // Please use TiledImage::SetGenerateOrUpdateTextureCallback(...)
+        TiledImage::GenerateOrUpdateTextureCb(t.texID,t.tw,t.th,c,&tileBuffer[0],false,false,false);
+    }
+
+    // Returns the index of the resident tile, or -1. Can upload the tile if allowed.
+    int getTile(int level,int tx,int ty,int frame,bool canUpload) {
+        const ImGuiID key = GetTileKey(level,tx,ty);
+        const int index = tileMap.GetInt(key,0)-1;
+        if (index>=0) {tiles[index].lastUsedFrame=frame;return index;}
+        if (!canUpload || numUploadsThisFrame>=maxTileUploadsPerFrame) return -1;
+
+        const Level& l = levels[level];
+        const int x0 = tx*tileSize,y0 = ty*tileSize;
+        const int tw = ImMin(tileSize,l.w-x0),th = ImMin(tileSize,l.h-y0);
+
+        // Find a slot: a new one, or the least recently used tile (not used in this frame)
+        int slot = -1;
+        if (tiles.size()<maxResidentTiles) {
+            Tile t;t.texID=NULL;t.tw=t.th=0;
+            tiles.push_back(t);slot=tiles.size()-1;
+        }
+        else {
+            int minFrame = frame;
+            for (int i=0,isz=tiles.size();i<isz;i++) {
+                const Tile& t = tiles[i];
+                if (!t.pinned && t.lastUsedFrame<minFrame) {minFrame=t.lastUsedFrame;slot=i;}
+            }
+            if (slot<0) return -1;
+            Tile& t = tiles[slot];
+            tileMap.SetInt(GetTileKey(t.level,t.tx,t.ty),0);
+            if (t.texID && (t.tw!=tw || t.th!=th)) {
+                // Textures are reused only when they have the same size (some bindings can't resize them)
+                IM_ASSERT(TiledImage::FreeTextureCb);   // Please use TiledImage::SetFreeTextureCallback(...)
+                TiledImage::FreeTextureCb(t.texID);t.texID=NULL;
+            }
+        }
+
+        Tile& t = tiles[slot];
+        t.level=level;t.tx=tx;t.ty=ty;t.tw=tw;t.th=th;
+        uploadTile(t);
+        t.lastUsedFrame=frame;
+        t.pinned = (level==levels.size()-1);
+        tileMap.SetInt(key,slot+1);
+        ++numUploadsThisFrame;
+        return slot;
+    }
+
+    void render(ImDrawList* drawList,const ImVec2& pMin,const ImVec2& pMax,const ImVec2& uv0,const ImVec2& uv1,ImU32 col) {
+        const int numReady = Load(&numLevelsReady);
+        if (numReady==0 || !drawList || uv1.x<=uv0.x || uv1.y<=uv0.y || pMax.x<=pMin.x || pMax.y<=pMin.y) return;
+        const int frame = ImGui::GetFrameCount();
+        if (frame!=lastFrame) {lastFrame=frame;numUploadsThisFrame=0;}
+
+        // Visible part of [uv0,uv1]
+        const ImVec2 uvPerPixel((uv1.x-uv0.x)/(pMax.x-pMin.x),(uv1.y-uv0.y)/(pMax.y-pMin.y));
+        const ImVec2 clipMin = drawList->GetClipRectMin(),clipMax = drawList->GetClipRectMax();
+        const ImVec2 vuv0(ImMax(ImMax(uv0.x,0.f),uv0.x+(clipMin.x-pMin.x)*uvPerPixel.x),ImMax(ImMax(uv0.y,0.f),uv0.y+(clipMin.y-pMin.y)*uvPerPixel.y));
+        const ImVec2 vuv1(ImMin(ImMin(uv1.x,1.f),uv0.x+(clipMax.x-pMin.x)*uvPerPixel.x),ImMin(ImMin(uv1.y,1.f),uv0.y+(clipMax.y-pMin.y)*uvPerPixel.y));
+        if (vuv1.x<=vuv0.x || vuv1.y<=vuv0.y) return;
+
+        // The finest level where an image pixel doesn't cover more than one screen pixel
+        const float screenPixelsPerImagePixel = ImMax(1.f/(uvPerPixel.x*(float)w),1.f/(uvPerPixel.y*(float)h));
+        int level = 0;
+        for (float s=screenPixelsPerImagePixel;level+1<levels.size() && s*2.f<=1.f;s*=2.f) ++level;
+        // All the visible tiles must fit the cache (the pinned tile excluded)
+        int tx0=0,ty0=0,tx1=0,ty1=0;
+        for (;;) {
+            const Level& l = levels[level];
+            const float ts = (float) tileSize;
+            tx0 = (int)(vuv0.x*l.w/ts);ty0 = (int)(vuv0.y*l.h/ts);
+            tx1 = ImMin((int)(vuv1.x*l.w/ts),l.numTilesX-1);ty1 = ImMin((int)(vuv1.y*l.h/ts),l.numTilesY-1);
+            if ((tx1-tx0+1)*(ty1-ty0+1)<maxResidentTiles || level+1==levels.size()) break;
+            ++level;
+        }
+        if (level>=numReady) {
+            // The pyramid is not ready yet: we can't use a finer level if it doesn't fit the cache
+            const int fallbackLevel = numReady-1;
+            const Level& l = levels[fallbackLevel];
+            const float ts = (float) tileSize;
+            tx0 = (int)(vuv0.x*l.w/ts);ty0 = (int)(vuv0.y*l.h/ts);
+            tx1 = ImMin((int)(vuv1.x*l.w/ts),l.numTilesX-1);ty1 = ImMin((int)(vuv1.y*l.h/ts),l.numTilesY-1);
+            if ((tx1-tx0+1)*(ty1-ty0+1)>=maxResidentTiles) return;
+            level = fallbackLevel;
+        }
+
+        const Level& l = levels[level];
+        const ImVec2 scale((pMax.x-pMin.x)/(uv1.x-uv0.x),(pMax.y-pMin.y)/(uv1.y-uv0.y));
+        for (int ty=ty0;ty<=ty1;ty++) {
+            for (int tx=tx0;tx<=tx1;tx++) {
+                // Part of this tile that must be drawn, in normalized image coords
+                const ImVec2 tuv0(ImMax(vuv0.x,(float)(tx*tileSize)/(float)l.w),ImMax(vuv0.y,(float)(ty*tileSize)/(float)l.h));
+                const ImVec2 tuv1(ImMin(vuv1.x,(float)ImMin((tx+1)*tileSize,l.w)/(float)l.w),ImMin(vuv1.y,(float)ImMin((ty+1)*tileSize,l.h)/(float)l.h));
+                if (tuv1.x<=tuv0.x || tuv1.y<=tuv0.y) continue;
+                // Use the tile, or the best available coarser tile that contains it
+                int index = -1;
+                for (int li=level,k=0;li<numReady && index<0;li++,k++) index = getTile(li,tx>>k,ty>>k,frame,li==level || li==numReady-1);
+                if (index<0) continue;
+                const Tile& t = tiles[index];
+                const Level& tl = levels[t.level];
+                const ImVec2 tileUv0((float)(t.tx*tileSize)/(float)tl.w,(float)(t.ty*tileSize)/(float)tl.h);
+                const ImVec2 tileUvSize((float)t.tw/(float)tl.w,(float)t.th/(float)tl.h);
+                drawList->AddImage(t.texID,
+                                   ImVec2(pMin.x+(tuv0.x-uv0.x)*scale.x,pMin.y+(tuv0.y-uv0.y)*scale.y),
+                                   ImVec2(pMin.x+(tuv1.x-uv0.x)*scale.x,pMin.y+(tuv1.y-uv0.y)*scale.y),
+                                   ImVec2((tuv0.x-tileUv0.x)/tileUvSize.x,(tuv0.y-tileUv0.y)/tileUvSize.y),
+                                   ImVec2((tuv1.x-tileUv0.x)/tileUvSize.x,(tuv1.y-tileUv0.y)/tileUvSize.y),col);
+            }
+        }
+    }
+};
+
+TiledImage::FreeTextureDelegate TiledImage::FreeTextureCb =
+#ifdef IMGUI_USE_AUTO_BINDING
+    &ImImpl_FreeTexture;
+#else //IMGUI_USE_AUTO_BINDING
+    NULL;
+#endif //IMGUI_USE_AUTO_BINDING
+TiledImage::GenerateOrUpdateTextureDelegate TiledImage::GenerateOrUpdateTextureCb =
+#ifdef IMGUI_USE_AUTO_BINDING
+    &ImImpl_GenerateOrUpdateTexture;
+#else //IMGUI_USE_AUTO_BINDING
+    NULL;
+#endif //IMGUI_USE_AUTO_BINDING
+
+TiledImage::TiledImage(int tileSize,int maxResidentTiles,int maxTileUploadsPerFrame) {
+    ptr = (TiledImageInternal*) ImGui::MemAlloc(sizeof(TiledImageInternal));
+    IM_PLACEMENT_NEW(ptr) TiledImageInternal(tileSize,maxResidentTiles,maxTileUploadsPerFrame);
+}
+TiledImage::~TiledImage() {
+    clear();
+    ptr->~TiledImageInternal();
+    ImGui::MemFree(ptr);ptr=NULL;
+}
+void TiledImage::clear() {ptr->clear();}
+bool TiledImage::setImage(const unsigned char* pixels,int w,int h,int c) {return ptr->setImage(pixels,w,h,c);}
+bool TiledImage::updateImage(const unsigned char* pixels,int x0,int y0,int x1,int y1) {return ptr->updateImage(pixels,x0,y0,x1,y1);}
+bool TiledImage::isReady() const {return ptr->levels.size()>0 && TiledImageInternal::Load(&ptr->numLevelsReady)==ptr->levels.size();}
+float TiledImage::getProgress() const {
+    if (ptr->levels.size()==0) return 0.f;
+    return ptr->numRowsTotal>0 ? (float)TiledImageInternal::Load(&ptr->numRowsDone)/(float)ptr->numRowsTotal : 1.f;
+}
+int TiledImage::getWidth() const {return ptr->w;}
+int TiledImage::getHeight() const {return ptr->h;}
+int TiledImage::getNumChannels() const {return ptr->c;}
+int TiledImage::getNumLevels() const {return ptr->levels.size();}
+int TiledImage::getNumResidentTiles() const {return ptr->tiles.size();}
+void TiledImage::render(ImDrawList* drawList,const ImVec2& pMin,const ImVec2& pMax,const ImVec2& uv0,const ImVec2& uv1,ImU32 col) const {ptr->render(drawList,pMin,pMax,uv0,uv1,col);}
+
+bool ImageZoomAndPan(const TiledImage& image, const ImVec2& size,float& zoom,ImVec2& zoomCenter,int panMouseButtonDrag,int resetZoomAndPanMouseButton,const ImVec2& zoomMaxAndZoomStep)
+{
+    const int w = image.getWidth(),h = image.getHeight();
+    if (w<=0 || h<=0) return false;
+    ImVec2 zoomMaxAndStep = zoomMaxAndZoomStep;
+    if (zoomMaxAndStep.x<=0) {
+        // Fully zoomed in, an image pixel covers about 8 screen pixels
+        const ImVec2 curPos = ImGui::GetCursorPos();
+        const ImVec2 wndSz(size.x>0 ? size.x : ImGui::GetWindowSize().x-curPos.x,size.y>0 ? size.y : ImGui::GetWindowSize().y-curPos.y);
+        zoomMaxAndStep.x = ImMax(16.f,8.f*ImMin((float)w/ImMax(wndSz.x,1.f),(float)h/ImMax(wndSz.y,1.f)));
+    }
+    ImVec2 startPos,endPos,uv0,uv1;bool visible = false;
+    const bool rv = ImageZoomAndPanBehavior(size,(float)w/(float)h,zoom,zoomCenter,panMouseButtonDrag,resetZoomAndPanMouseButton,zoomMaxAndStep,startPos,endPos,uv0,uv1,&visible);
+    if (visible) image.render(GetCurrentWindow()->DrawList,startPos,endPos,uv0,uv1);
     return rv;
 }
+#endif //NO_IMGUIVARIOUSCONTROLS_TILEDIMAGE
 
 inline static bool GlyphButton(ImGuiID id, const ImVec2& pos,const ImVec2& halfSize,const char* text,bool* toggleButtonState=NULL,bool *pHovered = NULL)    {
     ImGuiWindow* window = GetCurrentWindow();
@@ -285,6 +285,9 @@ struct AnimatedImage {
 #	ifndef STBI_NO_GIF
 #   ifndef IMGUIVARIOUSCONTROLS_NO_STDIO
     IMGUI_API bool load(char const *gif_filepath,bool useHoverModeIfSupported=false); // 'hoverMode' is supported only if all frames fit 'MaxPersistentTextureSize'
+    // Same as load(...), but the file is read and decoded in a worker thread (when the threading layer of imguihelper is available).
+    // Nothing is displayed until the image is ready. Texture uploads are limited by ImGuiHelper::SetTextureUploadBudgetPerFrame(...).
+    IMGUI_API bool loadAsync(char const *gif_filepath,bool useHoverModeIfSupported=false);
 #   endif //IMGUIVARIOUSCONTROLS_NO_STDIO
     IMGUI_API bool load_from_memory(const unsigned char* gif_buffer,int gif_buffer_size,bool useHoverModeIfSupported=false);  // 'hoverMode' is supported only if all frames fit 'MaxPersistentTextureSize'
 #	endif //STBI_NO_GIF
@@ -293,6 +296,7 @@ struct AnimatedImage {
     IMGUI_API int getHeight() const;
     IMGUI_API int getNumFrames() const;
     IMGUI_API bool areAllFramesInASingleTexture() const;  // when true, 'hoverMode' was available in ctr/load/create (but it can't change at runtime)
+    IMGUI_API bool isLoading() const;                     // true while loadAsync(...) is decoding the image
 
     static ImVec2 MaxPersistentTextureSize;   // 2048,2048 (Enlarge the buffer if needed for 'hoverMode': but using smaller animated images and less frames is better)
 
@@ -310,6 +314,56 @@ struct AnimatedImage {
 // returns true if some user interaction have been processed
 IMGUI_API bool ImageZoomAndPan(ImTextureID user_texture_id, const ImVec2& size,float aspectRatio,float& zoom,ImVec2& zoomCenter,int panMouseButtonDrag=1,int resetZoomAndPanMouseButton=2,const ImVec2& zoomMaxAndZoomStep=ImVec2(16.f,1.025f));
 
+#ifndef NO_IMGUIVARIOUSCONTROLS_TILEDIMAGE
+// Displays huge images (bigger than the max texture size) through a tiled mipmap pyramid.
+// The pyramid is generated in a background thread (when the threading layer of imguihelper is available),
+// and only the visible tiles at the appropriate level are uploaded, into a fixed-size texture cache.
+// While a tile is missing, the best available coarser tile is used instead.
+struct TiledImage {
+    public:
+    typedef void (*FreeTextureDelegate)(ImTextureID& texid);
+    typedef void (*GenerateOrUpdateTextureDelegate)(ImTextureID& imtexid,int width,int height,int channels,const unsigned char* pixels,bool useMipmapsIfPossible,bool wraps,bool wrapt);
+    static void SetFreeTextureCallback(FreeTextureDelegate freeTextureCb) {FreeTextureCb=freeTextureCb;}
+    static void SetGenerateOrUpdateTextureCallback(GenerateOrUpdateTextureDelegate generateOrUpdateTextureCb) {GenerateOrUpdateTextureCb=generateOrUpdateTextureCb;}
+    static FreeTextureDelegate GetFreeTextureCallback() {return FreeTextureCb;}
+    static GenerateOrUpdateTextureDelegate GetGenerateOrUpdateTextureCallback() {return GenerateOrUpdateTextureCb;}
+
+    // GPU memory is bounded by: maxResidentTiles*tileSize*tileSize*channels
+    IMGUI_API TiledImage(int tileSize=256,int maxResidentTiles=128,int maxTileUploadsPerFrame=4);
+    IMGUI_API ~TiledImage();   // calls 'clear'
+    IMGUI_API void clear();    // releases the textures and the pyramid
+
+    // The pixels are copied (so they can be released soon after this call). c can be 1,3 or 4.
+    // It (re)starts the generation of the pyramid: the textures of a previous image are released.
+    IMGUI_API bool setImage(const unsigned char* pixels,int w,int h,int c);
+    // Faster than setImage(...) when only the [x0,x1)x[y0,y1) part of the image has changed: pixels is the whole image (with the size and channels passed to setImage(...)).
+    // Only that part is filtered again on each level, and only the resident tiles that contain it are uploaded again.
+    // If the pyramid is still being generated, it waits for it. Returns false when there's no image.
+    IMGUI_API bool updateImage(const unsigned char* pixels,int x0,int y0,int x1,int y1);
+    IMGUI_API bool isReady() const;                 // true when the whole pyramid is available
+    IMGUI_API float getProgress() const;            // of the pyramid generation, in [0,1]
+    IMGUI_API int getWidth() const;
+    IMGUI_API int getHeight() const;
+    IMGUI_API int getNumChannels() const;
+    IMGUI_API int getNumLevels() const;
+    IMGUI_API int getNumResidentTiles() const;
+
+    // Draws the [uv0,uv1] portion of the image into [pMin,pMax]. Must be called once per frame (per view).
+    IMGUI_API void render(ImDrawList* drawList,const ImVec2& pMin,const ImVec2& pMax,const ImVec2& uv0=ImVec2(0,0),const ImVec2& uv1=ImVec2(1,1),ImU32 col=0xFFFFFFFF) const;
+
+    private:
+    TiledImage(const TiledImage& ) {}
+    void operator=(const TiledImage& ) {}
+    static FreeTextureDelegate FreeTextureCb;
+    static GenerateOrUpdateTextureDelegate GenerateOrUpdateTextureCb;
+    friend struct TiledImageInternal;
+    struct TiledImageInternal* ptr;
+};
+// Same as above, but for a TiledImage (the aspect ratio is the one of the image).
+// When zoomMaxAndZoomStep.x<=0, the max zoom is calculated so that a single image pixel can cover many screen pixels
+IMGUI_API bool ImageZoomAndPan(const TiledImage& image, const ImVec2& size,float& zoom,ImVec2& zoomCenter,int panMouseButtonDrag=1,int resetZoomAndPanMouseButton=2,const ImVec2& zoomMaxAndZoomStep=ImVec2(0.f,1.025f));
+#endif //NO_IMGUIVARIOUSCONTROLS_TILEDIMAGE
+
 // USAGE:
 /*
 // Nobody will use this, it's too complicated to set up. However:
@@ -5120,7 +5120,7 @@ bool Bz2DecompressFromMemory(const char* memoryBuffer,int memoryBufferSize,ImVec
 
     if (memoryBufferSize == 0  || !memoryBuffer) return false;
     const int memoryChunk = memoryBufferSize > (16*1024) ? (16*1024) : memoryBufferSize;
-    rv.resize(memoryChunk);  // we start using the memoryChunk length
+    rv.resize(startRv+memoryChunk);  // we start using the memoryChunk length
 
     bz_stream myBZStream;
     myBZStream.next_in =  (char *) memoryBuffer;
@@ -5131,6 +5131,7 @@ bool Bz2DecompressFromMemory(const char* memoryBuffer,int memoryBufferSize,ImVec
     myBZStream.bzfree = NULL;
     myBZStream.opaque = NULL;
     typedef unsigned long uLongType64;	// We can't use unsigned long long, because it needs C++11 (and we'll later cast it to an int in any case!)
+    uLongType64 prevStreamsOut = 0;    // total_out is reset at every bzip2 stream
     uLongType64 total_out = GetTotalOut<uLongType64>(myBZStream);
 
     bool done = false;
@@ -5143,16 +5144,27 @@ bool Bz2DecompressFromMemory(const char* memoryBuffer,int memoryBufferSize,ImVec
 	    myBZStream.next_out = (char *) (&rv[startRv] + total_out);
 	    myBZStream.avail_out = rv.size() - startRv - total_out;
 
-	    if ((err = BZ2_bzDecompress (&myBZStream))==BZ_STREAM_END) done = true;
+	    if ((err = BZ2_bzDecompress (&myBZStream))==BZ_STREAM_END) {
+		done = true;
+		// Concatenated bzip2 streams (e.g. from Bz2CompressFromMemoryParallel(...)): go on if another bzip2 header follows
+		if (myBZStream.avail_in>=3 && myBZStream.next_in[0]=='B' && myBZStream.next_in[1]=='Z' && myBZStream.next_in[2]=='h') {
+		    prevStreamsOut+=GetTotalOut<uLongType64>(myBZStream);
+		    char* next_in = myBZStream.next_in;unsigned int avail_in = myBZStream.avail_in;
+		    BZ2_bzDecompressEnd(&myBZStream);
+		    if (BZ2_bzDecompressInit(&myBZStream,0,0) != BZ_OK) {done = false;break;}
+		    myBZStream.next_in = next_in;myBZStream.avail_in = avail_in;
+		    done = false;
+		}
+	    }
 	    else if (err < 0)  break;
-	    total_out = GetTotalOut<uLongType64>(myBZStream);
+	    total_out = prevStreamsOut + GetTotalOut<uLongType64>(myBZStream);
 	}
 
 	if ((err=BZ2_bzDecompressEnd(&myBZStream)) < 0) done = false;
     }
     else done = false;
 
-    rv.resize(startRv+(done ? GetTotalOut<uLongType64>(myBZStream) : 0));
+    rv.resize(startRv+(done ? total_out : 0));
 
     return done;
 }
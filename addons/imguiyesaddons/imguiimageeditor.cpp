@@ -59,6 +59,25 @@ SOFTWARE.
     #define M_PI 3.14159265358979323846
 #endif
 
+// The convolution filters use SSE when available. Convolution and resizing process the image in parallel when the threading layer of imguihelper is available
+#if (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)) && !defined(IMGUIIMAGEEDITOR_NO_SSE)
+#   define IMGUIIMAGEEDITOR_ENABLE_SSE
+#   include <xmmintrin.h>
+#endif
+#if (defined(IMGUIHELPER_H_) && defined(IMGUIHELPER_HAS_THREADS))
+#   define IMGUIIMAGEEDITOR_HAS_THREADS
+#endif
+#ifndef IMGUIIMAGEEDITOR_ASYNC_RESIZE_MIN_PIXELS
+#   define IMGUIIMAGEEDITOR_ASYNC_RESIZE_MIN_PIXELS (2048*2048)
+#endif //IMGUIIMAGEEDITOR_ASYNC_RESIZE_MIN_PIXELS
+// Huge images are displayed through ImGui::TiledImage (from imguivariouscontrols) when available
+#if (defined(IMGUIVARIOUSCONTROLS_H_) && !defined(NO_IMGUIVARIOUSCONTROLS_TILEDIMAGE) && !defined(IMGUIIMAGEEDITOR_NO_TILED_VIEW))
+#   define IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+#   ifndef IMGUIIMAGEEDITOR_TILED_VIEW_MIN_SIZE
+#       define IMGUIIMAGEEDITOR_TILED_VIEW_MIN_SIZE 4096
+#   endif //IMGUIIMAGEEDITOR_TILED_VIEW_MIN_SIZE
+#endif //IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+
 // stb_image.h is MANDATORY
 #ifndef IMGUI_USE_AUTO_BINDING
 #ifndef STBI_INCLUDE_STB_IMAGE_H
@@ -1271,131 +1290,232 @@ static unsigned char* ClipImage(int dstW,int dstH,const unsigned char* im,int w,
     return nim;
 }
 
-// return image must be freed by the caller
-static unsigned char* ResizeImage(int dstW,int dstH,const unsigned char* im,int w, int h,int c,ImGuiIE::ResizeFilter filter,void* p_stbir_data_struct=NULL) {
-    IM_ASSERT(im && w>0 && h>0 && c>0 && c<=4 && c!=2 && dstW>0 && dstH>0);
-    if (!(im && w>0 && h>0 && c>0 && c<=4 && c!=2 && dstW>0 && dstH>0)) return NULL;
-
-    const int dstWxH = dstW*dstH;
-    const int dstSize = dstWxH*c;
-    unsigned char* nim = (unsigned char*) STBI_MALLOC(dstSize);
-    //memset((void*)nim,255,dstSize);
-    unsigned char* pni = nim;
-    const unsigned char* pim = im;
-
-    if (w<=2 || h<=2) filter = ImGuiIE::RF_NEAREST;  // Otherwise algorithms may fail.
-
-#   ifndef STBIR_INCLUDE_STB_IMAGE_RESIZE_H
-    if ((int)filter>ImGuiIE::RF_GOOD) filter = ImGuiIE::RF_GOOD;  // RF_BEST unavailable
+// Resizes horizontal bands of the destination image independently: ResizeImage(...) processes them in parallel
+// when imguihelper threads are available, and ResizeImageAsyncJob runs the whole thing in the background.
+struct ResizeImageJob {
+    const unsigned char* im;
+    int w,h,c;
+    unsigned char* nim;
+    int dstW,dstH;
+    ImGuiIE::ResizeFilter filter;
+#   ifdef STBIR_INCLUDE_STB_IMAGE_RESIZE_H
+    stbir_data_struct stbirData;
 #   endif //STBIR_INCLUDE_STB_IMAGE_RESIZE_H
+    int bandHeight,numBands;
+    volatile int numBandsDone;
+    volatile int cancelRequested;
+    volatile int failed;
+
+    // returns false if nothing can be done
+    bool init(int _dstW,int _dstH,const unsigned char* _im,int _w,int _h,int _c,ImGuiIE::ResizeFilter _filter,const void* p_stbir_data_struct=NULL) {
+        IM_ASSERT(_im && _w>0 && _h>0 && _c>0 && _c<=4 && _c!=2 && _dstW>0 && _dstH>0);
+        if (!(_im && _w>0 && _h>0 && _c>0 && _c<=4 && _c!=2 && _dstW>0 && _dstH>0)) return false;
+        im = _im;w = _w;h = _h;c = _c;
+        dstW = _dstW;dstH = _dstH;
+        filter = _filter;
+        if (w<=2 || h<=2) filter = ImGuiIE::RF_NEAREST;  // Otherwise algorithms may fail.
+#       ifndef STBIR_INCLUDE_STB_IMAGE_RESIZE_H
+        if ((int)filter>ImGuiIE::RF_GOOD) filter = ImGuiIE::RF_GOOD;  // RF_BEST unavailable
+        (void)p_stbir_data_struct;
+#       else //STBIR_INCLUDE_STB_IMAGE_RESIZE_H
+        stbirData = p_stbir_data_struct ? *((const stbir_data_struct*) p_stbir_data_struct) : stbir_data_struct();
+#       endif //STBIR_INCLUDE_STB_IMAGE_RESIZE_H
+        if ((int)filter<0 || (int)filter>=ImGuiIE::RF_COUNT) return false;
+        nim = (unsigned char*) STBI_MALLOC(dstW*dstH*c);
+        if (!nim) return false;
+        // ~256 KB per band
+        bandHeight = (256*1024)/(dstW*c);
+        if (bandHeight<16) bandHeight=16;
+        numBands = (dstH+bandHeight-1)/bandHeight;
+        numBandsDone = cancelRequested = failed = 0;
+        return true;
+    }
 
-    //typedef float real_t;
-    typedef double real_t;
+    void resizeBand(int y0,int y1) {
+        //typedef float real_t;
+        typedef double real_t;
+        unsigned char* pni = &nim[y0*dstW*c];
+        const unsigned char* pim = im;
 
-    if  (filter==ImGuiIE::RF_NEAREST) {
-        // http://tech-algorithm.com/articles/nearest-neighbor-image-scaling/
+        if  (filter==ImGuiIE::RF_NEAREST) {
+            // http://tech-algorithm.com/articles/nearest-neighbor-image-scaling/
 
-        // EDIT: added +1 to account for an early rounding problem
-        int x_ratio = (int)((w<<16)/dstW) +1;
-        int y_ratio = (int)((h<<16)/dstH) +1;
-        int x2=0, y2=0;
-        for (int i=0;i<dstH;i++) {
-            for (int j=0;j<dstW;j++) {
-                x2 = ((j*x_ratio)>>16);
-                y2 = ((i*y_ratio)>>16);
+            // EDIT: added +1 to account for an early rounding problem
+            int x_ratio = (int)((w<<16)/dstW) +1;
+            int y_ratio = (int)((h<<16)/dstH) +1;
+            int x2=0, y2=0;
+            for (int i=y0;i<y1;i++) {
+                for (int j=0;j<dstW;j++) {
+                    x2 = ((j*x_ratio)>>16);
+                    y2 = ((i*y_ratio)>>16);
 
-                pni = &nim[(i*dstW+j)*c];
-                pim = &im[(y2*w+x2)*c];
-                for (int ch=0;ch<c;ch++) {*pni++ = *pim++;}
+                    pni = &nim[(i*dstW+j)*c];
+                    pim = &im[(y2*w+x2)*c];
+                    for (int ch=0;ch<c;ch++) {*pni++ = *pim++;}
+                }
             }
         }
-        /*
-        const real_t x_ratio = ((real_t)(w-1))/dstW;
-        const real_t y_ratio = ((real_t)(h-1))/dstH;
-        int x2=0, y2=0;
-        for (int i = 0; i<dstH; i++) {
-            for (int j = 0; j<dstW; j++) {
-                x2 = (int) (x_ratio * j);
-                y2 = (int) (y_ratio * i);
-
-                pni = &nim[(i*dstW+j)*c];
-                pim = &im[(y2*w+x2)*c];
-                for (int ch=0;ch<c;ch++) {*pni++ = *pim++;}
-            }
-        }*/
-    }
-    else if (filter==ImGuiIE::RF_GOOD)
-    {
-        // http://tech-algorithm.com/articles/bilinear-image-scaling/
-        int x=0,y=0,index=0;
-        const unsigned char *A=NULL;
-        const unsigned char *B=NULL;
-        const unsigned char *C=NULL;
-        const unsigned char *D=NULL;        
-        const real_t x_ratio = ((real_t)(w-1))/dstW;
-        const real_t y_ratio = ((real_t)(h-1))/dstH;
-        real_t x_diff=0, y_diff=0, one_minus_x_diff=0, one_minus_y_diff=0;
-        for (int i=0;i<dstH;i++) {
-            for (int j=0;j<dstW;j++) {
-                x = (int)(x_ratio * j) ;
-                y = (int)(y_ratio * i) ;
-                x_diff = (x_ratio * j) - x ;
-                y_diff = (y_ratio * i) - y ;
-                one_minus_x_diff = 1.f - x_diff;
-                one_minus_y_diff = 1.f - y_diff;
-                index = (y*w+x)*c;
-                A = &im[index] ;
-                B = &im[index+c] ;
-                C = &im[index+w*c] ;
-                D = &im[index+(w+1)*c] ;
-
-
-                for (int ch=0;ch<c;ch++) {
-                    // TODO: Alpha now s like all other channels...
-                    *pni++= (unsigned char)
-                            ((real_t)(*A)*(one_minus_x_diff*one_minus_y_diff) +
-                             (real_t)(*B)*(x_diff*one_minus_y_diff) +
-                             (real_t)(*C)*(y_diff*one_minus_x_diff) +
-                             (real_t)(*D)*(y_diff*x_diff));
-                    ++A;++B;++C;++D;
+        else if (filter==ImGuiIE::RF_GOOD)
+        {
+            // http://tech-algorithm.com/articles/bilinear-image-scaling/
+            int x=0,y=0,index=0;
+            const unsigned char *A=NULL;
+            const unsigned char *B=NULL;
+            const unsigned char *C=NULL;
+            const unsigned char *D=NULL;
+            const real_t x_ratio = ((real_t)(w-1))/dstW;
+            const real_t y_ratio = ((real_t)(h-1))/dstH;
+            real_t x_diff=0, y_diff=0, one_minus_x_diff=0, one_minus_y_diff=0;
+            for (int i=y0;i<y1;i++) {
+                for (int j=0;j<dstW;j++) {
+                    x = (int)(x_ratio * j) ;
+                    y = (int)(y_ratio * i) ;
+                    x_diff = (x_ratio * j) - x ;
+                    y_diff = (y_ratio * i) - y ;
+                    one_minus_x_diff = 1.f - x_diff;
+                    one_minus_y_diff = 1.f - y_diff;
+                    index = (y*w+x)*c;
+                    A = &im[index] ;
+                    B = &im[index+c] ;
+                    C = &im[index+w*c] ;
+                    D = &im[index+(w+1)*c] ;
+
+
+                    for (int ch=0;ch<c;ch++) {
+                        // TODO: Alpha now s like all other channels...
+                        *pni++= (unsigned char)
+                                ((real_t)(*A)*(one_minus_x_diff*one_minus_y_diff) +
+                                 (real_t)(*B)*(x_diff*one_minus_y_diff) +
+                                 (real_t)(*C)*(y_diff*one_minus_x_diff) +
+                                 (real_t)(*D)*(y_diff*x_diff));
+                        ++A;++B;++C;++D;
+                    }
                 }
             }
-        }
 
+        }
+#       ifdef STBIR_INCLUDE_STB_IMAGE_RESIZE_H
+        else if (filter==ImGuiIE::RF_BEST)   {
+            const stbir_colorspace color_space =  stbirData.color_space!=1 ? STBIR_COLORSPACE_LINEAR : STBIR_COLORSPACE_SRGB;
+            const stbir_edge edge_wrap_mode = (stbir_edge) (stbirData.edge_mode+1);
+            const stbir_filter filter = (stbir_filter) stbirData.filter;
+            const int alpha_channel = -1;   // what's this for ?
+                                      //c==1 ? 0 : c==4 ? 3 : -1;
+            const int flags = 0;
+
+            // The band is the output region that starts at row y0 (same scale as the whole image)
+            const int rv = stbir_resize_subpixel(im,w,h,0,pni,dstW,y1-y0,0,
+                                                 STBIR_TYPE_UINT8,c,alpha_channel,flags,
+                                                 edge_wrap_mode,edge_wrap_mode,filter,filter,color_space,NULL,
+                                                 (float)dstW/(float)w,(float)dstH/(float)h,0.f,(float)y0);
+            if (rv==0) failed = 1;
+        }
+#       endif //STBIR_INCLUDE_STB_IMAGE_RESIZE_H
     }
-#   ifdef STBIR_INCLUDE_STB_IMAGE_RESIZE_H
-    else if (filter==ImGuiIE::RF_BEST)   {
-        stbir_colorspace color_space = STBIR_COLORSPACE_LINEAR; // STBIR_COLORSPACE_SRGB
-        stbir_edge edge_wrap_mode = STBIR_EDGE_CLAMP;
-        stbir_filter filter = STBIR_FILTER_DEFAULT;
-        const int alpha_channel = -1;   // what's this for ?
-                                  //c==1 ? 0 : c==4 ? 3 : -1;
-        const int flags = 0;
-        if (p_stbir_data_struct) {
-            const stbir_data_struct& ds = *((const stbir_data_struct*) p_stbir_data_struct);
-            color_space =  ds.color_space!=1 ? STBIR_COLORSPACE_LINEAR : STBIR_COLORSPACE_SRGB;
-            edge_wrap_mode = (stbir_edge) (ds.edge_mode+1);
-            filter = (stbir_filter) ds.filter;
-        }
-
-        const int rv = stbir_resize_uint8_generic(im,w,h,0,nim,dstW,dstH,0,
-                                                  c,alpha_channel,flags,
-                                                  edge_wrap_mode,filter, color_space,
-                                                  NULL);
-
-        if (rv==0) {
+
+    static void RunBands(int startBand,int endBand,void* userPtr) {
+        ResizeImageJob& j = *((ResizeImageJob*) userPtr);
+        for (int band=startBand;band<endBand;band++) {
+#           ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+            if (ImGuiHelper::AtomicLoad(&j.cancelRequested)) return;
+#           endif //IMGUIIMAGEEDITOR_HAS_THREADS
+            const int y0 = band*j.bandHeight;
+            const int y1 = y0+j.bandHeight < j.dstH ? y0+j.bandHeight : j.dstH;
+            j.resizeBand(y0,y1);
+#           ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+            ImGuiHelper::AtomicAdd(&j.numBandsDone,1);
+#           else //IMGUIIMAGEEDITOR_HAS_THREADS
+            ++j.numBandsDone;
+#           endif //IMGUIIMAGEEDITOR_HAS_THREADS
+        }
+    }
+
+    // returns nim (that must be freed by the caller), or NULL if cancelled
+    unsigned char* run() {
+#       ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+        ImGuiHelper::ThreadPool::GetDefault().parallelFor(0,numBands,&RunBands,this,1);
+        if (ImGuiHelper::AtomicLoad(&cancelRequested)) {STBI_FREE(nim);nim=NULL;return NULL;}
+#       else //IMGUIIMAGEEDITOR_HAS_THREADS
+        RunBands(0,numBands,this);
+#       endif //IMGUIIMAGEEDITOR_HAS_THREADS
+        if (failed) {
             //fprintf(stderr,"stbir__resize_arbitrary FAILED\n");
-            STBI_FREE(nim);nim=NULL;
             // fallback:
-            return ResizeImage(dstW,dstH,im,w,h,c,ImGuiIE::RF_GOOD);
-        }
+            filter = ImGuiIE::RF_GOOD;
+            failed = 0;numBandsDone = 0;
+#           ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+            ImGuiHelper::ThreadPool::GetDefault().parallelFor(0,numBands,&RunBands,this,1);
+            if (ImGuiHelper::AtomicLoad(&cancelRequested)) {STBI_FREE(nim);nim=NULL;return NULL;}
+#           else //IMGUIIMAGEEDITOR_HAS_THREADS
+            RunBands(0,numBands,this);
+#           endif //IMGUIIMAGEEDITOR_HAS_THREADS
+        }
+        unsigned char* rv = nim;nim = NULL;
+        return rv;
     }
-#   endif //STBIR_INCLUDE_STB_IMAGE_RESIZE_H
-    else {STBI_FREE(nim);nim=NULL;IM_ASSERT(true);}
+};
 
-    return nim;
+// return image must be freed by the caller
+static unsigned char* ResizeImage(int dstW,int dstH,const unsigned char* im,int w, int h,int c,ImGuiIE::ResizeFilter filter,void* p_stbir_data_struct=NULL) {
+    ResizeImageJob job;
+    if (!job.init(dstW,dstH,im,w,h,c,filter,p_stbir_data_struct)) return NULL;
+    return job.run();
 }
 
+#ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+// Resizes a copy of an image in a worker thread. Poll isFinished() and then call getResult().
+struct ResizeImageAsyncJob {
+    ResizeImageJob job;
+    unsigned char* srcCopy;
+    unsigned char* result;
+    ImGuiHelper::ThreadHandle thread;
+    volatile int finished;
+
+    static void ThreadFunction(void* userPtr) {
+        ResizeImageAsyncJob& j = *((ResizeImageAsyncJob*) userPtr);
+        j.result = j.job.run();
+        ImGuiHelper::AtomicStore(&j.finished,1);
+    }
+
+    static ResizeImageAsyncJob* Create(int dstW,int dstH,const unsigned char* im,int w, int h,int c,ImGuiIE::ResizeFilter filter,const void* p_stbir_data_struct=NULL) {
+        if (!im || w<=0 || h<=0 || c<=0) return NULL;
+        unsigned char* srcCopy = (unsigned char*) STBI_MALLOC(w*h*c);
+        if (!srcCopy) return NULL;
+        memcpy(srcCopy,im,w*h*c);
+        ResizeImageAsyncJob* j = (ResizeImageAsyncJob*) ImGui::MemAlloc(sizeof(ResizeImageAsyncJob));
+        IM_PLACEMENT_NEW (j) ResizeImageAsyncJob();
+        j->srcCopy = srcCopy;j->result = NULL;j->finished = 0;j->thread = 0;
+        if (j->job.init(dstW,dstH,srcCopy,w,h,c,filter,p_stbir_data_struct)) j->thread = ImGuiHelper::ThreadCreate(&ThreadFunction,j);
+        if (!j->thread) Destroy(j);
+        return j;
+    }
+    // Cancels the job if it's still running
+    static void Destroy(ResizeImageAsyncJob*& j) {
+        if (!j) return;
+        if (j->thread) {
+            ImGuiHelper::AtomicStore(&j->job.cancelRequested,1);
+            ImGuiHelper::ThreadJoin(j->thread);
+            j->thread = 0;
+        }
+        if (j->job.nim) {STBI_FREE(j->job.nim);j->job.nim = NULL;}
+        if (j->result) {STBI_FREE(j->result);j->result = NULL;}
+        if (j->srcCopy) {STBI_FREE(j->srcCopy);j->srcCopy = NULL;}
+        j->~ResizeImageAsyncJob();
+        ImGui::MemFree(j);
+        j = NULL;
+    }
+    bool isFinished() {return ImGuiHelper::AtomicLoad(&finished)!=0;}
+    float getProgress() {return job.numBands>0 ? (float)ImGuiHelper::AtomicLoad(&job.numBandsDone)/(float)job.numBands : 0.f;}
+    // the returned image (or NULL if it failed) must be freed by the caller
+    unsigned char* getResult(int& dstW,int& dstH) {
+        IM_ASSERT(isFinished());
+        unsigned char* rv = result;result = NULL;
+        dstW = job.dstW;dstH = job.dstH;
+        return rv;
+    }
+};
+#endif //IMGUIIMAGEEDITOR_HAS_THREADS
+
 // in place operation
 template <typename T> static void FlipX(T* data,int w,int h, int numChannels) {
     T temp;
@@ -1857,162 +1977,154 @@ KernelMatrix::real KernelMatrix::MaxPixelValue = 255.0;
 KernelMatrix::real KernelMatrix::ScaleFactor = 1.0;
 KernelMatrix::real KernelMatrix::Offset = 0.0;
 
-// return image must be freed by the caller; kw and kh oddnumbers
-template <typename T> static T* ApplyConvolutionKernelNxN(const T* im,int w,int h,int c,const real* normalizedKernel,int kw,int kh,bool wrapx=false,bool wrapy=false,const real scaleFactor=1.0,const real offset=0.0,const real maxPixelValue=255.0)
-{
-    if (!im || w<=kw || h<=kh || (c!=1 && c!=3 && c!=4) || kw<3 || kh<3 || kw%2==0 || kh%2==0 || w<3 || h<3) return NULL;
-
-    KernelMatrix::MaxPixelValue = maxPixelValue;
-    KernelMatrix::ScaleFactor = scaleFactor;
-    KernelMatrix::Offset = offset;
-
-    const T* pim =im;
-    T* nim = (T*) STBI_MALLOC(w*h*c);
-    T* pnim = nim;
-    const real* k = normalizedKernel;
-
-    //const int stride = w*c;
-    const int skw=(kw-1)/2;
-    const int skh=(kh-1)/2;
-
-    const real maxPixelValueInv = 1.0/maxPixelValue;
-    //const real tot=(real)ImGuiIE::ipow(2.0,(N-1)*2);
-    //const real half_tot = tot/2.0;
-
+// Convolution: every source row is converted once into a float row padded by the kernel radius (with clamped or wrapped borders),
+// so that the inner loops are branch-free multiply-adds over contiguous floats. Separable kernels (e.g. Gaussian) use two 1D passes.
+// Output rows are processed in bands, in parallel when imguihelper threads are available.
+static inline void ConvolutionMultiplyAdd(float* acc,const float* src,float k,int n) {
+    int j=0;
+#   ifdef IMGUIIMAGEEDITOR_ENABLE_SSE
+    const __m128 kk = _mm_set1_ps(k);
+    for (;j+8<=n;j+=8) {
+        _mm_storeu_ps(&acc[j],_mm_add_ps(_mm_loadu_ps(&acc[j]),_mm_mul_ps(kk,_mm_loadu_ps(&src[j]))));
+        _mm_storeu_ps(&acc[j+4],_mm_add_ps(_mm_loadu_ps(&acc[j+4]),_mm_mul_ps(kk,_mm_loadu_ps(&src[j+4]))));
+    }
+#   endif //IMGUIIMAGEEDITOR_ENABLE_SSE
+    for (;j<n;j++) acc[j]+=k*src[j];
+}
 
-    //const KernelMatrix k(normalizedKernel,kw,kh,1);
-    ImVector<real> tmp_matrix;tmp_matrix.resize(kw*kh*c);for (int i=0,isz=kw*kh*c;i<isz;i++) tmp_matrix[i]=0.0;
-    KernelMatrix m(&tmp_matrix[0],kw,kh,c);
-    //ImVector<real> tmp_row;tmp_row.resize(kw*c);for (int i=0,isz=kw*c;i<isz;i++) tmp_row[i]=0.0;
-    //ImVector<real> tmp_col;tmp_col.resize(kh*c);for (int i=0,isz=kh*c;i<isz;i++) tmp_col[i]=0.0;
+// kernel (kw*kh values) can be written as colKernel[y]*rowKernel[x]
+static bool GetSeparableConvolutionKernel(const real* kernel,int kw,int kh,real* rowKernel,real* colKernel) {
+    int pivot = 0;
+    for (int i=1,iSz=kw*kh;i<iSz;i++) {if (fabs(kernel[i])>fabs(kernel[pivot])) pivot=i;}
+    const real pivotValue = kernel[pivot];
+    if (pivotValue==0) return false;
+    const int px = pivot%kw, py = pivot/kw;
+    for (int x=0;x<kw;x++) rowKernel[x] = kernel[py*kw+x];
+    for (int y=0;y<kh;y++) colKernel[y] = kernel[y*kw+px]/pivotValue;
+    const real tolerance = fabs(pivotValue)*1e-6;
+    for (int y=0;y<kh;y++) {
+        for (int x=0;x<kw;x++) {
+            if (fabs(kernel[y*kw+x]-colKernel[y]*rowKernel[x])>tolerance) return false;
+        }
+    }
+    return true;
+}
 
-    // Step 1) Fill m for (0,0)
-    int x=0,y=0;real* pm=NULL;
-    int xCol=0,yRow=0;
-    for(yRow=0;yRow<h;++yRow)    {
-        if (yRow%2==0)   {
-            xCol = 0;
-            if (yRow==0) {
-                // Fill the whole matrix m:
-                for(int sy=-skh;sy<=skh;++sy)    {
-                    y=sy;
-                    if (y<0)        y = wrapy ? (h+y) : 0;
-                    else if (y>=h)  y = wrapy ? (y-h) : (h-1);
-                    for(int sx=-skw;sx<=skw;++sx)   {
-                        x=sx;
-                        if (x<0)        x = wrapx ? (w+x) : 0;
-                        else if (x>=w)  x = wrapx ? (x-w) : (w-1);
-                        pm = m.get(sx+skw,sy+skh);
-                        pim = &im[(w*y+x)*c];
-                        for (int i=0;i<c;i++) *pm++ = (real)(*pim++) * maxPixelValueInv;
+template <typename T> struct ConvolutionJob {
+    const T* im;T* nim;
+    int w,h,c,kw,kh,bandHeight;
+    bool wrapx,wrapy;
+    const float* kernel;        // kw*kh (when not separable)
+    const float* rowKernel;     // kw (when separable)
+    const float* colKernel;     // kh (when separable)
+    float maxPixelValue;
+
+    void fillPaddedRow(int y,float* row) const {
+        if (y<0)        y = wrapy ? (h+y) : 0;
+        else if (y>=h)  y = wrapy ? (y-h) : (h-1);
+        const int skw = kw/2;
+        const T* src = &im[y*w*c];
+        float* pRow = &row[skw*c];
+        for (int i=0,iSz=w*c;i<iSz;i++) pRow[i] = (float) src[i];
+        for (int sx=1;sx<=skw;sx++) {
+            const int xl = wrapx ? (w-sx) : 0;
+            const int xr = wrapx ? (sx-1) : (w-1);
+            for (int i=0;i<c;i++) {
+                row[(skw-sx)*c+i] = (float) src[xl*c+i];
+                row[(skw+w-1+sx)*c+i] = (float) src[xr*c+i];
+            }
+        }
+    }
+
+    static void Run(int startBand,int endBand,void* userPtr) {
+        const ConvolutionJob& j = *((const ConvolutionJob*) userPtr);
+        const int c = j.c, kw = j.kw, kh = j.kh, skh = kh/2;
+        const int rowLen = j.w*c, paddedLen = (j.w+kw-1)*c;
+        const bool separable = (j.rowKernel!=NULL);
+        const int srcRowLen = separable ? rowLen : paddedLen;
+        ImVector<float> rows,padded,acc;
+        rows.resize((j.bandHeight+kh-1)*srcRowLen);
+        if (separable) padded.resize(paddedLen);
+        acc.resize(rowLen);
+        for (int band=startBand;band<endBand;band++) {
+            const int y0 = band*j.bandHeight;
+            const int y1 = (y0+j.bandHeight<j.h) ? (y0+j.bandHeight) : j.h;
+            // Source rows [y0-skh,y1+skh), padded (or already filtered horizontally when separable)
+            for (int r=0,rSz=y1-y0+kh-1;r<rSz;r++) {
+                float* row = &rows[r*srcRowLen];
+                if (!separable) j.fillPaddedRow(y0-skh+r,row);
+                else {
+                    j.fillPaddedRow(y0-skh+r,&padded[0]);
+                    memset(row,0,rowLen*sizeof(float));
+                    for (int kx=0;kx<kw;kx++) {
+                        if (j.rowKernel[kx]!=0.f) ConvolutionMultiplyAdd(row,&padded[kx*c],j.rowKernel[kx],rowLen);
                     }
                 }
             }
-            else {
-                // Shift up and fill bottom kernel row
-                pm = m.shiftUp();
-                y=yRow+skh;
-                if (y<0)        y = wrapy ? (h+y) : 0;
-                else if (y>=h)  y = wrapy ? (y-h) : (h-1);
-                for(int sx=-skw;sx<=skw;++sx)   {
-                    x=sx;
-                    if (x<0)        x = wrapx ? (w+x) : 0;
-                    else if (x>=w)  x = wrapx ? (x-w) : (w-1);
-                    //pm = m.get(sx+skw,sy+skh);
-                    pim = &im[(w*y+x)*c];
-                    for (int i=0;i<c;i++) *pm++ = (real)(*pim++) * maxPixelValueInv;
+            for (int y=y0;y<y1;y++) {
+                float* pAcc = &acc[0];
+                memset(pAcc,0,rowLen*sizeof(float));
+                const float* pRows = &rows[(y-y0)*srcRowLen];
+                for (int ky=0;ky<kh;ky++) {
+                    if (separable) {
+                        if (j.colKernel[ky]!=0.f) ConvolutionMultiplyAdd(pAcc,&pRows[ky*srcRowLen],j.colKernel[ky],rowLen);
+                    }
+                    else {
+                        for (int kx=0;kx<kw;kx++) {
+                            const float k = j.kernel[ky*kw+kx];
+                            if (k!=0.f) ConvolutionMultiplyAdd(pAcc,&pRows[ky*srcRowLen+kx*c],k,rowLen);
+                        }
+                    }
                 }
-            }
-            pnim = &nim[(yRow*w+xCol)*c];
-            m.getSum(pnim,k);pnim+=c;       // fill pixel and shift right
-            for (xCol=1;xCol<w;++xCol)   {
-                // Shift left and fill right kernel column
-                pm = m.shiftLeft();
-                x=xCol+skw;  // right col
-                if (x<0)        x = wrapx ? (w+x) : 0;
-                else if (x>=w)  x = wrapx ? (x-w) : (w-1);
-                for(int sy=-skh;sy<=skh;++sy)   {
-                    y=yRow+sy;
-                    if (y<0)        y = wrapy ? (h+y) : 0;
-                    else if (y>=h)  y = wrapy ? (y-h) : (h-1);
-                    //pm = m.get(sx+skw,sy+skh);
-                    pim = &im[(w*y+x)*c];
-                    for (int i=0;i<c;i++) *pm++ = (real)(*pim++) * maxPixelValueInv;
-                    pm+=kw*c-c;    // go down one line
+                T* pnim = &j.nim[y*rowLen];
+                for (int i=0;i<rowLen;i++) {
+                    float d = pAcc[i];
+                    if (d<0.f) d=0.f;else if (d>j.maxPixelValue) d=j.maxPixelValue;
+                    pnim[i] = (T)d;
                 }
-                m.getSum(pnim,k);pnim+=c;       // fill pixel and shift right
+            }
+        }
+    }
+};
 
-                /*// Debug-------------------------------
-                if (xCol==w-1 && yRow==0) {
-                    fprintf(stderr,"[%d,%d]:\n",xCol,yRow);m.debug();
-                    pnim-=c;
-                    fprintf(stderr,"Sum [%d,%d] = (",xCol,yRow);
-                    for (int i=0;i<c;i++) {fprintf(stderr,"%d ",(int) *pnim++);}
-                    fprintf(stderr,")\n");
-                }
-                //-------------------------------------*/
+// return image must be freed by the caller; kw and kh oddnumbers
+template <typename T> static T* ApplyConvolutionKernelNxN(const T* im,int w,int h,int c,const real* normalizedKernel,int kw,int kh,bool wrapx=false,bool wrapy=false,const real scaleFactor=1.0,const real offset=0.0,const real maxPixelValue=255.0)
+{
+    if (!im || w<=kw || h<=kh || (c!=1 && c!=3 && c!=4) || kw<3 || kh<3 || kw%2==0 || kh%2==0 || w<3 || h<3) return NULL;
 
-            }
+    T* nim = (T*) STBI_MALLOC(w*h*c*sizeof(T));
+    if (!nim) return NULL;
 
-        }
-        else {// yRow odd number
-            xCol = w-1;
-            {
-                // Shift up and fill bottom kernel row
-                pm = m.shiftUp();
-                y=yRow+skh;
-                if (y<0)        y = wrapy ? (h+y) : 0;
-                else if (y>=h)  y = wrapy ? (y-h) : (h-1);
-                for(int sx=-skw;sx<=skw;++sx)   {
-                    x=xCol+sx;
-                    if (x<0)        x = wrapx ? (w+x) : 0;
-                    else if (x>=w)  x = wrapx ? (x-w) : (w-1);
-                    //pm = m.get(sx+skw,sy+skh);
-                    pim = &im[(w*y+x)*c];
-                    for (int i=0;i<c;i++) *pm++ = (real)(*pim++) * maxPixelValueInv;
-                }
-            }
-            pnim = &nim[(yRow*w+xCol)*c];
-            m.getSum(pnim,k);pnim-=c;       // fill pixel and shift left
-            /*// Debug-------------------------------
-            if (xCol==w-1 && yRow==1) {
-                fprintf(stderr,"[%d,%d]:\n",xCol,yRow);m.debug();
-                fprintf(stderr,"Sum [%d,%d] = (",xCol,yRow);
-                pnim+=c;
-                for (int i=0;i<c;i++) {fprintf(stderr,"%d ",(int) *pnim++);}
-                pnim-=2*c;
-                fprintf(stderr,")\n");
-            }
-            //-------------------------------------*/
-            for (xCol=w-2;xCol>=0;--xCol)   {
-                // Shift right and fill left kernel column
-                pm = m.shiftRight();
-                x=xCol-skw;  // left col
-                if (x<0)        x = wrapx ? (w+x) : 0;
-                else if (x>=w)  x = wrapx ? (x-w) : (w-1);
-                for(int sy=-skh;sy<=skh;++sy)   {
-                    y=yRow+sy;
-                    if (y<0)        y = wrapy ? (h+y) : 0;
-                    else if (y>=h)  y = wrapy ? (y-h) : (h-1);
-                    //pm = m.get(sx+skw,sy+skh);
-                    pim = &im[(w*y+x)*c];
-                    for (int i=0;i<c;i++) *pm++ = (real)(*pim++) * maxPixelValueInv;
-                    pm+=kw*c-c;    // go down one line
-                }
-                m.getSum(pnim,k);pnim-=c;   // fill pixel and shift left
-                /*// Debug-------------------------------
-                if (xCol==w/2 && yRow==3) {
-                    fprintf(stderr,"[%d,%d]:\n",xCol,yRow);m.debug();
-                    fprintf(stderr,"Sum [%d,%d] = (",xCol,yRow);
-                    pnim+=c;
-                    for (int i=0;i<c;i++) {fprintf(stderr,"%d ",(int) *pnim++);}
-                    pnim-=2*c;
-                    fprintf(stderr,")\n");
-                }
-                //-------------------------------------*/
-            }
-        }
+    // Every output value is: clamp(sum(kernel*pixels)*(scaleFactor+offset),0,maxPixelValue)
+    const real factor = scaleFactor+offset;
+    ImVector<real> rowKernel,colKernel;rowKernel.resize(kw);colKernel.resize(kh);
+    const bool separable = GetSeparableConvolutionKernel(normalizedKernel,kw,kh,&rowKernel[0],&colKernel[0]);
+    ImVector<float> kernel,rowKernelF,colKernelF;
+    if (separable) {
+        rowKernelF.resize(kw);colKernelF.resize(kh);
+        for (int i=0;i<kw;i++) rowKernelF[i] = (float) (rowKernel[i]*factor);
+        for (int i=0;i<kh;i++) colKernelF[i] = (float) colKernel[i];
     }
+    else {
+        kernel.resize(kw*kh);
+        for (int i=0,iSz=kw*kh;i<iSz;i++) kernel[i] = (float) (normalizedKernel[i]*factor);
+    }
+
+    ConvolutionJob<T> job;
+    job.im = im;job.nim = nim;
+    job.w = w;job.h = h;job.c = c;job.kw = kw;job.kh = kh;
+    job.bandHeight = kh*2 > 32 ? kh*2 : 32;
+    job.wrapx = wrapx;job.wrapy = wrapy;
+    job.kernel = separable ? NULL : &kernel[0];
+    job.rowKernel = separable ? &rowKernelF[0] : NULL;
+    job.colKernel = separable ? &colKernelF[0] : NULL;
+    job.maxPixelValue = (float) maxPixelValue;
+    const int numBands = (h+job.bandHeight-1)/job.bandHeight;
+#   ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+    ImGuiHelper::ThreadPool::GetDefault().parallelFor(0,numBands,&ConvolutionJob<T>::Run,&job,1);
+#   else //IMGUIIMAGEEDITOR_HAS_THREADS
+    ConvolutionJob<T>::Run(0,numBands,&job);
+#   endif //IMGUIIMAGEEDITOR_HAS_THREADS
 
     return nim;
 }
@@ -3489,7 +3601,7 @@ int FillHelperClass::overlayAlpha=0;
 int FillHelperClass::twoFiveFiveMinusoverlayAlpha=0;
 
 // This class is used for "CopiedImage" (the static image that can be cut/copied/paste.
-// However it has later be enhanced to be the base for "UndoStack" (some methods has been added only for this purpose)
+// (It has been the base for "UndoStack" too, before UndoStack started storing image tiles)
 class StbImageBuffer {
 public:
     int w,h,c;  // relative to the stored image (can be calculated from imageSelection)
@@ -3671,158 +3783,272 @@ public:
 
 //#define IMGUIIMAGEEDITOR_DEBUG_UNDO_STACK
 
+// Cold undo tiles can be zlib compressed with the stb_image_write encoder and the stb_image decoder
+#if (!defined(IMGUIIMAGEEDITOR_UNDO_NO_COMPRESSION) && defined(INCLUDE_STB_IMAGE_WRITE_H) && defined(STB_IMAGE_WRITE_IMPLEMENTATION) && !defined(STBI_NO_ZLIB))
+#   define IMGUIIMAGEEDITOR_UNDO_CAN_COMPRESS
+#endif
 
-// We could have used just something like: StbImageBuffer buffers[stack_max], since we don't resize them at runtime...
-class UndoStack : protected ImVector<StbImageBuffer*> {
+// Every stored image is a grid of reference counted tiles, shared with the previous image when unchanged:
+// so an operation only stores the tiles it modifies (when push(...) gets a selection, only the tiles
+// inside it are compared at the next push). Memory is bounded by a byte budget: when it's exceeded,
+// the tiles that the current image doesn't use are compressed first, and then the oldest entries are discarded.
+class UndoStack {
     protected:
-    typedef ImVector<StbImageBuffer*> Base;
-    typedef StbImageBuffer ItemType;
-
-    static void DeleteItem(ItemType*& it) {
-        if (it) {
-            it->~StbImageBuffer();  // it should call it->destroy
-            ImGui::MemFree(it);
-            it = NULL;
-        }
-    }
-    static void ClearItem(ItemType*& it) {if (it) it->destroy();}
-
-    const int stack_max;    //Number Of Available Undo/Redo (higher=more memory used)
-    int stack_cur;          //=0;
-    bool stack_max_reached;
 
-    public:
+    enum {TileSize = 128};
 
-    ~UndoStack() {clear(true);}
-    UndoStack(int stackMax=-1) : Base(),stack_max(stackMax>0 ? stackMax : 25),stack_cur(0),stack_max_reached(false)  {
-        this->resize(stack_max);   // We resize it soon, and we never resize it again
-    }
+    struct Tile {
+        int refCount;
+        int size;               // uncompressed size in bytes
+        int compressedSize;     // if > 0, pixels are zlib compressed
+        bool incompressible;
+        bool hot;               // used by the current image (temporary flag)
+        unsigned char* pixels;
+    };
+    struct Snapshot {
+        int w,h,c,numTilesX,numTilesY;
+        ImVector<Tile*> tiles;  // numTilesX*numTilesY
+        Snapshot(int _w,int _h,int _c) : w(_w),h(_h),c(_c) {
+            numTilesX = (w+TileSize-1)/TileSize;
+            numTilesY = (h+TileSize-1)/TileSize;
+            tiles.resize(numTilesX*numTilesY);
+        }
+        inline void getTileRect(int tx,int ty,int& x0,int& y0,int& tw,int& th) const {
+            x0 = tx*TileSize; y0 = ty*TileSize;
+            tw = w-x0 < TileSize ? w-x0 : TileSize;
+            th = h-y0 < TileSize ? h-y0 : TileSize;
+        }
+        inline bool sameFormatAs(int W,int H,int C) const {return w==W && h==H && c==C;}
+    };
 
-    inline void clear(bool destroyEverything=false) {
-        if (Data) {
-            if (destroyEverything) {
-                for (int i=0;i<Size;i++) {DeleteItem(Data[i]);}
-                ImGui::MemFree(Data);Data = NULL;
-                Size = Capacity = 0;
+    ImVector<Snapshot*> snapshots;
+    int stack_cur;          // index of the snapshot of the current image (== snapshots.Size when it's not stored yet)
+    int base;               // index of the snapshot the current image equals outside "dirty" (-1 if none)
+    ImRect dirty;           // the area the current operation can modify (Min==Max: none)
+    bool dirtyAll;
+    bool stack_max_reached; // true when some old entries have been discarded
+    size_t maxBytes;
+    int maxEntries;         // <=0: no limit
+    size_t usedBytes;
+    ImVector<unsigned char> scratch;    // decompressed tile
+
+    Tile* createTile(const unsigned char* im,int w,int c,int x0,int y0,int tw,int th) {
+        Tile* t = (Tile*) ImGui::MemAlloc(sizeof(Tile));
+        t->refCount = 1;
+        t->size = tw*th*c;
+        t->compressedSize = 0;
+        t->incompressible = t->hot = false;
+        t->pixels = (unsigned char*) STBI_MALLOC(t->size);
+        const int rowSize = tw*c;
+        for (int y=0;y<th;y++) memcpy(&t->pixels[y*rowSize],&im[((y0+y)*w+x0)*c],rowSize);
+        usedBytes+=t->size;
+        return t;
+    }
+    void releaseTile(Tile* t) {
+        if (--t->refCount>0) return;
+        if (t->compressedSize>0) {
+            usedBytes-=t->compressedSize;
+#           ifdef IMGUIIMAGEEDITOR_UNDO_CAN_COMPRESS
+            STBIW_FREE(t->pixels);
+#           endif //IMGUIIMAGEEDITOR_UNDO_CAN_COMPRESS
+        }
+        else {usedBytes-=t->size;STBI_FREE(t->pixels);}
+        ImGui::MemFree(t);
+    }
+    const unsigned char* getTilePixels(const Tile* t) {
+        if (t->compressedSize==0) return t->pixels;
+        scratch.resize(t->size);
+#       ifdef IMGUIIMAGEEDITOR_UNDO_CAN_COMPRESS
+        if (stbi_zlib_decode_buffer((char*)&scratch[0],t->size,(const char*)t->pixels,t->compressedSize)==t->size) return &scratch[0];
+#       endif //IMGUIIMAGEEDITOR_UNDO_CAN_COMPRESS
+        IM_ASSERT(0);   // corrupted tile
+        memset(&scratch[0],0,t->size);
+        return &scratch[0];
+    }
+#   ifdef IMGUIIMAGEEDITOR_UNDO_CAN_COMPRESS
+    void compressTile(Tile* t) {
+        int compressedSize = 0;
+        unsigned char* compressed = stbi_zlib_compress(t->pixels,t->size,&compressedSize,1);
+        if (!compressed || compressedSize<=0 || compressedSize>t->size-t->size/8) {
+            if (compressed) STBIW_FREE(compressed);
+            t->incompressible = true;   // not worth it
+            return;
+        }
+        STBI_FREE(t->pixels);
+        t->pixels = compressed;
+        t->compressedSize = compressedSize;
+        usedBytes-=t->size-compressedSize;
+    }
+#   endif //IMGUIIMAGEEDITOR_UNDO_CAN_COMPRESS
+
+    void destroySnapshot(Snapshot*& s) {
+        if (!s) return;
+        for (int i=0;i<s->tiles.Size;i++) releaseTile(s->tiles[i]);
+        s->~Snapshot();
+        ImGui::MemFree(s);
+        s = NULL;
+    }
+
+    inline bool isDirty(int x0,int y0,int tw,int th) const {
+        return dirtyAll || (dirty.Min.x<dirty.Max.x && dirty.Min.y<dirty.Max.y &&
+                            (float)x0<dirty.Max.x && (float)(x0+tw)>dirty.Min.x && (float)y0<dirty.Max.y && (float)(y0+th)>dirty.Min.y);
+    }
+    inline void setDirty(const ImRect* sel) {
+        if (sel) {dirty = *sel;dirtyAll = false;}
+        else {dirty.Min = dirty.Max = ImVec2(0,0);dirtyAll = true;}
+    }
+    inline void clearDirty() {dirty.Min = dirty.Max = ImVec2(0,0);dirtyAll = false;}
+
+    // Stores im, sharing the tiles of snapshots[base] that are outside "dirty" or that have not changed
+    Snapshot* capture(const unsigned char* im,int w,int h,int c) {
+        Snapshot* s = (Snapshot*) ImGui::MemAlloc(sizeof(Snapshot));
+        IM_PLACEMENT_NEW (s) Snapshot(w,h,c);
+        const Snapshot* b = (base>=0 && base<snapshots.Size) ? snapshots[base] : NULL;
+        if (b && !b->sameFormatAs(w,h,c)) b = NULL;
+        int x0,y0,tw,th;
+        for (int ty=0;ty<s->numTilesY;ty++) {
+            for (int tx=0;tx<s->numTilesX;tx++) {
+                const int i = ty*s->numTilesX+tx;
+                s->getTileRect(tx,ty,x0,y0,tw,th);
+                Tile* t = NULL;
+                if (b) {
+                    Tile* bt = b->tiles[i];
+                    if (!isDirty(x0,y0,tw,th)) t = bt;
+                    else {
+                        const unsigned char* pxl = getTilePixels(bt);
+                        const int rowSize = tw*c;
+                        t = bt;
+                        for (int y=0;y<th;y++) {
+                            if (memcmp(&pxl[y*rowSize],&im[((y0+y)*w+x0)*c],rowSize)!=0) {t = NULL;break;}
+                        }
+                    }
+                    if (t) ++t->refCount;
+                }
+                if (!t) t = createTile(im,w,c,x0,y0,tw,th);
+                s->tiles[i] = t;
             }
-            else {for (int i=0;i<Size;i++) {ClearItem(Data[i]);}}            
         }
-        stack_cur=0;
-        stack_max_reached = false;
+        return s;
     }
-    inline int getStackCur() const {return stack_cur;}
-    inline bool getStackMaxReached() const {return stack_max_reached;}
 
-    void push(const unsigned char* im,int w,int h,int c,const ImRect* sel=NULL,bool clearNextEntries = false)    {
-        if (stack_cur<stack_max)    {
-            Data[stack_cur]->assign(im,w,h,c,sel);
-#           ifdef IMGUIIMAGEEDITOR_DEBUG_UNDO_STACK
-            fprintf(stderr,"%s at %d -> (%d,%d), (%d,%d) [w=%d h=%d c=%d]\n",
-                    clearNextEntries ? "Pushing" : "UNDO. Pushing",
-                    stack_cur,
-                    sel?(int)sel->Min.x:0,
-                    sel?(int)sel->Min.y:0,
-                    sel?(int)(sel->Max.x-sel->Min.x):w,
-                    sel?(int)(sel->Max.y-sel->Min.y):h,
-                    w,
-                    h,
-                    c
-                    );
-#           endif //IMGUIIMAGEEDITOR_DEBUG_UNDO_STACK
-            //if (stack[stack_cur]== null) Console.WriteLine ("\tStackPush(): Error: stack[stack_cur]==null with: stack_cur={0}, stack_max={1}", stack_cur, stack_max);
-            stack_cur++;
-
-            if (clearNextEntries) {
-                for (int i = stack_cur;i<stack_max;i++) {
-                    ItemType*& it = Data[i];
-                    if (!it->isValid()) break;
-                    ClearItem(it);
-                }
-            }
-            //Console.WriteLine ("\tStackPush(): stack_cur={0}, stack_max={1}", stack_cur, stack_max);
-            return;
-        }
-        //stack_cur == stack_max:
-        //if (stack_cur!=stack_max) Console.WriteLine ("\tStackPush(): Error: stack_cur!=stack_max with: stack_cur={0}, stack_max={1}", stack_cur, stack_max);
-        stack_max_reached = true;
-        ItemType* Data0 = Data[0];
-        if (Data0->isValid()) {
-            /*stack [0].Dispose ();*/Data0->destroy(); //Discard stack[0]
+    // Writes s into im. "cur" (optional) must be equal to the current content of im: only the tiles that differ are written.
+    bool restore(const Snapshot& s,const Snapshot* cur,unsigned char*& im,int& w,int& h,int& c) {
+        if (!im || !s.sameFormatAs(w,h,c)) {
+            unsigned char* nim = (unsigned char*) STBI_MALLOC(s.w*s.h*s.c);
+            if (!nim) return false;
+            if (im) STBI_FREE(im);
+            im = nim;w = s.w;h = s.h;c = s.c;
+            cur = NULL;
         }
-        for (int t=1;t<stack_max;t++)   {
-            Data[t-1]=Data[t];	// Shift stack
+        if (cur && !cur->sameFormatAs(w,h,c)) cur = NULL;
+        int x0,y0,tw,th;
+        for (int ty=0;ty<s.numTilesY;ty++) {
+            for (int tx=0;tx<s.numTilesX;tx++) {
+                const int i = ty*s.numTilesX+tx;
+                if (cur && cur->tiles[i]==s.tiles[i]) continue;
+                s.getTileRect(tx,ty,x0,y0,tw,th);
+                const unsigned char* pxl = getTilePixels(s.tiles[i]);
+                const int rowSize = tw*c;
+                for (int y=0;y<th;y++) memcpy(&im[((y0+y)*w+x0)*c],&pxl[y*rowSize],rowSize);
+            }
         }
-        Data[stack_max-1] = Data0;
-        Data[stack_cur-1]->assign(im,w,h,c,sel);	// push the last element (remember stack_cur == stack_max here)
-        //if (stack[stack_cur-1]== null) Console.WriteLine ("\tStackPush(): Error: stack[stack_cur-1]==null with: stack_cur={0}, stack_max={1}", stack_cur, stack_max);
-        //Console.WriteLine ("\tStackPush(): stack_cur={0}, stack_max={1}", stack_cur, stack_max);
+        return true;
     }
-    const ItemType* undo(const unsigned char* im,int w,int h,int c) //,const ImRect* sel=NULL)
-    {
-        //fprintf(stderr,"StackUndo(): stack_cur=%d, stack_max=%d\n", stack_cur, stack_max);
-        //IM_ASSERT(sel==NULL);   // if this works we can remove last arg
-        if (stack_cur<0) {//Console.WriteLine ("StackUndo(): Error: stack_cur<0, with stack_cur = "+stack_cur);
-            stack_cur=0;return NULL;}
-        if (stack_cur<1) return NULL;
-        if (!Data[stack_cur-1]->isValid() /*|| stack[stack_cur-1]==image*/) {
-            //fprintf(stderr,"StackUndo(): Error: stack [stack_cur - 1] == null, with stack_cur = %d\n",stack_cur);
-            return NULL;
-        }
-        const ImRect* sel = Data[stack_cur-1]->isSelectionValid() ? &Data[stack_cur-1]->imageSelection : NULL;
-        push(im,w,h,c,sel);
-        stack_cur--;
-        stack_cur--;
-        while (stack_cur>=stack_max) stack_cur--;
 
-        return Data[stack_cur];
+    void discardOldest() {
+        IM_ASSERT(snapshots.Size>0 && base>0 && stack_cur>0);
+        destroySnapshot(snapshots[0]);
+        snapshots.erase(snapshots.begin());
+        --base;--stack_cur;
+        stack_max_reached = true;
     }
-
-    const ItemType* redo(const unsigned char* im,int w,int h,int c)    {
-        //Console.WriteLine ("StackRedo(): stack_cur={0}, stack_max={1}", stack_cur, stack_max);
-        if (stack_cur+1<stack_max && !Data[stack_cur+1]->isValid()) {
-            //Console.WriteLine ("StackRedo(): Nothing to do: 'stack_cur+1<stack_max && stack[stack_cur+1]==null' with: stack_cur={0}, stack_max={1}", stack_cur, stack_max);
-            return NULL;
+    void enforceLimits() {
+        while (maxEntries>0 && snapshots.Size>maxEntries+1 && base>0 && stack_cur>0) discardOldest();
+        if (usedBytes<=maxBytes) return;
+#       ifdef IMGUIIMAGEEDITOR_UNDO_CAN_COMPRESS
+        if (base>=0 && base<snapshots.Size) {
+            // Compress the tiles that the current image does not use, starting from the oldest entries
+            ImVector<Tile*>& hotTiles = snapshots[base]->tiles;
+            for (int i=0;i<hotTiles.Size;i++) hotTiles[i]->hot = true;
+            for (int j=0;j<snapshots.Size && usedBytes>maxBytes;j++) {
+                if (j==base) continue;
+                ImVector<Tile*>& tiles = snapshots[j]->tiles;
+                for (int i=0;i<tiles.Size && usedBytes>maxBytes;i++) {
+                    Tile* t = tiles[i];
+                    if (!t->hot && t->compressedSize==0 && !t->incompressible) compressTile(t);
+                }
+            }
+            for (int i=0;i<hotTiles.Size;i++) hotTiles[i]->hot = false;
         }
-        stack_cur++;
-        if (stack_cur>=stack_max) {
-            //Console.WriteLine ("StackRedo(): Nothing to do: stack_cur>=stack_max with: stack_cur={0}, stack_max={1} => Setting: stack_cur=stack_max-1", stack_cur, stack_max);
-            stack_cur=stack_max-1;return NULL;
+#       endif //IMGUIIMAGEEDITOR_UNDO_CAN_COMPRESS
+        while (usedBytes>maxBytes && base>0 && stack_cur>0) discardOldest();
+        // Then the redo entries, starting from the newest
+        while (usedBytes>maxBytes && snapshots.Size>stack_cur+1 && snapshots.Size>base+1) {
+            destroySnapshot(snapshots.back());
+            snapshots.pop_back();
         }
+    }
 
-        IM_ASSERT(stack_cur>0);
-        const ImRect* sel = Data[stack_cur]->isSelectionValid() ? &Data[stack_cur]->imageSelection : NULL;
-        Data[stack_cur-1]->assign(im,w,h,c,sel);
+    public:
+
+    ~UndoStack() {clear();}
+    UndoStack(int maxMegaBytes=256,int _maxEntries=-1) : stack_cur(0),base(-1),dirtyAll(false),stack_max_reached(false),
+        maxBytes((size_t)(maxMegaBytes>0 ? maxMegaBytes : 1)*1024*1024),maxEntries(_maxEntries),usedBytes(0) {}
 
+    inline void clear() {
+        for (int i=0;i<snapshots.Size;i++) destroySnapshot(snapshots[i]);
+        snapshots.clear();
+        stack_cur=0;base=-1;
+        clearDirty();
+        stack_max_reached = false;
+        IM_ASSERT(usedBytes==0);
+    }
+    inline int getStackCur() const {return stack_cur;}
+    inline bool getStackMaxReached() const {return stack_max_reached;}
+    inline size_t getUsedBytes() const {return usedBytes;}
+
+    // To call before modifying im. sel (optional) must contain all the pixels the operation is going to modify.
+    void push(const unsigned char* im,int w,int h,int c,const ImRect* sel=NULL)    {
+        if (!im) return;
+        Snapshot* s = capture(im,w,h,c);
+        while (snapshots.Size>stack_cur) {destroySnapshot(snapshots.back());snapshots.pop_back();}  // clear redo entries
+        snapshots.push_back(s);
+        base = stack_cur++;
+        setDirty(sel);
+        enforceLimits();
 #       ifdef IMGUIIMAGEEDITOR_DEBUG_UNDO_STACK
-        fprintf(stderr,"REDO. Assigning At %d -> (%d,%d), (%d,%d)  [w=%d h=%d c=%d]\n",
+        fprintf(stderr,"Pushing at %d -> (%d,%d), (%d,%d) [w=%d h=%d c=%d] (%d entries, %u bytes)\n",
                 stack_cur-1,
                 sel?(int)sel->Min.x:0,
                 sel?(int)sel->Min.y:0,
                 sel?(int)(sel->Max.x-sel->Min.x):w,
                 sel?(int)(sel->Max.y-sel->Min.y):h,
-                w,
-                h,
-                c
-                );
+                w,h,c,snapshots.Size,(unsigned)usedBytes);
 #       endif //IMGUIIMAGEEDITOR_DEBUG_UNDO_STACK
-        return Data[stack_cur];
     }
-
-    protected:
-
-    inline void resize(int new_size)            {
-        if (new_size > Capacity) reserve(_grow_capacity(new_size));
-        if (new_size < Size) {for (int i=new_size;i<Size;i++) DeleteItem(Data[i]);}
-        else if (new_size > Size) {
-            for (int i=Size;i<new_size;i++) {
-                ItemType* it = (ItemType*) ImGui::MemAlloc(sizeof(ItemType));
-                if (it) {
-                    IM_PLACEMENT_NEW (it) ItemType(true);
-                    Data[i] = it;
-                }
-            }
-        }
-        Size = new_size;
+    // These restore the image in place (they can change w,h and c, and reallocate im)
+    bool undo(unsigned char*& im,int& w,int& h,int& c) {
+        if (stack_cur<1 || stack_cur>snapshots.Size || !im) return false;
+        if (stack_cur==snapshots.Size) snapshots.push_back(capture(im,w,h,c)); // so that we can redo it
+        if (!restore(*snapshots[stack_cur-1],snapshots[stack_cur],im,w,h,c)) return false;
+        base = --stack_cur;
+        clearDirty();
+        enforceLimits();
+#       ifdef IMGUIIMAGEEDITOR_DEBUG_UNDO_STACK
+        fprintf(stderr,"UNDO to %d [w=%d h=%d c=%d] (%d entries, %u bytes)\n",stack_cur,w,h,c,snapshots.Size,(unsigned)usedBytes);
+#       endif //IMGUIIMAGEEDITOR_DEBUG_UNDO_STACK
+        return true;
+    }
+    bool redo(unsigned char*& im,int& w,int& h,int& c) {
+        if (stack_cur+1>=snapshots.Size || !im) return false;
+        if (!restore(*snapshots[stack_cur+1],snapshots[stack_cur],im,w,h,c)) return false;
+        base = ++stack_cur;
+        clearDirty();
+        enforceLimits();
+#       ifdef IMGUIIMAGEEDITOR_DEBUG_UNDO_STACK
+        fprintf(stderr,"REDO to %d [w=%d h=%d c=%d] (%d entries, %u bytes)\n",stack_cur,w,h,c,snapshots.Size,(unsigned)usedBytes);
+#       endif //IMGUIIMAGEEDITOR_DEBUG_UNDO_STACK
+        return true;
     }
 
 };
@@ -3855,10 +4081,24 @@ struct StbImage {
         }
     }
 
+#   ifdef IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+    static void TiledImageGenerateOrUpdateTextureCb(ImTextureID& texID,int w,int h,int c,const unsigned char* image,bool useMipmaps,bool wraps,bool wrapt) {
+        GenerateOrUpdateTextureCb(texID,w,h,c,image,useMipmaps,wraps,wrapt,false,true);
+    }
+    static void TiledImageFreeTextureCb(ImTextureID& texID) {
+        IM_ASSERT(ImGui::ImageEditor::FreeTextureCb);
+        ImGui::ImageEditor::FreeTextureCb(texID);
+    }
+#   endif //IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+
     ImageEditor* ie;            // reference
     unsigned char* image;
     int w,h,c;
-    ImTextureID texID;
+    ImTextureID texID;          // With the tiled view, it's just a low-resolution overview of the image
+#   ifdef IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+    ImGui::TiledImage* tiledImage;  // Used for huge images only
+    ImRect tiledViewDirtyRect;      // Part of the image that must be updated in tiledImage (when mustInvalidateTexID is false)
+#   endif //IMGUIIMAGEEDITOR_HAS_TILED_VIEW
 
     static ImTextureID IconsTexID;
     static ImTextureID CheckersTexID;
@@ -4008,6 +4248,12 @@ struct StbImage {
     int resizeWidth,resizeHeight;
     bool resizeKeepsProportions;
     int resizeFilter;
+#   ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+    ImGuiIE::ResizeImageAsyncJob* resizeJob;
+    ImTextureID resizePreviewTexID;
+    struct LoadJob;
+    LoadJob* loadJob;
+#   endif //IMGUIIMAGEEDITOR_HAS_THREADS
     int shiftPixels;
 
     int tolColor,tolAlpha;
@@ -4140,8 +4386,14 @@ struct StbImage {
 
     StbImage(ImageEditor& _ie) : ie(&_ie),image(NULL),w(0),h(0),c(0),texID(NULL),modified(false),
     undoStack(
+#       ifndef IMGUIIMAGEEDITOR_UNDO_MEMORY_BUDGET_MB
+        256
+#       else  // IMGUIIMAGEEDITOR_UNDO_MEMORY_BUDGET_MB
+        IMGUIIMAGEEDITOR_UNDO_MEMORY_BUDGET_MB
+#       endif //IMGUIIMAGEEDITOR_UNDO_MEMORY_BUDGET_MB
+        ,
 #       ifndef IMGUIIMAGEEDITOR_UNDO_SIZE
-        25
+        -1
 #       else  // IMGUIIMAGEEDITOR_UNDO_SIZE
         IMGUIIMAGEEDITOR_UNDO_SIZE
 #       endif //IMGUIIMAGEEDITOR_UNDO_SIZE
@@ -4151,6 +4403,13 @@ struct StbImage {
         slidersFraction.x=0.25f;slidersFraction.y=0.5f;
         resizeWidth=resizeHeight=resizeFilter=0;
         resizeKeepsProportions=true;
+#       ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+        resizeJob = NULL;resizePreviewTexID = NULL;loadJob = NULL;
+#       endif //IMGUIIMAGEEDITOR_HAS_THREADS
+#       ifdef IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+        tiledImage = NULL;
+        tiledViewDirtyRect = ImRect();
+#       endif //IMGUIIMAGEEDITOR_HAS_TILED_VIEW
         shiftPixels=4;
         penWidth = 1;
         penColor = ImVec4(0,0,0,1);
@@ -4378,6 +4637,13 @@ struct StbImage {
     }
     void clearModified() {assignModified(false);}
     void destroy() {
+#       ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+        cancelResizeJob();
+        LoadJob::Destroy(loadJob);
+#       endif //IMGUIIMAGEEDITOR_HAS_THREADS
+#       ifdef IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+        destroyTiledView();
+#       endif //IMGUIIMAGEEDITOR_HAS_TILED_VIEW
         if (image) STBI_FREE(image);
         w=h=c=0;
         if (texID) {
@@ -4395,6 +4661,12 @@ struct StbImage {
         modifyImageBottomToolbar.clearButtons();
     }
     void clear(bool keepPath=false) {
+#       ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+        cancelResizeJob();
+#       endif //IMGUIIMAGEEDITOR_HAS_THREADS
+#       ifdef IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+        destroyTiledView();
+#       endif //IMGUIIMAGEEDITOR_HAS_TILED_VIEW
         if (image) {STBI_FREE(image);image=NULL;}
         w=h=c=0;
         resizeWidth=resizeHeight=0;
@@ -4404,72 +4676,48 @@ struct StbImage {
         resetZoomAndPan();
     }
 
-    void pushImage(const ImRect* pSel=NULL) {undoStack.push(image,w,h,c,pSel,true);}
-    bool undo() //const ImRect* pSel=NULL)
+    // pushImage(), undo() and redo() cancel the background resize job: it works on a copy of the image, and its result would discard the changes.
+    // For the same reason they discard the result of a pending load job (that would replace the edited image without asking to save it).
+    void pushImage(const ImRect* pSel=NULL) {
+#       ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+        cancelResizeJob();
+        discardLoadJob();
+#       endif //IMGUIIMAGEEDITOR_HAS_THREADS
+        undoStack.push(image,w,h,c,pSel);
+    }
+    bool undo()
     {
-        const ImGuiIE::StbImageBuffer* buffer = undoStack.undo(image,w,h,c);//,pSel);
-        if (buffer) {
-            const int oldW = w;
-            const int oldH = h;
-            if (buffer->copyTo(image,w,h,c))   {
-#               ifdef IMGUIIMAGEEDITOR_DEBUG_UNDO_STACK
-                // Debug---------------------------------------
-                const ImRect* sel = &buffer->imageSelection;
-                fprintf(stderr,"UNDO. Copying image from: %d -> (%d,%d), (%d,%d) [w=%d h=%d c=%d]\n",
-                    undoStack.getStackCur(),
-                    sel?(int)sel->Min.x:0,
-                    sel?(int)sel->Min.y:0,
-                    sel?(int)(sel->Max.x-sel->Min.x):w,
-                    sel?(int)(sel->Max.y-sel->Min.y):h,
-                    buffer->W,
-                    buffer->H,
-                    buffer->c
-                    );
-                //-----------------------------------------------
-#               endif //IMGUIIMAGEEDITOR_DEBUG_UNDO_STACK
-                mustInvalidateTexID = true;
-                assignModified(true);
-                if (oldW!=w || oldH!=h) {
-                    ImFormatImageDimString(imageDimString,64,w,h);
-                    imageSelection.Min = imageSelection.Max = ImVec2(0,0);
-                }
-                if (undoStack.getStackCur()==0 && !undoStack.getStackMaxReached()) assignModified(false);
-                return true;
-            }
+#       ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+        cancelResizeJob();
+        discardLoadJob();
+#       endif //IMGUIIMAGEEDITOR_HAS_THREADS
+        const int oldW = w;
+        const int oldH = h;
+        if (!undoStack.undo(image,w,h,c)) return false;
+        mustInvalidateTexID = true;
+        assignModified(true);
+        if (oldW!=w || oldH!=h) {
+            ImFormatImageDimString(imageDimString,64,w,h);
+            imageSelection.Min = imageSelection.Max = ImVec2(0,0);
         }
-        return false;
+        if (undoStack.getStackCur()==0 && !undoStack.getStackMaxReached()) assignModified(false);
+        return true;
     }
     bool redo() {
-        const ImGuiIE::StbImageBuffer* buffer = undoStack.redo(image,w,h,c);
-        if (buffer) {
-            const int oldW = w;
-            const int oldH = h;
-            if (buffer->copyTo(image,w,h,c))   {
-#               ifdef IMGUIIMAGEEDITOR_DEBUG_UNDO_STACK
-                // Debug---------------------------------------
-                const ImRect* sel = &buffer->imageSelection;
-                fprintf(stderr,"REDO. Copying image from: %d -> (%d,%d), (%d,%d)[w=%d h=%d c=%d]\n",
-                    undoStack.getStackCur(),
-                    sel?(int)sel->Min.x:0,
-                    sel?(int)sel->Min.y:0,
-                    sel?(int)(sel->Max.x-sel->Min.x):w,
-                    sel?(int)(sel->Max.y-sel->Min.y):h,
-                    buffer->W,
-                    buffer->H,
-                    buffer->c
-                    );
-                //-----------------------------------------------
-#               endif //IMGUIIMAGEEDITOR_DEBUG_UNDO_STACK
-                mustInvalidateTexID = true;
-                assignModified(true);
-                if (oldW!=w || oldH!=h) {
-                    ImFormatImageDimString(imageDimString,64,w,h);
-                    imageSelection.Min = imageSelection.Max = ImVec2(0,0);
-                }
-                return true;
-            }
+#       ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+        cancelResizeJob();
+        discardLoadJob();
+#       endif //IMGUIIMAGEEDITOR_HAS_THREADS
+        const int oldW = w;
+        const int oldH = h;
+        if (!undoStack.redo(image,w,h,c)) return false;
+        mustInvalidateTexID = true;
+        assignModified(true);
+        if (oldW!=w || oldH!=h) {
+            ImFormatImageDimString(imageDimString,64,w,h);
+            imageSelection.Min = imageSelection.Max = ImVec2(0,0);
         }
-        return false;
+        return true;
     }
 
     bool convertImageToColorMode(int newC,bool assumeThatOneChannelMeansLuminance=true) {
@@ -4500,12 +4748,34 @@ struct StbImage {
         return true;
     }
 
-    bool resizeImage(int newW,int newH,ImGuiIE::ResizeFilter filter) {
+    // When allowBackgroundJob is true, big images are resized in a worker thread (if available): in that case it returns false,
+    // and the image is replaced when the job ends (see updateResizeJob())
+    bool resizeImage(int newW,int newH,ImGuiIE::ResizeFilter filter,bool allowBackgroundJob=false) {
         if (!image) return false;
         void* lastArg = NULL;
 #       ifdef STBIR_INCLUDE_STB_IMAGE_RESIZE_H
         lastArg = (void*)&myStbirData;
 #       endif //STBIR_INCLUDE_STB_IMAGE_RESIZE_H
+#       ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+        cancelResizeJob();
+        if (allowBackgroundJob && (newW*newH>=IMGUIIMAGEEDITOR_ASYNC_RESIZE_MIN_PIXELS || w*h>=IMGUIIMAGEEDITOR_ASYNC_RESIZE_MIN_PIXELS)) {
+            resizeJob = ImGuiIE::ResizeImageAsyncJob::Create(newW,newH,image,w,h,c,filter,lastArg);
+            if (resizeJob) {
+                // Low resolution preview (it's fast, so that the user sees soon what's going to happen)
+                const float scale = ImMin(256.f/(float)newW,256.f/(float)newH);
+                const int pw = scale<1.f ? ImMax((int)(newW*scale),1) : newW;
+                const int ph = scale<1.f ? ImMax((int)(newH*scale),1) : newH;
+                unsigned char* preview = ImGuiIE::ResizeImage(pw,ph,image,w,h,c,ImGuiIE::RF_GOOD);
+                if (preview) {
+                    StbImage::GenerateOrUpdateTextureCb(resizePreviewTexID,pw,ph,c,preview,false,false,false,false,false);
+                    STBI_FREE(preview);
+                }
+                return false;
+            }
+        }
+#       else //IMGUIIMAGEEDITOR_HAS_THREADS
+        (void)allowBackgroundJob;
+#       endif //IMGUIIMAGEEDITOR_HAS_THREADS
         unsigned char* im = ImGuiIE::ResizeImage(newW,newH,image,w,h,c,filter,lastArg);
         if (!im) return false;
         pushImage();
@@ -4515,6 +4785,71 @@ struct StbImage {
         ImFormatImageDimString(imageDimString,64,w,h);
         return true;
     }
+#   ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+    // Must be called every frame: replaces the image when the resize job has finished
+    void updateResizeJob() {
+        if (!resizeJob || !resizeJob->isFinished()) return;
+        int newW=0,newH=0;
+        unsigned char* im = resizeJob->getResult(newW,newH);
+        cancelResizeJob();
+        if (!im) return;
+        pushImage();
+        STBI_FREE(image);
+        mustInvalidateTexID = true;
+        image = im;w=newW;h=newH;
+        ImFormatImageDimString(imageDimString,64,w,h);
+        assignModified(true);
+    }
+    void cancelResizeJob() {
+        ImGuiIE::ResizeImageAsyncJob::Destroy(resizeJob);
+        if (resizePreviewTexID) {
+            IM_ASSERT(ImageEditor::FreeTextureCb);
+            ImageEditor::FreeTextureCb(resizePreviewTexID);resizePreviewTexID=NULL;
+        }
+    }
+#   endif //IMGUIIMAGEEDITOR_HAS_THREADS
+
+#   ifdef IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+    // The tile pyramid is rebuilt in the background, and texID gets a low-resolution overview that's displayed until it's ready
+    void updateTiledView() {
+        tiledViewDirtyRect = ImRect();
+        if (!tiledImage) {
+            if (!ImGui::TiledImage::GetFreeTextureCallback()) ImGui::TiledImage::SetFreeTextureCallback(&TiledImageFreeTextureCb);
+            if (!ImGui::TiledImage::GetGenerateOrUpdateTextureCallback()) ImGui::TiledImage::SetGenerateOrUpdateTextureCallback(&TiledImageGenerateOrUpdateTextureCb);
+            tiledImage = (ImGui::TiledImage*) ImGui::MemAlloc(sizeof(ImGui::TiledImage));
+            IM_PLACEMENT_NEW(tiledImage) ImGui::TiledImage();
+        }
+        if (!tiledImage->setImage(image,w,h,c)) destroyTiledView();
+        const float scale = (float)(IMGUIIMAGEEDITOR_TILED_VIEW_MIN_SIZE/2)/(float)ImMax(w,h);
+        const int ow = ImMax((int)(w*scale),1),oh = ImMax((int)(h*scale),1);
+        unsigned char* overview = ImGuiIE::ResizeImage(ow,oh,image,w,h,c,ImGuiIE::RF_NEAREST);
+        if (overview) {
+            GenerateOrUpdateTextureCb(texID,ow,oh,c,overview,true,false,false,false,true);
+            STBI_FREE(overview);
+        }
+    }
+    void destroyTiledView() {
+        tiledViewDirtyRect = ImRect();
+        if (tiledImage) {
+            tiledImage->~TiledImage();
+            ImGui::MemFree(tiledImage);
+            tiledImage = NULL;
+        }
+    }
+#   endif //IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+    // Use it instead of setting mustInvalidateTexID when only a part of the image has changed (e.g. by a pen stroke):
+    // with the tiled view, only that part of the pyramid is updated, instead of rebuilding all of it every frame.
+    void invalidateTexIDRect(int x0,int y0,int x1,int y1) {
+#       ifdef IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+        if (tiledImage && !mustInvalidateTexID) {
+            tiledViewDirtyRect.Add(ImRect((float)x0,(float)y0,(float)x1,(float)y1));
+            return;
+        }
+#       else //IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+        (void)x0;(void)y0;(void)x1;(void)y1;
+#       endif //IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+        mustInvalidateTexID = true;
+    }
 
     bool pasteImage(ImGuiIE::ResizeFilter filter,bool overlayOrAppendMode=false) {
         if (!isImageSelectionValid() || !CopiedImage.isValid()) return false;
@@ -5042,10 +5377,11 @@ struct StbImage {
         return ok;
     }
 
-    bool loadFromMemory(const unsigned char* buffer,int size,bool reloadMode = false,const char* ext=NULL) {
-        clear(reloadMode);
-        if (!buffer || size<=0) return false;
-        IM_ASSERT(!image);        
+    // Decodes an image file loaded in memory (the returned image must be freed with STBI_FREE(...)).
+    // It doesn't touch any StbImage, so that it can be called by worker threads too.
+    static unsigned char* DecodeImage(const unsigned char* buffer,int size,const char* ext,int& w,int& h,int& c) {
+        unsigned char* image = NULL;
+        if (!buffer || size<=0) return image;
         if (ext && ((strcmp(ext,".ico")==0) || (strcmp(ext,".cur")==0)))   {
 #           ifdef TINY_ICO_H
             image = tiny_ico_load_from_memory(buffer,size,&w,&h,&c,0);
@@ -5067,17 +5403,45 @@ struct StbImage {
 #           endif //_SVG_
         }
         else if (!image) image = stbi_load_from_memory(buffer,size,&w,&h,&c,0);
-        if (!image) return false;
+        if (!image) return image;
         if (c!=1 && c!=3 && c<4) {
-            clear(reloadMode);
+            STBI_FREE(image);
             image = stbi_load_from_memory(buffer,size,&w,&h,&c,3);
             c=3;
         }
         else if (c>4)	{
-            clear(reloadMode);
+            STBI_FREE(image);
             image = stbi_load_from_memory(buffer,size,&w,&h,&c,4);
             c=4;
         }
+        return image;
+    }
+    // Fetch file extension soon, because we could not use stbi_load in loadFromMemory(...)
+    static void GetImageFileExtension(const char* path,char ext[6]) {
+        ext[0]='\0';
+        if (path) {
+            const char* dot = strrchr(path,'.');
+            const int len = (int) strlen(path);
+            if (dot && ((dot-path)==len-4 || (dot-path)==len-5)) {
+                strcpy(ext,dot);
+                for (int i=0;i<6;i++) ext[i]=tolower(ext[i]);
+            }
+        }
+    }
+    static bool GetImageFileContent(const char* path,ImVector<char>& content) {
+#       if (defined(IMGUI_USE_MINIZIP) && defined(IMGUI_FILESYSTEM_H_) && !defined(IMGUIFS_NO_EXTRA_METHODS))
+        if (!ImGuiFs::FileGetContent(path,content)) return false;    // supports path inside zip files
+#       else // IMGUI_USE_MINIZIP
+        if (!ImGuiIE::GetFileContent(path,content)) return false;
+#       endif //IMGUI_USE_MINIZIP
+        return content.size()>0;
+    }
+
+    bool loadFromMemory(const unsigned char* buffer,int size,bool reloadMode = false,const char* ext=NULL) {
+        clear(reloadMode);
+        if (!buffer || size<=0) return false;
+        IM_ASSERT(!image);
+        image = DecodeImage(buffer,size,ext,w,h,c);
         if (image) {
             ImFormatFileSizeString(fileSizeString,64,size);
             ImFormatImageDimString(imageDimString,64,w,h);
@@ -5089,29 +5453,17 @@ struct StbImage {
     }
 
     bool loadFromFile(const char* path,bool updateFilePathsList=true) {
-        // Fetch file extension soon, because we could not use stbi_load in loadFromMemory(...):
         char ext[6] = "";
-        if (path) {
-            const char* dot = strrchr(path,'.');
-            const int len = (int) strlen(path);
-            if (dot && ((dot-path)==len-4 || (dot-path)==len-5)) {
-                strcpy(ext,dot);
-                for (int i=0;i<6;i++) ext[i]=tolower(ext[i]);
-            }
-        }
+        GetImageFileExtension(path,ext);
         if (strcmp(ext,".zip")==0) return false;    // not an image file
 
+#       ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+        LoadJob::Destroy(loadJob);
+#       endif //IMGUIIMAGEEDITOR_HAS_THREADS
         const bool reloadMode = (path==filePath);
         clear(reloadMode);
-        bool loadingFailed = false;
         ImVector<char> content;
-#       if (defined(IMGUI_USE_MINIZIP) && defined(IMGUI_FILESYSTEM_H_) && !defined(IMGUIFS_NO_EXTRA_METHODS))
-        if (!ImGuiFs::FileGetContent(path,content)) loadingFailed=true;    // supports path inside zip files
-#       else // IMGUI_USE_MINIZIP
-        if (!ImGuiIE::GetFileContent(path,content)) loadingFailed=true;
-#       endif //IMGUI_USE_MINIZIP
-        if (content.size()==0) loadingFailed=true;
-        bool ok = !loadingFailed;
+        bool ok = GetImageFileContent(path,content);
         if (ok) {
             ok =loadFromMemory((const unsigned char*)&content[0],content.size(),reloadMode,ext);
             if (ok) {
@@ -5126,6 +5478,100 @@ struct StbImage {
         return ok;
     }
 
+#   ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+    // Reads and decodes an image file in a worker thread
+    struct LoadJob {
+        char* path;
+        char ext[6];
+        bool reloadMode,updateFilePathsList;
+        bool discarded;     // the image has been edited in the meantime: the result is dropped when the job ends
+        unsigned char* image;
+        int w,h,c,fileSize;
+        ImGuiHelper::ThreadHandle thread;
+        volatile int finished;
+
+        static void ThreadFunction(void* userPtr) {
+            LoadJob& j = *((LoadJob*) userPtr);
+            ImVector<char> content;
+            if (GetImageFileContent(j.path,content)) {
+                j.fileSize = content.size();
+                j.image = DecodeImage((const unsigned char*)&content[0],content.size(),j.ext,j.w,j.h,j.c);
+            }
+            ImGuiHelper::AtomicStore(&j.finished,1);
+        }
+        static LoadJob* Create(const char* path,const char* ext,bool reloadMode,bool updateFilePathsList) {
+            LoadJob* j = (LoadJob*) ImGui::MemAlloc(sizeof(LoadJob));
+            IM_PLACEMENT_NEW (j) LoadJob();
+            const size_t len = strlen(path);
+            j->path = (char*) ImGui::MemAlloc(len+1);memcpy(j->path,path,len+1);
+            strcpy(j->ext,ext);
+            j->reloadMode = reloadMode;j->updateFilePathsList = updateFilePathsList;j->discarded = false;
+            j->image = NULL;j->w=j->h=j->c=j->fileSize=0;
+            j->finished = 0;
+            j->thread = ImGuiHelper::ThreadCreate(&ThreadFunction,j);
+            if (!j->thread) Destroy(j);
+            return j;
+        }
+        // There's no way to stop a decoder: this waits for it
+        static void Destroy(LoadJob*& j) {
+            if (!j) return;
+            if (j->thread) {ImGuiHelper::ThreadJoin(j->thread);j->thread = 0;}
+            if (j->image) {STBI_FREE(j->image);j->image = NULL;}
+            if (j->path) {ImGui::MemFree(j->path);j->path = NULL;}
+            j->~LoadJob();
+            ImGui::MemFree(j);
+            j = NULL;
+        }
+        bool isFinished() {return ImGuiHelper::AtomicLoad(&finished)!=0;}
+    };
+    // The current image is kept until the new one has been decoded (see updateLoadJob()).
+    // Returns false if the worker thread can't be started (without threads it just calls loadFromFile(...))
+    bool loadFromFileAsync(const char* path,bool updateFilePathsList=true) {
+        char ext[6] = "";
+        GetImageFileExtension(path,ext);
+        if (!path || strcmp(ext,".zip")==0) return false;    // not an image file
+        LoadJob::Destroy(loadJob);
+        loadJob = LoadJob::Create(path,ext,path==filePath,updateFilePathsList);
+        return loadJob!=NULL;
+    }
+    // Must be called every frame: it replaces the image when the load job has finished
+    void updateLoadJob() {
+        if (!loadJob || !loadJob->isFinished()) return;
+        LoadJob* j = loadJob;loadJob = NULL;
+        if (j->discarded) {LoadJob::Destroy(j);return;}
+        clear(j->reloadMode);
+        if (j->image) {
+            image = j->image;j->image = NULL;
+            w = j->w;h = j->h;c = j->c;
+            ImFormatFileSizeString(fileSizeString,64,j->fileSize);
+            ImFormatImageDimString(imageDimString,64,w,h);
+            resizeWidth = w; resizeHeight = h;
+            if (!j->reloadMode) assignFilePath(j->path,j->updateFilePathsList);
+            else if (mustUpdateFileListSoon) updateFileList();
+            assignModified(false);
+            undoStack.clear();
+        }
+        else if (j->fileSize>0) clearFilePath();
+        LoadJob::Destroy(j);
+        if (ImageEditor::ImageEditorEventCb) ImageEditor::ImageEditorEventCb(*ie,ImageEditor::ET_IMAGE_LOADED);
+    }
+    bool isLoading() const {return loadJob!=NULL && !loadJob->discarded;}
+    // There's no way to stop a decoder: the job is left running (so that we don't wait for it), and updateLoadJob() drops its result
+    void discardLoadJob() {
+        if (!loadJob || loadJob->discarded) return;
+        loadJob->discarded = true;
+#       ifdef IMGUI_FILESYSTEM_H_
+        // The browsing code has already moved filePathsIndex to the file being loaded
+        for (int i=0,isz=filePath ? filePaths.size() : 0;i<isz;i++) {
+            if (strcmp(filePath,filePaths[i])==0) {filePathsIndex = i;break;}
+        }
+#       endif //IMGUI_FILESYSTEM_H_
+    }
+#   else //IMGUIIMAGEEDITOR_HAS_THREADS
+    bool loadFromFileAsync(const char* path,bool updateFilePathsList=true) {return loadFromFile(path,updateFilePathsList);}
+    bool isLoading() const {return false;}
+#   endif //IMGUIIMAGEEDITOR_HAS_THREADS
+
     bool saveAs(const char* path=NULL,int numChannels=0) {
         bool rv = false;
         if (!path || path[0]=='\0') path = filePath;
@@ -5353,8 +5799,33 @@ struct StbImage {
         if (!window || window->SkipItems) return;
 
         if (modifyImageTopToolbar.getNumButtons()==0) initToolbars();   // This should call InitSupportTextures() if necessary
-
+#       ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+        updateResizeJob();
+        updateLoadJob();
+#       endif //IMGUIIMAGEEDITOR_HAS_THREADS
+
+#       ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+        // Uploads can be postponed to the next frames (the old texture is used in the meantime)
+        if (image && (!texID || mustInvalidateTexID) && !ImGuiHelper::IsTextureUploadBudgetAvailable()) {
+            if (!texID) return;
+        }
+        else
+#       endif //IMGUIIMAGEEDITOR_HAS_THREADS
+#       ifdef IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+        if (tiledImage && texID && !mustInvalidateTexID && tiledViewDirtyRect.Min.x<tiledViewDirtyRect.Max.x && tiledViewDirtyRect.Min.y<tiledViewDirtyRect.Max.y) {
+            const ImRect& r = tiledViewDirtyRect;
+            if (tiledImage->updateImage(image,(int)r.Min.x,(int)r.Min.y,(int)r.Max.x,(int)r.Max.y)) {
+                tiledViewDirtyRect = ImRect();
+                if (ImageEditor::ImageEditorEventCb) ImageEditor::ImageEditorEventCb(*ie,ImageEditor::ET_IMAGE_UPDATED);
+            }
+            else mustInvalidateTexID = true;    // Next frame
+        }
+        else
+#       endif //IMGUIIMAGEEDITOR_HAS_TILED_VIEW
         if (!texID || mustInvalidateTexID) {
+#           ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+            const double uploadStartTime = ImGuiHelper::GetTimeInMilliseconds();
+#           endif //IMGUIIMAGEEDITOR_HAS_THREADS
             if (mustInvalidateTexID) {
                 if (texID) {
                     IM_ASSERT(ImGui::ImageEditor::FreeTextureCb);   // Please call ImGui::ImageEditor::SetFreeTextureCallback(...) at InitGL() time.
@@ -5364,8 +5835,19 @@ struct StbImage {
             }
             if (image) {
                 IM_ASSERT(ImGui::ImageEditor::GenerateOrUpdateTextureCb);   // Please call ImGui::ImageEditor::SetGenerateOrUpdateTextureCallback(...) at InitGL() time.
+#               ifdef IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+                if (w>IMGUIIMAGEEDITOR_TILED_VIEW_MIN_SIZE || h>IMGUIIMAGEEDITOR_TILED_VIEW_MIN_SIZE) updateTiledView();
+                else {
+                    destroyTiledView();
+                    StbImage::GenerateOrUpdateTextureCb(texID,w,h,c,image,true,false,false,true,true);
+                }
+#               else //IMGUIIMAGEEDITOR_HAS_TILED_VIEW
                 StbImage::GenerateOrUpdateTextureCb(texID,w,h,c,image,true,false,false,true,true);
+#               endif //IMGUIIMAGEEDITOR_HAS_TILED_VIEW
                 if (ImageEditor::ImageEditorEventCb) ImageEditor::ImageEditorEventCb(*ie,ImageEditor::ET_IMAGE_UPDATED);
+#               ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+                ImGuiHelper::ConsumeTextureUploadBudget(ImGuiHelper::GetTimeInMilliseconds()-uploadStartTime);
+#               endif //IMGUIIMAGEEDITOR_HAS_THREADS
                 if (!texID) return;
             }
         }
@@ -5666,7 +6148,7 @@ struct StbImage {
 
                             if (mustSaveSavePath || mustSkipSavingSavePath) {
                                 filePathsIndex = newFilePathsIndex;
-                                loadFromFile(filePaths[filePathsIndex],false);
+                                loadFromFileAsync(filePaths[filePathsIndex],false);
                             }
                         }
                     }
@@ -5674,7 +6156,7 @@ struct StbImage {
                 else if (mustLoadNewImage)   {
                     // load the new image
                     filePathsIndex = newFilePathsIndex;
-                    loadFromFile(filePaths[filePathsIndex],false);
+                    loadFromFileAsync(filePaths[filePathsIndex],false);
                 }
                 ImGui::PopID();
             }
@@ -5712,11 +6194,24 @@ struct StbImage {
             }
 #           endif //STBIR_INCLUDE_STB_IMAGE_RESIZE_H
 
+#           ifdef IMGUIIMAGEEDITOR_HAS_THREADS
+            if (resizeJob) {
+                ImGui::ProgressBar(resizeJob->getProgress(),ImVec2(-1,0),"Resizing...");
+                if (ImGui::Button("Cancel")) cancelResizeJob();
+                else if (resizePreviewTexID) {
+                    // Low resolution preview of the result
+                    const float size = ImMin(ImGui::GetContentRegionAvailWidth(),128.f);
+                    const float aspectRatio = resizeHeight>0 ? (float)resizeWidth/(float)resizeHeight : 1.f;
+                    ImGui::Image(resizePreviewTexID,aspectRatio>=1.f ? ImVec2(size,size/aspectRatio) : ImVec2(size*aspectRatio,size));
+                }
+            }
+            else
+#           endif //IMGUIIMAGEEDITOR_HAS_THREADS
             if (resizeWidth>0 && resizeHeight>0)    {
                 if (ImGui::Button("Clip") && clipImage(resizeWidth,resizeHeight)) {assignModified(true);}
                 if (ImGui::IsItemHovered()) ImGui::SetTooltip("%s","Set new size without\nresizing the image");
                 ImGui::SameLine();
-                if (ImGui::Button("Resize") && resizeImage(resizeWidth,resizeHeight,(ImGuiIE::ResizeFilter)resizeFilter)) {assignModified(true);}
+                if (ImGui::Button("Resize") && resizeImage(resizeWidth,resizeHeight,(ImGuiIE::ResizeFilter)resizeFilter,true)) {assignModified(true);}
             }
             ImGui::PopID();
         }
@@ -6690,6 +7185,15 @@ struct StbImage {
             //window->DrawList->AddImage(CheckersTexID, startPos, endPos, uv0*m, uv1*m);
             window->DrawList->AddImage(CheckersTexID, startPos, endPos, ImVec2(0,0), CheckersRepeatFactor);
         }
+#       ifdef IMGUIIMAGEEDITOR_HAS_TILED_VIEW
+        if (tiledImage) {
+            // While the pyramid is not ready, the overview is drawn below the tiles, where they're still missing.
+            // It's not drawn afterwards, because it would show through the transparent pixels of the tiles.
+            if (!tiledImage->isReady()) window->DrawList->AddImage(texID, startPos, endPos, uv0, uv1);
+            tiledImage->render(window->DrawList, startPos, endPos, uv0, uv1);
+        }
+        else
+#       endif //IMGUIIMAGEEDITOR_HAS_TILED_VIEW
         window->DrawList->AddImage(texID, startPos, endPos, uv0, uv1);
 
 
@@ -7072,10 +7576,15 @@ struct StbImage {
                             unsigned char penColorUC[4] = {(unsigned char)(penColorToUse.x*255.f),(unsigned char)(penColorToUse.y*255.f),(unsigned char)(penColorToUse.z*255.f),(unsigned char)(penColorToUse.w*255.f)};
                             if (c==1) penColorUC[0]=penColorUC[1]=penColorUC[2]=penColorUC[3];
                             int numPixelsSet = 0;
+                            int dirtyX0=w,dirtyY0=h,dirtyX1=0,dirtyY1=0;
                             float dx=0,dy=0,deltaPenWidth2=ImGuiIE::round(penWidth*penWidth*0.25f);
                             for (int i=0;i<numPoints;i++)  {
                                 x = (int) pPenPoints->x-deltaPenWidth;y = (int) pPenPoints->y-deltaPenWidth;
                                 pPenPoints++;
+                                if (dirtyX0>x) dirtyX0=x;
+                                if (dirtyY0>y) dirtyY0=y;
+                                if (dirtyX1<x+penWidthi) dirtyX1=x+penWidthi;
+                                if (dirtyY1<y+penWidthi) dirtyY1=y+penWidthi;
                                 for (int yy=y,yySz=y+penWidthi;yy<yySz;yy++) {
                                     if (yy<Y || yy>=Y+H) continue;
                                     if (mustUseRoundPen) {dy = yy-y-deltaPenWidth+(penWidthIsEven?0.5f:0.f);dy*=dy;dy=ImGuiIE::round(dy);}
@@ -7109,7 +7618,7 @@ struct StbImage {
                                 }
                             }
                             if (numPixelsSet>0) {
-                                mustInvalidateTexID = true;
+                                invalidateTexIDRect(dirtyX0,dirtyY0,dirtyX1,dirtyY1);
                                 assignModified(true);
                             }
                         }
@@ -7129,7 +7638,8 @@ struct StbImage {
                     const ImVec4 penColorToUse = (c==3 && !penOverlayMode) ? ImVec4(penColor.x,penColor.y,penColor.z,1.f) : penColor;
                     if (ImGuiIE::FillHelperClass::Fill(image,w,h,c,imagePos,penColorToUse,ImVec4((float)tolColor/255.f,(float)tolColor/255.f,(float)tolColor/255.f,(float)tolAlpha/255.f),
                     pSelection,chbMirrorX,chbMirrorY,false,penOverlayMode)) {
-                        mustInvalidateTexID = true;
+                        if (pSelection) invalidateTexIDRect((int)pSelection->Min.x,(int)pSelection->Min.y,(int)pSelection->Max.x,(int)pSelection->Max.y);
+                        else mustInvalidateTexID = true;
                         assignModified(true);
                     }
                 }
@@ -7198,6 +7708,12 @@ bool ImageEditor::loadFromFile(const char *path)  {
     if (rv) {is->resizeWidth=is->w;is->resizeHeight=is->h;}
     return rv;
 }
+bool ImageEditor::loadFromFileAsync(const char *path)  {
+    if (!is) is = CreateStbImage(*this);
+    IM_ASSERT(is);	// You can't call loadFromFileAsync() after destroy()!
+    return is->loadFromFileAsync(path);
+}
+bool ImageEditor::isLoading() const {return is && is->isLoading();}
 bool ImageEditor::saveAs(const char* path) {
     if (!is) is = CreateStbImage(*this);
     IM_ASSERT(is);	// You can't call saveAs() after destroy()!
@@ -114,6 +114,13 @@ NOTES:
  *
  * IMGUIIMAGEEDITOR_LOAD_ONLY_SAVABLE_FORMATS - does what it says
  *
+ * IMGUIIMAGEEDITOR_UNDO_MEMORY_BUDGET_MB   - (default: 256) memory used by the undo/redo history, in MB.
+ * IMGUIIMAGEEDITOR_UNDO_SIZE               - (default: no limit) max number of undo steps.
+ * IMGUIIMAGEEDITOR_UNDO_NO_COMPRESSION     - don't zlib compress the old undo entries when the budget is exceeded.
+ * IMGUIIMAGEEDITOR_ASYNC_RESIZE_MIN_PIXELS - (default: 2048*2048) when imguihelper threads are available, bigger images are resized in the background.
+ * IMGUIIMAGEEDITOR_TILED_VIEW_MIN_SIZE     - (default: 4096) when imguivariouscontrols is available, images with a bigger side are displayed through ImGui::TiledImage.
+ * IMGUIIMAGEEDITOR_NO_TILED_VIEW           - always display the image using a single texture.
+ *
  * stb_image definitions can be used too (for example STBI_NO_GIF,etc.), but please make sure that you can load back
  * all the savable image formats.
  *
@@ -129,6 +136,17 @@ NOTES:
 */
 
 /* CHANGELOG:
+ IMGUIIMAGEEDITOR_VERSION 0.36
+ * The undo/redo history now stores images as tiles shared between consecutive entries, so that each step stores only
+   the tiles it modifies (previously the whole image or selection was copied and png-compressed at every step).
+   It's now limited by a memory budget (IMGUIIMAGEEDITOR_UNDO_MEMORY_BUDGET_MB) instead of a number of entries:
+   when it's exceeded, old tiles are zlib compressed, and then the oldest entries are discarded.
+ * Convolution filters (e.g. Gaussian Blur) are much faster (separable kernels, SSE, multi-threading).
+ * Resizing is multi-threaded, and big images are resized in the background (with a progress bar, a preview and a "Cancel" button).
+ * Huge images are displayed through a tiled mipmap pyramid (ImGui::TiledImage), so that they don't need a single huge texture.
+   In this case ImageEditor::getImageTexture() returns a low-resolution overview of the image.
+ * Added ImageEditor::loadFromFileAsync(...): images are decoded in a worker thread (browsing folders uses it too).
+
  IMGUIIMAGEEDITOR_VERSION 0.35
  * When both lodepng and stb_image_write are available, now .png images are saved using stb_image_write (so that saved .png images are now bigger in size).
                 Reason: lodepng_encode_memory(...) is not robust for us!
@@ -220,7 +238,7 @@ NOTES:
  * Added an optional callback SetImageEditorEventCallback(...)
 */
 
-#define IMGUIIMAGEEDITOR_VERSION 0.35
+#define IMGUIIMAGEEDITOR_VERSION 0.36
 
 namespace ImGui {
 
@@ -250,6 +268,10 @@ public:
     bool isInited() const {return init;}
 
     IMGUI_API bool loadFromFile(const char* path);
+    // The file is read and decoded in a worker thread (if available), and the image is replaced inside render() when it's ready
+    // (texture uploads are limited by ImGuiHelper::SetTextureUploadBudgetPerFrame(...)). ET_IMAGE_LOADED is sent as usual.
+    IMGUI_API bool loadFromFileAsync(const char* path);
+    IMGUI_API bool isLoading() const;
     IMGUI_API bool saveAs(const char* path=NULL);
 
     IMGUI_API void render(const ImVec2 &size);    // to be called inside an ImGui::Window. Makes isInited() return true;
@@ -77,6 +77,19 @@ The TED / SID support is based on tedplay (c) 2012 Attila Grosz, used under Unli
 
 #include "imguisoloud.h"
 
+#if (defined(IMGUIHELPER_H_) && defined(IMGUIHELPER_HAS_THREADS))
+#   define IMGUISOLOUD_HAS_THREADS
+#endif //IMGUIHELPER_HAS_THREADS
+#if (defined(IMGUISOLOUD_HAS_THREADS) && !defined(NO_IMGUISOLOUD_MIX_THREADS))
+#   define IMGUISOLOUD_HAS_MIX_THREADS
+#endif //NO_IMGUISOLOUD_MIX_THREADS
+#ifndef IMGUISOLOUD_COMMAND_QUEUE_SIZE
+#   define IMGUISOLOUD_COMMAND_QUEUE_SIZE 1024
+#endif //IMGUISOLOUD_COMMAND_QUEUE_SIZE
+#ifndef IMGUISOLOUD_MIX_VOICES_PER_CHUNK
+#   define IMGUISOLOUD_MIX_VOICES_PER_CHUNK 8
+#endif //IMGUISOLOUD_MIX_VOICES_PER_CHUNK
+
 // suppress some warning-----------------------------------------------------------------------
 #ifdef _MSC_VER
 #   pragma warning(disable:4100)
@@ -160,6 +173,23 @@ namespace SoLoud
 		} \
 		unlockAudioMutex();
 
+// Same as above, for when the audio mutex is already locked
+#define FOR_ALL_VOICES_PRE_LOCKED \
+		handle *h_ = NULL; \
+		handle th_[2] = { aVoiceHandle, 0 }; \
+		h_ = voiceGroupHandleToArray(aVoiceHandle); \
+		if (h_ == NULL) h_ = th_; \
+		while (*h_) \
+		{ \
+			int ch = getVoiceFromHandle(*h_); \
+			if (ch != -1)  \
+			{
+
+#define FOR_ALL_VOICES_POST_LOCKED \
+			} \
+			h_++; \
+		}
+
 #define FOR_ALL_VOICES_PRE_3D \
 		handle *h_ = NULL; \
 		handle th_[2] = { aVoiceHandle, 0 }; \
@@ -1393,6 +1423,18 @@ namespace SoLoud
 		mMaxActiveVoices = 16;
 		mHighestVoice = 0;
 		mActiveVoiceDirty = true;
+#ifdef IMGUISOLOUD_HAS_MIX_THREADS
+		mMixThreadCount = -1;	// Automatic: the thread pool is created in postinit()
+#else //IMGUISOLOUD_HAS_MIX_THREADS
+		mMixThreadCount = 0;
+#endif //IMGUISOLOUD_HAS_MIX_THREADS
+		mMixThreadPool = NULL;
+		mMixChunkBufferSize = 0;
+		mMixChunkSize = 0;
+		mCommandQueue = NULL;
+		mCommandQueueSize = 0;
+		mCommandQueueHead = 0;
+		mCommandQueueTail = 0;
         //mResampleData = NULL;
         //mResampleDataOwner = NULL;
 	}
@@ -1410,6 +1452,8 @@ namespace SoLoud
 		for (i = 0; i < mVoiceGroupCount; i++)
 			delete[] mVoiceGroup[i];
 		delete[] mVoiceGroup;
+		setMixThreadCount(0);
+		delete[] mCommandQueue;
         //delete[] mResampleData;
         //delete[] mResampleDataOwner;
 	}
@@ -1709,6 +1753,15 @@ namespace SoLoud
 		mOutputScratch.init(mScratchSize * MAX_CHANNELS);
 		mFlags = aFlags;
 		mPostClipScaler = 0.95f;
+		if (mMixThreadCount < 0)
+			setMixThreadCount(-1);
+#ifdef IMGUISOLOUD_HAS_THREADS
+		if ((aFlags & DEFERRED_COMMANDS) && !mCommandQueue)
+		{
+			mCommandQueueSize = IMGUISOLOUD_COMMAND_QUEUE_SIZE;
+			mCommandQueue = new VoiceCommand[mCommandQueueSize];
+		}
+#endif //IMGUISOLOUD_HAS_THREADS
 		switch (mChannels)
 		{
 		case 1:
@@ -2295,283 +2348,297 @@ namespace SoLoud
             aVoice->mCurrentChannelVolume[k] = pand[k];
     }
 
-    void Soloud::mixBus(float *aBuffer, unsigned int aSamplesToRead, unsigned int aBufferSize, float *aScratch, unsigned int aBus, float aSamplerate, unsigned int aChannels)
+    // Mixes an audible voice into aBuffer, using aScratch for resampling and aSeekScratch for the looping seeks.
+    // It only touches the voice and the given buffers, so different voices can be mixed concurrently.
+    // Returns true when the voice has ended and must be stopped.
+    bool Soloud::mixVoice(AudioSourceInstance *voice, float *aBuffer, unsigned int aSamplesToRead, unsigned int aBufferSize, float *aScratch, float *aSeekScratch, unsigned int aSeekScratchSize, float aSamplerate, unsigned int aChannels)
     {
-        unsigned int i, j;
-        // Clear accumulation buffer
-        for (i = 0; i < aSamplesToRead; i++)
+        unsigned int j;
+        float step = voice->mSamplerate / aSamplerate;
+        // avoid step overflow
+        if (step > (1 << (32 - FIXPOINT_FRAC_BITS)))
+            step = 0;
+        unsigned int step_fixed = (int)floor(step * FIXPOINT_FRAC_MUL);
+        unsigned int outofs = 0;
+
+        if (voice->mDelaySamples)
         {
-            for (j = 0; j < aChannels; j++)
+            if (voice->mDelaySamples > aSamplesToRead)
             {
-                aBuffer[i + j * aBufferSize] = 0;
+                outofs = aSamplesToRead;
+                voice->mDelaySamples -= aSamplesToRead;
+            }
+            else
+            {
+                outofs = voice->mDelaySamples;
+                voice->mDelaySamples = 0;
+            }
+
+            // Clear scratch where we're skipping
+            for (j = 0; j < voice->mChannels; j++)
+            {
+                memset(aScratch + j * aBufferSize, 0, sizeof(float) * outofs);
             }
         }
 
-        // Accumulate sound sources
-        for (i = 0; i < mActiveVoiceCount; i++)
+        while (step_fixed != 0 && outofs < aSamplesToRead)
         {
-            AudioSourceInstance *voice = mVoice[mActiveVoice[i]];
-            if (voice &&
-                voice->mBusHandle == aBus &&
-                !(voice->mFlags & AudioSourceInstance::PAUSED) &&
-                !(voice->mFlags & AudioSourceInstance::INAUDIBLE))
+            if (voice->mLeftoverSamples == 0)
             {
-                unsigned int j;
-                float step = voice->mSamplerate / aSamplerate;
-                // avoid step overflow
-                if (step > (1 << (32 - FIXPOINT_FRAC_BITS)))
-                    step = 0;
-                unsigned int step_fixed = (int)floor(step * FIXPOINT_FRAC_MUL);
-                unsigned int outofs = 0;
-
-                if (voice->mDelaySamples)
-                {
-                    if (voice->mDelaySamples > aSamplesToRead)
-                    {
-                        outofs = aSamplesToRead;
-                        voice->mDelaySamples -= aSamplesToRead;
-                    }
-                    else
-                    {
-                        outofs = voice->mDelaySamples;
-                        voice->mDelaySamples = 0;
-                    }
+                // Swap resample buffers (ping-pong)
+                AudioSourceResampleData * t = voice->mResampleData[0];
+                voice->mResampleData[0] = voice->mResampleData[1];
+                voice->mResampleData[1] = t;
 
-                    // Clear scratch where we're skipping
-                    for (j = 0; j < voice->mChannels; j++)
-                    {
-                        memset(aScratch + j * aBufferSize, 0, sizeof(float) * outofs);
-                    }
-                }
+                // Get a block of source data
 
-                while (step_fixed != 0 && outofs < aSamplesToRead)
+                int readcount = 0;
+                if (!voice->hasEnded() || voice->mFlags & AudioSourceInstance::LOOPING)
                 {
-                    if (voice->mLeftoverSamples == 0)
+                    readcount = voice->getAudio(voice->mResampleData[0]->mBuffer, SAMPLE_GRANULARITY, SAMPLE_GRANULARITY);
+                    if (readcount < SAMPLE_GRANULARITY)
                     {
-                        // Swap resample buffers (ping-pong)
-                        AudioSourceResampleData * t = voice->mResampleData[0];
-                        voice->mResampleData[0] = voice->mResampleData[1];
-                        voice->mResampleData[1] = t;
-
-                        // Get a block of source data
-
-                        int readcount = 0;
-                        if (!voice->hasEnded() || voice->mFlags & AudioSourceInstance::LOOPING)
+                        if (voice->mFlags & AudioSourceInstance::LOOPING)
                         {
-                            readcount = voice->getAudio(voice->mResampleData[0]->mBuffer, SAMPLE_GRANULARITY, SAMPLE_GRANULARITY);
-                            if (readcount < SAMPLE_GRANULARITY)
+                            while (readcount < SAMPLE_GRANULARITY && voice->seek(voice->mLoopPoint, aSeekScratch, aSeekScratchSize) == SO_NO_ERROR)
                             {
-                                if (voice->mFlags & AudioSourceInstance::LOOPING)
-                                {
-                                    while (readcount < SAMPLE_GRANULARITY && voice->seek(voice->mLoopPoint, mScratch.mData, mScratchSize) == SO_NO_ERROR)
-                                    {
-                                        voice->mLoopCount++;
-                                        int inc = voice->getAudio(voice->mResampleData[0]->mBuffer + readcount, SAMPLE_GRANULARITY - readcount, SAMPLE_GRANULARITY);
-                                        readcount += inc;
-                                        if (inc == 0) break;
-                                    }
-                                }
+                                voice->mLoopCount++;
+                                int inc = voice->getAudio(voice->mResampleData[0]->mBuffer + readcount, SAMPLE_GRANULARITY - readcount, SAMPLE_GRANULARITY);
+                                readcount += inc;
+                                if (inc == 0) break;
                             }
                         }
+                    }
+                }
 
-                        if (readcount < SAMPLE_GRANULARITY)
-                        {
-                            unsigned int i;
-                            for (i = 0; i < voice->mChannels; i++)
-                                memset(voice->mResampleData[0]->mBuffer + readcount + SAMPLE_GRANULARITY * i, 0, sizeof(float) * (SAMPLE_GRANULARITY - readcount));
-                        }
+                if (readcount < SAMPLE_GRANULARITY)
+                {
+                    unsigned int i;
+                    for (i = 0; i < voice->mChannels; i++)
+                        memset(voice->mResampleData[0]->mBuffer + readcount + SAMPLE_GRANULARITY * i, 0, sizeof(float) * (SAMPLE_GRANULARITY - readcount));
+                }
 
-                        // If we go past zero, crop to zero (a bit of a kludge)
-                        if (voice->mSrcOffset < SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL)
-                        {
-                            voice->mSrcOffset = 0;
-                        }
-                        else
-                        {
-                            // We have new block of data, move pointer backwards
-                            voice->mSrcOffset -= SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL;
-                        }
+                // If we go past zero, crop to zero (a bit of a kludge)
+                if (voice->mSrcOffset < SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL)
+                {
+                    voice->mSrcOffset = 0;
+                }
+                else
+                {
+                    // We have new block of data, move pointer backwards
+                    voice->mSrcOffset -= SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL;
+                }
 
 
-                        // Run the per-stream filters to get our source data
+                // Run the per-stream filters to get our source data
 
-                        for (j = 0; j < FILTERS_PER_STREAM; j++)
-                        {
-                            if (voice->mFilter[j])
-                            {
-                                voice->mFilter[j]->filter(
-                                    voice->mResampleData[0]->mBuffer,
-                                    SAMPLE_GRANULARITY,
-                                    voice->mChannels,
-                                    voice->mSamplerate,
-                                    mStreamTime);
-                            }
-                        }
-                    }
-                    else
+                for (j = 0; j < FILTERS_PER_STREAM; j++)
+                {
+                    if (voice->mFilter[j])
                     {
-                        voice->mLeftoverSamples = 0;
+                        voice->mFilter[j]->filter(
+                            voice->mResampleData[0]->mBuffer,
+                            SAMPLE_GRANULARITY,
+                            voice->mChannels,
+                            voice->mSamplerate,
+                            mStreamTime);
                     }
+                }
+            }
+            else
+            {
+                voice->mLeftoverSamples = 0;
+            }
 
-                    // Figure out how many samples we can generate from this source data.
-                    // The value may be zero.
+            // Figure out how many samples we can generate from this source data.
+            // The value may be zero.
 
-                    unsigned int writesamples = 0;
+            unsigned int writesamples = 0;
 
-                    if (voice->mSrcOffset < SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL)
-                    {
-                        writesamples = ((SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL) - voice->mSrcOffset) / step_fixed + 1;
+            if (voice->mSrcOffset < SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL)
+            {
+                writesamples = ((SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL) - voice->mSrcOffset) / step_fixed + 1;
 
-                        // avoid reading past the current buffer..
-                        if (((writesamples * step_fixed + voice->mSrcOffset) >> FIXPOINT_FRAC_BITS) >= SAMPLE_GRANULARITY)
-                            writesamples--;
-                    }
+                // avoid reading past the current buffer..
+                if (((writesamples * step_fixed + voice->mSrcOffset) >> FIXPOINT_FRAC_BITS) >= SAMPLE_GRANULARITY)
+                    writesamples--;
+            }
 
 
-                    // If this is too much for our output buffer, don't write that many:
-                    if (writesamples + outofs > aSamplesToRead)
-                    {
-                        voice->mLeftoverSamples = (writesamples + outofs) - aSamplesToRead;
-                        writesamples = aSamplesToRead - outofs;
-                    }
+            // If this is too much for our output buffer, don't write that many:
+            if (writesamples + outofs > aSamplesToRead)
+            {
+                voice->mLeftoverSamples = (writesamples + outofs) - aSamplesToRead;
+                writesamples = aSamplesToRead - outofs;
+            }
 
-                    // Call resampler to generate the samples, once per channel
-                    if (writesamples)
-                    {
-                        for (j = 0; j < voice->mChannels; j++)
-                        {
-                            resample(voice->mResampleData[0]->mBuffer + SAMPLE_GRANULARITY * j,
-                                voice->mResampleData[1]->mBuffer + SAMPLE_GRANULARITY * j,
-                                     aScratch + aBufferSize * j + outofs,
-                                     voice->mSrcOffset,
-                                     writesamples,
-                                     voice->mSamplerate,
-                                     aSamplerate,
-                                     step_fixed);
-                        }
-                    }
+            // Call resampler to generate the samples, once per channel
+            if (writesamples)
+            {
+                for (j = 0; j < voice->mChannels; j++)
+                {
+                    resample(voice->mResampleData[0]->mBuffer + SAMPLE_GRANULARITY * j,
+                        voice->mResampleData[1]->mBuffer + SAMPLE_GRANULARITY * j,
+                             aScratch + aBufferSize * j + outofs,
+                             voice->mSrcOffset,
+                             writesamples,
+                             voice->mSamplerate,
+                             aSamplerate,
+                             step_fixed);
+                }
+            }
 
-                    // Keep track of how many samples we've written so far
-                    outofs += writesamples;
+            // Keep track of how many samples we've written so far
+            outofs += writesamples;
 
-                    // Move source pointer onwards (writesamples may be zero)
-                    voice->mSrcOffset += writesamples * step_fixed;
-                }
+            // Move source pointer onwards (writesamples may be zero)
+            voice->mSrcOffset += writesamples * step_fixed;
+        }
 
-                // Handle panning and channel expansion (and/or shrinking)
-                panAndExpand(voice, aBuffer, aSamplesToRead, aBufferSize, aScratch, aChannels);
+        // Handle panning and channel expansion (and/or shrinking)
+        panAndExpand(voice, aBuffer, aSamplesToRead, aBufferSize, aScratch, aChannels);
 
-                // clear voice if the sound is over
-                if (!(voice->mFlags & AudioSourceInstance::LOOPING) && voice->hasEnded())
-                {
-                    stopVoice(mActiveVoice[i]);
-                }
+        return (!(voice->mFlags & AudioSourceInstance::LOOPING) && voice->hasEnded());
+    }
+
+    // Advances an inaudible voice that must be ticked. Returns true when the voice has ended and must be stopped.
+    bool Soloud::tickVoice(AudioSourceInstance *voice, unsigned int aSamplesToRead, float *aSeekScratch, unsigned int aSeekScratchSize, float aSamplerate)
+    {
+        // Inaudible but needs ticking. Do minimal work (keep counters up to date and ask audiosource for data)
+        float step = voice->mSamplerate / aSamplerate;
+        int step_fixed = (int)floor(step * FIXPOINT_FRAC_MUL);
+        unsigned int outofs = 0;
+
+        if (voice->mDelaySamples)
+        {
+            if (voice->mDelaySamples > aSamplesToRead)
+            {
+                outofs = aSamplesToRead;
+                voice->mDelaySamples -= aSamplesToRead;
             }
             else
-                if (voice &&
-                    voice->mBusHandle == aBus &&
-                    !(voice->mFlags & AudioSourceInstance::PAUSED) &&
-                    (voice->mFlags & AudioSourceInstance::INAUDIBLE) &&
-                    (voice->mFlags & AudioSourceInstance::INAUDIBLE_TICK))
             {
-                // Inaudible but needs ticking. Do minimal work (keep counters up to date and ask audiosource for data)
-                float step = voice->mSamplerate / aSamplerate;
-                int step_fixed = (int)floor(step * FIXPOINT_FRAC_MUL);
-                unsigned int outofs = 0;
+                outofs = voice->mDelaySamples;
+                voice->mDelaySamples = 0;
+            }
+        }
 
-                if (voice->mDelaySamples)
+        while (step_fixed != 0 && outofs < aSamplesToRead)
+        {
+            if (voice->mLeftoverSamples == 0)
+            {
+                // Swap resample buffers (ping-pong)
+                AudioSourceResampleData * t = voice->mResampleData[0];
+                voice->mResampleData[0] = voice->mResampleData[1];
+                voice->mResampleData[1] = t;
+
+                // Get a block of source data
+
+                int readcount = 0;
+                if (!voice->hasEnded() || voice->mFlags & AudioSourceInstance::LOOPING)
                 {
-                    if (voice->mDelaySamples > aSamplesToRead)
-                    {
-                        outofs = aSamplesToRead;
-                        voice->mDelaySamples -= aSamplesToRead;
-                    }
-                    else
+                    readcount = voice->getAudio(voice->mResampleData[0]->mBuffer, SAMPLE_GRANULARITY, SAMPLE_GRANULARITY);
+                    if (readcount < SAMPLE_GRANULARITY)
                     {
-                        outofs = voice->mDelaySamples;
-                        voice->mDelaySamples = 0;
+                        if (voice->mFlags & AudioSourceInstance::LOOPING)
+                        {
+                            while (readcount < SAMPLE_GRANULARITY && voice->seek(voice->mLoopPoint, aSeekScratch, aSeekScratchSize) == SO_NO_ERROR)
+                            {
+                                voice->mLoopCount++;
+                                readcount += voice->getAudio(voice->mResampleData[0]->mBuffer + readcount, SAMPLE_GRANULARITY - readcount, SAMPLE_GRANULARITY);
+                            }
+                        }
                     }
                 }
 
-                while (step_fixed != 0 && outofs < aSamplesToRead)
+                // If we go past zero, crop to zero (a bit of a kludge)
+                if (voice->mSrcOffset < SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL)
                 {
-                    if (voice->mLeftoverSamples == 0)
-                    {
-                        // Swap resample buffers (ping-pong)
-                        AudioSourceResampleData * t = voice->mResampleData[0];
-                        voice->mResampleData[0] = voice->mResampleData[1];
-                        voice->mResampleData[1] = t;
+                    voice->mSrcOffset = 0;
+                }
+                else
+                {
+                    // We have new block of data, move pointer backwards
+                    voice->mSrcOffset -= SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL;
+                }
 
-                        // Get a block of source data
+                // Skip filters
+            }
+            else
+            {
+                voice->mLeftoverSamples = 0;
+            }
 
-                        int readcount = 0;
-                        if (!voice->hasEnded() || voice->mFlags & AudioSourceInstance::LOOPING)
-                        {
-                            readcount = voice->getAudio(voice->mResampleData[0]->mBuffer, SAMPLE_GRANULARITY, SAMPLE_GRANULARITY);
-                            if (readcount < SAMPLE_GRANULARITY)
-                            {
-                                if (voice->mFlags & AudioSourceInstance::LOOPING)
-                                {
-                                    while (readcount < SAMPLE_GRANULARITY && voice->seek(voice->mLoopPoint, mScratch.mData, mScratchSize) == SO_NO_ERROR)
-                                    {
-                                        voice->mLoopCount++;
-                                        readcount += voice->getAudio(voice->mResampleData[0]->mBuffer + readcount, SAMPLE_GRANULARITY - readcount, SAMPLE_GRANULARITY);
-                                    }
-                                }
-                            }
-                        }
+            // Figure out how many samples we can generate from this source data.
+            // The value may be zero.
 
-                        // If we go past zero, crop to zero (a bit of a kludge)
-                        if (voice->mSrcOffset < SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL)
-                        {
-                            voice->mSrcOffset = 0;
-                        }
-                        else
-                        {
-                            // We have new block of data, move pointer backwards
-                            voice->mSrcOffset -= SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL;
-                        }
+            unsigned int writesamples = 0;
 
-                        // Skip filters
-                    }
-                    else
-                    {
-                        voice->mLeftoverSamples = 0;
-                    }
+            if (voice->mSrcOffset < SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL)
+            {
+                writesamples = ((SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL) - voice->mSrcOffset) / step_fixed + 1;
 
-                    // Figure out how many samples we can generate from this source data.
-                    // The value may be zero.
+                // avoid reading past the current buffer..
+                if (((writesamples * step_fixed + voice->mSrcOffset) >> FIXPOINT_FRAC_BITS) >= SAMPLE_GRANULARITY)
+                    writesamples--;
+            }
 
-                    unsigned int writesamples = 0;
 
-                    if (voice->mSrcOffset < SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL)
-                    {
-                        writesamples = ((SAMPLE_GRANULARITY * FIXPOINT_FRAC_MUL) - voice->mSrcOffset) / step_fixed + 1;
+            // If this is too much for our output buffer, don't write that many:
+            if (writesamples + outofs > aSamplesToRead)
+            {
+                voice->mLeftoverSamples = (writesamples + outofs) - aSamplesToRead;
+                writesamples = aSamplesToRead - outofs;
+            }
 
-                        // avoid reading past the current buffer..
-                        if (((writesamples * step_fixed + voice->mSrcOffset) >> FIXPOINT_FRAC_BITS) >= SAMPLE_GRANULARITY)
-                            writesamples--;
-                    }
+            // Skip resampler
 
+            // Keep track of how many samples we've written so far
+            outofs += writesamples;
 
-                    // If this is too much for our output buffer, don't write that many:
-                    if (writesamples + outofs > aSamplesToRead)
-                    {
-                        voice->mLeftoverSamples = (writesamples + outofs) - aSamplesToRead;
-                        writesamples = aSamplesToRead - outofs;
-                    }
+            // Move source pointer onwards (writesamples may be zero)
+            voice->mSrcOffset += writesamples * step_fixed;
+        }
 
-                    // Skip resampler
+        return (!(voice->mFlags & AudioSourceInstance::LOOPING) && voice->hasEnded());
+    }
 
-                    // Keep track of how many samples we've written so far
-                    outofs += writesamples;
+    void Soloud::mixBus(float *aBuffer, unsigned int aSamplesToRead, unsigned int aBufferSize, float *aScratch, unsigned int aBus, float aSamplerate, unsigned int aChannels)
+    {
+        unsigned int i, j;
+        // Clear accumulation buffer
+        for (i = 0; i < aSamplesToRead; i++)
+        {
+            for (j = 0; j < aChannels; j++)
+            {
+                aBuffer[i + j * aBufferSize] = 0;
+            }
+        }
 
-                    // Move source pointer onwards (writesamples may be zero)
-                    voice->mSrcOffset += writesamples * step_fixed;
+        // Accumulate sound sources
+        for (i = 0; i < mActiveVoiceCount; i++)
+        {
+            AudioSourceInstance *voice = mVoice[mActiveVoice[i]];
+            if (voice &&
+                voice->mBusHandle == aBus &&
+                !(voice->mFlags & AudioSourceInstance::PAUSED) &&
+                !(voice->mFlags & AudioSourceInstance::INAUDIBLE))
+            {
+                // clear voice if the sound is over
+                if (mixVoice(voice, aBuffer, aSamplesToRead, aBufferSize, aScratch, mScratch.mData, mScratchSize, aSamplerate, aChannels))
+                {
+                    stopVoice(mActiveVoice[i]);
                 }
-
+            }
+            else
+                if (voice &&
+                    voice->mBusHandle == aBus &&
+                    !(voice->mFlags & AudioSourceInstance::PAUSED) &&
+                    (voice->mFlags & AudioSourceInstance::INAUDIBLE) &&
+                    (voice->mFlags & AudioSourceInstance::INAUDIBLE_TICK))
+            {
                 // clear voice if the sound is over
-                if (!(voice->mFlags & AudioSourceInstance::LOOPING) && voice->hasEnded())
+                if (tickVoice(voice, aSamplesToRead, mScratch.mData, mScratchSize, aSamplerate))
                 {
                     stopVoice(mActiveVoice[i]);
                 }
@@ -2579,6 +2646,108 @@ namespace SoLoud
         }
     }
 
+#ifdef IMGUISOLOUD_HAS_MIX_THREADS
+    struct SoloudMixChunksData
+    {
+        Soloud *mSoloud;
+        unsigned int mSamples;
+    };
+    static void SoloudMixChunks(int start, int end, void *userPtr)
+    {
+        SoloudMixChunksData *data = (SoloudMixChunksData *)userPtr;
+        for (int c = start; c < end; c++)
+        {
+            data->mSoloud->mixVoiceChunk(c, data->mSamples);
+        }
+    }
+#endif //IMGUISOLOUD_HAS_MIX_THREADS
+
+    void Soloud::mixVoiceChunk(unsigned int aChunk, unsigned int aSamples)
+    {
+        float *buffer = mMixChunkBuffer.mData + aChunk * mMixChunkSize;
+        float *scratch = buffer + ((aSamples * mChannels + 3) & ~3);
+        memset(buffer, 0, sizeof(float) * aSamples * mChannels);
+
+        unsigned int i = aChunk * IMGUISOLOUD_MIX_VOICES_PER_CHUNK;
+        unsigned int end = i + IMGUISOLOUD_MIX_VOICES_PER_CHUNK;
+        if (end > mActiveVoiceCount) end = mActiveVoiceCount;
+        for (; i < end; i++)
+        {
+            bool ended = false;
+            AudioSourceInstance *voice = mVoice[mActiveVoice[i]];
+            if (voice && voice->mBusHandle == 0 && !(voice->mFlags & AudioSourceInstance::PAUSED))
+            {
+                // Same as mixBus(...), but the chunk scratch buffer replaces mScratch
+                if (!(voice->mFlags & AudioSourceInstance::INAUDIBLE))
+                    ended = mixVoice(voice, buffer, aSamples, aSamples, scratch, scratch, mScratchSize, (float)mSamplerate, mChannels);
+                else if (voice->mFlags & AudioSourceInstance::INAUDIBLE_TICK)
+                    ended = tickVoice(voice, aSamples, scratch, mScratchSize, (float)mSamplerate);
+            }
+            mMixVoiceEnded[i] = ended ? 1 : 0;
+        }
+    }
+
+    void Soloud::mixMainBus(unsigned int aSamples)
+    {
+#ifdef IMGUISOLOUD_HAS_MIX_THREADS
+        unsigned int i;
+        unsigned int numChunks = (mActiveVoiceCount + IMGUISOLOUD_MIX_VOICES_PER_CHUNK - 1) / IMGUISOLOUD_MIX_VOICES_PER_CHUNK;
+        bool canMixInParallel = (mMixThreadPool != NULL && numChunks > 1);
+        // A bus mixes (and stops) the voices routed to it from inside its getAudio(), so it can't run concurrently with other voices
+        for (i = 0; canMixInParallel && i < mActiveVoiceCount; i++)
+        {
+            AudioSourceInstance *voice = mVoice[mActiveVoice[i]];
+            if (voice && (voice->mFlags & AudioSourceInstance::BUS))
+                canMixInParallel = false;
+        }
+        if (canMixInParallel)
+        {
+            // Resize the chunk buffers if needed (both parts are rounded up to multiples of 4 floats to keep every chunk SSE aligned)
+            mMixChunkSize = ((aSamples * mChannels + 3) & ~3) + ((mScratchSize * MAX_CHANNELS + 3) & ~3);
+            if (mMixChunkBufferSize < numChunks * mMixChunkSize)
+            {
+                mMixChunkBufferSize = numChunks * mMixChunkSize;
+                mMixChunkBuffer.init(mMixChunkBufferSize);
+            }
+
+            // Mix each group of voices into its own buffer (the audio thread takes part too)
+            SoloudMixChunksData data;
+            data.mSoloud = this;
+            data.mSamples = aSamples;
+            ((ImGuiHelper::ThreadPool *)mMixThreadPool)->parallelFor(0, (int)numChunks, &SoloudMixChunks, &data, 1);
+
+            // Sum the chunk buffers, always in the same order, so that the result does not depend on the scheduling
+            float *dst = mOutputScratch.mData;
+            const unsigned int numFloats = aSamples * mChannels;
+            memcpy(dst, mMixChunkBuffer.mData, sizeof(float) * numFloats);
+            for (unsigned int c = 1; c < numChunks; c++)
+            {
+                const float *src = mMixChunkBuffer.mData + c * mMixChunkSize;
+                unsigned int j = 0;
+#ifdef SOLOUD_SSE_INTRINSICS
+                for (; j + 4 <= numFloats; j += 4)
+                {
+                    _mm_store_ps(dst + j, _mm_add_ps(_mm_load_ps(dst + j), _mm_load_ps(src + j)));
+                }
+#endif //SOLOUD_SSE_INTRINSICS
+                for (; j < numFloats; j++)
+                {
+                    dst[j] += src[j];
+                }
+            }
+
+            // Stop the ended voices afterwards, in order
+            for (i = 0; i < mActiveVoiceCount; i++)
+            {
+                if (mMixVoiceEnded[i])
+                    stopVoice(mActiveVoice[i]);
+            }
+            return;
+        }
+#endif //IMGUISOLOUD_HAS_MIX_THREADS
+        mixBus(mOutputScratch.mData, aSamples, aSamples, mScratch.mData, 0, (float)mSamplerate, mChannels);
+    }
+
     void Soloud::calcActiveVoices()
     {
         // TODO: consider whether we need to re-evaluate the active voices all the time.
@@ -2770,7 +2939,7 @@ namespace SoLoud
             mScratch.init(mScratchSize * MAX_CHANNELS);
         }
 
-        mixBus(mOutputScratch.mData, aSamples, aSamples, mScratch.mData, 0, (float)mSamplerate, mChannels);
+        mixMainBus(aSamples);
 
         for (i = 0; i < FILTERS_PER_STREAM; i++)
         {
@@ -2879,6 +3048,8 @@ namespace SoLoud
         }
         SOLOUD_ASSERT(!mInsideAudioThreadMutex);
         mInsideAudioThreadMutex = true;
+        // Deferred commands are applied by whoever takes the mutex first (usually the mixer)
+        applyCommands();
     }
 
     void Soloud::unlockAudioMutex()
@@ -3225,7 +3396,7 @@ namespace SoLoud
     {
         mParent = aParent;
         mScratchSize = 0;
-        mFlags |= PROTECTED | INAUDIBLE_TICK;
+        mFlags |= PROTECTED | INAUDIBLE_TICK | BUS;
     }
 
     unsigned int BusInstance::getAudio(float *aBuffer, unsigned int aSamplesToRead, unsigned int aBufferSize)
@@ -4200,9 +4371,10 @@ namespace SoLoud
 
 	void Soloud::stop(handle aVoiceHandle)
 	{
-		FOR_ALL_VOICES_PRE
-			stopVoice(ch);
-		FOR_ALL_VOICES_POST
+		VoiceCommand c;
+		c.mType = VOICE_STOP;
+		c.mVoiceHandle = aVoiceHandle;
+		postOrApplyCommand(c);
 	}
 
 	void Soloud::stopAudioSource(AudioSource &aSound)
@@ -4848,12 +5020,11 @@ namespace SoLoud
 
 	result Soloud::setRelativePlaySpeed(handle aVoiceHandle, float aSpeed)
 	{
-		result retVal = 0;
-		FOR_ALL_VOICES_PRE
-			mVoice[ch]->mRelativePlaySpeedFader.mActive = 0;
-			retVal = setVoiceRelativePlaySpeed(ch, aSpeed);
-			FOR_ALL_VOICES_POST
-		return retVal;
+		VoiceCommand c;
+		c.mType = VOICE_SET_RELATIVE_PLAY_SPEED;
+		c.mVoiceHandle = aVoiceHandle;
+		c.mParam[0] = aSpeed;
+		return postOrApplyCommand(c);
 	}
 
 	void Soloud::setSamplerate(handle aVoiceHandle, float aSamplerate)
@@ -4866,9 +5037,11 @@ namespace SoLoud
 
 	void Soloud::setPause(handle aVoiceHandle, bool aPause)
 	{
-		FOR_ALL_VOICES_PRE
-			setVoicePause(ch, aPause);
-		FOR_ALL_VOICES_POST
+		VoiceCommand c;
+		c.mType = VOICE_SET_PAUSE;
+		c.mVoiceHandle = aVoiceHandle;
+		c.mParam[0] = aPause ? 1.0f : 0.0f;
+		postOrApplyCommand(c);
 	}
 
 	result Soloud::setMaxActiveVoiceCount(unsigned int aVoiceCount)
@@ -4881,6 +5054,40 @@ namespace SoLoud
 		return SO_NO_ERROR;
 	}
 
+	void Soloud::setMixThreadCount(int aThreadCount)
+	{
+#ifdef IMGUISOLOUD_HAS_MIX_THREADS
+		if (aThreadCount < 0)
+			aThreadCount = ImGuiHelper::GetNumHardwareThreads() - 1;
+		if (aThreadCount == mMixThreadCount)
+			return;
+		// The pool is created outside the audio mutex, and swapped inside it
+		ImGuiHelper::ThreadPool *pool = NULL;
+		if (aThreadCount > 0)
+		{
+			pool = (ImGuiHelper::ThreadPool *) ImGui::MemAlloc(sizeof(ImGuiHelper::ThreadPool));
+			IM_PLACEMENT_NEW(pool) ImGuiHelper::ThreadPool(aThreadCount);
+		}
+		lockAudioMutex();
+		ImGuiHelper::ThreadPool *oldPool = (ImGuiHelper::ThreadPool *) mMixThreadPool;
+		mMixThreadPool = pool;
+		mMixThreadCount = aThreadCount;
+		unlockAudioMutex();
+		if (oldPool)
+		{
+			oldPool->~ThreadPool();
+			ImGui::MemFree(oldPool);
+		}
+#else //IMGUISOLOUD_HAS_MIX_THREADS
+		(void)aThreadCount;
+#endif //IMGUISOLOUD_HAS_MIX_THREADS
+	}
+
+	int Soloud::getMixThreadCount() const
+	{
+		return mMixThreadCount;
+	}
+
 	void Soloud::setPauseAll(bool aPause)
 	{
 		lockAudioMutex();
@@ -4908,30 +5115,25 @@ namespace SoLoud
 
 	void Soloud::setPan(handle aVoiceHandle, float aPan)
 	{		
-		FOR_ALL_VOICES_PRE
-			setVoicePan(ch, aPan);
-		FOR_ALL_VOICES_POST
+		VoiceCommand c;
+		c.mType = VOICE_SET_PAN;
+		c.mVoiceHandle = aVoiceHandle;
+		c.mParam[0] = aPan;
+		postOrApplyCommand(c);
 	}
 
 	void Soloud::setPanAbsolute(handle aVoiceHandle, float aLVolume, float aRVolume, float aLBVolume, float aRBVolume, float aCVolume, float aSVolume)
 	{
-		FOR_ALL_VOICES_PRE
-			mVoice[ch]->mPanFader.mActive = 0;	
-			mVoice[ch]->mChannelVolume[0] = aLVolume;			
-			mVoice[ch]->mChannelVolume[1] = aRVolume;
-			if (mVoice[ch]->mChannels == 4)
-			{
-				mVoice[ch]->mChannelVolume[2] = aLBVolume;
-				mVoice[ch]->mChannelVolume[3] = aRBVolume;
-			}
-			if (mVoice[ch]->mChannels == 6)
-			{
-				mVoice[ch]->mChannelVolume[2] = aCVolume;
-				mVoice[ch]->mChannelVolume[3] = aSVolume;
-				mVoice[ch]->mChannelVolume[4] = aLBVolume;
-				mVoice[ch]->mChannelVolume[5] = aRBVolume;
-			}
-		FOR_ALL_VOICES_POST
+		VoiceCommand c;
+		c.mType = VOICE_SET_PAN_ABSOLUTE;
+		c.mVoiceHandle = aVoiceHandle;
+		c.mParam[0] = aLVolume;
+		c.mParam[1] = aRVolume;
+		c.mParam[2] = aLBVolume;
+		c.mParam[3] = aRBVolume;
+		c.mParam[4] = aCVolume;
+		c.mParam[5] = aSVolume;
+		postOrApplyCommand(c);
 	}
 
 	void Soloud::setInaudibleBehavior(handle aVoiceHandle, bool aMustTick, bool aKill)
@@ -4951,25 +5153,127 @@ namespace SoLoud
 
 	void Soloud::setLooping(handle aVoiceHandle, bool aLooping)
 	{
-		FOR_ALL_VOICES_PRE
-			if (aLooping)
-			{
-				mVoice[ch]->mFlags |= AudioSourceInstance::LOOPING;
-			}
-			else
-			{
-				mVoice[ch]->mFlags &= ~AudioSourceInstance::LOOPING;
-			}
-		FOR_ALL_VOICES_POST
+		VoiceCommand c;
+		c.mType = VOICE_SET_LOOPING;
+		c.mVoiceHandle = aVoiceHandle;
+		c.mParam[0] = aLooping ? 1.0f : 0.0f;
+		postOrApplyCommand(c);
 	}
 
 
 	void Soloud::setVolume(handle aVoiceHandle, float aVolume)
 	{
-		FOR_ALL_VOICES_PRE
-			mVoice[ch]->mVolumeFader.mActive = 0;
-			setVoiceVolume(ch, aVolume);
-		FOR_ALL_VOICES_POST
+		VoiceCommand c;
+		c.mType = VOICE_SET_VOLUME;
+		c.mVoiceHandle = aVoiceHandle;
+		c.mParam[0] = aVolume;
+		postOrApplyCommand(c);
+	}
+
+	bool Soloud::postCommand(const VoiceCommand &aCommand)
+	{
+#ifdef IMGUISOLOUD_HAS_THREADS
+		if (!mCommandQueue)
+			return false;
+		// Only this (producer) thread writes mCommandQueueTail
+		int tail = mCommandQueueTail;
+		int next = (tail + 1) % mCommandQueueSize;
+		if (next == ImGuiHelper::AtomicLoad(&mCommandQueueHead))
+			return false;	// Full
+		mCommandQueue[tail] = aCommand;
+		ImGuiHelper::AtomicStore(&mCommandQueueTail, next);	// Publishes the command
+		return true;
+#else //IMGUISOLOUD_HAS_THREADS
+		(void)aCommand;
+		return false;
+#endif //IMGUISOLOUD_HAS_THREADS
+	}
+
+	void Soloud::applyCommands()
+	{
+#ifdef IMGUISOLOUD_HAS_THREADS
+		if (!mCommandQueue)
+			return;
+		// The consumers are serialized by the audio mutex
+		int head = mCommandQueueHead;
+		int tail = ImGuiHelper::AtomicLoad(&mCommandQueueTail);
+		while (head != tail)
+		{
+			applyCommand(mCommandQueue[head]);
+			head = (head + 1) % mCommandQueueSize;
+		}
+		ImGuiHelper::AtomicStore(&mCommandQueueHead, head);	// Frees the slots
+#endif //IMGUISOLOUD_HAS_THREADS
+	}
+
+	result Soloud::postOrApplyCommand(const VoiceCommand &aCommand)
+	{
+		if (aCommand.mType == VOICE_SET_RELATIVE_PLAY_SPEED && aCommand.mParam[0] <= 0.0f)
+			return INVALID_PARAMETER;
+		if (postCommand(aCommand))
+			return SO_NO_ERROR;
+		// lockAudioMutex() applies the queued commands first, so the order is preserved
+		lockAudioMutex();
+		result res = applyCommand(aCommand);
+		unlockAudioMutex();
+		return res;
+	}
+
+	result Soloud::applyCommand(const VoiceCommand &aCommand)
+	{
+		result retVal = 0;
+		handle aVoiceHandle = aCommand.mVoiceHandle;
+		const float *p = aCommand.mParam;
+		FOR_ALL_VOICES_PRE_LOCKED
+			switch (aCommand.mType)
+			{
+			case VOICE_STOP:
+				stopVoice(ch);
+				break;
+			case VOICE_SET_PAUSE:
+				setVoicePause(ch, p[0] != 0.0f);
+				break;
+			case VOICE_SET_VOLUME:
+				mVoice[ch]->mVolumeFader.mActive = 0;
+				setVoiceVolume(ch, p[0]);
+				break;
+			case VOICE_SET_PAN:
+				setVoicePan(ch, p[0]);
+				break;
+			case VOICE_SET_PAN_ABSOLUTE:
+				mVoice[ch]->mPanFader.mActive = 0;	
+				mVoice[ch]->mChannelVolume[0] = p[0];			
+				mVoice[ch]->mChannelVolume[1] = p[1];
+				if (mVoice[ch]->mChannels == 4)
+				{
+					mVoice[ch]->mChannelVolume[2] = p[2];
+					mVoice[ch]->mChannelVolume[3] = p[3];
+				}
+				if (mVoice[ch]->mChannels == 6)
+				{
+					mVoice[ch]->mChannelVolume[2] = p[4];
+					mVoice[ch]->mChannelVolume[3] = p[5];
+					mVoice[ch]->mChannelVolume[4] = p[2];
+					mVoice[ch]->mChannelVolume[5] = p[3];
+				}
+				break;
+			case VOICE_SET_RELATIVE_PLAY_SPEED:
+				mVoice[ch]->mRelativePlaySpeedFader.mActive = 0;
+				retVal = setVoiceRelativePlaySpeed(ch, p[0]);
+				break;
+			case VOICE_SET_LOOPING:
+				if (p[0] != 0.0f)
+				{
+					mVoice[ch]->mFlags |= AudioSourceInstance::LOOPING;
+				}
+				else
+				{
+					mVoice[ch]->mFlags &= ~AudioSourceInstance::LOOPING;
+				}
+				break;
+			}
+		FOR_ALL_VOICES_POST_LOCKED
+		return retVal;
 	}
 
 	void Soloud::setDelaySamples(handle aVoiceHandle, unsigned int aSamples)
@@ -96,6 +96,18 @@ The TED / SID support is based on tedplay (c) 2012 Attila Grosz, used under Unli
 
 // BUGS: there's a memory leak on Linux when using pthreads (so that WITH_SDL2 is good, but WITH_OPENAL leaks).
 
+// MULTI-THREADED MIXING: when imguihelper is available with its threads, the voices of the main bus are split into fixed
+// groups of IMGUISOLOUD_MIX_VOICES_PER_CHUNK voices (default: 8), that are mixed in parallel into separate buffers and then summed in order.
+// So the output does not depend on the number of threads (see Soloud::setMixThreadCount(...)). Playing a Bus disables it.
+// Define NO_IMGUISOLOUD_MIX_THREADS to remove it.
+
+// DEFERRED COMMANDS: when Soloud is initialized with the Soloud::DEFERRED_COMMANDS flag (and imguihelper threads are available),
+// stop(), setPause(), setVolume(), setPan(), setPanAbsolute(), setRelativePlaySpeed() and setLooping() don't take the audio mutex:
+// they are pushed into a single-producer/single-consumer lock-free ring (of IMGUISOLOUD_COMMAND_QUEUE_SIZE commands, default: 1024),
+// that is drained (in order) at the start of the next mix(), or as soon as any other call takes the audio mutex
+// (so the getters always see the effect of the previous setters). They fall back to the mutex when the ring is full.
+// Since the ring has a single producer, these setters must always be called from the same thread (e.g. the UI thread).
+
 /*
 // If no backend is defined, use WITH_SDL2_STATIC (however when used inside imguiaddons this is overridden. See addons/imgui_user.h).
 #if (!defined(WITH_SDL) && !defined(WITH_SDL_STATIC) && !defined(WITH_SDL2) && !defined(WITH_SDL2_STATIC) && !defined(WITH_PORTAUDIO)  && !defined(WITH_OPENAL) && !defined(WITH_XAUDIO2) && !defined(WITH_WINMM)  && !defined(WITH_WASAPI) && !defined(WITH_OSS) && !defined(WITH_ALSA) && !defined(WITH_NULLDRIVER))
@@ -402,7 +414,9 @@ namespace SoLoud
 			// If inaudible, should be killed (default = don't kill kill)
 			INAUDIBLE_KILL = 64,
 			// If inaudible, should still be ticked (default = pause)
-			INAUDIBLE_TICK = 128
+			INAUDIBLE_TICK = 128,
+			// This audio instance is a bus (it mixes other voices in its getAudio())
+			BUS = 256
 		};
 		// Ctor
 		AudioSourceInstance();
@@ -715,7 +729,9 @@ namespace SoLoud
 			// Use round-off clipper
 			CLIP_ROUNDOFF = 1,
 			ENABLE_VISUALIZATION = 2,
-			LEFT_HANDED_3D = 4
+			LEFT_HANDED_3D = 4,
+			// Queue the most common voice setters instead of locking the audio mutex (see the DEFERRED COMMANDS note at the top of this file)
+			DEFERRED_COMMANDS = 8
 		};
 
 		// Initialize SoLoud. Must be called before SoLoud can be used.
@@ -815,6 +831,11 @@ namespace SoLoud
 		void setLooping(handle aVoiceHandle, bool aLooping);
 		// Set current maximum active voice setting
 		result setMaxActiveVoiceCount(unsigned int aVoiceCount);
+		// Set the number of worker threads that help the audio thread mixing the voices: 0 = single-threaded mixing,
+		// < 0 = one less than the hardware threads (default). It does nothing if multi-threaded mixing is not available.
+		void setMixThreadCount(int aThreadCount);
+		// Get the number of worker threads used for mixing (0 = single-threaded mixing, < 0 = automatic, until the back-end is initialized)
+		int getMixThreadCount() const;
 		// Set behavior for inaudible sounds
 		void setInaudibleBehavior(handle aVoiceHandle, bool aMustTick, bool aKill);
 		// Set the global volume
@@ -939,6 +960,60 @@ namespace SoLoud
 		void calcActiveVoices();
 		// Perform mixing for a specific bus
         void mixBus(float *aBuffer, unsigned int aSamplesToRead, unsigned int aBufferSize, float *aScratch, unsigned int aBus, float aSamplerate, unsigned int aChannels);
+        // Mix a single audible voice into aBuffer. Returns true if the voice has ended.
+        bool mixVoice(AudioSourceInstance *aVoice, float *aBuffer, unsigned int aSamplesToRead, unsigned int aBufferSize, float *aScratch, float *aSeekScratch, unsigned int aSeekScratchSize, float aSamplerate, unsigned int aChannels);
+        // Tick a single inaudible voice. Returns true if the voice has ended.
+        bool tickVoice(AudioSourceInstance *aVoice, unsigned int aSamplesToRead, float *aSeekScratch, unsigned int aSeekScratchSize, float aSamplerate);
+        // Perform mixing for the main bus into mOutputScratch (in parallel when possible)
+        void mixMainBus(unsigned int aSamples);
+        // Mix the voices of a group of mixMainBus() into its own buffer
+        void mixVoiceChunk(unsigned int aChunk, unsigned int aSamples);
+        // Number of mixing worker threads (see setMixThreadCount())
+        int mMixThreadCount;
+        // Thread pool used for mixing (an ImGuiHelper::ThreadPool, or NULL)
+        void *mMixThreadPool;
+        // Accumulation and scratch buffers of the voice groups mixed in parallel
+        AlignedFloatBuffer mMixChunkBuffer;
+        // Current size of mMixChunkBuffer, in floats
+        unsigned int mMixChunkBufferSize;
+        // Size of the buffers of a single voice group, in floats (the accumulation buffer comes first)
+        unsigned int mMixChunkSize;
+        // Ended flags of the active voices mixed in parallel (so that they're stopped afterwards, in order)
+        unsigned char mMixVoiceEnded[VOICE_COUNT];
+
+        // Voice commands that can be deferred (see DEFERRED_COMMANDS)
+        enum VOICE_COMMANDS
+        {
+            VOICE_STOP = 0,
+            VOICE_SET_PAUSE,
+            VOICE_SET_VOLUME,
+            VOICE_SET_PAN,
+            VOICE_SET_PAN_ABSOLUTE,
+            VOICE_SET_RELATIVE_PLAY_SPEED,
+            VOICE_SET_LOOPING
+        };
+        struct VoiceCommand
+        {
+            unsigned int mType;
+            handle mVoiceHandle;
+            float mParam[6];
+        };
+        // Lock-free ring of deferred commands (NULL if DEFERRED_COMMANDS is not used)
+        VoiceCommand *mCommandQueue;
+        // Number of slots in mCommandQueue
+        int mCommandQueueSize;
+        // Next slot to read (written by the audio mutex owner only)
+        volatile int mCommandQueueHead;
+        // Next slot to write (written by the producer thread only)
+        volatile int mCommandQueueTail;
+        // Push a command into mCommandQueue. Returns false if the command must be applied directly (no queue, or full queue).
+        bool postCommand(const VoiceCommand &aCommand);
+        // Apply a command (audio mutex must be locked)
+        result applyCommand(const VoiceCommand &aCommand);
+        // Apply all the commands in mCommandQueue (audio mutex must be locked)
+        void applyCommands();
+        // Post a command, or apply it directly under the audio mutex
+        result postOrApplyCommand(const VoiceCommand &aCommand);
         // Max. number of active voices. Busses and tickable inaudibles also count against this.
 		unsigned int mMaxActiveVoices;
 		// Highest voice in use so far
@@ -1,351 +1,433 @@
-/* 
- CppSQLite was originally developed by Rob Groves on CodeProject:
- <http://www.codeproject.com/KB/database/CppSQLite.aspx>
- 
- Maintenance and updates are Copyright (C) 2011 NeoSmart Technologies
- <http://neosmart.net/>
- 
- Original copyright information:
- Copyright (C) 2004 Rob Groves. All Rights Reserved.
- <rob.groves@btinternet.com>
- 
- Permission to use, copy, modify, and distribute this software and its
- documentation for any purpose, without fee, and without a written
- agreement, is hereby granted, provided that the above copyright notice, 
- this paragraph and the following two paragraphs appear in all copies, 
- modifications, and distributions.
-
- IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT,
- INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST
- PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
- EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-
- THE AUTHOR SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT
- LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
- PARTICULAR PURPOSE. THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF
- ANY, PROVIDED HEREUNDER IS PROVIDED "AS IS". THE AUTHOR HAS NO OBLIGATION
- TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
-*/
-////////////////////////////////////////////////////////////////////////////////
-// Modifications to the original CppSQLite3 library:
-// -> added CppSQLite3 namespace
-// -> removed prefix "CppSQLite3" to all classes
-// -> removed #include <sqlite3.h> from the .h file
-////////////////////////////////////////////////////////////////////////////////
-// USAGE:
-// -> needs -lsqlite3
-// -> or the "plain C" amalgamated file "sqlite.c" compiled with a "plain C"
-//    compiler linked to the executable. (Not included because it's too big)
-////////////////////////////////////////////////////////////////////////////////
-#ifndef CppSQLite3_H
-#define CppSQLite3_H
-#define IMGUISQLITE3_H_
-
-/*#ifndef IMGUI_API
-#include <imgui.h>
-#endif //IMGUI_API*/
-
-// Define attributes of all API symbols declarations, e.g. for DLL under Windows.
-#ifndef IMGUI_API
-#define IMGUI_API
-#endif
-
-
-//#include <sqlite3.h>	// see if we can remove it
-// Attempt to move "sqlite3.h" to imguisqlite3.cpp:----
-struct sqlite3;
-struct sqlite3_stmt;
-#ifndef SQLITE_INT64_TYPE
-#if defined(_MSC_VER) || defined(__BORLANDC__)
-  #define SQLITE_INT64_TYPE __int64
-#else
-  #define SQLITE_INT64_TYPE long long int
-#endif
-#endif //SQLITE_INT64_TYPE
-typedef SQLITE_INT64_TYPE sqlite_int64;
-typedef unsigned SQLITE_INT64_TYPE sqlite_uint64;
-typedef sqlite_int64 sqlite3_int64;
-typedef sqlite_uint64 sqlite3_uint64;
-// End Attempt ------------------------------------------
-
-
-#define CPPSQLITE_ERROR 1000
-
-namespace CppSQLite3 {
-
-class Exception
-{
-public:
-
-    IMGUI_API Exception(const int nErrCode,
-                    const char* szErrMess,
-                    bool bDeleteMsg=true);
-
-    IMGUI_API Exception(const Exception&  e);
-
-    IMGUI_API virtual ~Exception();
-
-    int errorCode() const { return mnErrCode; }
-
-    const char* errorMessage() const { return mpszErrMess; }
-
-    static const char* errorCodeAsString(int nErrCode);
-
-private:
-
-    int mnErrCode;
-    char* mpszErrMess;
-};
-
-
-class Buffer
-{
-public:
-
-    IMGUI_API Buffer();
-
-    IMGUI_API ~Buffer();
-
-    IMGUI_API const char* format(const char* szFormat, ...);
-
-    operator const char*() const { return mpBuf; }
-
-    IMGUI_API void clear();
-
-private:
-
-    char* mpBuf;
-};
-
-
-class Binary
-{
-public:
-
-    IMGUI_API Binary();
-
-    IMGUI_API ~Binary();
-
-    IMGUI_API void setBinary(const unsigned char* pBuf, int nLen);
-    IMGUI_API void setEncoded(const unsigned char* pBuf);
-
-    IMGUI_API const unsigned char* getEncoded();
-    IMGUI_API const unsigned char* getBinary();
-
-    IMGUI_API int getBinaryLength();
-
-    IMGUI_API unsigned char* allocBuffer(int nLen);
-
-    IMGUI_API void clear();
-
-private:
-
-    unsigned char* mpBuf;
-    int mnBinaryLen;
-    int mnBufferLen;
-    int mnEncodedLen;
-    bool mbEncoded;
-};
-
-
-class Query
-{
-public:
-
-    IMGUI_API Query();
-
-    IMGUI_API Query(const Query& rQuery);
-
-    IMGUI_API Query(sqlite3* pDB,
-                sqlite3_stmt* pVM,
-                bool bEof,
-                bool bOwnVM=true);
-
-    IMGUI_API Query& operator=(const Query& rQuery);
-
-    IMGUI_API virtual ~Query();
-
-    IMGUI_API int numFields() const;
-
-    IMGUI_API int fieldIndex(const char* szField) const;
-    IMGUI_API const char* fieldName(int nCol) const;
-
-    IMGUI_API const char* fieldDeclType(int nCol) const;
-    IMGUI_API int fieldDataType(int nCol) const;
-
-    IMGUI_API const char* fieldValue(int nField) const;
-    IMGUI_API const char* fieldValue(const char* szField) const;
-
-    IMGUI_API int getIntField(int nField, int nNullValue=0) const;
-    IMGUI_API int getIntField(const char* szField, int nNullValue=0) const;
-
-    IMGUI_API long long getInt64Field(int nField, long long nNullValue=0) const;
-    IMGUI_API long long getInt64Field(const char* szField, long long nNullValue=0) const;
-
-    IMGUI_API double getFloatField(int nField, double fNullValue=0.0) const;
-    IMGUI_API double getFloatField(const char* szField, double fNullValue=0.0) const;
-
-    IMGUI_API const char* getStringField(int nField, const char* szNullValue="") const;
-    IMGUI_API const char* getStringField(const char* szField, const char* szNullValue="") const;
-
-    IMGUI_API const unsigned char* getBlobField(int nField, int& nLen) const;
-    IMGUI_API const unsigned char* getBlobField(const char* szField, int& nLen) const;
-
-    IMGUI_API bool fieldIsNull(int nField) const;
-    IMGUI_API bool fieldIsNull(const char* szField) const;
-
-    IMGUI_API bool eof() const;
-
-    IMGUI_API void nextRow();
-
-    IMGUI_API void finalize();
-
-private:
-
-    void checkVM() const;
-
-    sqlite3* mpDB;
-    sqlite3_stmt* mpVM;
-    bool mbEof;
-    int mnCols;
-    bool mbOwnVM;
-};
-
-
-class Table
-{
-public:
-
-    IMGUI_API Table();
-
-    IMGUI_API Table(const Table& rTable);
-
-    IMGUI_API Table(char** paszResults, int nRows, int nCols);
-
-    IMGUI_API virtual ~Table();
-
-    IMGUI_API Table& operator=(const Table& rTable);
-
-    IMGUI_API int numFields() const;
-
-    IMGUI_API int numRows() const;
-
-    IMGUI_API const char* fieldName(int nCol) const;
-
-    IMGUI_API const char* fieldValue(int nField) const;
-    IMGUI_API const char* fieldValue(const char* szField) const;
-
-    IMGUI_API int getIntField(int nField, int nNullValue=0) const;
-    IMGUI_API int getIntField(const char* szField, int nNullValue=0) const;
-
-    IMGUI_API double getFloatField(int nField, double fNullValue=0.0) const;
-    IMGUI_API double getFloatField(const char* szField, double fNullValue=0.0) const;
-
-    IMGUI_API const char* getStringField(int nField, const char* szNullValue="") const;
-    IMGUI_API const char* getStringField(const char* szField, const char* szNullValue="") const;
-
-    IMGUI_API bool fieldIsNull(int nField) const;
-    IMGUI_API bool fieldIsNull(const char* szField) const;
-
-    IMGUI_API void setRow(int nRow);
-
-    IMGUI_API void finalize();
-
-private:
-
-    void checkResults() const;
-
-    int mnCols;
-    int mnRows;
-    int mnCurrentRow;
-    char** mpaszResults;
-};
-
-
-class Statement
-{
-public:
-
-    IMGUI_API Statement();
-
-    IMGUI_API Statement(const Statement& rStatement);
-
-    IMGUI_API Statement(sqlite3* pDB, sqlite3_stmt* pVM);
-
-    IMGUI_API virtual ~Statement();
-
-    IMGUI_API Statement& operator=(const Statement& rStatement);
-
-    IMGUI_API int execDML();
-
-    IMGUI_API Query execQuery();
-
-    IMGUI_API void bind(int nParam, const char* szValue);
-    IMGUI_API void bind(int nParam, const int nValue);
-    IMGUI_API void bind(int nParam, const long long nValue);
-    IMGUI_API void bind(int nParam, const double dwValue);
-    IMGUI_API void bind(int nParam, const unsigned char* blobValue, int nLen);
-    IMGUI_API void bindNull(int nParam);
-
-    IMGUI_API void reset();
-
-    IMGUI_API void finalize();
-
-private:
-
-    void checkDB() const;
-    void checkVM() const;
-
-    sqlite3* mpDB;
-    sqlite3_stmt* mpVM;
-};
-
-
-class DB
-{
-public:
-
-    IMGUI_API DB();
-
-    IMGUI_API virtual ~DB();
-
-    IMGUI_API void open(const char* szFile);
-
-    IMGUI_API void close();
-
-    IMGUI_API bool tableExists(const char* szTable);
-
-    IMGUI_API int execDML(const char* szSQL);
-
-    IMGUI_API Query execQuery(const char* szSQL);
-
-    IMGUI_API int execScalar(const char* szSQL);
-
-    IMGUI_API Table getTable(const char* szSQL);
-
-    IMGUI_API Statement compileStatement(const char* szSQL);
-
-    IMGUI_API sqlite_int64 lastRowId() const;
-
-    IMGUI_API void interrupt();
-
-    IMGUI_API void setBusyTimeout(int nMillisecs);
-
-    IMGUI_API static const char* SQLiteVersion();
-
-private:
-
-    DB(const DB& db);
-    DB& operator=(const DB& db);
-
-    sqlite3_stmt* compile(const char* szSQL);
-
-    void checkDB() const;
-
-    sqlite3* mpDB;
-    int mnBusyTimeoutMs;
-};
-} // namespace CppSQLite3
-
-#endif //IMGUISQLITE3_H_
-
+/* 
+ CppSQLite was originally developed by Rob Groves on CodeProject:
+ <http://www.codeproject.com/KB/database/CppSQLite.aspx>
+ 
+ Maintenance and updates are Copyright (C) 2011 NeoSmart Technologies
+ <http://neosmart.net/>
+ 
+ Original copyright information:
+ Copyright (C) 2004 Rob Groves. All Rights Reserved.
+ <rob.groves@btinternet.com>
+ 
+ Permission to use, copy, modify, and distribute this software and its
+ documentation for any purpose, without fee, and without a written
+ agreement, is hereby granted, provided that the above copyright notice, 
+ this paragraph and the following two paragraphs appear in all copies, 
+ modifications, and distributions.
+
+ IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT,
+ INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST
+ PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ THE AUTHOR SPECIFICALLY DISCLAIMS ANY WARRANTIES, INCLUDING, BUT NOT
+ LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE. THE SOFTWARE AND ACCOMPANYING DOCUMENTATION, IF
+ ANY, PROVIDED HEREUNDER IS PROVIDED "AS IS". THE AUTHOR HAS NO OBLIGATION
+ TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+*/
+////////////////////////////////////////////////////////////////////////////////
+// Modifications to the original CppSQLite3 library:
+// -> added CppSQLite3 namespace
+// -> removed prefix "CppSQLite3" to all classes
+// -> removed #include <sqlite3.h> from the .h file
+////////////////////////////////////////////////////////////////////////////////
+// USAGE:
+// -> needs -lsqlite3
+// -> or the "plain C" amalgamated file "sqlite.c" compiled with a "plain C"
+//    compiler linked to the executable. (Not included because it's too big)
+////////////////////////////////////////////////////////////////////////////////
+#ifndef CppSQLite3_H
+#define CppSQLite3_H
+#define IMGUISQLITE3_H_
+
+/*#ifndef IMGUI_API
+#include <imgui.h>
+#endif //IMGUI_API*/
+
+// Define attributes of all API symbols declarations, e.g. for DLL under Windows.
+#ifndef IMGUI_API
+#define IMGUI_API
+#endif
+
+
+//#include <sqlite3.h>	// see if we can remove it
+// Attempt to move "sqlite3.h" to imguisqlite3.cpp:----
+struct sqlite3;
+struct sqlite3_stmt;
+#ifndef SQLITE_INT64_TYPE
+#if defined(_MSC_VER) || defined(__BORLANDC__)
+  #define SQLITE_INT64_TYPE __int64
+#else
+  #define SQLITE_INT64_TYPE long long int
+#endif
+#endif //SQLITE_INT64_TYPE
+typedef SQLITE_INT64_TYPE sqlite_int64;
+typedef unsigned SQLITE_INT64_TYPE sqlite_uint64;
+typedef sqlite_int64 sqlite3_int64;
+typedef sqlite_uint64 sqlite3_uint64;
+// End Attempt ------------------------------------------
+
+
+#define CPPSQLITE_ERROR 1000
+
+namespace CppSQLite3 {
+
+class Exception
+{
+public:
+
+    IMGUI_API Exception(const int nErrCode,
+                    const char* szErrMess,
+                    bool bDeleteMsg=true);
+
+    IMGUI_API Exception(const Exception&  e);
+
+    IMGUI_API virtual ~Exception();
+
+    int errorCode() const { return mnErrCode; }
+
+    const char* errorMessage() const { return mpszErrMess; }
+
+    static const char* errorCodeAsString(int nErrCode);
+
+private:
+
+    int mnErrCode;
+    char* mpszErrMess;
+};
+
+
+class Buffer
+{
+public:
+
+    IMGUI_API Buffer();
+
+    IMGUI_API ~Buffer();
+
+    IMGUI_API const char* format(const char* szFormat, ...);
+
+    operator const char*() const { return mpBuf; }
+
+    IMGUI_API void clear();
+
+private:
+
+    char* mpBuf;
+};
+
+
+class Binary
+{
+public:
+
+    IMGUI_API Binary();
+
+    IMGUI_API ~Binary();
+
+    IMGUI_API void setBinary(const unsigned char* pBuf, int nLen);
+    IMGUI_API void setEncoded(const unsigned char* pBuf);
+
+    IMGUI_API const unsigned char* getEncoded();
+    IMGUI_API const unsigned char* getBinary();
+
+    IMGUI_API int getBinaryLength();
+
+    IMGUI_API unsigned char* allocBuffer(int nLen);
+
+    IMGUI_API void clear();
+
+private:
+
+    unsigned char* mpBuf;
+    int mnBinaryLen;
+    int mnBufferLen;
+    int mnEncodedLen;
+    bool mbEncoded;
+};
+
+
+class Query
+{
+public:
+
+    IMGUI_API Query();
+
+    IMGUI_API Query(const Query& rQuery);
+
+    IMGUI_API Query(sqlite3* pDB,
+                sqlite3_stmt* pVM,
+                bool bEof,
+                bool bOwnVM=true);
+
+    IMGUI_API Query& operator=(const Query& rQuery);
+
+    IMGUI_API virtual ~Query();
+
+    IMGUI_API int numFields() const;
+
+    IMGUI_API int fieldIndex(const char* szField) const;
+    IMGUI_API const char* fieldName(int nCol) const;
+
+    IMGUI_API const char* fieldDeclType(int nCol) const;
+    IMGUI_API int fieldDataType(int nCol) const;
+
+    IMGUI_API const char* fieldValue(int nField) const;
+    IMGUI_API const char* fieldValue(const char* szField) const;
+
+    IMGUI_API int getIntField(int nField, int nNullValue=0) const;
+    IMGUI_API int getIntField(const char* szField, int nNullValue=0) const;
+
+    IMGUI_API long long getInt64Field(int nField, long long nNullValue=0) const;
+    IMGUI_API long long getInt64Field(const char* szField, long long nNullValue=0) const;
+
+    IMGUI_API double getFloatField(int nField, double fNullValue=0.0) const;
+    IMGUI_API double getFloatField(const char* szField, double fNullValue=0.0) const;
+
+    IMGUI_API const char* getStringField(int nField, const char* szNullValue="") const;
+    IMGUI_API const char* getStringField(const char* szField, const char* szNullValue="") const;
+
+    IMGUI_API const unsigned char* getBlobField(int nField, int& nLen) const;
+    IMGUI_API const unsigned char* getBlobField(const char* szField, int& nLen) const;
+
+    IMGUI_API bool fieldIsNull(int nField) const;
+    IMGUI_API bool fieldIsNull(const char* szField) const;
+
+    IMGUI_API bool eof() const;
+
+    IMGUI_API void nextRow();
+
+    IMGUI_API void finalize();
+
+private:
+
+    void checkVM() const;
+
+    sqlite3* mpDB;
+    sqlite3_stmt* mpVM;
+    bool mbEof;
+    int mnCols;
+    bool mbOwnVM;
+};
+
+
+class Table
+{
+public:
+
+    IMGUI_API Table();
+
+    IMGUI_API Table(const Table& rTable);
+
+    IMGUI_API Table(char** paszResults, int nRows, int nCols);
+
+    IMGUI_API virtual ~Table();
+
+    IMGUI_API Table& operator=(const Table& rTable);
+
+    IMGUI_API int numFields() const;
+
+    IMGUI_API int numRows() const;
+
+    IMGUI_API const char* fieldName(int nCol) const;
+
+    IMGUI_API const char* fieldValue(int nField) const;
+    IMGUI_API const char* fieldValue(const char* szField) const;
+
+    IMGUI_API int getIntField(int nField, int nNullValue=0) const;
+    IMGUI_API int getIntField(const char* szField, int nNullValue=0) const;
+
+    IMGUI_API double getFloatField(int nField, double fNullValue=0.0) const;
+    IMGUI_API double getFloatField(const char* szField, double fNullValue=0.0) const;
+
+    IMGUI_API const char* getStringField(int nField, const char* szNullValue="") const;
+    IMGUI_API const char* getStringField(const char* szField, const char* szNullValue="") const;
+
+    IMGUI_API bool fieldIsNull(int nField) const;
+    IMGUI_API bool fieldIsNull(const char* szField) const;
+
+    IMGUI_API void setRow(int nRow);
+
+    IMGUI_API void finalize();
+
+private:
+
+    void checkResults() const;
+
+    int mnCols;
+    int mnRows;
+    int mnCurrentRow;
+    char** mpaszResults;
+};
+
+
+class Statement
+{
+public:
+
+    IMGUI_API Statement();
+
+    IMGUI_API Statement(const Statement& rStatement);
+
+    IMGUI_API Statement(sqlite3* pDB, sqlite3_stmt* pVM);
+
+    IMGUI_API virtual ~Statement();
+
+    IMGUI_API Statement& operator=(const Statement& rStatement);
+
+    IMGUI_API int execDML();
+
+    IMGUI_API Query execQuery();
+
+    IMGUI_API void bind(int nParam, const char* szValue);
+    IMGUI_API void bind(int nParam, const int nValue);
+    IMGUI_API void bind(int nParam, const long long nValue);
+    IMGUI_API void bind(int nParam, const double dwValue);
+    IMGUI_API void bind(int nParam, const unsigned char* blobValue, int nLen);
+    IMGUI_API void bindNull(int nParam);
+
+    IMGUI_API void reset();
+
+    IMGUI_API void finalize();
+
+private:
+
+    void checkDB() const;
+    void checkVM() const;
+
+    sqlite3* mpDB;
+    sqlite3_stmt* mpVM;
+};
+
+
+class DB
+{
+public:
+
+    IMGUI_API DB();
+
+    IMGUI_API virtual ~DB();
+
+    IMGUI_API void open(const char* szFile);
+
+    IMGUI_API void close();
+
+    IMGUI_API bool tableExists(const char* szTable);
+
+    IMGUI_API int execDML(const char* szSQL);
+
+    IMGUI_API Query execQuery(const char* szSQL);
+
+    IMGUI_API int execScalar(const char* szSQL);
+
+    IMGUI_API Table getTable(const char* szSQL);
+
+    IMGUI_API Statement compileStatement(const char* szSQL);
+
+    IMGUI_API sqlite_int64 lastRowId() const;
+
+    IMGUI_API void interrupt();
+
+    IMGUI_API void setBusyTimeout(int nMillisecs);
+
+    IMGUI_API static const char* SQLiteVersion();
+
+private:
+
+    DB(const DB& db);
+    DB& operator=(const DB& db);
+
+    sqlite3_stmt* compile(const char* szSQL);
+
+    void checkDB() const;
+
+    sqlite3* mpDB;
+    int mnBusyTimeoutMs;
+
+    friend class PagedQuery;
+};
+
+
+// Windowed access to the rows of a table (in rowid order), so that huge tables can be browsed without loading them into memory.
+// -> Rows are fetched in pages by prepared statements with keyset pagination ("WHERE rowid>=? ORDER BY rowid LIMIT ?"): the first rowid of
+//    the pages met so far is remembered, so that jumping to a far page needs a single index-only seek from the nearest known page.
+// -> Only the last nMaxCachedPages pages are kept (LRU cache), and each field value is truncated to nMaxFieldBytes (blobs are just described).
+// -> The row count is estimated at once (from the rowid range), and counted exactly in a worker thread when imguihelper threads are available.
+// open() throws Exception on errors. The other methods never throw (they are meant to be called every frame): they return NULL or 0 instead,
+// and keep the last error code in lastErrorCode().
+class PagedQuery
+{
+public:
+
+    IMGUI_API PagedQuery();
+
+    IMGUI_API virtual ~PagedQuery();
+
+    // szColumns: e.g. "*" or "name,age*2". szWhere: an optional SQL expression (e.g. "age>20") or NULL.
+    IMGUI_API void open(DB& db, const char* szTable, const char* szColumns="*", const char* szWhere=0, int nPageSize=256, int nMaxCachedPages=64, int nMaxFieldBytes=1024);
+
+    IMGUI_API void close();
+
+    IMGUI_API bool isOpen() const;
+
+    IMGUI_API int numFields() const;
+
+    IMGUI_API const char* fieldName(int nCol) const;
+
+    IMGUI_API int numRows() const;              // the exact number of rows when known, an estimate otherwise
+
+    IMGUI_API bool isNumRowsExact() const;
+
+    // The returned pointer is valid until nMaxCachedPages-1 other pages are fetched. NULL for NULL fields and out of range rows.
+    IMGUI_API const char* fieldValue(int nRow, int nField) const;
+
+    IMGUI_API bool fieldIsNull(int nRow, int nField) const;
+
+    IMGUI_API sqlite_int64 rowId(int nRow, sqlite_int64 nInvalidValue=-1) const;
+
+    IMGUI_API void invalidate();                // drops the cached pages and the row count (to call after modifying the table)
+
+    // Adds a condition on the result columns (they can be referred to by their fieldName(...) as quoted identifiers), or removes it (szFilter=NULL).
+    // It's applied on top of the szWhere of open(). Returns false (and keeps the previous filter) if the statements can't be prepared.
+    IMGUI_API bool setFilter(const char* szFilter);
+
+    IMGUI_API int lastErrorCode() const;
+
+private:
+
+    PagedQuery(const PagedQuery&);
+    PagedQuery& operator=(const PagedQuery&);
+
+    struct PagedQueryData* d;
+    char* mszTable;
+};
+} // namespace CppSQLite3
+
+#ifdef IMGUILISTVIEW_H_
+namespace CppSQLite3 {
+// A virtualized grid for a PagedQuery: only the pages of the visible rows are fetched.
+// Open "query" and then call render(...) (see ImGui::ListViewBase). Rows can't be sorted.
+// The row filter of ImGui::ListViewBase is translated into a SQL condition for query.setFilter(...) (so the query must be open when the filter is set).
+class PagedListView : public ImGui::ListViewBase
+{
+public:
+    PagedQuery query;
+
+    PagedListView() : mbSelectedFlag(false) {}
+
+    IMGUI_API size_t getNumColumns() const;
+    IMGUI_API size_t getNumRows() const;
+
+protected:
+    IMGUI_API void getHeaderData(size_t column,HeaderData& headerDataOut) const;
+    IMGUI_API void getCellData(size_t row,size_t column,CellData& cellDataOut) const;
+    IMGUI_API bool onFilterChanged(const ImGuiTextFilter& filter,int filterColumn);
+
+    mutable bool mbSelectedFlag;    // ListViewBase wants a bool per row: we only have one selected row, so we reuse it
+};
+} // namespace CppSQLite3
+#endif //IMGUILISTVIEW_H_
+
+#endif //IMGUISQLITE3_H_
+
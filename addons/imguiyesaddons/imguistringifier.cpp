@@ -1,433 +1,442 @@
 #include "imguistringifier.h"
 
-
-
-//#include <iostream>	// TO REMOVE
-// LIBB64 LICENSE (libb64.sourceforge.net):
-/*
-Copyright-Only Dedication (based on United States law) 
-or Public Domain Certification
-
-The person or persons who have associated work with this document (the
-"Dedicator" or "Certifier") hereby either (a) certifies that, to the best of
-his knowledge, the work of authorship identified is in the public domain of the
-country from which the work is published, or (b) hereby dedicates whatever
-copyright the dedicators holds in the work of authorship identified below (the
-"Work") to the public domain. A certifier, moreover, dedicates any copyright
-interest he may have in the associated work, and for these purposes, is
-described as a "dedicator" below.
-
-A certifier has taken reasonable steps to verify the copyright status of this
-work. Certifier recognizes that his good faith efforts may not shield him from
-liability if in fact the work certified is not in the public domain.
-
-Dedicator makes this dedication for the benefit of the public at large and to
-the detriment of the Dedicator's heirs and successors. Dedicator intends this
-dedication to be an overt act of relinquishment in perpetuity of all present
-and future rights under copyright law, whether vested or contingent, in the
-Work. Dedicator understands that such relinquishment of all rights includes
-the relinquishment of all rights to enforce (by lawsuit or otherwise) those
-copyrights in the Work.
-
-Dedicator recognizes that, once placed in the public domain, the Work may be
-freely reproduced, distributed, transmitted, used, modified, built upon, or
-otherwise exploited by anyone for any purpose, commercial or non-commercial,
-and in any way, including by methods that have not yet been invented or
-conceived.
-*/
-namespace base64 {
-
-// Decoder here
-	extern "C"
-	{
-		typedef enum {step_a, step_b, step_c, step_d} base64_decodestep;
-		typedef struct {base64_decodestep step;char plainchar;} base64_decodestate;
-
-inline int base64_decode_value(char value_in)	{
-	static const char decoding[] = {62,-1,-1,-1,63,52,53,54,55,56,57,58,59,60,61,-1,-1,-1,-2,-1,-1,-1,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,-1,-1,-1,-1,-1,-1,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51};
-	static const char decoding_size = sizeof(decoding);
-	value_in -= 43;
-	if (value_in < 0 || value_in > decoding_size) return -1;
-	return decoding[(int)value_in];
-}
-inline void base64_init_decodestate(base64_decodestate* state_in)	{
-	state_in->step = step_a;
-	state_in->plainchar = 0;
-}
-inline int base64_decode_block(const char* code_in, const int length_in, char* plaintext_out, base64_decodestate* state_in)	{
-	const char* codechar = code_in;
-	char* plainchar = plaintext_out;
-	char fragment;
-	
-	*plainchar = state_in->plainchar;
-	
-	switch (state_in->step)
-	{
-		while (1)
-		{
-	case step_a:
-			do {
-				if (codechar == code_in+length_in)
-				{
-					state_in->step = step_a;
-					state_in->plainchar = *plainchar;
-					return plainchar - plaintext_out;
-				}
-				fragment = (char)base64_decode_value(*codechar++);
-			} while (fragment < 0);
-			*plainchar    = (fragment & 0x03f) << 2;
-	case step_b:
-			do {
-				if (codechar == code_in+length_in)
-				{
-					state_in->step = step_b;
-					state_in->plainchar = *plainchar;
-					return plainchar - plaintext_out;
-				}
-				fragment = (char)base64_decode_value(*codechar++);
-			} while (fragment < 0);
-			*plainchar++ |= (fragment & 0x030) >> 4;
-			*plainchar    = (fragment & 0x00f) << 4;
-	case step_c:
-			do {
-				if (codechar == code_in+length_in)
-				{
-					state_in->step = step_c;
-					state_in->plainchar = *plainchar;
-					return plainchar - plaintext_out;
-				}
-				fragment = (char)base64_decode_value(*codechar++);
-			} while (fragment < 0);
-			*plainchar++ |= (fragment & 0x03c) >> 2;
-			*plainchar    = (fragment & 0x003) << 6;
-	case step_d:
-			do {
-				if (codechar == code_in+length_in)
-				{
-					state_in->step = step_d;
-					state_in->plainchar = *plainchar;
-					return plainchar - plaintext_out;
-				}
-				fragment = (char)base64_decode_value(*codechar++);
-			} while (fragment < 0);
-			*plainchar++   |= (fragment & 0x03f);
-		}
-	}
-	/* control should not reach here */
-	return plainchar - plaintext_out;
-}
-	}	// extern "C"
-	struct decoder
-	{
-		base64_decodestate _state;
-		int _buffersize;
-		
-		decoder(int buffersize_in = 4096) : _buffersize(buffersize_in) {}
-		int decode(char value_in) {return base64_decode_value(value_in);}
-		int decode(const char* code_in, const int length_in, char* plaintext_out)	{return base64_decode_block(code_in, length_in, plaintext_out, &_state);}
-        /*void decode(std::istream& istream_in, std::ostream& ostream_in)
-		{
-			base64_init_decodestate(&_state);
-			//
-			const int N = _buffersize;
-			char* code = new char[N];
-			char* plaintext = new char[N];
-			int codelength;
-			int plainlength;
-			
-			do
-			{
-				istream_in.read((char*)code, N);
-				codelength = istream_in.gcount();
-				plainlength = decode(code, codelength, plaintext);
-				ostream_in.write((const char*)plaintext, plainlength);
-			}
-			while (istream_in.good() && codelength > 0);
-			//
-			base64_init_decodestate(&_state);
-			
-			delete [] code;
-			delete [] plaintext;
-        }*/
-	};
-
-// Encoder Here
-	extern "C" {
-		typedef enum {step_A, step_B, step_C} base64_encodestep;
-		typedef struct {base64_encodestep step;char result;int stepcount;} base64_encodestate;
-
-const int CHARS_PER_LINE = 2147483647;//72; // This was hard coded to 72 originally. But here we add '\n' at a later step. So we use MAX_INT here.
-inline void base64_init_encodestate(base64_encodestate* state_in)	{
-	state_in->step = step_A;
-	state_in->result = 0;
-	state_in->stepcount = 0;
-}
-inline char base64_encode_value(char value_in)	{
-	static const char* encoding = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-	if (value_in > 63) return '=';
-	return encoding[(int)value_in];
-}
-inline int base64_encode_block(const char* plaintext_in, int length_in, char* code_out, base64_encodestate* state_in)	{
-	const char* plainchar = plaintext_in;
-	const char* const plaintextend = plaintext_in + length_in;
-	char* codechar = code_out;
-    char result = '\0';
-    char fragment = '\0';
-	
-	result = state_in->result;
-	
-	switch (state_in->step)
-	{
-		while (1)
-		{
-	case step_A:
-			if (plainchar == plaintextend)
-			{
-				state_in->result = result;
-				state_in->step = step_A;
-				return codechar - code_out;
-			}
-			fragment = *plainchar++;
-			result = (fragment & 0x0fc) >> 2;
-			*codechar++ = base64_encode_value(result);
-			result = (fragment & 0x003) << 4;
-	case step_B:
-			if (plainchar == plaintextend)
-			{
-				state_in->result = result;
-				state_in->step = step_B;
-				return codechar - code_out;
-			}
-			fragment = *plainchar++;
-			result |= (fragment & 0x0f0) >> 4;
-			*codechar++ = base64_encode_value(result);
-			result = (fragment & 0x00f) << 2;
-	case step_C:
-			if (plainchar == plaintextend)
-			{
-				state_in->result = result;
-				state_in->step = step_C;
-				return codechar - code_out;
-			}
-			fragment = *plainchar++;
-			result |= (fragment & 0x0c0) >> 6;
-			*codechar++ = base64_encode_value(result);
-			result  = (fragment & 0x03f) >> 0;
-			*codechar++ = base64_encode_value(result);
-			
-			++(state_in->stepcount);
-			if (state_in->stepcount == CHARS_PER_LINE/4)
-			{
-				*codechar++ = '\n';
-				state_in->stepcount = 0;
-			}
-		}
-	}
-	/* control should not reach here */
-	return codechar - code_out;
-}
-inline int base64_encode_blockend(char* code_out, base64_encodestate* state_in)	{
-	char* codechar = code_out;
-	
-	switch (state_in->step)
-	{
-	case step_B:
-		*codechar++ = base64_encode_value(state_in->result);
-		*codechar++ = '=';
-		*codechar++ = '=';
-		break;
-	case step_C:
-		*codechar++ = base64_encode_value(state_in->result);
-		*codechar++ = '=';
-		break;
-	case step_A:
-		break;
-	}
-	*codechar++ = '\n';
-	
-	return codechar - code_out;
-}	
-	} // extern "C"
-	struct encoder
-	{
-		base64_encodestate _state;
-		int _buffersize;
-		
-		encoder(int buffersize_in = 4096)
-		: _buffersize(buffersize_in)
-		{}
-		int encode(char value_in)
-		{
-			return base64_encode_value(value_in);
-		}
-		int encode(const char* code_in, const int length_in, char* plaintext_out)
-		{
-			return base64_encode_block(code_in, length_in, plaintext_out, &_state);
-		}
-		int encode_end(char* plaintext_out)
-		{
-			return base64_encode_blockend(plaintext_out, &_state);
-		}
-        /*void encode(std::istream& istream_in, std::ostream& ostream_in)
-		{
-			base64_init_encodestate(&_state);
-			//
-			const int N = _buffersize;
-			char* plaintext = new char[N];
-			char* code = new char[2*N];
-			int plainlength;
-			int codelength;
-			
-			do
-			{
-				istream_in.read(plaintext, N);
-				plainlength = istream_in.gcount();
-				//
-				codelength = encode(plaintext, plainlength, code);
-				ostream_in.write(code, codelength);
-			}
-			while (istream_in.good() && plainlength > 0);
-			
-			codelength = encode_end(code);
-			ostream_in.write(code, codelength);
-			//
-			base64_init_encodestate(&_state);
-			
-			delete [] code;
-			delete [] plaintext;
-        }*/
-	};
-
-
-} // namespace base64
-
+#include <string.h> // strlen, memcpy
+
+// The Base64 codecs use SSSE3 (or AVX2) when the compiler targets it (e.g. -mssse3, -mavx2 or /arch:AVX2), the Base85 encoder uses SSE2.
+// Define IMGUISTRINGIFIER_NO_SIMD to force the scalar code paths (that produce the same output).
+#if !defined(IMGUISTRINGIFIER_NO_SIMD)
+#   if defined(__AVX2__)
+#       define IMGUISTRINGIFIER_ENABLE_AVX2
+#   endif
+#   if (defined(__SSSE3__) || defined(__AVX2__))
+#       define IMGUISTRINGIFIER_ENABLE_SSSE3
+#   endif
+#   if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#       define IMGUISTRINGIFIER_ENABLE_SSE2
+#   endif
+#endif //IMGUISTRINGIFIER_NO_SIMD
+#if defined(IMGUISTRINGIFIER_ENABLE_AVX2)
+#   include <immintrin.h>
+#elif defined(IMGUISTRINGIFIER_ENABLE_SSSE3)
+#   include <tmmintrin.h>
+#elif defined(IMGUISTRINGIFIER_ENABLE_SSE2)
+#   include <emmintrin.h>
+#endif
 
 
 namespace ImGui {
 
 namespace Stringifier {
 
-
-template <typename VectorChar> static bool Base64Decode(const char* input,VectorChar& output)	{
-    output.clear();if (!input) return false;
-    const int N = 4096;
-    base64::decoder d(N);
-    base64_init_decodestate(&d._state);
-
-    int outputStart=0,outputlength = 0;
-    int codelength = strlen(input);
-    const char* pIn = input;
-    int stepCodeLength = 0;
-    do
-    {
-        output.resize(outputStart+N);
-        stepCodeLength = codelength>=N?N:codelength;
-        outputlength = d.decode(pIn, stepCodeLength, &output[outputStart]);
-        outputStart+=outputlength;
-        pIn+=stepCodeLength;
-        codelength-=stepCodeLength;
-    }
-    while (codelength>0);
-
-    output.resize(outputStart);
-    //
-    base64_init_decodestate(&d._state);
+// Base64 ----------------------------------------------------------------------
+// Output format (the one of the libb64 encoder this code replaces): no line breaks, '=' padding and a final '\n'.
+// The decoder skips all the chars that are not in the alphabet ('=', newlines and quotes included).
+static const char Base64EncodeTable[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const signed char Base64DecodeTable[256] = {
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,62,-1,-1,-1,63,
+    52,53,54,55,56,57,58,59,60,61,-1,-1,-1,-1,-1,-1,
+    -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,
+    15,16,17,18,19,20,21,22,23,24,25,-1,-1,-1,-1,-1,
+    -1,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,
+    41,42,43,44,45,46,47,48,49,50,51,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
+};
+// Extra bytes the SIMD decoder can write past the decoded data
+enum {BASE64_DECODE_SLACK = 32};
+
+#ifdef IMGUISTRINGIFIER_ENABLE_SSSE3
+// 12 input bytes (in the low part of 'in') -> 16 chars
+static inline __m128i Base64EncodeSSSE3(__m128i in) {
+    in = _mm_shuffle_epi8(in,_mm_setr_epi8(1,0,2,1, 4,3,5,4, 7,6,8,7, 10,9,11,10));
+    // Split each 24-bit group into 4 6-bit values (one per byte)
+    const __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in,_mm_set1_epi32(0x0fc0fc00)),_mm_set1_epi32(0x04000040));
+    const __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in,_mm_set1_epi32(0x003f03f0)),_mm_set1_epi32(0x01000010));
+    const __m128i v = _mm_or_si128(t0,t1);
+    // Map the 6-bit values to ASCII adding a per-range offset
+    const __m128i offsets = _mm_setr_epi8(65,71,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-19,-16,0,0);
+    __m128i idx = _mm_subs_epu8(v,_mm_set1_epi8(51));
+    idx = _mm_sub_epi8(idx,_mm_cmpgt_epi8(v,_mm_set1_epi8(25)));
+    return _mm_add_epi8(v,_mm_shuffle_epi8(offsets,idx));
+}
+// 16 chars -> 12 bytes (in the low part of 'out'). Returns false if some char is not in the alphabet.
+static inline bool Base64DecodeSSSE3(__m128i str,__m128i& out) {
+    const __m128i lutLo = _mm_setr_epi8(0x15,0x11,0x11,0x11,0x11,0x11,0x11,0x11,0x11,0x11,0x13,0x1A,0x1B,0x1B,0x1B,0x1A);
+    const __m128i lutHi = _mm_setr_epi8(0x10,0x10,0x01,0x02,0x04,0x08,0x04,0x08,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10);
+    const __m128i lutRoll = _mm_setr_epi8(0,16,19,4,-65,-65,-71,-71,0,0,0,0,0,0,0,0);
+    const __m128i mask2F = _mm_set1_epi8(0x2F);
+    const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(str,4),mask2F);
+    const __m128i loNibbles = _mm_and_si128(str,mask2F);
+    const __m128i invalid = _mm_and_si128(_mm_shuffle_epi8(lutLo,loNibbles),_mm_shuffle_epi8(lutHi,hiNibbles));
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(invalid,_mm_setzero_si128()))!=0) return false;
+    const __m128i roll = _mm_shuffle_epi8(lutRoll,_mm_add_epi8(_mm_cmpeq_epi8(str,mask2F),hiNibbles));
+    str = _mm_add_epi8(str,roll);
+    // Pack 4 6-bit values into 3 bytes
+    str = _mm_madd_epi16(_mm_maddubs_epi16(str,_mm_set1_epi32(0x01400140)),_mm_set1_epi32(0x00011000));
+    out = _mm_shuffle_epi8(str,_mm_setr_epi8(2,1,0, 6,5,4, 10,9,8, 14,13,12, -1,-1,-1,-1));
     return true;
 }
-
-template <typename VectorChar> static bool Base64Encode(const char* input,int inputSize,VectorChar& output)	{
-	output.clear();if (!input || inputSize==0) return false;
-
-    const int N=4096;
-    base64::encoder e(N);
-    base64_init_encodestate(&e._state);
-
-    int outputStart=0,outputlength = 0;
-    int codelength = inputSize;
-    const char* pIn = input;
-    int stepCodeLength = 0;
-
-    do
-    {
-        output.resize(outputStart+2*N);
-        stepCodeLength = codelength>=N?N:codelength;
-        outputlength = e.encode(pIn, stepCodeLength,&output[outputStart]);
-        outputStart+=outputlength;
-        pIn+=stepCodeLength;
-        codelength-=stepCodeLength;
+#endif //IMGUISTRINGIFIER_ENABLE_SSSE3
+#ifdef IMGUISTRINGIFIER_ENABLE_AVX2
+// Same as above on two lanes: 'in' must be loaded 4 bytes before the 24 input bytes
+static inline __m256i Base64EncodeAVX2(__m256i in) {
+    in = _mm256_shuffle_epi8(in,_mm256_set_epi8(
+        10,11, 9,10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+        14,15,13,14,11,12,10,11, 8, 9, 7, 8, 5, 6, 4, 5));
+    const __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in,_mm256_set1_epi32(0x0fc0fc00)),_mm256_set1_epi32(0x04000040));
+    const __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in,_mm256_set1_epi32(0x003f03f0)),_mm256_set1_epi32(0x01000010));
+    const __m256i v = _mm256_or_si256(t0,t1);
+    const __m256i offsets = _mm256_setr_epi8(65,71,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-19,-16,0,0,
+                                             65,71,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-19,-16,0,0);
+    __m256i idx = _mm256_subs_epu8(v,_mm256_set1_epi8(51));
+    idx = _mm256_sub_epi8(idx,_mm256_cmpgt_epi8(v,_mm256_set1_epi8(25)));
+    return _mm256_add_epi8(v,_mm256_shuffle_epi8(offsets,idx));
+}
+// 32 chars -> 24 bytes (in the low part of 'out')
+static inline bool Base64DecodeAVX2(__m256i str,__m256i& out) {
+    const __m256i lutLo = _mm256_setr_epi8(0x15,0x11,0x11,0x11,0x11,0x11,0x11,0x11,0x11,0x11,0x13,0x1A,0x1B,0x1B,0x1B,0x1A,
+                                           0x15,0x11,0x11,0x11,0x11,0x11,0x11,0x11,0x11,0x11,0x13,0x1A,0x1B,0x1B,0x1B,0x1A);
+    const __m256i lutHi = _mm256_setr_epi8(0x10,0x10,0x01,0x02,0x04,0x08,0x04,0x08,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10,
+                                           0x10,0x10,0x01,0x02,0x04,0x08,0x04,0x08,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10);
+    const __m256i lutRoll = _mm256_setr_epi8(0,16,19,4,-65,-65,-71,-71,0,0,0,0,0,0,0,0,
+                                             0,16,19,4,-65,-65,-71,-71,0,0,0,0,0,0,0,0);
+    const __m256i mask2F = _mm256_set1_epi8(0x2F);
+    const __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(str,4),mask2F);
+    const __m256i loNibbles = _mm256_and_si256(str,mask2F);
+    const __m256i invalid = _mm256_and_si256(_mm256_shuffle_epi8(lutLo,loNibbles),_mm256_shuffle_epi8(lutHi,hiNibbles));
+    if (_mm256_movemask_epi8(_mm256_cmpgt_epi8(invalid,_mm256_setzero_si256()))!=0) return false;
+    const __m256i roll = _mm256_shuffle_epi8(lutRoll,_mm256_add_epi8(_mm256_cmpeq_epi8(str,mask2F),hiNibbles));
+    str = _mm256_add_epi8(str,roll);
+    str = _mm256_madd_epi16(_mm256_maddubs_epi16(str,_mm256_set1_epi32(0x01400140)),_mm256_set1_epi32(0x00011000));
+    str = _mm256_shuffle_epi8(str,_mm256_setr_epi8(2,1,0, 6,5,4, 10,9,8, 14,13,12, -1,-1,-1,-1,
+                                                   2,1,0, 6,5,4, 10,9,8, 14,13,12, -1,-1,-1,-1));
+    out = _mm256_permutevar8x32_epi32(str,_mm256_setr_epi32(0,1,2,4,5,6,-1,-1));
+    return true;
+}
+#endif //IMGUISTRINGIFIER_ENABLE_AVX2
+
+// Encodes inputSize bytes (a multiple of 3) into (inputSize/3)*4 chars. Returns the number of chars written.
+static int Base64EncodeGroups(const unsigned char* src,int inputSize,char* dst) {
+    const unsigned char* const srcEnd = src+inputSize;
+    char* d = dst;
+#   ifdef IMGUISTRINGIFIER_ENABLE_AVX2
+    if (srcEnd-src>=32) {
+        // The first 12 bytes go through the SSSE3 path, so that the AVX2 loads (that start 4 bytes before the data) stay inside the input
+        _mm_storeu_si128((__m128i*)d,Base64EncodeSSSE3(_mm_loadu_si128((const __m128i*)src)));
+        src+=12;d+=16;
+        while (srcEnd-src>=28) {
+            _mm256_storeu_si256((__m256i*)d,Base64EncodeAVX2(_mm256_loadu_si256((const __m256i*)(src-4))));
+            src+=24;d+=32;
+        }
     }
-    while (codelength>0);
-
-    output.resize(outputStart+2*N);
-    outputlength = e.encode_end(&output[outputStart]);
-    outputStart+=outputlength;
-    output.resize(outputStart);
-    //
-    base64_init_encodestate(&e._state);
-
-	return true;
+#   endif //IMGUISTRINGIFIER_ENABLE_AVX2
+#   ifdef IMGUISTRINGIFIER_ENABLE_SSSE3
+    while (srcEnd-src>=16) {
+        _mm_storeu_si128((__m128i*)d,Base64EncodeSSSE3(_mm_loadu_si128((const __m128i*)src)));
+        src+=12;d+=16;
+    }
+#   endif //IMGUISTRINGIFIER_ENABLE_SSSE3
+    for (;src<srcEnd;src+=3,d+=4) {
+        const unsigned int v = ((unsigned int)src[0]<<16)|((unsigned int)src[1]<<8)|(unsigned int)src[2];
+        d[0] = Base64EncodeTable[v>>18];d[1] = Base64EncodeTable[(v>>12)&0x3F];
+        d[2] = Base64EncodeTable[(v>>6)&0x3F];d[3] = Base64EncodeTable[v&0x3F];
+    }
+    return (int)(d-dst);
+}
+// Encodes the last inputSize bytes (0,1 or 2) with padding and appends the final '\n'. Returns the number of chars written.
+static int Base64EncodeTail(const unsigned char* src,int inputSize,char* dst) {
+    char* d = dst;
+    if (inputSize>0) {
+        const unsigned int v = ((unsigned int)src[0]<<16)|(inputSize>1 ? ((unsigned int)src[1]<<8) : 0);
+        *d++ = Base64EncodeTable[v>>18];
+        *d++ = Base64EncodeTable[(v>>12)&0x3F];
+        *d++ = inputSize>1 ? Base64EncodeTable[(v>>6)&0x3F] : '=';
+        *d++ = '=';
+    }
+    *d++ = '\n';
+    return (int)(d-dst);
+}
+static inline int Base64EncodedSize(int inputSize) {return ((inputSize+2)/3)*4+1;}
+
+// Decoder state between calls: the bits of the 0-3 chars of the current group decoded so far
+struct Base64DecodeState {
+    unsigned int bits;int numChars;
+    Base64DecodeState() : bits(0),numChars(0) {}
+};
+// Decodes inputSize chars, skipping the ones that are not in the alphabet. Returns the number of bytes written.
+// dst must have room for (inputSize/4)*3+3+BASE64_DECODE_SLACK bytes.
+static int Base64DecodeChars(const unsigned char* src,int inputSize,unsigned char* dst,Base64DecodeState& s) {
+    const unsigned char* const srcEnd = src+inputSize;
+    unsigned char* d = dst;
+    unsigned int bits = s.bits;int numChars = s.numChars;
+    while (src<srcEnd) {
+#       ifdef IMGUISTRINGIFIER_ENABLE_SSSE3
+        // Whole runs of valid chars are decoded 16 (or 32) at a time. Blocks with other chars (newlines, quotes, padding) go through the scalar loop.
+        if (numChars==0) {
+#           ifdef IMGUISTRINGIFIER_ENABLE_AVX2
+            __m256i out256;
+            while (srcEnd-src>=32 && Base64DecodeAVX2(_mm256_loadu_si256((const __m256i*)src),out256)) {
+                _mm256_storeu_si256((__m256i*)d,out256);
+                src+=32;d+=24;
+            }
+#           endif //IMGUISTRINGIFIER_ENABLE_AVX2
+            __m128i out;
+            while (srcEnd-src>=16 && Base64DecodeSSSE3(_mm_loadu_si128((const __m128i*)src),out)) {
+                _mm_storeu_si128((__m128i*)d,out);
+                src+=16;d+=12;
+            }
+            if (src==srcEnd) break;
+        }
+#       endif //IMGUISTRINGIFIER_ENABLE_SSSE3
+        const int v = Base64DecodeTable[*src++];
+        if (v<0) continue;
+        bits = (bits<<6)|(unsigned int)v;
+        if (++numChars==4) {
+            d[0] = (unsigned char)(bits>>16);d[1] = (unsigned char)(bits>>8);d[2] = (unsigned char)bits;
+            d+=3;bits=0;numChars=0;
+        }
+    }
+    s.bits = bits;s.numChars = numChars;
+    return (int)(d-dst);
+}
+// Writes the bytes of the last incomplete group (0-2). Returns the number of bytes written.
+static int Base64DecodeEnd(unsigned char* dst,Base64DecodeState& s) {
+    int n = 0;
+    if (s.numChars==2) dst[n++] = (unsigned char)(s.bits>>4);
+    else if (s.numChars==3) {dst[n++] = (unsigned char)(s.bits>>10);dst[n++] = (unsigned char)(s.bits>>2);}
+    s = Base64DecodeState();
+    return n;
 }
 
 
-
-inline static unsigned int Decode85Byte(char c)   { return c >= '\\' ? c-36 : c-35; }
-static void Decode85(const unsigned char* src, unsigned char* dst)	{
-    while (*src)
-    {
-        unsigned int tmp = Decode85Byte(src[0]) + 85*(Decode85Byte(src[1]) + 85*(Decode85Byte(src[2]) + 85*(Decode85Byte(src[3]) + 85*Decode85Byte(src[4]))));
+// Base85 ----------------------------------------------------------------------
+// Same encoding used by binary_to_compressed_c(...) inside imgui_draw.cpp: 4 little-endian bytes -> 5 chars in ['#','~'] without '\\'
+inline static unsigned int Decode85Byte(unsigned char c)   { return c >= '\\' ? c-36 : c-35; }
+// Decodes numGroups groups of 5 chars into numGroups*4 bytes
+static void Base85DecodeGroups(const unsigned char* src,int numGroups,unsigned char* dst)	{
+    for (int i=0;i<numGroups;i++,src+=5,dst+=4) {
+        const unsigned int tmp = Decode85Byte(src[0]) + 85*(Decode85Byte(src[1]) + 85*(Decode85Byte(src[2]) + 85*(Decode85Byte(src[3]) + 85*Decode85Byte(src[4]))));
         dst[0] = ((tmp >> 0) & 0xFF); dst[1] = ((tmp >> 8) & 0xFF); dst[2] = ((tmp >> 16) & 0xFF); dst[3] = ((tmp >> 24) & 0xFF);   // We can't assume little-endianness.
-        src += 5;
-        dst += 4;
     }
 }
-template <typename VectorChar> static bool Base85Decode(const char* input,VectorChar& output)	{
-	output.clear();if (!input) return false;
-	const int outputSize = (((int)strlen(input) + 4) / 5) * 4;
-	output.resize(outputSize);
-    Decode85((const unsigned char*)input,(unsigned char*)&output[0]);
-    return true;
+// Decodes inputSize chars into ((inputSize+4)/5)*4 bytes. A trailing incomplete group is padded with the highest digit.
+static void Base85Decode(const unsigned char* src,int inputSize,unsigned char* dst)    {
+    const int numGroups = inputSize/5, rem = inputSize%5;
+    Base85DecodeGroups(src,numGroups,dst);
+    if (rem>0) {
+        unsigned char last[5] = {'x','x','x','x','x'};   // 'x' is the char of the highest digit (84)
+        memcpy(last,src+numGroups*5,rem);
+        Base85DecodeGroups(last,1,dst+numGroups*4);
+    }
 }
 
-
 inline static char Encode85Byte(unsigned int x) 	{
     x = (x % 85) + 35;
     return (x>='\\') ? x+1 : x;
 }
-template <typename VectorChar> static bool Base85Encode(const char* input,int inputSize,VectorChar& output,bool outputStringifiedMode,int numCharsPerLineInStringifiedMode=112)	{
-    // Adapted from binary_to_compressed_c(...) inside imgui_draw.cpp
-    output.clear();if (!input || inputSize==0) return false;
-    output.reserve((int)((float)inputSize*1.3f));
+// Encodes numGroups groups of 4 bytes into numGroups*5 chars
+static void Base85EncodeGroups(const unsigned char* src,int numGroups,char* dst)    {
+#   ifdef IMGUISTRINGIFIER_ENABLE_SSE2
+    // 4 groups at a time: the divisions by 85 become multiplications by 0xC0C0C0C1 (>>38), that are exact for all 32-bit values
+    const __m128i magic = _mm_set1_epi32((int)0xC0C0C0C1);
+    const __m128i c35 = _mm_set1_epi32(35), c56 = _mm_set1_epi32(56);
+    for (;numGroups>=4;numGroups-=4,src+=16,dst+=20) {
+        __m128i x = _mm_loadu_si128((const __m128i*)src);   // SSE2 implies little-endian
+        __m128i digits[5];
+        for (int n5=0;n5<5;n5++) {
+            const __m128i qEven = _mm_srli_epi64(_mm_mul_epu32(x,magic),38);
+            const __m128i qOdd = _mm_slli_epi64(_mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(x,32),magic),38),32);
+            const __m128i q = _mm_or_si128(qEven,qOdd);
+            const __m128i q85 = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(q,6),_mm_slli_epi32(q,4)),_mm_add_epi32(_mm_slli_epi32(q,2),q));
+            const __m128i r = _mm_sub_epi32(x,q85);
+            digits[n5] = _mm_sub_epi32(_mm_add_epi32(r,c35),_mm_cmpgt_epi32(r,c56)); // Encode85Byte(...)
+            x = q;
+        }
+        // Bytes: digit 0 of the 4 groups, digit 1 of the 4 groups, ... -> transposed to: 5 digits of group 0, 5 digits of group 1, ...
+        const __m128i d0123 = _mm_packus_epi16(_mm_packs_epi32(digits[0],digits[1]),_mm_packs_epi32(digits[2],digits[3]));
+        const __m128i d4 = _mm_packus_epi16(_mm_packs_epi32(digits[4],digits[4]),digits[4]);
+#       ifdef IMGUISTRINGIFIER_ENABLE_SSSE3
+        _mm_storeu_si128((__m128i*)dst,_mm_or_si128(_mm_shuffle_epi8(d0123,_mm_setr_epi8(0,4,8,12,-1, 1,5,9,13,-1, 2,6,10,14,-1, 3)),
+                                                     _mm_shuffle_epi8(d4,_mm_setr_epi8(-1,-1,-1,-1,0, -1,-1,-1,-1,1, -1,-1,-1,-1,2, -1))));
+        const int last = _mm_cvtsi128_si32(_mm_or_si128(_mm_shuffle_epi8(d0123,_mm_setr_epi8(7,11,15,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1)),
+                                                        _mm_shuffle_epi8(d4,_mm_setr_epi8(-1,-1,-1,3,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1))));
+        memcpy(&dst[16],&last,4);
+#       else //IMGUISTRINGIFIER_ENABLE_SSSE3
+        unsigned char t[20];
+        _mm_storeu_si128((__m128i*)t,d0123);
+        const int t4 = _mm_cvtsi128_si32(d4);
+        memcpy(&t[16],&t4,4);
+        for (int g=0;g<4;g++) {
+            char* d = &dst[g*5];
+            d[0]=t[g];d[1]=t[4+g];d[2]=t[8+g];d[3]=t[12+g];d[4]=t[16+g];
+        }
+#       endif //IMGUISTRINGIFIER_ENABLE_SSSE3
+    }
+#   endif //IMGUISTRINGIFIER_ENABLE_SSE2
+    for (;numGroups>0;--numGroups,src+=4,dst+=5) {
+        unsigned int d = (unsigned int)src[0]|((unsigned int)src[1]<<8)|((unsigned int)src[2]<<16)|((unsigned int)src[3]<<24);
+        for (unsigned int n5 = 0; n5 < 5; n5++, d /= 85) dst[n5] = Encode85Byte(d);
+    }
+}
+// Encodes inputSize bytes into ((inputSize+3)/4)*5 chars. A trailing incomplete group is padded with zeros.
+static void Base85Encode(const unsigned char* src,int inputSize,char* dst)   {
+    const int numGroups = inputSize/4, rem = inputSize%4;
+    Base85EncodeGroups(src,numGroups,dst);
+    if (rem>0) {
+        unsigned char last[4] = {0,0,0,0};
+        memcpy(last,src+numGroups*4,rem);
+        Base85EncodeGroups(last,1,dst+numGroups*5);
+    }
+}
+
+
+// Streaming -------------------------------------------------------------------
+// Collects the output in a fixed-size buffer that is passed to the user callback when full
+struct StringifierSink {
+    enum {BUFFER_SIZE = 8192};
+    char buffer[BUFFER_SIZE];
+    int size;
+    StringifierWriteCallback writeCallback;
+    void* userPtr;
+    bool ok;
+    StringifierSink(StringifierWriteCallback _writeCallback,void* _userPtr) : size(0),writeCallback(_writeCallback),userPtr(_userPtr),ok(true) {}
+    inline bool flush() {
+        if (ok && size>0) ok = writeCallback(buffer,size,userPtr);
+        size = 0;
+        return ok;
+    }
+    inline void write(const char* data,int dataSize) {
+        while (dataSize>0 && ok) {
+            if (size==BUFFER_SIZE) flush();
+            int n = BUFFER_SIZE-size;if (n>dataSize) n=dataSize;
+            memcpy(&buffer[size],data,n);
+            size+=n;data+=n;dataSize-=n;
+        }
+    }
+    inline void put(char c) {if (size==BUFFER_SIZE) flush();buffer[size++]=c;}
+};
+static bool AppendToImVector(const char* data,int dataSize,void* userPtr) {
+    ImVector<char>& v = *((ImVector<char>*) userPtr);
+    const int start = v.size();
+    v.resize(start+dataSize);
+    memcpy(&v[start],data,dataSize);
+    return true;
+}
+
+static bool Base64Encode(const unsigned char* input,int inputSize,StringifierSink& sink)  {
+    enum {CHUNK_SIZE = 3*1024};    // A multiple of 3
+    char tmp[(CHUNK_SIZE/3)*4+8];
+    const int numFullBytes = (inputSize/3)*3;
+    for (int i=0;i<numFullBytes && sink.ok;i+=CHUNK_SIZE) {
+        const int n = numFullBytes-i < CHUNK_SIZE ? numFullBytes-i : CHUNK_SIZE;
+        sink.write(tmp,Base64EncodeGroups(&input[i],n,tmp));
+    }
+    sink.write(tmp,Base64EncodeTail(&input[numFullBytes],inputSize-numFullBytes,tmp));
+    return sink.flush();
+}
+static bool Base64Decode(const unsigned char* input,int inputSize,StringifierSink& sink)  {
+    enum {CHUNK_SIZE = 4096};
+    unsigned char tmp[(CHUNK_SIZE/4)*3+3+BASE64_DECODE_SLACK];
+    Base64DecodeState s;
+    for (int i=0;i<inputSize && sink.ok;i+=CHUNK_SIZE) {
+        const int n = inputSize-i < CHUNK_SIZE ? inputSize-i : CHUNK_SIZE;
+        sink.write((const char*)tmp,Base64DecodeChars(&input[i],n,tmp,s));
+    }
+    sink.write((const char*)tmp,Base64DecodeEnd(tmp,s));
+    return sink.flush();
+}
+static bool Base85Decode(const unsigned char* input,int inputSize,StringifierSink& sink)  {
+    enum {CHUNK_SIZE = 5*1024};    // A multiple of 5
+    unsigned char tmp[(CHUNK_SIZE/5)*4];
+    for (int i=0;i<inputSize && sink.ok;i+=CHUNK_SIZE) {
+        const int n = inputSize-i < CHUNK_SIZE ? inputSize-i : CHUNK_SIZE;
+        Base85Decode(&input[i],n,tmp);
+        sink.write((const char*)tmp,((n+4)/5)*4);
+    }
+    return sink.flush();
+}
+// Same output as Base85Encode(...) below without the final '\0'
+static bool Base85Encode(const unsigned char* input,int inputSize,StringifierSink& sink,bool outputStringifiedMode,int numCharsPerLineInStringifiedMode=112)  {
+    enum {CHUNK_SIZE = 4*1024};    // A multiple of 4
+    char tmp[(CHUNK_SIZE/4)*5];
     if (numCharsPerLineInStringifiedMode<=12) numCharsPerLineInStringifiedMode = 12;
-    if (outputStringifiedMode) output.push_back('"');
+    if (outputStringifiedMode) sink.put('"');
     char prev_c = 0;int cnt=0;
-    for (int src_i = 0; src_i < inputSize; src_i += 4)	{
-        unsigned int d = *(unsigned int*)(input + src_i);
-        for (unsigned int n5 = 0; n5 < 5; n5++, d /= 85)	{
-            char c = Encode85Byte(d);
-            if (outputStringifiedMode && c == '?' && prev_c == '?') output.push_back('\\');	// This is made a little more complicated by the fact that ??X sequences are interpreted as trigraphs by old C/C++ compilers. So we need to escape pairs of ??.
-            output.push_back(c);
-            prev_c = c;
-        }
-        cnt+=4;
-        if (outputStringifiedMode && cnt>=numCharsPerLineInStringifiedMode)	{
-            output.push_back('"');
-            output.push_back('	');
-            output.push_back('\\');
-            //output.push_back(' ');
-            output.push_back('\n');
-            output.push_back('"');
-            cnt=0;
+    for (int i=0;i<inputSize && sink.ok;i+=CHUNK_SIZE) {
+        const int n = inputSize-i < CHUNK_SIZE ? inputSize-i : CHUNK_SIZE;
+        Base85Encode(&input[i],n,tmp);
+        const int numChars = ((n+3)/4)*5;
+        if (!outputStringifiedMode) {sink.write(tmp,numChars);continue;}
+        for (int j=0;j<numChars;j+=5)  {
+            for (int n5 = 0; n5 < 5; n5++)	{
+                const char c = tmp[j+n5];
+                if (c == '?' && prev_c == '?') sink.put('\\');	// This is made a little more complicated by the fact that ??X sequences are interpreted as trigraphs by old C/C++ compilers. So we need to escape pairs of ??.
+                sink.put(c);
+                prev_c = c;
+            }
+            cnt+=4;
+            if (cnt>=numCharsPerLineInStringifiedMode)	{
+                sink.write("\"\t\\\n\"",5);
+                cnt=0;
+            }
         }
     }
     // End
-    if (outputStringifiedMode) {
-        output.push_back('"');
-        output.push_back(';');
-        output.push_back('\n');
-        output.push_back('\n');
+    if (outputStringifiedMode) sink.write("\";\n\n",4);
+    return sink.flush();
+}
+
+template <typename VectorChar> static bool Base64Decode(const char* input,VectorChar& output,int inputSize=-1)	{
+    output.clear();if (!input) return false;
+    if (inputSize<0) inputSize = (int)strlen(input);
+    output.resize((inputSize/4)*3+3+BASE64_DECODE_SLACK);
+    Base64DecodeState s;
+    int outputSize = Base64DecodeChars((const unsigned char*)input,inputSize,(unsigned char*)&output[0],s);
+    outputSize+=Base64DecodeEnd((unsigned char*)&output[outputSize],s);
+    output.resize(outputSize);
+    return true;
+}
+
+template <typename VectorChar> static bool Base64Encode(const char* input,int inputSize,VectorChar& output)	{
+    output.clear();if (!input || inputSize<=0) return false;
+    output.resize(Base64EncodedSize(inputSize));
+    const int numFullBytes = (inputSize/3)*3;
+    const int numChars = Base64EncodeGroups((const unsigned char*)input,numFullBytes,&output[0]);
+    Base64EncodeTail((const unsigned char*)&input[numFullBytes],inputSize-numFullBytes,&output[numChars]);
+    return true;
+}
+
+template <typename VectorChar> static bool Base85Decode(const char* input,VectorChar& output,int inputSize=-1)	{
+    output.clear();if (!input) return false;
+    if (inputSize<0) inputSize = (int)strlen(input);
+    const int outputSize = ((inputSize + 4) / 5) * 4;
+    output.resize(outputSize);
+    if (outputSize>0) Base85Decode((const unsigned char*)input,inputSize,(unsigned char*)&output[0]);
+    return true;
+}
+
+template <typename VectorChar> static bool Base85Encode(const char* input,int inputSize,VectorChar& output,bool outputStringifiedMode,int numCharsPerLineInStringifiedMode=112)	{
+    // Adapted from binary_to_compressed_c(...) inside imgui_draw.cpp
+    output.clear();if (!input || inputSize<=0) return false;
+    if (!outputStringifiedMode) {
+        const int numChars = ((inputSize+3)/4)*5;
+        output.resize(numChars+1);
+        Base85Encode((const unsigned char*)input,inputSize,&output[0]);
+        output[numChars] = '\0';	// End character
+        return true;
     }
+    output.reserve((int)((float)inputSize*1.3f));
+    StringifierSink sink(&AppendToImVector,&output);
+    Base85Encode((const unsigned char*)input,inputSize,sink,true,numCharsPerLineInStringifiedMode);
     output.push_back('\0');	// End character
-
     return true;
 }
 
@@ -435,6 +444,8 @@ template <typename VectorChar> static bool Base85Encode(const char* input,int in
 
 
 
+
+
 bool Base64Encode(const char* input,int inputSize,ImVector<char>& output,bool stringifiedMode,int numCharsPerLineInStringifiedMode)	{
     if (!stringifiedMode) return Stringifier::Base64Encode<ImVector<char> >(input,inputSize,output);
     else {
@@ -455,6 +466,28 @@ bool Base85Encode(const char* input,int inputSize,ImVector<char>& output,bool st
 bool Base85Decode(const char* input,ImVector<char>& output)	{
     return Stringifier::Base85Decode<ImVector<char> >(input,output);
 }
+bool Base64Encode(const char* input,int inputSize,StringifierWriteCallback writeCallback,void* userPtr)    {
+    if (!input || inputSize<=0 || !writeCallback) return false;
+    Stringifier::StringifierSink sink(writeCallback,userPtr);
+    return Stringifier::Base64Encode((const unsigned char*)input,inputSize,sink);
+}
+bool Base64Decode(const char* input,StringifierWriteCallback writeCallback,void* userPtr,int inputSize)    {
+    if (!input || !writeCallback) return false;
+    if (inputSize<0) inputSize = (int)strlen(input);
+    Stringifier::StringifierSink sink(writeCallback,userPtr);
+    return Stringifier::Base64Decode((const unsigned char*)input,inputSize,sink);
+}
+bool Base85Encode(const char* input,int inputSize,StringifierWriteCallback writeCallback,void* userPtr,bool stringifiedMode,int numCharsPerLineInStringifiedMode)    {
+    if (!input || inputSize<=0 || !writeCallback) return false;
+    Stringifier::StringifierSink sink(writeCallback,userPtr);
+    return Stringifier::Base85Encode((const unsigned char*)input,inputSize,sink,stringifiedMode,numCharsPerLineInStringifiedMode);
+}
+bool Base85Decode(const char* input,StringifierWriteCallback writeCallback,void* userPtr,int inputSize)    {
+    if (!input || !writeCallback) return false;
+    if (inputSize<0) inputSize = (int)strlen(input);
+    Stringifier::StringifierSink sink(writeCallback,userPtr);
+    return Stringifier::Base85Decode((const unsigned char*)input,inputSize,sink);
+}
 bool BinaryStringify(const char* input, int inputSize, ImVector<char>& output, int numInputBytesPerLineInStringifiedMode,bool serializeUnsignedBytes) {
     output.clear();
     if (!input || inputSize<=0) return false;
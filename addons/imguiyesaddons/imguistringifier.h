@@ -6,7 +6,7 @@
 #include <imgui.h>	// ImVector
 #endif //IMGUI_API
 
-// Base64Encode(...) and Base64Decode(...) embed libb64 (stripped from STL <iostream> header file):
+// Base64Encode(...) and Base64Decode(...) used to embed libb64 (stripped from STL <iostream> header file): they now use their own (SIMD) code, but keep its output format:
 // LIBB64 LICENSE (libb64.sourceforge.net):
 /*
 Copyright-Only Dedication (based on United States law) 
@@ -77,6 +77,15 @@ IMGUI_API bool Base64Decode(const char* input,ImVector<char>& output);
 IMGUI_API bool Base85Encode(const char* input,int inputSize,ImVector<char>& output,bool stringifiedMode=false,int numCharsPerLineInStringifiedMode=112);
 IMGUI_API bool Base85Decode(const char* input,ImVector<char>& output);
 
+// Streaming versions: the output is passed to writeCallback in chunks of a few KB, so that it's never stored in memory as a whole (e.g. writeCallback can fwrite(...) it).
+// They return false if writeCallback returns false (this stops the process). The encoded output is the same as above, without the final '\0' of Base85Encode(...).
+// Decoders take an optional inputSize (when -1 strlen(input) is used). Base64Encode(...) has no stringifiedMode here (because it's made by TextStringify(...)).
+typedef bool (*StringifierWriteCallback)(const char* data,int dataSize,void* userPtr);
+IMGUI_API bool Base64Encode(const char* input,int inputSize,StringifierWriteCallback writeCallback,void* userPtr);
+IMGUI_API bool Base64Decode(const char* input,StringifierWriteCallback writeCallback,void* userPtr,int inputSize=-1);
+IMGUI_API bool Base85Encode(const char* input,int inputSize,StringifierWriteCallback writeCallback,void* userPtr,bool stringifiedMode=false,int numCharsPerLineInStringifiedMode=112);
+IMGUI_API bool Base85Decode(const char* input,StringifierWriteCallback writeCallback,void* userPtr,int inputSize=-1);
+
 IMGUI_API bool BinaryStringify(const char* input, int inputSize, ImVector<char>& output, int numInputBytesPerLineInStringifiedMode=80, bool serializeUnsignedBytes=false);
 IMGUI_API bool TextStringify(const char* input,ImVector<char>& output,int numCharsPerLineInStringifiedMode=0,int inputSize=0);
 
@@ -0,0 +1,94 @@
+// Benchmark of the convolution filters of imguiimageeditor (Gaussian blur and Sobel, see ApplyConvolutionKernelNxN(...) in imguiimageeditor.cpp).
+// It filters random RGBA images of 4K (3840x2160) and 8K (7680x4320) pixels with a separable kernel (Gaussian blur) and with a non-separable one (Sobel),
+// prints the time of each filter, and checks some rows of the output against a plain (double precision) convolution.
+// These filters are private to imguiimageeditor.cpp: that's why this file includes imgui.cpp (that includes the addons), instead of linking it.
+//
+// [The current directory must be: imgui/examples/addons_examples]
+// g++ -O2 -I"../../" -I"../../addons" ../../imgui_draw.cpp ../../imgui_demo.cpp benchmark_convolution.cpp -D"IMGUI_INCLUDE_IMGUI_USER_H" -D"IMGUI_INCLUDE_IMGUI_USER_INL" -D"YES_IMGUIIMAGEEDITOR" -lpthread -o benchmark_convolution
+// Usage: ./benchmark_convolution [kernelSize=9] [numRepetitions=2]
+
+#include "imgui.cpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef IMGUIIMAGEEDITOR_H_
+#error "This benchmark needs: YES_IMGUIIMAGEEDITOR"
+#endif
+
+static int NumFailures = 0;
+
+// The plain convolution with clamped borders: clamp(sum(kernel*pixels)*factor,0,255)
+static int ReferencePixel(const unsigned char* im,int w,int h,int c,const ImGuiIE::real* kernel,int k,double factor,int x,int y,int ch) {
+    double d = 0.0;
+    for (int ky=0;ky<k;ky++) {
+        const int sy = ImClamp(y+ky-k/2,0,h-1);
+        for (int kx=0;kx<k;kx++) {
+            const int sx = ImClamp(x+kx-k/2,0,w-1);
+            d+=(double)kernel[ky*k+kx]*(double)im[(sy*w+sx)*c+ch];
+        }
+    }
+    d*=factor;
+    if (d<0.0) d=0.0;else if (d>255.0) d=255.0;
+    return (int)d;
+}
+// Checks some rows (the first, the last and a few in between): float sums can differ by one from the double ones
+static void CheckRows(const char* label,const unsigned char* im,const unsigned char* filtered,int w,int h,int c,const ImGuiIE::real* kernel,int k,double factor) {
+    const int rows[] = {0,1,h/3,h/2,h-2,h-1};
+    int maxDiff = 0;
+    for (int r=0;r<(int)(sizeof(rows)/sizeof(rows[0]));r++) {
+        const int y = rows[r];
+        for (int x=0;x<w;x++) {
+            for (int ch=0;ch<c;ch++) {
+                const int d = abs(ReferencePixel(im,w,h,c,kernel,k,factor,x,y,ch)-(int)filtered[(y*w+x)*c+ch]);
+                if (maxDiff<d) maxDiff=d;
+            }
+        }
+    }
+    if (maxDiff>1) {printf("  [FAILED: %s: max difference from the plain convolution: %d]\n",label,maxDiff);++NumFailures;}
+}
+
+int main(int argc,char** argv)
+{
+    const int kernelSize = argc>1 ? atoi(argv[1]) : 9;
+    const int numRepetitions = argc>2 ? atoi(argv[2]) : 2;
+    if (kernelSize<3 || kernelSize%2==0 || kernelSize>63 || numRepetitions<=0) {fprintf(stderr,"Usage: %s [kernelSize=9 (odd, in [3,63])] [numRepetitions=2]\n",argv[0]);return 1;}
+
+    ImGui::CreateContext();
+
+    const int c = 4;
+    ImVector<ImGuiIE::real> gaussianKernel,sobelKernel;
+    gaussianKernel.resize(kernelSize*kernelSize);sobelKernel.resize(kernelSize*kernelSize);
+    ImGuiIE::GenerateGaussianBlurConvolutionKernel(&gaussianKernel[0],kernelSize,kernelSize);
+    ImGuiIE::GenerateSobelConvolutionKernel(&sobelKernel[0],kernelSize,kernelSize);
+    printf("Kernel: %dx%d, RGBA images, %d repetitions, %d hardware threads\n",kernelSize,kernelSize,numRepetitions,ImGuiHelper::GetNumHardwareThreads());
+
+    const int sizes[2][2] = {{3840,2160},{7680,4320}};
+    for (int s=0;s<2;s++) {
+        const int w = sizes[s][0], h = sizes[s][1];
+        ImVector<unsigned char> im;im.resize(w*h*c);
+        unsigned int seed = 12345;
+        for (int i=0,isz=im.size();i<isz;i++) {seed = seed*1103515245u+12345u;im[i] = (unsigned char)(seed>>16);}
+        for (int f=0;f<2;f++) {
+            const bool gaussian = (f==0);
+            unsigned char* filtered = NULL;
+            const double startTime = ImGuiHelper::GetTimeInMilliseconds();
+            for (int r=0;r<numRepetitions;r++) {
+                if (filtered) STBI_FREE(filtered);
+                filtered = gaussian ? ImGuiIE::ApplyGaussianBlurNxN(&im[0],w,h,c,kernelSize) : ImGuiIE::ApplySobelNxN(&im[0],w,h,c,kernelSize);
+            }
+            const double ms = (ImGuiHelper::GetTimeInMilliseconds()-startTime)/(double)numRepetitions;
+            char label[64];sprintf(label,"%dx%d %s",w,h,gaussian ? "Gaussian blur (separable)" : "Sobel (not separable)");
+            printf("%-45s %9.2f ms %9.1f Mpixels/s\n",label,ms,ms>0 ? ((double)w*(double)h/1000000.0)/(ms/1000.0) : 0.0);
+            if (!filtered) {printf("  [FAILED: %s: no output]\n",label);++NumFailures;continue;}
+            // ApplySobelNxN(...) uses scaleFactor=1 and offset=0.5
+            CheckRows(label,&im[0],filtered,w,h,c,gaussian ? &gaussianKernel[0] : &sobelKernel[0],kernelSize,gaussian ? 1.0 : 1.5);
+            STBI_FREE(filtered);
+        }
+    }
+
+    ImGui::DestroyContext();
+    printf("%s\n",NumFailures==0 ? "All checks passed" : "Some checks FAILED");
+    return NumFailures==0 ? 0 : 1;
+}
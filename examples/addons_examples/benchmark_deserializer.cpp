@@ -0,0 +1,123 @@
+// Benchmark of ImGuiHelper::Deserializer (see imguihelper.h).
+// It writes a big layout file with ImGuiHelper::Serializer (all the field types, array fields and text fields), and then it loads and parses it:
+// a) with Deserializer(filename) (the file is memory-mapped, unless NO_IMGUIHELPER_SERIALIZATION_MMAP is defined).
+// b) with GetFileContent(...) + Deserializer(text,size) (the file is read into a buffer, and the buffer is copied).
+// Both must give the same fields and values (a checksum of them is compared).
+//
+// [The current directory must be: imgui/examples/addons_examples]
+// g++ -O2 -I"../../" ../../imgui.cpp ../../imgui_draw.cpp ../../imgui_demo.cpp benchmark_deserializer.cpp -D"IMGUI_INCLUDE_IMGUI_USER_H" -D"IMGUI_INCLUDE_IMGUI_USER_INL" -lpthread -o benchmark_deserializer
+// Usage: ./benchmark_deserializer [numItems=100000] [numRepetitions=3] [layoutFilePath=benchmark_deserializer.layout]
+
+#include <imgui.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (defined(NO_IMGUIHELPER) || defined(NO_IMGUIHELPER_SERIALIZATION) || defined(NO_IMGUIHELPER_SERIALIZATION_LOAD) || defined(NO_IMGUIHELPER_SERIALIZATION_SAVE))
+#error "This benchmark needs the serialization code of imguihelper"
+#endif
+
+struct ParseResult {
+    int numFields;
+    unsigned int checksum;
+    ParseResult() : numFields(0),checksum(0) {}
+    void add(const void* data,size_t size) {const unsigned char* p = (const unsigned char*) data;for (size_t i=0;i<size;i++) checksum = (checksum^p[i])*16777619u;}
+};
+static bool ParseCallback(ImGui::FieldType ft,int numArrayElements,void* pValue,const char* name,void* userPtr) {
+    ParseResult& r = *((ParseResult*)userPtr);
+    ++r.numFields;
+    r.add(name,strlen(name));
+    switch (ft) {
+    case ImGui::FT_FLOAT:
+    case ImGui::FT_COLOR:       r.add(pValue,sizeof(float)*numArrayElements);break;
+    case ImGui::FT_DOUBLE:      r.add(pValue,sizeof(double)*numArrayElements);break;
+    case ImGui::FT_INT:
+    case ImGui::FT_ENUM:        r.add(pValue,sizeof(int)*numArrayElements);break;
+    case ImGui::FT_UNSIGNED:    r.add(pValue,sizeof(unsigned)*numArrayElements);break;
+    case ImGui::FT_BOOL:        r.add(pValue,sizeof(bool)*numArrayElements);break;
+    default:                    r.add(pValue,strlen((const char*)pValue));break;   // FT_STRING, FT_TEXTLINE...
+    }
+    return false;
+}
+
+static unsigned int RandomSeed = 777;
+static unsigned int Random() {RandomSeed = RandomSeed*1103515245u+12345u;return RandomSeed>>8;}
+
+static bool WriteLayout(const char* path,int numItems) {
+    ImGuiHelper::Serializer s(path);
+    if (!s.isValid()) return false;
+    char name[64];
+    for (int i=0;i<numItems;i++)    {
+        sprintf(name,"item%d",i);
+        float f[4];for (int k=0;k<4;k++) f[k] = (float)((int)(Random()%2000000)-1000000)*0.001f*(k==3 ? 1000.f : 1.f);
+        int iv[3];for (int k=0;k<3;k++) iv[k] = (int)Random()-(1<<23);
+        unsigned u = Random()*97u;
+        double d[2] = {(double)Random()*1e-3,-1.0/(double)(1+Random()%1000)};
+        bool b[2] = {(Random()&1)!=0,true};
+        s.save(f,name,4,(int)(Random()%8));
+        s.save(iv,name,3);
+        s.save(&u,name);
+        s.save(d,name,2,12);
+        s.save(b,name,2);
+        s.save(ImGui::FT_COLOR,f,name,4,5);
+        if (i%10==0) {
+            s.save("hello \"world\"\nsecond line",name);
+            s.saveTextLines("line one\nline two\nline three",name);
+        }
+    }
+    return true;
+}
+
+int main(int argc,char** argv)
+{
+    const int numItems = argc>1 ? atoi(argv[1]) : 100000;
+    const int numRepetitions = argc>2 ? atoi(argv[2]) : 3;
+    const char* path = argc>3 ? argv[3] : "benchmark_deserializer.layout";
+    if (numItems<=0 || numRepetitions<=0) {fprintf(stderr,"Usage: %s [numItems=100000] [numRepetitions=3] [layoutFilePath=benchmark_deserializer.layout]\n",argv[0]);return 1;}
+
+    ImGui::CreateContext();
+
+    double startTime = ImGuiHelper::GetTimeInMilliseconds();
+    if (!WriteLayout(path,numItems)) {fprintf(stderr,"Can't write: %s\n",path);return 1;}
+    const double writeTime = ImGuiHelper::GetTimeInMilliseconds()-startTime;
+    ImVector<char> content;
+    ImGuiHelper::GetFileContent(path,content);
+    printf("Layout file: %s (%d items, %.2f MB), written in %.2f ms\n",path,numItems,(double)content.size()/(1024.0*1024.0),writeTime);
+
+    ParseResult mapped,buffered;
+    double mappedLoadTime=0,mappedParseTime=0,bufferedLoadTime=0,bufferedParseTime=0;
+    for (int r=0;r<numRepetitions;r++)  {
+        mapped = ParseResult();buffered = ParseResult();
+        {
+            startTime = ImGuiHelper::GetTimeInMilliseconds();
+            ImGuiHelper::Deserializer d(path);
+            const double loadedTime = ImGuiHelper::GetTimeInMilliseconds();
+            d.parse(&ParseCallback,&mapped);
+            mappedLoadTime+=loadedTime-startTime;
+            mappedParseTime+=ImGuiHelper::GetTimeInMilliseconds()-loadedTime;
+        }
+        {
+            startTime = ImGuiHelper::GetTimeInMilliseconds();
+            ImGuiHelper::GetFileContent(path,content);
+            ImGuiHelper::Deserializer d(&content[0],(size_t)content.size());
+            const double loadedTime = ImGuiHelper::GetTimeInMilliseconds();
+            d.parse(&ParseCallback,&buffered);
+            bufferedLoadTime+=loadedTime-startTime;
+            bufferedParseTime+=ImGuiHelper::GetTimeInMilliseconds()-loadedTime;
+        }
+    }
+    const double n = (double)numRepetitions;
+#   ifndef NO_IMGUIHELPER_SERIALIZATION_MMAP
+    const char* fileLabel = "Deserializer(filename) [mmap]";
+#   else //NO_IMGUIHELPER_SERIALIZATION_MMAP
+    const char* fileLabel = "Deserializer(filename) [read]";
+#   endif //NO_IMGUIHELPER_SERIALIZATION_MMAP
+    printf("%-40s load %8.2f ms  parse %8.2f ms  (%d fields)\n",fileLabel,mappedLoadTime/n,mappedParseTime/n,mapped.numFields);
+    printf("%-40s load %8.2f ms  parse %8.2f ms  (%d fields)\n","GetFileContent(...) + Deserializer(text)",bufferedLoadTime/n,bufferedParseTime/n,buffered.numFields);
+    const bool ok = (mapped.numFields==buffered.numFields && mapped.checksum==buffered.checksum && mapped.numFields>=numItems*6);
+    printf("%s\n",ok ? "Same fields and values" : "The two parsed layouts are DIFFERENT");
+
+    if (argc<=3) remove(path);
+    ImGui::DestroyContext();
+    return ok ? 0 : 1;
+}
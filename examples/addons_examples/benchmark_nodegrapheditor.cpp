@@ -0,0 +1,213 @@
+// Benchmark of the link queries of imguinodegrapheditor (see NodeGraphEditor::addLink(...), isLinkPresent(...) and isNodeReachableFrom(...) in imguinodegrapheditor.h).
+// It needs no window: it generates a random DAG (every node is linked to random nodes created before it), and it measures:
+// a) addLink(...) with the duplicate check, isLinkPresent(...) and getInputNodesForNodeAndSlot(...) on all the links.
+// b) random isNodeReachableFrom(...) queries (most of them fail, after exploring all the nodes downstream of the start node).
+// c) the same queries after removing random links and all the links of some nodes.
+// d) a query through a "diamond ladder" (every level is reachable through two paths), that used to take exponential time.
+// The reachability results are checked against a plain breadth-first search on a copy of the links.
+//
+// [The current directory must be: imgui/examples/addons_examples]
+// g++ -O2 -I"../../" ../../imgui.cpp ../../imgui_draw.cpp ../../imgui_demo.cpp benchmark_nodegrapheditor.cpp -D"IMGUI_INCLUDE_IMGUI_USER_H" -D"IMGUI_INCLUDE_IMGUI_USER_INL" -lpthread -o benchmark_nodegrapheditor
+// Usage: ./benchmark_nodegrapheditor [numNodes=20000] [numQueries=1000] [numDiamondLevels=100]
+
+#include <imgui.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef IMGUINODEGRAPHEDITOR_H_
+#error "This benchmark needs imguinodegrapheditor (don't define NO_IMGUINODEGRAPHEDITOR)"
+#endif
+
+static int NumFailures = 0;
+static void Check(bool ok,const char* what) {if (!ok) {printf("  [FAILED: %s]\n",what);++NumFailures;}}
+
+static unsigned int RandomSeed = 777;
+static unsigned int Random() {RandomSeed = RandomSeed*1103515245u+12345u;return RandomSeed>>8;}
+
+static void PrintResult(const char* label,double milliseconds,int numOperations)   {
+    printf("%-45s %9.2f ms %9.3f us/op\n",label,milliseconds,numOperations>0 ? milliseconds*1000.0/(double)numOperations : 0.0);
+}
+#define BENCHMARK(label,numOperations,code) {                                       \
+    const double startTime = ImGuiHelper::GetTimeInMilliseconds();                  \
+    {code;}                                                                         \
+    PrintResult(label,ImGuiHelper::GetTimeInMilliseconds()-startTime,numOperations); \
+}
+
+// A node with 3 input slots and 2 output slots, and no fields
+class BenchmarkNode : public ImGui::Node {
+    public:
+    static BenchmarkNode* Create(const ImVec2& pos) {
+        BenchmarkNode* node = (BenchmarkNode*) ImGui::MemAlloc(sizeof(BenchmarkNode));IM_PLACEMENT_NEW (node) BenchmarkNode();
+        node->init("BenchmarkNode",pos,"a;b;c","x;y",0);
+        return node;
+    }
+};
+static const char* NodeTypeNames[1] = {"BenchmarkNode"};
+static ImGui::Node* NodeFactory(int /*nodeType*/,const ImVec2& pos,const ImGui::NodeGraphEditor& /*nge*/) {return BenchmarkNode::Create(pos);}
+enum {NumInputSlots=3,NumOutputSlots=2};
+
+// A copy of the links, for the reference results
+struct Edge {
+    int from,fromSlot,to,toSlot;
+    bool removed;
+};
+struct ReferenceGraph {
+    ImVector<int> start,targets,visited,queue;  // start[n]..start[n+1] are the indices (in targets) of the nodes linked from the outputs of node n
+    int numNodes;
+    void build(const ImVector<Edge>& edges,int _numNodes)   {
+        numNodes = _numNodes;
+        start.resize(numNodes+1);memset(&start[0],0,start.size()*sizeof(int));
+        for (int i=0;i<edges.size();i++) if (!edges[i].removed) ++start[edges[i].from+1];
+        for (int n=0;n<numNodes;n++) start[n+1]+=start[n];
+        targets.resize(start[numNodes]>0 ? start[numNodes] : 1);
+        ImVector<int> pos = start;
+        for (int i=0;i<edges.size();i++) if (!edges[i].removed) targets[pos[edges[i].from]++] = edges[i].to;
+        visited.resize(numNodes);
+    }
+    // Like NodeGraphEditor::isNodeReachableFrom(node1,false,nodeToFind): follows the links from the outputs of node1
+    bool isReachable(int from,int to)   {
+        memset(&visited[0],0,visited.size()*sizeof(int));
+        queue.resize(0);queue.push_back(from);
+        for (int q=0;q<queue.size();q++)    {
+            const int n = queue[q];
+            for (int i=start[n];i<start[n+1];i++)   {
+                const int t = targets[i];
+                if (t==to) return true;
+                if (!visited[t]) {visited[t]=1;queue.push_back(t);}
+            }
+        }
+        return false;
+    }
+};
+
+struct Query {int from,to;};
+
+// Runs all the queries, and returns the number of results that differ from the reference ones
+static int RunQueries(const char* label,const ImGui::NodeGraphEditor& nge,const ImVector<ImGui::Node*>& nodes,const ImVector<Query>& queries,ReferenceGraph& ref,int& numReachableOut)   {
+    ImVector<char> results;results.resize(queries.size());
+    BENCHMARK(label,queries.size(),
+        for (int i=0;i<queries.size();i++) results[i] = nge.isNodeReachableFrom(nodes[queries[i].from],false,nodes[queries[i].to]) ? 1 : 0;
+    );
+    int numMismatches = 0;numReachableOut = 0;
+    for (int i=0;i<queries.size();i++)  {
+        const char expected = ref.isReachable(queries[i].from,queries[i].to) ? 1 : 0;
+        if (results[i]!=expected) ++numMismatches;
+        numReachableOut+=expected;
+    }
+    return numMismatches;
+}
+
+int main(int argc,char** argv)
+{
+    const int numNodes = argc>1 ? atoi(argv[1]) : 20000;
+    const int numQueries = argc>2 ? atoi(argv[2]) : 1000;
+    const int numDiamondLevels = argc>3 ? atoi(argv[3]) : 100;
+    if (numNodes<2 || numQueries<=0 || numDiamondLevels<=0) {fprintf(stderr,"Usage: %s [numNodes=20000] [numQueries=1000] [numDiamondLevels=100]\n",argv[0]);return 1;}
+
+    ImGui::CreateContext();
+
+    // The random DAG: every input slot of node i (i>0) is linked to an output slot of a random node j<i
+    ImVector<Edge> edges;
+    for (int i=1;i<numNodes;i++)    {
+        for (int s=0;s<NumInputSlots;s++)   {
+            Edge e;e.from = (int)(Random()%(unsigned)i);e.fromSlot = (int)(Random()%NumOutputSlots);e.to = i;e.toSlot = s;e.removed = false;
+            edges.push_back(e);
+        }
+    }
+    printf("Random DAG: %d nodes, %d links\n",numNodes,edges.size());
+
+    ImGui::NodeGraphEditor nge(true,true,false,true);
+    nge.registerNodeTypes(NodeTypeNames,1,NodeFactory);
+    ImVector<ImGui::Node*> nodes;nodes.resize(numNodes);
+    for (int i=0;i<numNodes;i++) nodes[i] = nge.addNode(0,ImVec2((float)(i%100)*150.f,(float)(i/100)*100.f));
+
+    int numAdded = 0,numPresent = 0;
+    BENCHMARK("addLink(...,checkIfAlreadyPresent=true)",edges.size()*2,
+        // every link is added twice: the second time it must be found
+        for (int i=0;i<edges.size();i++) {const Edge& e = edges[i];if (nge.addLink(nodes[e.from],e.fromSlot,nodes[e.to],e.toSlot,true)) ++numAdded;}
+        for (int i=0;i<edges.size();i++) {const Edge& e = edges[i];if (nge.addLink(nodes[e.from],e.fromSlot,nodes[e.to],e.toSlot,true)) ++numAdded;}
+    );
+    Check(numAdded==edges.size(),"addLink(...) must skip the duplicate links");
+    BENCHMARK("isLinkPresent(...)",edges.size()*2,
+        // the second loop asks for links with the wrong output slot (that may or may not exist)
+        for (int i=0;i<edges.size();i++) {const Edge& e = edges[i];if (nge.isLinkPresent(nodes[e.from],e.fromSlot,nodes[e.to],e.toSlot)) ++numPresent;}
+        for (int i=0;i<edges.size();i++) {const Edge& e = edges[i];nge.isLinkPresent(nodes[e.from],1-e.fromSlot,nodes[e.to],e.toSlot);}
+    );
+    Check(numPresent==edges.size(),"isLinkPresent(...) must find all the links");
+    ImVector<ImGui::Node*> inputNodes;
+    int numInputNodes = 0;
+    BENCHMARK("getInputNodesForNodeAndSlot(...)",numNodes*NumInputSlots,
+        for (int i=0;i<numNodes;i++) {for (int s=0;s<NumInputSlots;s++) {nge.getInputNodesForNodeAndSlot(nodes[i],s,inputNodes);numInputNodes+=inputNodes.size();}}
+    );
+    Check(numInputNodes==edges.size(),"getInputNodesForNodeAndSlot(...) must return all the links");
+
+    // Half of the queries go from an older node to a newer one (some of them are reachable),
+    // the other half go backward (never reachable: the whole subgraph downstream is explored)
+    ImVector<Query> queries;queries.resize(numQueries);
+    for (int i=0;i<numQueries;i++)  {
+        int a = (int)(Random()%(unsigned)numNodes),b = (int)(Random()%(unsigned)numNodes);
+        if (a==b) b = (a+1)%numNodes;
+        if ((a<b) != (i%2==0)) {const int tmp=a;a=b;b=tmp;}
+        queries[i].from = a;queries[i].to = b;
+    }
+    ReferenceGraph ref;ref.build(edges,numNodes);
+    int numReachable = 0;
+    int numMismatches = RunQueries("isNodeReachableFrom(...)",nge,nodes,queries,ref,numReachable);
+    printf("  (%d reachable, %d unreachable)\n",numReachable,numQueries-numReachable);
+    Check(numMismatches==0,"isNodeReachableFrom(...) differs from the reference");
+
+    // Removes 10% of the links one by one, and all the links of 1% of the nodes
+    const int numLinksToRemove = edges.size()/10,numNodesToUnlink = numNodes/100;
+    int numRemoved = 0;
+    ImVector<int> nodesToUnlink;
+    for (int i=0;i<numNodesToUnlink;i++) nodesToUnlink.push_back((int)(Random()%(unsigned)numNodes));
+    BENCHMARK("removeLink(...) + removeAnyLinkFromNode(...)",numLinksToRemove+numNodesToUnlink,
+        for (int i=0;i<numLinksToRemove;i++)    {
+            Edge& e = edges[(int)(Random()%(unsigned)edges.size())];
+            if (!e.removed && nge.removeLink(nodes[e.from],e.fromSlot,nodes[e.to],e.toSlot)) ++numRemoved;
+            e.removed = true;
+        }
+        for (int i=0;i<nodesToUnlink.size();i++) nge.removeAnyLinkFromNode(nodes[nodesToUnlink[i]]);
+    );
+    int numRemovedByRemoveLink = 0;
+    for (int i=0;i<edges.size();i++) if (edges[i].removed) ++numRemovedByRemoveLink;
+    Check(numRemoved==numRemovedByRemoveLink,"removeLink(...) must remove every existing link once");
+    for (int i=0;i<nodesToUnlink.size();i++)    {
+        ImGui::Node* n = nodes[nodesToUnlink[i]];
+        Check(!nge.hasLinks(n),"removeAnyLinkFromNode(...) must leave no links");
+        for (int k=0;k<edges.size();k++) {Edge& e = edges[k];if (nodes[e.from]==n || nodes[e.to]==n) e.removed = true;}
+    }
+    ref.build(edges,numNodes);
+    numMismatches = RunQueries("isNodeReachableFrom(...) after the removals",nge,nodes,queries,ref,numReachable);
+    printf("  (%d reachable, %d unreachable)\n",numReachable,numQueries-numReachable);
+    Check(numMismatches==0,"isNodeReachableFrom(...) after the removals differs from the reference");
+
+    // Diamond ladder: top -> (left,right) -> bottom -> (left,right) -> bottom ... (2^numDiamondLevels paths from the top to the last node)
+    {
+        ImGui::NodeGraphEditor ladder(true,true,false,true);
+        ladder.registerNodeTypes(NodeTypeNames,1,NodeFactory);
+        ImGui::Node* top = ladder.addNode(0);
+        ImGui::Node* first = top;
+        for (int l=0;l<numDiamondLevels;l++)    {
+            ImGui::Node* left = ladder.addNode(0);
+            ImGui::Node* right = ladder.addNode(0);
+            ImGui::Node* bottom = ladder.addNode(0);
+            ladder.addLink(top,0,left,0);ladder.addLink(top,1,right,0);
+            ladder.addLink(left,0,bottom,0);ladder.addLink(right,0,bottom,1);
+            top = bottom;
+        }
+        ImGui::Node* isolated = ladder.addNode(0);
+        bool found = false,notFound = true;
+        BENCHMARK("isNodeReachableFrom(...) on a diamond ladder",2,
+            found = ladder.isNodeReachableFrom(first,false,top);
+            notFound = ladder.isNodeReachableFrom(first,false,isolated);
+        );
+        printf("  (%d levels, %d nodes)\n",numDiamondLevels,ladder.getNumNodes());
+        Check(found && !notFound,"isNodeReachableFrom(...) on the diamond ladder");
+    }
+
+    ImGui::DestroyContext();
+    printf("%s\n",NumFailures==0 ? "All checks passed" : "Some checks FAILED");
+    return NumFailures==0 ? 0 : 1;
+}
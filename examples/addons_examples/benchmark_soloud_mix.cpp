@@ -0,0 +1,92 @@
+// Benchmark of the multi-threaded mixing of imguisoloud (see Soloud::setMixThreadCount(...) in imguisoloud.h).
+// It needs no audio device and no window: SoLoud uses its null driver, and Soloud::mix(...) is called directly.
+// It plays many looping voices (with different speeds, so that they are resampled) and it mixes the same number of blocks
+// with different numbers of mixing threads. It also checks that the output does not depend on the number of threads.
+//
+// [The current directory must be: imgui/examples/addons_examples]
+// g++ -O2 -I"../../" ../../imgui.cpp ../../imgui_draw.cpp ../../imgui_demo.cpp benchmark_soloud_mix.cpp -D"IMGUI_INCLUDE_IMGUI_USER_H" -D"IMGUI_INCLUDE_IMGUI_USER_INL" -D"YES_IMGUISOLOUD" -D"WITH_NULLDRIVER" -D"WITH_NULL" -lpthread -o benchmark_soloud_mix
+// Usage: ./benchmark_soloud_mix [numVoices=256] [numBlocks=200]
+
+#include <imgui.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if (!defined(YES_IMGUISOLOUD) || !defined(WITH_NULL) || defined(NO_IMGUISOLOUD_WAV))
+#error "This benchmark needs: YES_IMGUISOLOUD, WITH_NULLDRIVER and WITH_NULL (and SoLoud::Wav)"
+#endif
+
+static const unsigned int BlockSize = 2048;     // samples per channel
+static const unsigned int NumChannels = 2;
+static const int NumWaves = 16;
+
+// Mixes numBlocks blocks with numVoices voices into output, and returns the elapsed time in milliseconds
+static double RunMix(int mixThreadCount,int numVoices,int numBlocks,SoLoud::Wav* waves,ImVector<float>& output,int& usedMixThreadCount)   {
+    SoLoud::Soloud soloud;
+    if (soloud.init(SoLoud::Soloud::CLIP_ROUNDOFF,SoLoud::Soloud::NULLDRIVER,44100,BlockSize,NumChannels)!=0) {
+        fprintf(stderr,"Can't initialize the SoLoud null driver\n");
+        exit(1);
+    }
+    soloud.setMixThreadCount(mixThreadCount);
+    soloud.setMaxActiveVoiceCount(numVoices);
+    for (int i=0;i<numVoices;i++)   {
+        SoLoud::handle h = soloud.play(waves[i%NumWaves],0.5f/(float)numVoices,(float)((i%9)-4)/4.f);
+        soloud.setRelativePlaySpeed(h,0.7f+(float)(i%11)*0.07f);
+    }
+    output.resize(numBlocks*BlockSize*NumChannels);
+    const double startTime = ImGuiHelper::GetTimeInMilliseconds();
+    for (int b=0;b<numBlocks;b++) soloud.mix(&output[b*BlockSize*NumChannels],BlockSize);
+    const double elapsedTime = ImGuiHelper::GetTimeInMilliseconds()-startTime;
+    usedMixThreadCount = soloud.getMixThreadCount();
+    soloud.deinit();
+    return elapsedTime;
+}
+
+int main(int argc,char** argv)
+{
+    const int numVoices = argc>1 ? atoi(argv[1]) : 256;
+    const int numBlocks = argc>2 ? atoi(argv[2]) : 200;
+    if (numVoices<=0 || numBlocks<=0) {fprintf(stderr,"Usage: %s [numVoices=256] [numBlocks=200]\n",argv[0]);return 1;}
+
+    ImGui::CreateContext();
+
+    // One second of a few waves (a sine plus its third harmonic at different frequencies), played in loop
+    static SoLoud::Wav waves[NumWaves];
+    for (int i=0;i<NumWaves;i++)    {
+        const unsigned int numSamples = 44100;
+        float* samples = new float[numSamples];     // SoLoud::Wav takes its ownership
+        const float freq = 110.f*(1.f+(float)i*0.25f);
+        for (unsigned int s=0;s<numSamples;s++) {
+            const float t = 2.f*3.14159265f*freq*(float)s/44100.f;
+            samples[s] = 0.7f*sinf(t)+0.3f*sinf(3.f*t);
+        }
+        waves[i].loadRawWave(samples,numSamples,44100.f,1,false,true);
+        waves[i].setLooping(true);
+    }
+
+    printf("Mixing %d blocks of %u samples with %d voices (%d hardware threads)\n",numBlocks,BlockSize,numVoices,ImGuiHelper::GetNumHardwareThreads());
+    const int threadCounts[] = {0,1,2,4,-1};
+    ImVector<float> reference,output;
+    double singleThreadedTime = 0;
+    for (int t=0;t<(int)(sizeof(threadCounts)/sizeof(threadCounts[0]));t++)   {
+        int usedThreadCount = 0;
+        const double time = RunMix(threadCounts[t],numVoices,numBlocks,waves,t==0 ? reference : output,usedThreadCount);
+        if (t==0) singleThreadedTime = time;
+        const double audioTime = (double)numBlocks*BlockSize*1000.0/44100.0;
+        printf("setMixThreadCount(%2d): %d mixing threads: %8.2f ms (%6.2f%% of real time, speedup %.2fx)",threadCounts[t],usedThreadCount,time,100.0*time/audioTime,time>0 ? singleThreadedTime/time : 0.0);
+        if (t>0 && usedThreadCount>0) {
+            // The voices are mixed in fixed groups and summed in order, so all the multi-threaded runs give the same output
+            static ImVector<float> firstParallelOutput;
+            if (firstParallelOutput.size()==0) firstParallelOutput = output;
+            else if (firstParallelOutput.size()!=output.size() || memcmp(&firstParallelOutput[0],&output[0],output.size()*sizeof(float))!=0) printf(" [OUTPUT MISMATCH]");
+            float maxDiff = 0.f;
+            for (int i=0;i<output.size();i++) {const float d = fabsf(output[i]-reference[i]);if (maxDiff<d) maxDiff=d;}
+            printf(" [max difference from single-threaded: %g]",maxDiff);
+        }
+        printf("\n");
+    }
+
+    ImGui::DestroyContext();
+    return 0;
+}
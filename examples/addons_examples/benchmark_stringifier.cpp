@@ -0,0 +1,76 @@
+// Benchmark of the Base64/Base85 codecs of imguistringifier (see imguistringifier.h).
+// It encodes and decodes a buffer of random bytes (plain and stringified output, ImVector and streaming versions),
+// prints the throughput of each operation, and checks that the decoded data is the same as the input.
+//
+// [The current directory must be: imgui/examples/addons_examples]
+// g++ -O2 -I"../../" ../../imgui.cpp ../../imgui_draw.cpp ../../imgui_demo.cpp benchmark_stringifier.cpp -D"IMGUI_INCLUDE_IMGUI_USER_H" -D"IMGUI_INCLUDE_IMGUI_USER_INL" -D"YES_IMGUISTRINGIFIER" -lpthread -o benchmark_stringifier
+// Usage: ./benchmark_stringifier [sizeInMegaBytes=16] [numRepetitions=3]
+
+#include <imgui.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef YES_IMGUISTRINGIFIER
+#error "This benchmark needs: YES_IMGUISTRINGIFIER"
+#endif
+
+static int NumFailures = 0;
+static void Check(bool ok,const char* what) {if (!ok) {printf("  [FAILED: %s]\n",what);++NumFailures;}}
+
+// A StringifierWriteCallback that just counts the bytes (so that we measure the encoder, not the disk)
+static bool CountBytesCallback(const char* /*data*/,int dataSize,void* userPtr) {*((size_t*)userPtr)+=(size_t)dataSize;return true;}
+
+static void PrintResult(const char* label,double totalMilliseconds,int numRepetitions,int inputSize)   {
+    const double ms = totalMilliseconds/(double)numRepetitions;
+    printf("%-40s %9.2f ms %9.1f MB/s\n",label,ms,ms>0 ? ((double)inputSize/(1024.0*1024.0))/(ms/1000.0) : 0.0);
+}
+#define BENCHMARK(label,sizeForThroughput,code) {                                    \
+    const double startTime = ImGuiHelper::GetTimeInMilliseconds();                 \
+    for (int r=0;r<numRepetitions;r++) {code;}                                      \
+    PrintResult(label,ImGuiHelper::GetTimeInMilliseconds()-startTime,numRepetitions,sizeForThroughput); \
+}
+
+int main(int argc,char** argv)
+{
+    const int sizeInMegaBytes = argc>1 ? atoi(argv[1]) : 16;
+    const int numRepetitions = argc>2 ? atoi(argv[2]) : 3;
+    if (sizeInMegaBytes<=0 || sizeInMegaBytes>256 || numRepetitions<=0) {fprintf(stderr,"Usage: %s [sizeInMegaBytes=16 (max 256)] [numRepetitions=3]\n",argv[0]);return 1;}
+
+    ImGui::CreateContext();
+
+    const int N = sizeInMegaBytes*1024*1024;
+    ImVector<char> input;input.resize(N);
+    unsigned int seed = 12345;
+    for (int i=0;i<N;i++) {seed = seed*1103515245u+12345u;input[i] = (char)(seed>>16);}
+    ImVector<char> encoded,decoded;
+    size_t numStreamedBytes = 0;
+    printf("Input: %d MB of random bytes, %d repetitions (throughput measured on the input size)\n",sizeInMegaBytes,numRepetitions);
+
+    // Base64
+    BENCHMARK("Base64Encode",N,ImGui::Base64Encode(&input[0],N,encoded));
+    const size_t base64EncodedSize = (size_t)encoded.size();
+    encoded.push_back('\0');
+    BENCHMARK("Base64Decode",N,ImGui::Base64Decode(&encoded[0],decoded));
+    Check(decoded.size()==N && memcmp(&decoded[0],&input[0],N)==0,"Base64 round trip");
+    BENCHMARK("Base64Encode (stringified)",N,ImGui::Base64Encode(&input[0],N,encoded,true));
+    BENCHMARK("Base64Decode (stringified input)",N,ImGui::Base64Decode(&encoded[0],decoded));
+    Check(decoded.size()==N && memcmp(&decoded[0],&input[0],N)==0,"Base64 stringified round trip");
+    BENCHMARK("Base64Encode (streaming)",N,numStreamedBytes=0;ImGui::Base64Encode(&input[0],N,&CountBytesCallback,&numStreamedBytes));
+    Check(numStreamedBytes==base64EncodedSize,"Base64 streaming output size");
+
+    // Base85 (the decoded size is rounded up to a multiple of 4)
+    BENCHMARK("Base85Encode",N,ImGui::Base85Encode(&input[0],N,encoded));
+    BENCHMARK("Base85Decode",N,ImGui::Base85Decode(&encoded[0],decoded));
+    Check(decoded.size()>=N && memcmp(&decoded[0],&input[0],N)==0,"Base85 round trip");
+    BENCHMARK("Base85Encode (stringified)",N,ImGui::Base85Encode(&input[0],N,encoded,true));
+    BENCHMARK("Base85Encode (streaming)",N,numStreamedBytes=0;ImGui::Base85Encode(&input[0],N,&CountBytesCallback,&numStreamedBytes));
+    ImGui::Base85Encode(&input[0],N,encoded);
+    Check(numStreamedBytes+1==(size_t)encoded.size(),"Base85 streaming output size");
+    BENCHMARK("Base85Decode (streaming)",N,numStreamedBytes=0;ImGui::Base85Decode(&encoded[0],&CountBytesCallback,&numStreamedBytes));
+    Check(numStreamedBytes==(size_t)decoded.size(),"Base85 streaming decoded size");
+
+    ImGui::DestroyContext();
+    printf("%s\n",NumFailures==0 ? "All checks passed" : "Some checks FAILED");
+    return NumFailures==0 ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+// Benchmark of the UTF-8 text functions of imgui (ImTextStrFromUtf8(...), ImTextCountCharsFromUtf8(...) and ImFont::CalcTextSizeA(...)).
+// It needs no window (it just builds the default font). It generates three texts with the same number of characters:
+// a) ASCII only (where the runs of ASCII characters are scanned with SSE2/NEON, unless IMGUI_DISABLE_SSE is defined).
+// b) Latin-1 (western european words, with many 2-byte characters).
+// c) CJK (3-byte characters, with a few ASCII spaces and punctuation marks).
+// It prints the time of each function on each text, and checks the results against a plain decoder that reads one character at a time.
+//
+// [The current directory must be: imgui/examples/addons_examples]
+// g++ -O2 -I"../../" ../../imgui.cpp ../../imgui_draw.cpp ../../imgui_demo.cpp benchmark_utf8.cpp -D"IMGUI_INCLUDE_IMGUI_USER_H" -D"IMGUI_INCLUDE_IMGUI_USER_INL" -lpthread -o benchmark_utf8
+// Usage: ./benchmark_utf8 [numCharsInThousands=100] [numRepetitions=100]
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+static int NumFailures = 0;
+static void Check(bool ok,const char* what) {if (!ok) {printf("  [FAILED: %s]\n",what);++NumFailures;}}
+
+static unsigned int RandomSeed = 12345;
+static unsigned int Random() {RandomSeed = RandomSeed*1103515245u+12345u;return RandomSeed>>8;}
+
+static void PrintResult(const char* label,double totalMilliseconds,int numRepetitions,int textSize)   {
+    const double ms = totalMilliseconds/(double)numRepetitions;
+    printf("%-40s %9.3f ms %9.1f MB/s\n",label,ms,ms>0 ? ((double)textSize/(1024.0*1024.0))/(ms/1000.0) : 0.0);
+}
+#define BENCHMARK(label,textSize,code) {                                            \
+    const double startTime = ImGuiHelper::GetTimeInMilliseconds();                  \
+    for (int r=0;r<numRepetitions;r++) {code;}                                      \
+    PrintResult(label,ImGuiHelper::GetTimeInMilliseconds()-startTime,numRepetitions,textSize); \
+}
+
+// Appends random words (picked from 'words', separated by single spaces) until the text has numChars characters; a line is about 80 characters long
+static void GenerateText(ImVector<char>& text,const char** words,int numWords,int numChars)    {
+    text.resize(0);
+    int count = 0,lineLength = 0;
+    while (count<numChars)  {
+        const char* w = words[Random()%(unsigned)numWords];
+        const int wordLength = ImTextCountCharsFromUtf8(w,NULL);
+        for (const char* p=w;*p;p++) text.push_back(*p);
+        count+=wordLength;lineLength+=wordLength;
+        if (lineLength>=80) {text.push_back('\n');lineLength=0;}
+        else text.push_back(' ');
+        ++count;
+    }
+    text.push_back('\0');
+}
+
+// The plain decoders: one ImTextCharFromUtf8(...) call per character
+static int ReferenceStrFromUtf8(ImWchar* buf,int buf_size,const char* in_text,const char* in_text_end)  {
+    ImWchar* buf_out = buf;
+    ImWchar* buf_end = buf + buf_size;
+    while (buf_out < buf_end-1 && in_text < in_text_end && *in_text)    {
+        unsigned int c;
+        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+        if (c == 0) break;
+        if (c < 0x10000) *buf_out++ = (ImWchar)c;
+    }
+    *buf_out = 0;
+    return (int)(buf_out - buf);
+}
+static ImVec2 ReferenceCalcTextSize(const ImFont* font,float size,const char* s,const char* text_end)   {
+    const float scale = size / font->FontSize;
+    ImVec2 text_size(0,0);
+    float line_width = 0.0f;
+    while (s < text_end)    {
+        unsigned int c;
+        s += ImTextCharFromUtf8(&c, s, text_end);
+        if (c == 0) break;
+        if (c == '\n') {text_size.x = ImMax(text_size.x, line_width);text_size.y += size;line_width = 0.0f;continue;}
+        if (c == '\r') continue;
+        line_width += ((int)c < font->IndexAdvanceX.Size ? font->IndexAdvanceX.Data[c] : font->FallbackAdvanceX) * scale;
+    }
+    if (text_size.x < line_width) text_size.x = line_width;
+    if (line_width > 0 || text_size.y == 0.0f) text_size.y += size;
+    return text_size;
+}
+
+int main(int argc,char** argv)
+{
+    const int numCharsInThousands = argc>1 ? atoi(argv[1]) : 100;
+    const int numRepetitions = argc>2 ? atoi(argv[2]) : 100;
+    if (numCharsInThousands<=0 || numCharsInThousands>10000 || numRepetitions<=0) {fprintf(stderr,"Usage: %s [numCharsInThousands=100 (max 10000)] [numRepetitions=100]\n",argv[0]);return 1;}
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    unsigned char* pixels = NULL;int width=0,height=0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels,&width,&height);   // builds the default font
+    const ImFont* font = io.Fonts->Fonts[0];
+    const float fontSize = font->FontSize;
+
+    static const char* asciiWords[] = {"lorem","ipsum","dolor","sit","amet,","consectetur","adipiscing","elit.","Sed","do","eiusmod","tempor","incididunt","ut","labore","et","dolore","magna","aliqua."};
+    static const char* latin1Words[] = {"caf\xc3\xa9","na\xc3\xafve","fa\xc3\xa7""ade","\xc3\xa0","pi\xc3\xb1""ata","M\xc3\xbcller","Stra\xc3\x9f""e","d\xc3\xa9j\xc3\xa0","vu","Gar\xc3\xa7on,","\xc3\xa9t\xc3\xa9","ni\xc3\xb1o","\xc3\xb6l","s\xc3\xa5","fj\xc3\xb8rd","la","de","und"};
+    static const char* cjkWords[] = {"\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e","\xe4\xb8\xad\xe6\x96\x87","\xe6\xbc\xa2\xe5\xad\x97\xe3\x80\x82","\xed\x95\x9c\xea\xb5\xad\xec\x96\xb4","\xe3\x81\x93\xe3\x82\x93\xe3\x81\xab\xe3\x81\xa1\xe3\x81\xaf","\xe4\xb8\x96\xe7\x95\x8c,","\xe6\x9d\xb1\xe4\xba\xac"};
+    struct TextKind {const char* name;const char** words;int numWords;};
+    const TextKind kinds[3] = {
+        {"ASCII",asciiWords,(int)(sizeof(asciiWords)/sizeof(asciiWords[0]))},
+        {"Latin-1",latin1Words,(int)(sizeof(latin1Words)/sizeof(latin1Words[0]))},
+        {"CJK",cjkWords,(int)(sizeof(cjkWords)/sizeof(cjkWords[0]))}
+    };
+#   if (defined(IMGUI_DISABLE_SSE) || !(defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || (defined(__ARM_NEON) && defined(__aarch64__))))
+    const char* scanner = "scalar";
+#   else
+    const char* scanner = "SSE2/NEON";
+#   endif
+    printf("Texts of %d thousand characters, %d repetitions (ASCII runs scanned with: %s)\n",numCharsInThousands,numRepetitions,scanner);
+
+    ImVector<char> text;
+    ImVector<ImWchar> wtext,wreference;
+    for (int k=0;k<3;k++)   {
+        const TextKind& kind = kinds[k];
+        GenerateText(text,kind.words,kind.numWords,numCharsInThousands*1000);
+        const char* textBegin = &text[0];
+        const char* textEnd = textBegin+text.size()-1;
+        const int textSize = text.size()-1;
+        printf("%s text: %.2f KB\n",kind.name,(double)textSize/1024.0);
+        wtext.resize(textSize+1);wreference.resize(textSize+1);
+
+        int numWChars=0,numChars=0;
+        ImVec2 textSizeInPixels(0,0);
+        BENCHMARK("  ImTextStrFromUtf8",textSize,numWChars = ImTextStrFromUtf8(&wtext[0],wtext.size(),textBegin,textEnd));
+        BENCHMARK("  ImTextStrFromUtf8 (no text_end)",textSize,ImTextStrFromUtf8(&wtext[0],wtext.size(),textBegin,NULL));
+        BENCHMARK("  ImTextCountCharsFromUtf8",textSize,numChars = ImTextCountCharsFromUtf8(textBegin,textEnd));
+        BENCHMARK("  ImFont::CalcTextSizeA",textSize,textSizeInPixels = font->CalcTextSizeA(fontSize,FLT_MAX,0.0f,textBegin,textEnd));
+        BENCHMARK("  ImFont::CalcTextSizeA (wrapped)",textSize,font->CalcTextSizeA(fontSize,FLT_MAX,300.0f,textBegin,textEnd));
+
+        const int numReferenceWChars = ReferenceStrFromUtf8(&wreference[0],wreference.size(),textBegin,textEnd);
+        Check(numWChars==numReferenceWChars && memcmp(&wtext[0],&wreference[0],(numWChars+1)*sizeof(ImWchar))==0,"ImTextStrFromUtf8(...) differs from the plain decoder");
+        Check(numChars==numReferenceWChars,"ImTextCountCharsFromUtf8(...) differs from the plain decoder");
+        const ImVec2 referenceSize = ReferenceCalcTextSize(font,fontSize,textBegin,textEnd);
+        Check(textSizeInPixels.x==referenceSize.x && textSizeInPixels.y==referenceSize.y,"ImFont::CalcTextSizeA(...) differs from the plain decoder");
+    }
+
+    ImGui::DestroyContext();
+    printf("%s\n",NumFailures==0 ? "All checks passed" : "Some checks FAILED");
+    return NumFailures==0 ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// Stress test of the window focus order of imgui (see ImGui::FocusWindow(...) and ImGuiContext::WindowsFocusOrderFront in imgui_internal.h).
+// It needs no window and no bindings (the frames are rendered, but their draw data is not used).
+// It creates many windows, and then, for some frames, it submits all of them and focuses random windows between the frames:
+// a) with ImGui::BringWindowToFocusFront(...) (the focus order list only).
+// b) with ImGui::FocusWindow(...) (that also moves the window to the front of the display order, a vector).
+// After every frame it checks that the focus order list is consistent, and that it sorts the windows by the time of their last focus.
+//
+// [The current directory must be: imgui/examples/addons_examples]
+// g++ -O2 -I"../../" ../../imgui.cpp ../../imgui_draw.cpp ../../imgui_demo.cpp benchmark_window_focus.cpp -D"IMGUI_INCLUDE_IMGUI_USER_H" -D"IMGUI_INCLUDE_IMGUI_USER_INL" -lpthread -o benchmark_window_focus
+// Usage: ./benchmark_window_focus [numWindows=10000] [numFrames=20] [numFocusChangesPerFrame=1000]
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int NumFailures = 0;
+static void Check(bool ok,const char* what) {if (!ok) {printf("  [FAILED: %s]\n",what);++NumFailures;}}
+
+static unsigned int RandomSeed = 777;
+static unsigned int Random() {RandomSeed = RandomSeed*1103515245u+12345u;return RandomSeed>>8;}
+
+// Submits all the windows (the first frame creates them, and every new window is focused when it appears)
+static void RenderFrame(ImVector<ImGuiWindow*>& windows,int numWindows)  {
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = 1.0f/60.0f;
+    ImGui::NewFrame();
+    char name[32];
+    for (int i=0;i<numWindows;i++)  {
+        sprintf(name,"Window %d",i);
+        ImGui::SetNextWindowPos(ImVec2((float)(i%64)*25.f,(float)((i/64)%40)*25.f),ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowSize(ImVec2(200,100),ImGuiCond_FirstUseEver);
+        ImGui::Begin(name,NULL,ImGuiWindowFlags_NoSavedSettings);
+        ImGui::Text("Window %d",i);
+        if (windows.size()<numWindows) windows.push_back(ImGui::GetCurrentWindow());
+        ImGui::End();
+    }
+    ImGui::Render();
+}
+
+// Walks the focus order list from the back to the front: every window must be there once, and the windows we focused
+// must appear in the order of their last focus ('focusTimes' is indexed like 'windows', and lookup maps a window ID to that index)
+static bool CheckFocusOrder(const ImVector<ImGuiWindow*>& windows,const ImVector<int>& focusTimes,const ImGuiStorage& lookup,ImGuiWindow* lastFocusedWindow)    {
+    ImGuiContext& g = *GImGui;
+    int count = 0,lastFocusTime = -1;
+    ImGuiWindow* prev = NULL;
+    for (ImGuiWindow* window = g.WindowsFocusOrderBack; window != NULL; window = window->FocusOrderNext)    {
+        if (window->FocusOrderPrev!=prev || ++count>g.Windows.Size) return false;
+        const int index = lookup.GetInt(window->ID,-1);
+        if (index>=0 && windows[index]==window) {
+            if (focusTimes[index]<=lastFocusTime) return false;
+            lastFocusTime = focusTimes[index];
+        }
+        prev = window;
+    }
+    return prev==g.WindowsFocusOrderFront && count==g.WindowsFocusOrderCount && count==g.Windows.Size && (!lastFocusedWindow || lastFocusedWindow==g.WindowsFocusOrderFront);
+}
+
+int main(int argc,char** argv)
+{
+    const int numWindows = argc>1 ? atoi(argv[1]) : 10000;
+    const int numFrames = argc>2 ? atoi(argv[2]) : 20;
+    const int numFocusChangesPerFrame = argc>3 ? atoi(argv[3]) : 1000;
+    if (numWindows<=0 || numFrames<=0 || numFocusChangesPerFrame<=0) {fprintf(stderr,"Usage: %s [numWindows=10000] [numFrames=20] [numFocusChangesPerFrame=1000]\n",argv[0]);return 1;}
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1920,1080);
+    io.IniFilename = NULL;
+    unsigned char* pixels = NULL;int width=0,height=0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels,&width,&height);   // builds the default font
+
+    ImVector<ImGuiWindow*> windows;
+    double startTime = ImGuiHelper::GetTimeInMilliseconds();
+    RenderFrame(windows,numWindows);
+    printf("%-50s %9.2f ms\n","First frame (creates all the windows)",ImGuiHelper::GetTimeInMilliseconds()-startTime);
+    Check(windows.size()==numWindows,"all the windows must be created");
+
+    // Windows are focused when they appear, so the creation order is the initial focus order
+    ImVector<int> focusTimes;focusTimes.resize(windows.size());
+    ImGuiStorage lookup;
+    for (int i=0;i<windows.size();i++) {focusTimes[i] = i;lookup.SetInt(windows[i]->ID,i);}
+    int focusTime = windows.size();
+    Check(CheckFocusOrder(windows,focusTimes,lookup,windows[windows.size()-1]),"focus order after the first frame");
+
+    for (int pass=0;pass<2;pass++)  {
+        const bool onlyFocusOrder = (pass==0);
+        double frameTime = 0,focusChangeTime = 0;
+        int numBadFrames = 0;
+        for (int f=0;f<numFrames;f++)   {
+            startTime = ImGuiHelper::GetTimeInMilliseconds();
+            RenderFrame(windows,numWindows);
+            frameTime+=ImGuiHelper::GetTimeInMilliseconds()-startTime;
+
+            ImGuiWindow* window = NULL;
+            startTime = ImGuiHelper::GetTimeInMilliseconds();
+            for (int i=0;i<numFocusChangesPerFrame;i++) {
+                const int index = (int)(Random()%(unsigned)windows.size());
+                window = windows[index];
+                if (onlyFocusOrder) ImGui::BringWindowToFocusFront(window);
+                else ImGui::FocusWindow(window);
+                focusTimes[index] = focusTime++;
+            }
+            focusChangeTime+=ImGuiHelper::GetTimeInMilliseconds()-startTime;
+            if (!CheckFocusOrder(windows,focusTimes,lookup,window)) ++numBadFrames;
+        }
+        const int numFocusChanges = numFrames*numFocusChangesPerFrame;
+        printf("%-50s %9.2f ms %9.3f us/op\n",onlyFocusOrder ? "BringWindowToFocusFront(...)" : "FocusWindow(...)",focusChangeTime,focusChangeTime*1000.0/(double)numFocusChanges);
+        printf("%-50s %9.2f ms\n","  frame (all the windows submitted)",frameTime/(double)numFrames);
+        Check(numBadFrames==0,onlyFocusOrder ? "focus order after BringWindowToFocusFront(...)" : "focus order after FocusWindow(...)");
+    }
+
+    ImGui::DestroyContext();
+    printf("%s\n",NumFailures==0 ? "All checks passed" : "Some checks FAILED");
+    return NumFailures==0 ? 0 : 1;
+}
@@ -941,6 +941,15 @@ CODE
 #include <stdint.h>     // intptr_t
 #endif
 
+// SSE2/NEON are only used to scan text for runs of ASCII characters (see ImTextFindAsciiRunEnd)
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(IMGUI_DISABLE_SSE)
+#define IMGUI_ENABLE_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__) && !defined(IMGUI_DISABLE_SSE)
+#define IMGUI_ENABLE_NEON
+#include <arm_neon.h>
+#endif
+
 // Debug options
 #define IMGUI_DEBUG_NAV_SCORING     0   // Display navigation scoring preview when hovering items. Display last moving direction matches when holding CTRL
 #define IMGUI_DEBUG_NAV_RECTS       0   // Display the reference navigation rectangle for each window
@@ -996,6 +1005,8 @@ static const float WINDOWS_RESIZE_FROM_EDGES_FEEDBACK_TIMER = 0.04f;    // Reduc
 static void             SetCurrentWindow(ImGuiWindow* window);
 static void             FindHoveredWindow();
 static ImGuiWindow*     CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFlags flags);
+static void             LinkWindowToFocusFront(ImGuiWindow* window);
+static void             UnlinkWindowFromFocusOrder(ImGuiWindow* window);
 static void             CheckStacksSize(ImGuiWindow* window, bool write);
 static ImVec2           CalcNextScrollFromScrollTargetAndClamp(ImGuiWindow* window, bool snap_on_edges);
 
@@ -1008,6 +1019,7 @@ static ImRect           GetViewportRect();
 static void*            SettingsHandlerWindow_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name);
 static void             SettingsHandlerWindow_ReadLine(ImGuiContext*, ImGuiSettingsHandler*, void* entry, const char* line);
 static void             SettingsHandlerWindow_WriteAll(ImGuiContext* imgui_ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* buf);
+static void             SettingsHandlerWindow_WriteEntry(ImGuiContext* imgui_ctx, ImGuiSettingsHandler* handler, ImGuiID entry_id, ImGuiTextBuffer* buf);
 
 // Platform Dependents default implementation for IO functions
 static const char*      GetClipboardTextFn_DefaultImpl(void* user_data);
@@ -1526,6 +1538,26 @@ FILE* ImFileOpen(const char* filename, const char* mode)
 #endif
 }
 
+#if defined(_WIN32) && !defined(__CYGWIN__) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS)
+extern "C" __declspec(dllimport) int __stdcall MoveFileExW(const wchar_t* existing_filename, const wchar_t* new_filename, unsigned long flags);
+#endif
+
+bool ImFileReplace(const char* src_filename, const char* dst_filename)
+{
+#if defined(_WIN32) && !defined(__CYGWIN__) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS)
+    // rename() fails on Windows when the destination exists. MoveFileEx() with MOVEFILE_REPLACE_EXISTING (0x01) replaces it atomically.
+    const int src_wsize = ImTextCountCharsFromUtf8(src_filename, NULL) + 1;
+    const int dst_wsize = ImTextCountCharsFromUtf8(dst_filename, NULL) + 1;
+    ImVector<ImWchar> buf;
+    buf.resize(src_wsize + dst_wsize);
+    ImTextStrFromUtf8(&buf[0], src_wsize, src_filename, NULL);
+    ImTextStrFromUtf8(&buf[src_wsize], dst_wsize, dst_filename, NULL);
+    return MoveFileExW((wchar_t*)&buf[0], (wchar_t*)&buf[src_wsize], 0x01) != 0;
+#else
+    return rename(src_filename, dst_filename) == 0;
+#endif
+}
+
 // Load file content into memory
 // Memory allocated with ImGui::MemAlloc(), must be freed by user using ImGui::MemFree()
 void* ImFileLoadToMemory(const char* filename, const char* file_open_mode, size_t* out_file_size, int padding_bytes)
@@ -1633,12 +1665,43 @@ int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char*
     return 0;
 }
 
+// Return a pointer to the first byte in [in_text, in_text_end) which is not an ASCII character >= 'min_char' (1..0x7F).
+// Bytes before it are one character each and need no UTF-8 decoding. Scans 16 bytes at a time with SSE2/NEON:
+// a signed compare against 'min_char' catches both control characters and bytes >= 0x80 in one instruction.
+const char* ImTextFindAsciiRunEnd(const char* in_text, const char* in_text_end, char min_char)
+{
+    IM_ASSERT(min_char > 0);
+    const char* p = in_text;
+#if defined(IMGUI_ENABLE_SSE)
+    const __m128i v_min_char = _mm_set1_epi8(min_char);
+    while (in_text_end - p >= 16 && _mm_movemask_epi8(_mm_cmplt_epi8(_mm_loadu_si128((const __m128i*)(const void*)p), v_min_char)) == 0)
+        p += 16;
+#elif defined(IMGUI_ENABLE_NEON)
+    const int8x16_t v_min_char = vdupq_n_s8(min_char);
+    while (in_text_end - p >= 16 && vmaxvq_u8(vcltq_s8(vld1q_s8((const int8_t*)(const void*)p), v_min_char)) == 0)
+        p += 16;
+#endif
+    while (p < in_text_end && (signed char)*p >= min_char)
+        p++;
+    return p;
+}
+
 int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
 {
     ImWchar* buf_out = buf;
     ImWchar* buf_end = buf + buf_size;
+    if (!in_text_end && buf_size > 1)
+        in_text_end = in_text + strlen(in_text);
     while (buf_out < buf_end-1 && (!in_text_end || in_text < in_text_end) && *in_text)
     {
+        if ((unsigned char)*in_text < 0x80)
+        {
+            // Copy runs of ASCII characters without decoding them one by one
+            const char* run_end = ImTextFindAsciiRunEnd(in_text, ImMin(in_text_end, in_text + (buf_end - 1 - buf_out)), 1);
+            while (in_text < run_end)
+                *buf_out++ = (ImWchar)*in_text++;
+            continue;
+        }
         unsigned int c;
         in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
         if (c == 0)
@@ -1655,8 +1718,17 @@ int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const cha
 int ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end)
 {
     int char_count = 0;
-    while ((!in_text_end || in_text < in_text_end) && *in_text)
+    if (!in_text_end)
+        in_text_end = in_text + strlen(in_text);
+    while (in_text < in_text_end && *in_text)
     {
+        if ((unsigned char)*in_text < 0x80)
+        {
+            const char* run_end = ImTextFindAsciiRunEnd(in_text, in_text_end, 1);
+            char_count += (int)(run_end - in_text);
+            in_text = run_end;
+            continue;
+        }
         unsigned int c;
         in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
         if (c == 0)
@@ -2548,6 +2620,7 @@ ImGuiWindow::ImGuiWindow(ImGuiContext* context, const char* name)
     RootWindow = NULL;
     RootWindowForTitleBarHighlight = NULL;
     RootWindowForNav = NULL;
+    FocusOrderPrev = FocusOrderNext = NULL;
 
     NavLastIds[0] = NavLastIds[1] = 0;
     NavRectRel[0] = NavRectRel[1] = ImRect();
@@ -2814,6 +2887,52 @@ bool ImGui::ItemAdd(const ImRect& bb, ImGuiID id, const ImRect* nav_bb_arg)
     return true;
 }
 
+// Culling early-out, to be called by widgets before measuring their label.
+// If the item bounding box 'bb' is vertically clipped and nothing requires the item to be submitted (navigation request,
+// active or nav item, logging), the layout is advanced with ItemSize(size), ItemAdd(bb, id) stores the last item data
+// like for any clipped item, and true is returned: the caller should then return immediately, skipping CalcTextSize().
+// - When the item width depends on a label, pass the width without the label in 'size' and 'bb', and the label itself
+//   (label_end == NULL: hide the text after "##"). Its width (+ 'label_spacing' when not empty) is only measured if SameLine()
+//   follows, to place the next item. The contents width (CursorMaxPos.x) misses it: so we refuse in windows which depend on it
+//   every frame (auto-resize, horizontal scrolling), and the manual auto-fit of the resize grip takes one more frame to measure it.
+bool ImGui::ItemSkipIfClipped(const ImRect& bb, ImGuiID id, const ImVec2& size, float text_offset_y, const char* label, const char* label_end, float label_spacing)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    if (g.LogEnabled || g.NavAnyRequest)
+        return false;
+    if ((window->Flags & ImGuiWindowFlags_AlwaysAutoResize) || window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0)
+        return false;
+    if (label && (window->Flags & (ImGuiWindowFlags_HorizontalScrollbar | ImGuiWindowFlags_AlwaysHorizontalScrollbar)))
+        return false;
+    if (window->DC.LayoutType != ImGuiLayoutType_Vertical || window->DC.GroupStack.Size > 0)
+        return false;
+    if (bb.Min.y < window->ClipRect.Max.y && bb.Max.y > window->ClipRect.Min.y)
+        return false;
+    if (id != 0 && (id == g.ActiveId || id == g.NavId))
+        return false;
+
+    ItemSize(size, text_offset_y);
+    ItemAdd(bb, id); // Clipped: it only stores the last item data
+
+    if (label)
+    {
+        const int label_len = (int)(label_end ? (label_end - label) : strlen(label));
+        if (label_len > 0)
+        {
+            ImVector<char>& buf = window->DC.ItemSkippedLabel;
+            buf.resize(label_len + 1);
+            memcpy(buf.Data, label, (size_t)label_len);
+            buf.Data[label_len] = 0;
+            window->DC.ItemSkippedLabelPrevLine = window->DC.CursorPosPrevLine;
+            window->DC.ItemSkippedLabelSpacing = label_spacing;
+            window->DC.ItemSkippedLabelHideTextAfterDoubleHash = (label_end == NULL);
+            window->DC.ItemSkippedWidthUnknown = true;
+        }
+    }
+    return true;
+}
+
 // This is roughly matching the behavior of internal-facing ItemHoverable()
 // - we allow hovering to be true when ActiveId==window->MoveID, so that clicking on non-interactive items such as a Text() item still returns true with IsItemHovered()
 // - this should work even for non-interactive items that have no ID, so we cannot use LastItemId
@@ -3553,7 +3672,7 @@ void ImGui::NewFrame()
     g.NavIdTabCounter = INT_MAX;
 
     // Mark all windows as not visible
-    IM_ASSERT(g.WindowsFocusOrder.Size == g.Windows.Size);
+    IM_ASSERT(g.WindowsFocusOrderCount == g.Windows.Size);
     for (int i = 0; i != g.Windows.Size; i++)
     {
         ImGuiWindow* window = g.Windows[i];
@@ -3596,6 +3715,7 @@ void ImGui::Initialize(ImGuiContext* context)
     ini_handler.ReadOpenFn = SettingsHandlerWindow_ReadOpen;
     ini_handler.ReadLineFn = SettingsHandlerWindow_ReadLine;
     ini_handler.WriteAllFn = SettingsHandlerWindow_WriteAll;
+    ini_handler.WriteEntryFn = SettingsHandlerWindow_WriteEntry;
     g.SettingsHandlers.push_back(ini_handler);
 
     g.Initialized = true;
@@ -3630,7 +3750,8 @@ void ImGui::Shutdown(ImGuiContext* context)
     for (int i = 0; i < g.Windows.Size; i++)
         IM_DELETE(g.Windows[i]);
     g.Windows.clear();
-    g.WindowsFocusOrder.clear();
+    g.WindowsFocusOrderBack = g.WindowsFocusOrderFront = NULL;
+    g.WindowsFocusOrderCount = 0;
     g.WindowsSortBuffer.clear();
     g.CurrentWindow = NULL;
     g.CurrentWindowStack.clear();
@@ -3657,9 +3778,19 @@ void ImGui::Shutdown(ImGuiContext* context)
 
     if (g.LogFile && g.LogFile != stdout)
     {
+        if (g.LogType == ImGuiLogType_File && !g.LogBuffer.empty())
+            fwrite(g.LogBuffer.begin(), 1, (size_t)g.LogBuffer.size(), g.LogFile);
         fclose(g.LogFile);
         g.LogFile = NULL;
     }
+    if (g.LogSink)
+    {
+        if (!g.LogBuffer.empty())
+            g.LogSink->WriteFn(g.LogSink, g.LogBuffer.begin(), g.LogBuffer.size());
+        if (g.LogSink->CloseFn)
+            g.LogSink->CloseFn(g.LogSink);
+        g.LogSink = NULL;
+    }
     g.LogBuffer.clear();
 
     g.Initialized = false;
@@ -3858,6 +3989,9 @@ void ImGui::EndFrame()
         g.DragDropWithinSourceOrTarget = false;
     }
 
+    // Flush logged text to file/sink
+    LogFlush();
+
     // End frame
     g.FrameScopeActive = false;
     g.FrameCountEnded = g.FrameCount;
@@ -4535,6 +4669,7 @@ static ImGuiWindow* CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFl
 
     // User can disable loading and saving of settings. Tooltip and child windows also don't store settings.
     if (!(flags & ImGuiWindowFlags_NoSavedSettings))
+    {
         if (ImGuiWindowSettings* settings = ImGui::FindWindowSettings(window->ID))
         {
             // Retrieve settings from .ini file
@@ -4545,6 +4680,18 @@ static ImGuiWindow* CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFl
             if (ImLengthSqr(settings->Size) > 0.00001f)
                 size = ImFloor(settings->Size);
         }
+        else if (g.IO.IniBinaryFormat)
+        {
+            // Incremental binary saves only write the flagged entries: flag the new window so that it's saved even if it's never moved or resized
+            // (a new window can't be in the list yet, so we skip the linear search of MarkIniSettingsDirty())
+            ImGuiSettingsDirtyEntry entry;
+            entry.TypeHash = ImHashStr("Window", 0);
+            entry.ID = window->ID;
+            g.SettingsDirtyEntries.push_back(entry);
+            if (g.SettingsDirtyTimer <= 0.0f)
+                g.SettingsDirtyTimer = g.IO.IniSavingRate;
+        }
+    }
     window->Size = window->SizeFull = window->SizeFullAtLastBegin = ImFloor(size);
     window->DC.CursorMaxPos = window->Pos; // So first call to CalcSizeContents() doesn't return crazy values
 
@@ -4562,7 +4709,7 @@ static ImGuiWindow* CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFl
         window->AutoFitOnlyGrows = (window->AutoFitFramesX > 0) || (window->AutoFitFramesY > 0);
     }
 
-    g.WindowsFocusOrder.push_back(window);
+    LinkWindowToFocusFront(window);
     if (flags & ImGuiWindowFlags_NoBringToFrontOnFocus)
         g.Windows.push_front(window); // Quite slow but rare and only once
     else
@@ -4777,7 +4924,16 @@ static void ImGui::UpdateManualResize(ImGuiWindow* window, const ImVec2& size_au
         if (held && g.IO.MouseDoubleClicked[0] && resize_grip_n == 0)
         {
             // Manual auto-fit when double-clicking
-            size_target = CalcSizeAfterConstraint(window, size_auto_fit);
+            if (window->DC.ItemSkippedWidthUnknown)
+            {
+                // The contents width misses the items skipped before measuring their label (see ItemSkipIfClipped): measure them all in this frame, fit in the next one
+                window->AutoFitFramesX = window->AutoFitFramesY = 2;
+                window->AutoFitOnlyGrows = false;
+            }
+            else
+            {
+                size_target = CalcSizeAfterConstraint(window, size_auto_fit);
+            }
             ClearActiveID();
         }
         else if (held)
@@ -5360,6 +5516,8 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         window->DC.CursorPos = window->DC.CursorStartPos;
         window->DC.CursorPosPrevLine = window->DC.CursorPos;
         window->DC.CursorMaxPos = window->DC.CursorStartPos;
+        window->DC.ItemSkippedLabel.resize(0);
+        window->DC.ItemSkippedWidthUnknown = false;
         window->DC.CurrentLineSize = window->DC.PrevLineSize = ImVec2(0.0f, 0.0f);
         window->DC.CurrentLineTextBaseOffset = window->DC.PrevLineTextBaseOffset = 0.0f;
         window->DC.NavHideHighlightOneFrame = false;
@@ -5569,18 +5727,42 @@ void ImGui::End()
     SetCurrentWindow(g.CurrentWindowStack.empty() ? NULL : g.CurrentWindowStack.back());
 }
 
+// Focus order is an intrusive doubly-linked list so that focusing a window is O(1) regardless of the number of windows.
+static void LinkWindowToFocusFront(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(window->FocusOrderPrev == NULL && window->FocusOrderNext == NULL && g.WindowsFocusOrderBack != window);
+    window->FocusOrderPrev = g.WindowsFocusOrderFront;
+    if (g.WindowsFocusOrderFront)
+        g.WindowsFocusOrderFront->FocusOrderNext = window;
+    else
+        g.WindowsFocusOrderBack = window;
+    g.WindowsFocusOrderFront = window;
+    g.WindowsFocusOrderCount++;
+}
+
+static void UnlinkWindowFromFocusOrder(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    if (window->FocusOrderPrev)
+        window->FocusOrderPrev->FocusOrderNext = window->FocusOrderNext;
+    else
+        g.WindowsFocusOrderBack = window->FocusOrderNext;
+    if (window->FocusOrderNext)
+        window->FocusOrderNext->FocusOrderPrev = window->FocusOrderPrev;
+    else
+        g.WindowsFocusOrderFront = window->FocusOrderPrev;
+    window->FocusOrderPrev = window->FocusOrderNext = NULL;
+    g.WindowsFocusOrderCount--;
+}
+
 void ImGui::BringWindowToFocusFront(ImGuiWindow* window)
 {
     ImGuiContext& g = *GImGui;
-    if (g.WindowsFocusOrder.back() == window)
+    if (g.WindowsFocusOrderFront == window)
         return;
-    for (int i = g.WindowsFocusOrder.Size - 2; i >= 0; i--) // We can ignore the front most window
-        if (g.WindowsFocusOrder[i] == window)
-        {
-            memmove(&g.WindowsFocusOrder[i], &g.WindowsFocusOrder[i + 1], (size_t)(g.WindowsFocusOrder.Size - i - 1) * sizeof(ImGuiWindow*));
-            g.WindowsFocusOrder[g.WindowsFocusOrder.Size - 1] = window;
-            break;
-        }
+    UnlinkWindowFromFocusOrder(window);
+    LinkWindowToFocusFront(window);
 }
 
 void ImGui::BringWindowToDisplayFront(ImGuiWindow* window)
@@ -5651,10 +5833,9 @@ void ImGui::FocusWindow(ImGuiWindow* window)
 void ImGui::FocusPreviousWindowIgnoringOne(ImGuiWindow* ignore_window)
 {
     ImGuiContext& g = *GImGui;
-    for (int i = g.WindowsFocusOrder.Size - 1; i >= 0; i--)
+    for (ImGuiWindow* window = g.WindowsFocusOrderFront; window != NULL; window = window->FocusOrderPrev)
     {
         // We may later decide to test for different NoXXXInputs based on the active navigation input (mouse vs nav) but that may feel more confusing to the user.
-        ImGuiWindow* window = g.WindowsFocusOrder[i];
         if (window != ignore_window && window->WasActive && !(window->Flags & ImGuiWindowFlags_ChildWindow))
             if ((window->Flags & (ImGuiWindowFlags_NoMouseInputs | ImGuiWindowFlags_NoNavInputs)) != (ImGuiWindowFlags_NoMouseInputs | ImGuiWindowFlags_NoNavInputs))
             {
@@ -6659,6 +6840,23 @@ void ImGui::SameLine(float pos_x, float spacing_w)
         return;
 
     ImGuiContext& g = *GImGui;
+
+    // The previous item was skipped by ItemSkipIfClipped() before measuring its label: add its width now, to place the next item
+    if (window->DC.ItemSkippedLabel.Size > 0)
+    {
+        if (window->DC.ItemSkippedLabelPrevLine.x == window->DC.CursorPosPrevLine.x && window->DC.ItemSkippedLabelPrevLine.y == window->DC.CursorPosPrevLine.y)
+        {
+            const char* label = window->DC.ItemSkippedLabel.Data;
+            const float label_width = CalcTextSize(label, label + window->DC.ItemSkippedLabel.Size - 1, window->DC.ItemSkippedLabelHideTextAfterDoubleHash).x;
+            if (label_width > 0.0f)
+            {
+                window->DC.CursorPosPrevLine.x += label_width + window->DC.ItemSkippedLabelSpacing;
+                window->DC.CursorMaxPos.x = ImMax(window->DC.CursorMaxPos.x, window->DC.CursorPosPrevLine.x);
+            }
+        }
+        window->DC.ItemSkippedLabel.resize(0);
+    }
+
     if (pos_x != 0.0f)
     {
         if (spacing_w < 0.0f) spacing_w = 0.0f;
@@ -7987,21 +8185,13 @@ static float ImGui::NavUpdatePageUpPageDown(int allowed_dir_flags)
     return 0.0f;
 }
 
-static int FindWindowFocusIndex(ImGuiWindow* window) // FIXME-OPT O(N)
-{
-    ImGuiContext& g = *GImGui;
-    for (int i = g.WindowsFocusOrder.Size-1; i >= 0; i--)
-        if (g.WindowsFocusOrder[i] == window)
-            return i;
-    return -1;
-}
-
-static ImGuiWindow* FindWindowNavFocusable(int i_start, int i_stop, int dir) // FIXME-OPT O(N)
+// Walk the focus order list from 'window_start' (included) toward the back (dir < 0) or the front (dir > 0), stopping before 'window_stop'.
+// Cost is proportional to the number of non-focusable windows skipped, not to the total number of windows.
+static ImGuiWindow* FindWindowNavFocusable(ImGuiWindow* window_start, ImGuiWindow* window_stop, int dir)
 {
-    ImGuiContext& g = *GImGui;
-    for (int i = i_start; i >= 0 && i < g.WindowsFocusOrder.Size && i != i_stop; i += dir)
-        if (ImGui::IsWindowNavFocusable(g.WindowsFocusOrder[i]))
-            return g.WindowsFocusOrder[i];
+    for (ImGuiWindow* window = window_start; window != NULL && window != window_stop; window = (dir < 0) ? window->FocusOrderPrev : window->FocusOrderNext)
+        if (ImGui::IsWindowNavFocusable(window))
+            return window;
     return NULL;
 }
 
@@ -8012,10 +8202,10 @@ static void NavUpdateWindowingHighlightWindow(int focus_change_dir)
     if (g.NavWindowingTarget->Flags & ImGuiWindowFlags_Modal)
         return;
 
-    const int i_current = FindWindowFocusIndex(g.NavWindowingTarget);
-    ImGuiWindow* window_target = FindWindowNavFocusable(i_current + focus_change_dir, -INT_MAX, focus_change_dir);
+    ImGuiWindow* window_current = g.NavWindowingTarget;
+    ImGuiWindow* window_target = FindWindowNavFocusable((focus_change_dir < 0) ? window_current->FocusOrderPrev : window_current->FocusOrderNext, NULL, focus_change_dir);
     if (!window_target)
-        window_target = FindWindowNavFocusable((focus_change_dir < 0) ? (g.WindowsFocusOrder.Size - 1) : 0, i_current, focus_change_dir);
+        window_target = FindWindowNavFocusable((focus_change_dir < 0) ? g.WindowsFocusOrderFront : g.WindowsFocusOrderBack, window_current, focus_change_dir);
     if (window_target) // Don't reset windowing target if there's a single window in the list
         g.NavWindowingTarget = g.NavWindowingTargetAnim = window_target;
     g.NavWindowingToggleLayer = false;
@@ -8049,7 +8239,7 @@ static void ImGui::NavUpdateWindowing()
     bool start_windowing_with_gamepad = !g.NavWindowingTarget && IsNavInputPressed(ImGuiNavInput_Menu, ImGuiInputReadMode_Pressed);
     bool start_windowing_with_keyboard = !g.NavWindowingTarget && g.IO.KeyCtrl && IsKeyPressedMap(ImGuiKey_Tab) && (g.IO.ConfigFlags & ImGuiConfigFlags_NavEnableKeyboard);
     if (start_windowing_with_gamepad || start_windowing_with_keyboard)
-        if (ImGuiWindow* window = g.NavWindow ? g.NavWindow : FindWindowNavFocusable(g.WindowsFocusOrder.Size - 1, -INT_MAX, -1))
+        if (ImGuiWindow* window = g.NavWindow ? g.NavWindow : FindWindowNavFocusable(g.WindowsFocusOrderFront, NULL, -1))
         {
             g.NavWindowingTarget = g.NavWindowingTargetAnim = window;
             g.NavWindowingTimer = g.NavWindowingHighlightAlpha = 0.0f;
@@ -8184,9 +8374,8 @@ void ImGui::NavUpdateWindowingList()
     SetNextWindowPos(g.IO.DisplaySize * 0.5f, ImGuiCond_Always, ImVec2(0.5f, 0.5f));
     PushStyleVar(ImGuiStyleVar_WindowPadding, g.Style.WindowPadding * 2.0f);
     Begin("###NavWindowingList", NULL, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings);
-    for (int n = g.WindowsFocusOrder.Size - 1; n >= 0; n--)
+    for (ImGuiWindow* window = g.WindowsFocusOrderFront; window != NULL; window = window->FocusOrderPrev)
     {
-        ImGuiWindow* window = g.WindowsFocusOrder[n];
         if (!IsWindowNavFocusable(window))
             continue;
         const char* label = window->Name;
@@ -8834,9 +9023,10 @@ void ImGui::LogText(const char* fmt, ...)
     if (!g.LogEnabled)
         return;
 
+    // File and sink output are accumulated and flushed once per frame by LogFlush(), instead of hitting the destination for every fragment.
     va_list args;
     va_start(args, fmt);
-    if (g.LogFile)
+    if (g.LogType == ImGuiLogType_TTY)
         vfprintf(g.LogFile, fmt, args);
     else
         g.LogBuffer.appendfv(fmt, args);
@@ -8902,6 +9092,7 @@ void ImGui::LogBegin(ImGuiLogType type, int auto_open_depth)
     ImGuiWindow* window = g.CurrentWindow;
     IM_ASSERT(g.LogEnabled == false);
     IM_ASSERT(g.LogFile == NULL);
+    IM_ASSERT(g.LogSink == NULL);
     IM_ASSERT(g.LogBuffer.empty());
     g.LogEnabled = true;
     g.LogType = type;
@@ -8962,6 +9153,32 @@ void ImGui::LogToBuffer(int auto_open_depth)
     LogBegin(ImGuiLogType_Buffer, auto_open_depth);
 }
 
+// Start logging/capturing text output to a custom sink. The sink must stay alive until LogFinish() has been called.
+void ImGui::LogToSink(ImGuiLogSink* sink, int auto_open_depth)
+{
+    ImGuiContext& g = *GImGui;
+    if (g.LogEnabled)
+        return;
+    IM_ASSERT(sink != NULL && sink->WriteFn != NULL);
+    LogBegin(ImGuiLogType_Sink, auto_open_depth);
+    g.LogSink = sink;
+}
+
+// Hand over the text accumulated during the frame to the log file/sink with a single write.
+void ImGui::LogFlush()
+{
+    ImGuiContext& g = *GImGui;
+    if (!g.LogEnabled || g.LogBuffer.empty())
+        return;
+    if (g.LogType == ImGuiLogType_File)
+        fwrite(g.LogBuffer.begin(), 1, (size_t)g.LogBuffer.size(), g.LogFile);
+    else if (g.LogType == ImGuiLogType_Sink)
+        g.LogSink->WriteFn(g.LogSink, g.LogBuffer.begin(), g.LogBuffer.size());
+    else
+        return;
+    g.LogBuffer.Buf.resize(0);    // Keep the allocation for the next frame
+}
+
 void ImGui::LogFinish()
 {
     ImGuiContext& g = *GImGui;
@@ -8969,6 +9186,7 @@ void ImGui::LogFinish()
         return;
 
     LogText(IM_NEWLINE);
+    LogFlush();
     switch (g.LogType)
     {
     case ImGuiLogType_TTY:
@@ -8977,6 +9195,10 @@ void ImGui::LogFinish()
     case ImGuiLogType_File:
         fclose(g.LogFile);
         break;
+    case ImGuiLogType_Sink:
+        if (g.LogSink->CloseFn)
+            g.LogSink->CloseFn(g.LogSink);
+        break;
     case ImGuiLogType_Buffer:
         break;
     case ImGuiLogType_Clipboard:
@@ -8991,6 +9213,7 @@ void ImGui::LogFinish()
     g.LogEnabled = false;
     g.LogType = ImGuiLogType_None;
     g.LogFile = NULL;
+    g.LogSink = NULL;
     g.LogBuffer.clear();
 }
 
@@ -9029,14 +9252,38 @@ void ImGui::MarkIniSettingsDirty()
     ImGuiContext& g = *GImGui;
     if (g.SettingsDirtyTimer <= 0.0f)
         g.SettingsDirtyTimer = g.IO.IniSavingRate;
+    g.SettingsDirtyAll = true;
 }
 
 void ImGui::MarkIniSettingsDirty(ImGuiWindow* window)
 {
     ImGuiContext& g = *GImGui;
-    if (!(window->Flags & ImGuiWindowFlags_NoSavedSettings))
-        if (g.SettingsDirtyTimer <= 0.0f)
-            g.SettingsDirtyTimer = g.IO.IniSavingRate;
+    if (window->Flags & ImGuiWindowFlags_NoSavedSettings)
+        return;
+    if (g.SettingsDirtyTimer <= 0.0f)
+        g.SettingsDirtyTimer = g.IO.IniSavingRate;
+    if (g.IO.IniBinaryFormat)
+        MarkIniSettingsDirty(FindSettingsHandler("Window"), window->ID);
+}
+
+void ImGui::MarkIniSettingsDirty(ImGuiSettingsHandler* handler, ImGuiID entry_id)
+{
+    ImGuiContext& g = *GImGui;
+    if (g.SettingsDirtyTimer <= 0.0f)
+        g.SettingsDirtyTimer = g.IO.IniSavingRate;
+    if (handler->WriteEntryFn == NULL)
+    {
+        g.SettingsDirtyAll = true;
+        return;
+    }
+    // The list only holds the entries modified within io.IniSavingRate seconds, so a linear search is fine
+    for (int n = 0; n < g.SettingsDirtyEntries.Size; n++)
+        if (g.SettingsDirtyEntries[n].ID == entry_id && g.SettingsDirtyEntries[n].TypeHash == handler->TypeHash)
+            return;
+    ImGuiSettingsDirtyEntry entry;
+    entry.TypeHash = handler->TypeHash;
+    entry.ID = entry_id;
+    g.SettingsDirtyEntries.push_back(entry);
 }
 
 ImGuiWindowSettings* ImGui::CreateNewWindowSettings(const char* name)
@@ -9065,13 +9312,39 @@ ImGuiWindowSettings* ImGui::FindOrCreateWindowSettings(const char* name)
     return CreateNewWindowSettings(name);
 }
 
+// Binary settings file: an header followed by one record per entry. Saving appends a new record for each modified entry,
+// and on load later records override earlier ones, so the file is only rewritten (compacted) when it grows too much.
+// Record layout (native endianness): [int record_size][ImGuiID type_hash][int name_len][name][lines of text, each one terminated by '\n'].
+// The text lines are the ones produced by ImGuiSettingsHandler::WriteAllFn/WriteEntryFn and fed back to ReadLineFn, so every handler works unmodified.
+static const char   IMGUI_SETTINGS_BINARY_MAGIC[8] = { 'I', 'M', 'G', 'U', 'I', 'B', 'I', 'N' };
+static const int    IMGUI_SETTINGS_BINARY_VERSION = 1;
+static const int    IMGUI_SETTINGS_BINARY_HEADER_SIZE = 8 + 4;
+
+static bool IsBinarySettingsData(const char* data, size_t data_size)
+{
+    return data_size >= (size_t)IMGUI_SETTINGS_BINARY_HEADER_SIZE && memcmp(data, IMGUI_SETTINGS_BINARY_MAGIC, 8) == 0;
+}
+
+static void LoadIniSettingsFromWritableMemory(char* buf, char* buf_end);
+
 void ImGui::LoadIniSettingsFromDisk(const char* ini_filename)
 {
+    ImGuiContext& g = *GImGui;
     size_t file_data_size = 0;
-    char* file_data = (char*)ImFileLoadToMemory(ini_filename, "rb", &file_data_size);
+    char* file_data = (char*)ImFileLoadToMemory(ini_filename, "rb", &file_data_size, 1);
     if (!file_data)
         return;
-    LoadIniSettingsFromMemory(file_data, (size_t)file_data_size);
+    // Both parsers work in place on the loaded buffer, without a copy
+    if (IsBinarySettingsData(file_data, file_data_size))
+    {
+        // Only append to a file that we could parse completely (with our version): otherwise the appended records would follow garbage, and the next save must rewrite it
+        const bool parsed_completely = LoadBinarySettingsFromMemory(file_data, file_data_size);
+        g.SettingsBinaryFileSize = parsed_completely ? (int)file_data_size : 0;
+    }
+    else
+    {
+        LoadIniSettingsFromWritableMemory(file_data, file_data + file_data_size);
+    }
     ImGui::MemFree(file_data);
 }
 
@@ -9092,7 +9365,7 @@ void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
     IM_ASSERT(g.Initialized);
     IM_ASSERT(g.SettingsLoaded == false && g.FrameCount == 0);
 
-    // For user convenience, we allow passing a non zero-terminated string (hence the ini_size parameter).
+    // For user convenience, we allow passing a non zero-terminated string (hence the ini_size parameter). Binary settings data always needs ini_size.
     // For our convenience and to make the code simpler, we'll also write zero-terminators within the buffer. So let's create a writable copy..
     if (ini_size == 0)
         ini_size = strlen(ini_data);
@@ -9100,6 +9373,20 @@ void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
     char* buf_end = buf + ini_size;
     memcpy(buf, ini_data, ini_size);
     buf[ini_size] = 0;
+    if (IsBinarySettingsData(buf, ini_size))
+        LoadBinarySettingsFromMemory(buf, ini_size);
+    else
+        LoadIniSettingsFromWritableMemory(buf, buf_end);
+    ImGui::MemFree(buf);
+}
+
+// Zero-tolerance, no error reporting, cheap .ini parsing. Works in place: 'buf_end' must be writable too (we write a zero-terminator there)
+static void LoadIniSettingsFromWritableMemory(char* buf, char* buf_end)
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(g.Initialized);
+    IM_ASSERT(g.SettingsLoaded == false && g.FrameCount == 0);
+    buf_end[0] = 0;
 
     void* entry_data = NULL;
     ImGuiSettingsHandler* entry_handler = NULL;
@@ -9134,7 +9421,7 @@ void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
                 *type_end = 0; // Overwrite first ']'
                 name_start++;  // Skip second '['
             }
-            entry_handler = FindSettingsHandler(type_start);
+            entry_handler = ImGui::FindSettingsHandler(type_start);
             entry_data = entry_handler ? entry_handler->ReadOpenFn(&g, entry_handler, name_start) : NULL;
         }
         else if (entry_handler != NULL && entry_data != NULL)
@@ -9143,16 +9430,231 @@ void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
             entry_handler->ReadLineFn(&g, entry_handler, entry_data, line);
         }
     }
-    ImGui::MemFree(buf);
     g.SettingsLoaded = true;
 }
 
+static void SettingsBinaryPatchRecordSize(ImVector<char>* out, int record_start)
+{
+    const int record_size = out->Size - record_start - (int)sizeof(int);
+    memcpy(out->Data + record_start, &record_size, sizeof(int));
+}
+
+// Keep track of the size of the latest record of each entry, to know how much of the file is still in use
+static void SettingsBinaryTrackRecords(const char* p, const char* p_end)
+{
+    ImGuiContext& g = *GImGui;
+    while (p < p_end)
+    {
+        int record_size, name_len;
+        ImGuiID type_hash;
+        memcpy(&record_size, p, sizeof(int));
+        memcpy(&type_hash, p + sizeof(int), sizeof(ImGuiID));
+        memcpy(&name_len, p + sizeof(int) * 2, sizeof(int));
+        const ImGuiID record_key = ImHashStr(p + sizeof(int) * 3, (size_t)name_len, type_hash);
+        g.SettingsBinaryLiveSize += (int)sizeof(int) + record_size - g.SettingsBinaryRecordSizes.GetInt(record_key, 0);
+        g.SettingsBinaryRecordSizes.SetInt(record_key, (int)sizeof(int) + record_size);
+        p += sizeof(int) + record_size;
+    }
+}
+
+bool ImGui::LoadBinarySettingsFromMemory(char* data, size_t data_size)
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(g.Initialized);
+    IM_ASSERT(g.SettingsLoaded == false && g.FrameCount == 0);
+    IM_ASSERT(IsBinarySettingsData(data, data_size));
+    g.SettingsLoaded = true;
+    g.SettingsBinaryRecordSizes.Clear();
+    g.SettingsBinaryLiveSize = 0;
+
+    int version = 0;
+    memcpy(&version, data + 8, sizeof(int));
+    if (version != IMGUI_SETTINGS_BINARY_VERSION)
+        return false;
+
+    ImVector<char> name;
+    char* p = data + IMGUI_SETTINGS_BINARY_HEADER_SIZE;
+    char* data_end = data + data_size;
+    while (data_end - p >= (ptrdiff_t)(sizeof(int) * 3))
+    {
+        // Read record header. A truncated record (e.g. a save interrupted by a crash) ends the parsing.
+        int record_size, name_len;
+        ImGuiID type_hash;
+        memcpy(&record_size, p, sizeof(int));
+        memcpy(&type_hash, p + sizeof(int), sizeof(ImGuiID));
+        memcpy(&name_len, p + sizeof(int) * 2, sizeof(int));
+        char* record_end = p + sizeof(int) + record_size;
+        char* lines = p + sizeof(int) * 3 + name_len;
+        if (record_size < (int)sizeof(int) * 2 || name_len < 0 || record_end > data_end || lines > record_end)
+            break;
+        name.resize(name_len + 1);
+        memcpy(name.Data, p + sizeof(int) * 3, (size_t)name_len);
+        name[name_len] = 0;
+
+        SettingsBinaryTrackRecords(p, record_end);
+
+        ImGuiSettingsHandler* handler = NULL;
+        for (int handler_n = 0; handler_n < g.SettingsHandlers.Size && handler == NULL; handler_n++)
+            if (g.SettingsHandlers[handler_n].TypeHash == type_hash)
+                handler = &g.SettingsHandlers[handler_n];
+        if (void* entry = handler ? handler->ReadOpenFn(&g, handler, name.Data) : NULL)
+        {
+            // Every line is '\n' terminated: we zero-terminate it in place
+            for (char* line = lines; line < record_end; )
+            {
+                char* line_end = (char*)memchr(line, '\n', (size_t)(record_end - line));
+                if (line_end == NULL)
+                    break;
+                *line_end = 0;
+                handler->ReadLineFn(&g, handler, entry, line);
+                line = line_end + 1;
+            }
+        }
+        p = record_end;
+    }
+    return p == data_end;
+}
+
+// Convert the text produced by WriteAllFn/WriteEntryFn ("[Type][Name]" headers followed by lines) to binary records appended to 'out'.
+static void SettingsTextToBinaryRecords(const char* text, const char* text_end, ImVector<char>* out)
+{
+    int record_start = -1;
+    for (const char* line = text; line < text_end; )
+    {
+        const char* line_end = line;
+        while (line_end < text_end && *line_end != '\n' && *line_end != '\r')
+            line_end++;
+        const int line_len = (int)(line_end - line);
+        if (line_len >= 2 && line[0] == '[' && line_end[-1] == ']')
+        {
+            // Parse "[Type][Name]" and start a new record
+            const char* type_start = line + 1;
+            const char* type_end = ImStrchrRange(type_start, line_end - 1, ']');
+            const char* name_start = type_end ? ImStrchrRange(type_end + 1, line_end - 1, '[') : NULL;
+            if (type_end && name_start)
+            {
+                if (record_start != -1)
+                    SettingsBinaryPatchRecordSize(out, record_start);
+                name_start++;
+                const int name_len = (int)(line_end - 1 - name_start);
+                const ImGuiID type_hash = ImHashStr(type_start, (size_t)(type_end - type_start));
+                record_start = out->Size;
+                out->resize(out->Size + (int)sizeof(int) * 3 + name_len);
+                char* dst = out->Data + record_start;
+                memcpy(dst + sizeof(int), &type_hash, sizeof(ImGuiID));
+                memcpy(dst + sizeof(int) * 2, &name_len, sizeof(int));
+                memcpy(dst + sizeof(int) * 3, name_start, (size_t)name_len);
+            }
+            else
+            {
+                record_start = -1;
+            }
+        }
+        else if (line_len > 0 && record_start != -1)
+        {
+            const int sz = out->Size;
+            out->resize(sz + line_len + 1);
+            memcpy(out->Data + sz, line, (size_t)line_len);
+            out->Data[sz + line_len] = '\n';
+        }
+        line = line_end + 1;
+    }
+    if (record_start != -1)
+        SettingsBinaryPatchRecordSize(out, record_start);
+}
+
+void ImGui::SaveBinarySettingsToDisk(const char* filename)
+{
+    ImGuiContext& g = *GImGui;
+    g.SettingsDirtyTimer = 0.0f;
+
+    // Incremental save: append one record per modified entry.
+    // We rewrite the whole file when we can't do that, or when obsolete records take more than half of the file.
+    bool rewrite = g.SettingsDirtyAll || g.SettingsBinaryFileSize == 0 || g.SettingsBinaryFileSize > g.SettingsBinaryLiveSize * 2 + 64 * 1024;
+    ImVector<char> records;
+    if (!rewrite)
+    {
+        ImGuiTextBuffer* buf = &g.SettingsIniData;
+        buf->Buf.resize(0);
+        buf->Buf.push_back(0);
+        for (int n = 0; n < g.SettingsDirtyEntries.Size; n++)
+        {
+            const ImGuiSettingsDirtyEntry& entry = g.SettingsDirtyEntries[n];
+            for (int handler_n = 0; handler_n < g.SettingsHandlers.Size; handler_n++)
+                if (g.SettingsHandlers[handler_n].TypeHash == entry.TypeHash)
+                {
+                    ImGuiSettingsHandler* handler = &g.SettingsHandlers[handler_n];
+                    handler->WriteEntryFn(&g, handler, entry.ID, buf);
+                    break;
+                }
+        }
+        SettingsTextToBinaryRecords(buf->begin(), buf->end(), &records);
+        if (records.Size > 0)
+        {
+            FILE* f = ImFileOpen(filename, "ab");
+            // Make sure that the file is the one we know about (the position of a file opened in append mode is unspecified before the first write: the MSVC CRT reports 0)
+            if (f && fseek(f, 0, SEEK_END) == 0 && ftell(f) == g.SettingsBinaryFileSize)
+            {
+                rewrite = (fwrite(records.Data, 1, (size_t)records.Size, f) != (size_t)records.Size);
+                fclose(f);
+            }
+            else
+            {
+                if (f)
+                    fclose(f);
+                rewrite = true;
+            }
+        }
+        if (!rewrite)
+        {
+            SettingsBinaryTrackRecords(records.Data, records.Data + records.Size);
+            g.SettingsBinaryFileSize += records.Size;
+        }
+    }
+
+    if (rewrite)
+    {
+        // Full save: write every entry to a temporary file, then rename it over the old one so that a crash never leaves a half-written file
+        size_t ini_data_size = 0;
+        const char* ini_data = SaveIniSettingsToMemory(&ini_data_size);
+        records.resize(IMGUI_SETTINGS_BINARY_HEADER_SIZE);
+        memcpy(records.Data, IMGUI_SETTINGS_BINARY_MAGIC, 8);
+        memcpy(records.Data + 8, &IMGUI_SETTINGS_BINARY_VERSION, sizeof(int));
+        SettingsTextToBinaryRecords(ini_data, ini_data + ini_data_size, &records);
+
+        ImGuiTextBuffer tmp_filename;
+        tmp_filename.appendf("%s.tmp", filename);
+        FILE* f = ImFileOpen(tmp_filename.c_str(), "wb");
+        if (!f)
+            return;
+        const bool written = (fwrite(records.Data, 1, (size_t)records.Size, f) == (size_t)records.Size);
+        const bool closed = (fclose(f) == 0);
+        if (!written || !closed || !ImFileReplace(tmp_filename.c_str(), filename))
+        {
+            remove(tmp_filename.c_str());
+            g.SettingsBinaryFileSize = 0;
+            return;
+        }
+        g.SettingsBinaryFileSize = records.Size;
+        g.SettingsBinaryLiveSize = 0;
+        g.SettingsBinaryRecordSizes.Clear();
+        SettingsBinaryTrackRecords(records.Data + IMGUI_SETTINGS_BINARY_HEADER_SIZE, records.Data + records.Size);
+    }
+    g.SettingsDirtyAll = false;
+    g.SettingsDirtyEntries.resize(0);
+}
+
 void ImGui::SaveIniSettingsToDisk(const char* ini_filename)
 {
     ImGuiContext& g = *GImGui;
     g.SettingsDirtyTimer = 0.0f;
     if (!ini_filename)
         return;
+    if (g.IO.IniBinaryFormat)
+    {
+        SaveBinarySettingsToDisk(ini_filename);
+        return;
+    }
 
     size_t ini_data_size = 0;
     const char* ini_data = SaveIniSettingsToMemory(&ini_data_size);
@@ -9198,6 +9700,36 @@ static void SettingsHandlerWindow_ReadLine(ImGuiContext*, ImGuiSettingsHandler*,
     else if (sscanf(line, "Collapsed=%d", &i) == 1)     settings->Collapsed = (i != 0);
 }
 
+static ImGuiWindowSettings* SettingsHandlerWindow_UpdateSettings(ImGuiContext* imgui_ctx, ImGuiWindow* window)
+{
+    ImGuiContext& g = *imgui_ctx;
+    ImGuiWindowSettings* settings = (window->SettingsIdx != -1) ? &g.SettingsWindows[window->SettingsIdx] : ImGui::FindWindowSettings(window->ID);
+    if (!settings)
+    {
+        settings = ImGui::CreateNewWindowSettings(window->Name);
+        window->SettingsIdx = g.SettingsWindows.index_from_ptr(settings);
+    }
+    IM_ASSERT(settings->ID == window->ID);
+    settings->Pos = window->Pos;
+    settings->Size = window->SizeFull;
+    settings->Collapsed = window->Collapsed;
+    return settings;
+}
+
+static void SettingsHandlerWindow_WriteSettings(ImGuiSettingsHandler* handler, const ImGuiWindowSettings* settings, ImGuiTextBuffer* buf)
+{
+    if (settings->Pos.x == FLT_MAX)
+        return;
+    const char* name = settings->Name;
+    if (const char* p = strstr(name, "###"))  // Skip to the "###" marker if any. We don't skip past to match the behavior of GetID()
+        name = p;
+    buf->appendf("[%s][%s]\n", handler->TypeName, name);
+    buf->appendf("Pos=%d,%d\n", (int)settings->Pos.x, (int)settings->Pos.y);
+    buf->appendf("Size=%d,%d\n", (int)settings->Size.x, (int)settings->Size.y);
+    buf->appendf("Collapsed=%d\n", settings->Collapsed);
+    buf->appendf("\n");
+}
+
 static void SettingsHandlerWindow_WriteAll(ImGuiContext* imgui_ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* buf)
 {
     // Gather data from windows that were active during this session
@@ -9208,35 +9740,21 @@ static void SettingsHandlerWindow_WriteAll(ImGuiContext* imgui_ctx, ImGuiSetting
         ImGuiWindow* window = g.Windows[i];
         if (window->Flags & ImGuiWindowFlags_NoSavedSettings)
             continue;
-
-        ImGuiWindowSettings* settings = (window->SettingsIdx != -1) ? &g.SettingsWindows[window->SettingsIdx] : ImGui::FindWindowSettings(window->ID);
-        if (!settings)
-        {
-            settings = ImGui::CreateNewWindowSettings(window->Name);
-            window->SettingsIdx = g.SettingsWindows.index_from_ptr(settings);
-        }
-        IM_ASSERT(settings->ID == window->ID);
-        settings->Pos = window->Pos;
-        settings->Size = window->SizeFull;
-        settings->Collapsed = window->Collapsed;
+        SettingsHandlerWindow_UpdateSettings(imgui_ctx, window);
     }
 
     // Write to text buffer
     buf->reserve(buf->size() + g.SettingsWindows.Size * 96); // ballpark reserve
     for (int i = 0; i != g.SettingsWindows.Size; i++)
-    {
-        const ImGuiWindowSettings* settings = &g.SettingsWindows[i];
-        if (settings->Pos.x == FLT_MAX)
-            continue;
-        const char* name = settings->Name;
-        if (const char* p = strstr(name, "###"))  // Skip to the "###" marker if any. We don't skip past to match the behavior of GetID()
-            name = p;
-        buf->appendf("[%s][%s]\n", handler->TypeName, name);
-        buf->appendf("Pos=%d,%d\n", (int)settings->Pos.x, (int)settings->Pos.y);
-        buf->appendf("Size=%d,%d\n", (int)settings->Size.x, (int)settings->Size.y);
-        buf->appendf("Collapsed=%d\n", settings->Collapsed);
-        buf->appendf("\n");
-    }
+        SettingsHandlerWindow_WriteSettings(handler, &g.SettingsWindows[i], buf);
+}
+
+static void SettingsHandlerWindow_WriteEntry(ImGuiContext* imgui_ctx, ImGuiSettingsHandler* handler, ImGuiID entry_id, ImGuiTextBuffer* buf)
+{
+    ImGuiContext& g = *imgui_ctx;
+    ImGuiWindow* window = (ImGuiWindow*)g.WindowsById.GetVoidPtr(entry_id);
+    if (window && !(window->Flags & ImGuiWindowFlags_NoSavedSettings))
+        SettingsHandlerWindow_WriteSettings(handler, SettingsHandlerWindow_UpdateSettings(imgui_ctx, window), buf);
 }
 
 //-----------------------------------------------------------------------------
@@ -2681,6 +2681,29 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
             }
         }
 
+        // Fast path for runs of printable ASCII characters: no decoding and no control characters to handle.
+        // Widths are still accumulated one character at a time, in the same order, so results are unchanged.
+        if ((unsigned char)*s >= 32 && (unsigned char)*s < 0x80 && IndexAdvanceX.Size >= 0x80)
+        {
+            const char* run_limit = word_wrap_enabled ? word_wrap_eol : text_end;
+            const float* advance_x = IndexAdvanceX.Data;
+            bool max_width_reached = false;
+            for (unsigned int c = (unsigned char)*s; c >= 32 && c < 0x80; c = (s < run_limit) ? (unsigned char)*s : 0)
+            {
+                const float char_width = advance_x[c] * scale;
+                if (line_width + char_width >= max_width)
+                {
+                    max_width_reached = true;
+                    break;
+                }
+                line_width += char_width;
+                s++;
+            }
+            if (max_width_reached)
+                break;
+            continue;
+        }
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
@@ -68,10 +68,12 @@ struct ImGuiContext;                // Main imgui context
 struct ImGuiGroupData;              // Stacked storage data for BeginGroup()/EndGroup()
 struct ImGuiInputTextState;         // Internal state of the currently focused/edited text input box
 struct ImGuiItemHoveredDataBackup;  // Backup and restore IsItemHovered() internal data
+struct ImGuiLogSink;                // Custom log destination (see LogToSink())
 struct ImGuiMenuColumns;            // Simple column measurement, currently used for MenuItem() only
 struct ImGuiNavMoveResult;          // Result of a directional navigation move query result
 struct ImGuiNextWindowData;         // Storage for SetNexWindow** functions
 struct ImGuiPopupRef;               // Storage for current popup stack
+struct ImGuiSettingsDirtyEntry;     // Settings entry modified since the last binary save
 struct ImGuiSettingsHandler;        // Storage for one type registered in the .ini file
 struct ImGuiStyleMod;               // Stacked style modifier, backup of modified data so we can restore it
 struct ImGuiTabBar;                 // Storage for a tab bar
@@ -149,12 +151,14 @@ IMGUI_API int           ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char
 IMGUI_API int           ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end);                            // return number of UTF-8 code-points (NOT bytes count)
 IMGUI_API int           ImTextCountUtf8BytesFromChar(const char* in_text, const char* in_text_end);                        // return number of bytes to express one char in UTF-8
 IMGUI_API int           ImTextCountUtf8BytesFromStr(const ImWchar* in_text, const ImWchar* in_text_end);                   // return number of bytes to express string in UTF-8
+IMGUI_API const char*   ImTextFindAsciiRunEnd(const char* in_text, const char* in_text_end, char min_char);                // return end of the run of ASCII characters >= min_char (1..0x7F) starting at in_text
 
 // Helpers: Misc
 IMGUI_API ImU32         ImHashData(const void* data, size_t data_size, ImU32 seed = 0);
 IMGUI_API ImU32         ImHashStr(const char* data, size_t data_size, ImU32 seed = 0);
 IMGUI_API void*         ImFileLoadToMemory(const char* filename, const char* file_open_mode, size_t* out_file_size = NULL, int padding_bytes = 0);
 IMGUI_API FILE*         ImFileOpen(const char* filename, const char* file_open_mode);
+IMGUI_API bool          ImFileReplace(const char* src_filename, const char* dst_filename);   // Rename 'src_filename' to 'dst_filename', atomically replacing 'dst_filename' if it exists
 static inline bool      ImCharIsBlankA(char c)          { return c == ' ' || c == '\t'; }
 static inline bool      ImCharIsBlankW(unsigned int c)  { return c == ' ' || c == '\t' || c == 0x3000; }
 static inline bool      ImIsPowerOfTwo(int v)           { return v != 0 && (v & (v - 1)) == 0; }
@@ -403,7 +407,8 @@ enum ImGuiLogType
     ImGuiLogType_TTY,
     ImGuiLogType_File,
     ImGuiLogType_Buffer,
-    ImGuiLogType_Clipboard
+    ImGuiLogType_Clipboard,
+    ImGuiLogType_Sink
 };
 
 // X/Y enums are fixed to 0/1 so they may be used to index ImVec2
@@ -631,11 +636,31 @@ struct ImGuiSettingsHandler
     void*       (*ReadOpenFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, const char* name);              // Read: Called when entering into a new ini entry e.g. "[Window][Name]"
     void        (*ReadLineFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, void* entry, const char* line); // Read: Called for every line of text within an ini entry
     void        (*WriteAllFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* out_buf);      // Write: Output every entries into 'out_buf'
+    void        (*WriteEntryFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImGuiID entry_id, ImGuiTextBuffer* out_buf);  // Write: Output a single entry (same format as WriteAllFn). Optional: allows incremental binary saving of the entries flagged with MarkIniSettingsDirty(handler, entry_id)
     void*       UserData;
 
     ImGuiSettingsHandler() { memset(this, 0, sizeof(*this)); }
 };
 
+// Settings entry modified since the last save, when io.IniBinaryFormat is set
+struct ImGuiSettingsDirtyEntry
+{
+    ImGuiID     TypeHash;       // == ImGuiSettingsHandler::TypeHash
+    ImGuiID     ID;             // Passed to ImGuiSettingsHandler::WriteEntryFn
+};
+
+// Custom log destination, see LogToSink().
+// Text logged during a frame is accumulated in g.LogBuffer and handed over to WriteFn() once per frame (from EndFrame() and LogFinish()),
+// so WriteFn() is called at most a few times per frame and should only copy the data (e.g. into a queue consumed by another thread).
+struct ImGuiLogSink
+{
+    void        (*WriteFn)(ImGuiLogSink* sink, const char* text, int text_len);    // Receive a batch of logged text (not zero-terminated)
+    void        (*CloseFn)(ImGuiLogSink* sink);                                     // Called by LogFinish() after the last WriteFn(). Optional.
+    void*       UserData;
+
+    ImGuiLogSink() { memset(this, 0, sizeof(*this)); }
+};
+
 // Storage for current popup stack
 struct ImGuiPopupRef
 {
@@ -809,7 +834,9 @@ struct ImGuiContext
     int                     FrameCountEnded;
     int                     FrameCountRendered;
     ImVector<ImGuiWindow*>  Windows;                            // Windows, sorted in display order, back to front
-    ImVector<ImGuiWindow*>  WindowsFocusOrder;                  // Windows, sorted in focus order, back to front
+    ImGuiWindow*            WindowsFocusOrderBack;              // Windows, linked in focus order: least recently focused window. Walk toward the front with window->FocusOrderNext.
+    ImGuiWindow*            WindowsFocusOrderFront;             // Windows, linked in focus order: most recently focused window. Walk toward the back with window->FocusOrderPrev.
+    int                     WindowsFocusOrderCount;
     ImVector<ImGuiWindow*>  WindowsSortBuffer;
     ImVector<ImGuiWindow*>  CurrentWindowStack;
     ImGuiStorage            WindowsById;
@@ -959,12 +986,18 @@ struct ImGuiContext
     ImGuiTextBuffer                SettingsIniData;             // In memory .ini settings
     ImVector<ImGuiSettingsHandler> SettingsHandlers;            // List of .ini settings handlers
     ImVector<ImGuiWindowSettings>  SettingsWindows;             // ImGuiWindow .ini settings entries (parsed from the last loaded .ini file and maintained on saving)
+    bool                           SettingsDirtyAll;            // (Binary format) Set by MarkIniSettingsDirty(): next save rewrites every entry
+    ImVector<ImGuiSettingsDirtyEntry> SettingsDirtyEntries;     // (Binary format) Entries to append on next save
+    ImGuiStorage                   SettingsBinaryRecordSizes;   // (Binary format) Size of the latest record of each entry in the file, keyed by ImHashStr(name, 0, type_hash)
+    int                            SettingsBinaryFileSize;      // (Binary format) Size of the file we last wrote/loaded (0: unknown, must rewrite)
+    int                            SettingsBinaryLiveSize;      // (Binary format) Sum of SettingsBinaryRecordSizes: the file is compacted when it gets much bigger than this
 
     // Logging
     bool                    LogEnabled;
     ImGuiLogType            LogType;
     FILE*                   LogFile;                            // If != NULL log to stdout/ file
-    ImGuiTextBuffer         LogBuffer;                          // Accumulation buffer when log to clipboard. This is pointer so our GImGui static constructor doesn't call heap allocators.
+    ImGuiLogSink*           LogSink;                            // If != NULL log to custom sink
+    ImGuiTextBuffer         LogBuffer;                          // Accumulation buffer when log to clipboard/file/sink (file and sink are flushed once per frame). This is pointer so our GImGui static constructor doesn't call heap allocators.
     float                   LogLinePosY;
     bool                    LogLineFirstItem;
     int                     LogDepthRef;
@@ -993,6 +1026,8 @@ struct ImGuiContext
         FrameCount = 0;
         FrameCountEnded = FrameCountRendered = -1;
         WindowsActiveCount = 0;
+        WindowsFocusOrderBack = WindowsFocusOrderFront = NULL;
+        WindowsFocusOrderCount = 0;
         CurrentWindow = NULL;
         HoveredWindow = NULL;
         HoveredRootWindow = NULL;
@@ -1086,10 +1121,13 @@ struct ImGuiContext
 
         SettingsLoaded = false;
         SettingsDirtyTimer = 0.0f;
+        SettingsDirtyAll = false;
+        SettingsBinaryFileSize = SettingsBinaryLiveSize = 0;
 
         LogEnabled = false;
         LogType = ImGuiLogType_None;
         LogFile = NULL;
+        LogSink = NULL;
         LogLinePosY = FLT_MAX;
         LogLineFirstItem = false;
         LogDepthRef = 0;
@@ -1125,6 +1163,11 @@ struct IMGUI_API ImGuiWindowTempData
     ImGuiItemStatusFlags    LastItemStatusFlags;
     ImRect                  LastItemRect;           // Interaction rect
     ImRect                  LastItemDisplayRect;    // End-user display rect (only valid if LastItemStatusFlags & ImGuiItemStatusFlags_HasDisplayRect)
+    ImVector<char>          ItemSkippedLabel;       // Copy of the label of the last item skipped by ItemSkipIfClipped() before measuring it (zero-terminated, empty if none). Measured by SameLine() if it follows.
+    ImVec2                  ItemSkippedLabelPrevLine;   // CursorPosPrevLine after that item (if it changed, another item followed)
+    float                   ItemSkippedLabelSpacing;    // Added to the label width when the label is not empty
+    bool                    ItemSkippedLabelHideTextAfterDoubleHash;
+    bool                    ItemSkippedWidthUnknown;    // An item was skipped before measuring its label in this frame: CursorMaxPos.x may miss its width
     ImGuiNavLayer           NavLayerCurrent;        // Current layer, 0..31 (we currently only use 0..1)
     int                     NavLayerCurrentMask;    // = (1 << NavLayerCurrent) used by ItemAdd prior to clipping.
     int                     NavLayerActiveMask;     // Which layer have been written to (result from previous frame)
@@ -1165,6 +1208,9 @@ struct IMGUI_API ImGuiWindowTempData
         LastItemId = 0;
         LastItemStatusFlags = 0;
         LastItemRect = LastItemDisplayRect = ImRect();
+        ItemSkippedLabelPrevLine = ImVec2(0.0f, 0.0f);
+        ItemSkippedLabelSpacing = 0.0f;
+        ItemSkippedLabelHideTextAfterDoubleHash = ItemSkippedWidthUnknown = false;
         NavLayerActiveMask = NavLayerActiveMaskNext = 0x00;
         NavLayerCurrent = ImGuiNavLayer_Main;
         NavLayerCurrentMask = (1 << ImGuiNavLayer_Main);
@@ -1257,6 +1303,8 @@ struct IMGUI_API ImGuiWindow
     ImGuiWindow*            RootWindow;                         // Point to ourself or first ancestor that is not a child window.
     ImGuiWindow*            RootWindowForTitleBarHighlight;     // Point to ourself or first ancestor which will display TitleBgActive color when this window is active.
     ImGuiWindow*            RootWindowForNav;                   // Point to ourself or first ancestor which doesn't have the NavFlattened flag.
+    ImGuiWindow*            FocusOrderPrev;                     // Intrusive focus order list: next window toward the back (less recently focused), NULL if we are the back-most.
+    ImGuiWindow*            FocusOrderNext;                     // Intrusive focus order list: next window toward the front (more recently focused), NULL if we are the front-most.
 
     ImGuiWindow*            NavLastChildNavWindow;              // When going to the menu bar, we remember the child window we came from. (This could probably be made implicit if we kept g.Windows sorted by last focused including child window.)
     ImGuiID                 NavLastIds[ImGuiNavLayer_COUNT];    // Last known NavId for this window, per layer (0/1)
@@ -1408,10 +1456,13 @@ namespace ImGui
     // Settings
     IMGUI_API void                  MarkIniSettingsDirty();
     IMGUI_API void                  MarkIniSettingsDirty(ImGuiWindow* window);
+    IMGUI_API void                  MarkIniSettingsDirty(ImGuiSettingsHandler* handler, ImGuiID entry_id);   // Flag a single entry of a handler that implements WriteEntryFn
     IMGUI_API ImGuiWindowSettings*  CreateNewWindowSettings(const char* name);
     IMGUI_API ImGuiWindowSettings*  FindWindowSettings(ImGuiID id);
     IMGUI_API ImGuiWindowSettings*  FindOrCreateWindowSettings(const char* name);
     IMGUI_API ImGuiSettingsHandler* FindSettingsHandler(const char* type_name);
+    IMGUI_API bool                  LoadBinarySettingsFromMemory(char* data, size_t data_size);    // 'data' is modified in place. Returns false if the data wasn't parsed up to its end (truncated/corrupt record or different version)
+    IMGUI_API void                  SaveBinarySettingsToDisk(const char* filename);
 
     // Basic Accessors
     inline ImGuiID          GetItemID()     { ImGuiContext& g = *GImGui; return g.CurrentWindow->DC.LastItemId; }
@@ -1429,6 +1480,7 @@ namespace ImGui
     IMGUI_API void          ItemSize(const ImVec2& size, float text_offset_y = 0.0f);
     IMGUI_API void          ItemSize(const ImRect& bb, float text_offset_y = 0.0f);
     IMGUI_API bool          ItemAdd(const ImRect& bb, ImGuiID id, const ImRect* nav_bb = NULL);
+    IMGUI_API bool          ItemSkipIfClipped(const ImRect& bb, ImGuiID id, const ImVec2& size, float text_offset_y = 0.0f, const char* label = NULL, const char* label_end = NULL, float label_spacing = 0.0f); // Culling early-out for widgets which know their height before measuring their label. See comments in imgui.cpp.
     IMGUI_API bool          ItemHoverable(const ImRect& bb, ImGuiID id);
     IMGUI_API bool          IsClippedEx(const ImRect& bb, ImGuiID id, bool clip_even_when_logged);
     IMGUI_API bool          FocusableItemRegister(ImGuiWindow* window, ImGuiID id);   // Return true if focus is requested
@@ -1442,6 +1494,8 @@ namespace ImGui
     // Logging/Capture
     IMGUI_API void          LogBegin(ImGuiLogType type, int auto_open_depth);   // -> BeginCapture() when we design v2 api, for now stay under the radar by using the old name.
     IMGUI_API void          LogToBuffer(int auto_open_depth = -1);              // Start logging/capturing to internal buffer
+    IMGUI_API void          LogToSink(ImGuiLogSink* sink, int auto_open_depth = -1);    // Start logging/capturing to a custom sink (e.g. a background writer)
+    IMGUI_API void          LogFlush();                                         // Hand over accumulated text to the file/sink. Called once per frame by EndFrame().
 
     // Popups, Modals, Tooltips
     IMGUI_API void          OpenPopupEx(ImGuiID id);
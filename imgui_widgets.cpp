@@ -222,6 +222,10 @@ void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags)
     }
     else
     {
+        // Culling early-out: a single line of text has a known height, skip measuring it when clipped
+        if (!wrap_enabled && memchr(text, '\n', text_end - text) == NULL && ItemSkipIfClipped(ImRect(text_pos, text_pos + ImVec2(0.0f, g.FontSize)), 0, ImVec2(0.0f, g.FontSize), 0.0f, text_begin, text_end))
+            return;
+
         const float wrap_width = wrap_enabled ? CalcWrapWidthForPos(window->DC.CursorPos, wrap_pos_x) : 0.0f;
         const ImVec2 text_size = CalcTextSize(text_begin, text_end, false, wrap_width);
 
@@ -559,11 +563,20 @@ bool ImGui::ButtonEx(const char* label, const ImVec2& size_arg, ImGuiButtonFlags
     ImGuiContext& g = *GImGui;
     const ImGuiStyle& style = g.Style;
     const ImGuiID id = window->GetID(label);
-    const ImVec2 label_size = CalcTextSize(label, NULL, true);
 
     ImVec2 pos = window->DC.CursorPos;
     if ((flags & ImGuiButtonFlags_AlignTextBaseLine) && style.FramePadding.y < window->DC.CurrentLineTextBaseOffset) // Try to vertically align buttons that are smaller/have no padding so that text baseline matches (bit hacky, since it shouldn't be a flag)
         pos.y += window->DC.CurrentLineTextBaseOffset - style.FramePadding.y;
+
+    // Culling early-out: a single line label has a known height, skip measuring it when clipped (the label width is only needed without a width in size_arg)
+    if (size_arg.y != 0.0f || strchr(label, '\n') == NULL)
+    {
+        const ImVec2 size_no_label = CalcItemSize(size_arg, style.FramePadding.x * 2.0f, g.FontSize + style.FramePadding.y * 2.0f);
+        if (ItemSkipIfClipped(ImRect(pos, pos + size_no_label), id, size_no_label, style.FramePadding.y, size_arg.x == 0.0f ? label : NULL))
+            return false;
+    }
+
+    const ImVec2 label_size = CalcTextSize(label, NULL, true);
     ImVec2 size = CalcItemSize(size_arg, label_size.x + style.FramePadding.x * 2.0f, label_size.y + style.FramePadding.y * 2.0f);
 
     const ImRect bb(pos, pos + size);
@@ -920,10 +933,18 @@ bool ImGui::Checkbox(const char* label, bool* v)
     ImGuiContext& g = *GImGui;
     const ImGuiStyle& style = g.Style;
     const ImGuiID id = window->GetID(label);
-    const ImVec2 label_size = CalcTextSize(label, NULL, true);
-
     const float square_sz = GetFrameHeight();
     const ImVec2 pos = window->DC.CursorPos;
+
+    // Culling early-out: a single line label has a known height, skip measuring it when clipped
+    if (strchr(label, '\n') == NULL)
+    {
+        const ImVec2 size_no_label(square_sz, g.FontSize + style.FramePadding.y * 2.0f);
+        if (ItemSkipIfClipped(ImRect(pos, pos + size_no_label), id, size_no_label, style.FramePadding.y, label, NULL, style.ItemInnerSpacing.x))
+            return false;
+    }
+
+    const ImVec2 label_size = CalcTextSize(label, NULL, true);
     const ImRect total_bb(pos, pos + ImVec2(square_sz + (label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f), label_size.y + style.FramePadding.y * 2.0f));
     ItemSize(total_bb, style.FramePadding.y);
     if (!ItemAdd(total_bb, id))
@@ -4892,10 +4913,35 @@ bool ImGui::TreeNodeBehavior(ImGuiID id, ImGuiTreeNodeFlags flags, const char* l
 
     if (!label_end)
         label_end = FindRenderedTextEnd(label);
-    const ImVec2 label_size = CalcTextSize(label, label_end, false);
 
     // We vertically grow up to current line height up the typical widget height.
     const float text_base_offset_y = ImMax(padding.y, window->DC.CurrentLineTextBaseOffset); // Latch before ItemSize changes it
+
+    // Culling early-out: a single line label has a known height, skip measuring it when clipped
+    if (memchr(label, '\n', label_end - label) == NULL)
+    {
+        const float frame_height = ImMax(ImMin(window->DC.CurrentLineSize.y, g.FontSize + style.FramePadding.y*2), g.FontSize + padding.y*2);
+        ImRect frame_bb = ImRect(window->DC.CursorPos, ImVec2(window->Pos.x + GetContentRegionMax().x, window->DC.CursorPos.y + frame_height));
+        if (display_frame)
+        {
+            frame_bb.Min.x -= (float)(int)(window->WindowPadding.x*0.5f) - 1;
+            frame_bb.Max.x += (float)(int)(window->WindowPadding.x*0.5f) - 1;
+        }
+        const ImRect interact_bb = display_frame ? frame_bb : ImRect(frame_bb.Min.x, frame_bb.Min.y, frame_bb.Min.x + g.FontSize + style.ItemSpacing.x*2, frame_bb.Max.y);
+        if (ItemSkipIfClipped(interact_bb, id, ImVec2(g.FontSize, frame_height), text_base_offset_y, label, label_end, padding.x*2))
+        {
+            window->DC.LastItemStatusFlags |= ImGuiItemStatusFlags_HasDisplayRect;
+            window->DC.LastItemDisplayRect = frame_bb;
+            bool is_open = TreeNodeBehaviorIsOpen(id, flags);
+            if (is_open && !g.NavIdIsAlive && (flags & ImGuiTreeNodeFlags_NavLeftJumpsBackHere) && !(flags & ImGuiTreeNodeFlags_NoTreePushOnOpen))
+                window->DC.TreeDepthMayJumpToParentOnPop |= (1 << window->DC.TreeDepth);
+            if (is_open && !(flags & ImGuiTreeNodeFlags_NoTreePushOnOpen))
+                TreePushRawID(id);
+            return is_open;
+        }
+    }
+
+    const ImVec2 label_size = CalcTextSize(label, label_end, false);
     const float frame_height = ImMax(ImMin(window->DC.CurrentLineSize.y, g.FontSize + style.FramePadding.y*2), label_size.y + padding.y*2);
     ImRect frame_bb = ImRect(window->DC.CursorPos, ImVec2(window->Pos.x + GetContentRegionMax().x, window->DC.CursorPos.y + frame_height));
     if (display_frame)
@@ -5154,27 +5200,49 @@ bool ImGui::Selectable(const char* label, bool selected, ImGuiSelectableFlags fl
         PopClipRect();
 
     ImGuiID id = window->GetID(label);
-    ImVec2 label_size = CalcTextSize(label, NULL, true);
-    ImVec2 size(size_arg.x != 0.0f ? size_arg.x : label_size.x, size_arg.y != 0.0f ? size_arg.y : label_size.y);
     ImVec2 pos = window->DC.CursorPos;
     pos.y += window->DC.CurrentLineTextBaseOffset;
+    ImVec2 window_padding = window->WindowPadding;
+    float max_x = (flags & ImGuiSelectableFlags_SpanAllColumns) ? GetWindowContentRegionMax().x : GetContentRegionMax().x;
+
+    // Selectables are tightly packed together, we extend the box to cover spacing between selectable.
+    float spacing_L = (float)(int)(style.ItemSpacing.x * 0.5f);
+    float spacing_U = (float)(int)(style.ItemSpacing.y * 0.5f);
+    float spacing_R = style.ItemSpacing.x - spacing_L;
+    float spacing_D = style.ItemSpacing.y - spacing_U;
+
+    // Culling early-out: a single line label has a known height, skip measuring it when clipped (the label width is only needed without a width in size_arg)
+    if (size_arg.x >= 0.0f && (size_arg.y > 0.0f || (size_arg.y == 0.0f && strchr(label, '\n') == NULL)))
+    {
+        const ImVec2 size_no_label(size_arg.x, size_arg.y != 0.0f ? size_arg.y : g.FontSize);
+        ImRect bb(pos, ImVec2(window->Pos.x + max_x - window_padding.x, pos.y + size_no_label.y));
+        if (size_arg.x != 0.0f && !(flags & ImGuiSelectableFlags_DrawFillAvailWidth))
+            bb.Max.x = pos.x + size_arg.x;
+        if (size_arg.x == 0.0f || (flags & ImGuiSelectableFlags_DrawFillAvailWidth))
+            bb.Max.x += window_padding.x;
+        bb.Min.x -= spacing_L;
+        bb.Min.y -= spacing_U;
+        bb.Max.x += spacing_R;
+        bb.Max.y += spacing_D;
+        if (ItemSkipIfClipped(bb, id, size_no_label, 0.0f, size_arg.x == 0.0f ? label : NULL))
+        {
+            if ((flags & ImGuiSelectableFlags_SpanAllColumns) && window->DC.ColumnsSet)
+                PushColumnClipRect();
+            return false;
+        }
+    }
+
+    ImVec2 label_size = CalcTextSize(label, NULL, true);
+    ImVec2 size(size_arg.x != 0.0f ? size_arg.x : label_size.x, size_arg.y != 0.0f ? size_arg.y : label_size.y);
     ImRect bb_inner(pos, pos + size);
     ItemSize(bb_inner);
 
     // Fill horizontal space.
-    ImVec2 window_padding = window->WindowPadding;
-    float max_x = (flags & ImGuiSelectableFlags_SpanAllColumns) ? GetWindowContentRegionMax().x : GetContentRegionMax().x;
     float w_draw = ImMax(label_size.x, window->Pos.x + max_x - window_padding.x - pos.x);
     ImVec2 size_draw((size_arg.x != 0 && !(flags & ImGuiSelectableFlags_DrawFillAvailWidth)) ? size_arg.x : w_draw, size_arg.y != 0.0f ? size_arg.y : size.y);
     ImRect bb(pos, pos + size_draw);
     if (size_arg.x == 0.0f || (flags & ImGuiSelectableFlags_DrawFillAvailWidth))
         bb.Max.x += window_padding.x;
-
-    // Selectables are tightly packed together, we extend the box to cover spacing between selectable.
-    float spacing_L = (float)(int)(style.ItemSpacing.x * 0.5f);
-    float spacing_U = (float)(int)(style.ItemSpacing.y * 0.5f);
-    float spacing_R = style.ItemSpacing.x - spacing_L;
-    float spacing_D = style.ItemSpacing.y - spacing_U;
     bb.Min.x -= spacing_L;
     bb.Min.y -= spacing_U;
     bb.Max.x += spacing_R;